@@ -0,0 +1,463 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+/*
+ * Accuracy versus speed report for the rotation kernels.
+ *
+ * Every kernel is evaluated in float and double on a sweep of inputs which contains random rotations
+ * and the classical singular configurations (identity, small angles, angles close to pi, pitch close to +-pi/2).
+ * The result is compared to the same kernel evaluated in long double on the identical (rounded) input.
+ * The reference is therefore not an independent method: it measures the rounding error of the kernel in the
+ * given precision, but not an error of the formula itself (which is shared by both evaluations).
+ *
+ * Errors are measured as
+ *  - the disparity angle if the kernel returns a rotation or a rotation vector (compared through its exponential,
+ *    since v and -v close to pi describe the same rotation on the antipodal branch),
+ *  - the maximal absolute coefficient difference (relative to the largest reference coefficient if it is larger than one)
+ *    if the kernel returns a vector or a matrix.
+ *
+ * Usage: runAccuracyBenchmark [number of random samples] [repetitions for timing]
+ * The exit code is nonzero if any kernel exceeds its tolerance.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <Eigen/Core>
+#include <Eigen/StdVector>
+
+#include "kindr/Core"
+
+namespace kindr_benchmark {
+
+typedef long double Reference;
+
+//! Input class names, used to find the configuration with the largest error.
+enum class InputClass : int {
+  Random = 0,
+  Identity,
+  SmallAngle,
+  AngleNearPi,
+  PitchNearPlusHalfPi,
+  PitchNearMinusHalfPi,
+  NumInputClasses
+};
+
+static const char* const inputClassNames[] = {
+  "random", "identity", "small angle", "angle near pi", "pitch near +pi/2", "pitch near -pi/2"
+};
+
+struct Sample {
+  kindr::RotationQuaternion<Reference> rotation;
+  InputClass inputClass;
+};
+
+typedef std::vector<Sample, Eigen::aligned_allocator<Sample>> Samples;
+
+//! Generates a deterministic sweep of rotations including the near-singular configurations.
+inline Samples generateSamples(int numRandomSamples) {
+  typedef kindr::AngleAxis<Reference> AngleAxis;
+  typedef kindr::EulerAnglesZyx<Reference> EulerAnglesZyx;
+  typedef Eigen::Matrix<Reference, 3, 1> Vector3;
+  const Reference pi = Reference(M_PI);
+
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> angleDistribution(-M_PI, M_PI);
+  std::normal_distribution<double> axisDistribution(0.0, 1.0);
+  auto randomAxis = [&]() {
+    Vector3 axis(axisDistribution(generator), axisDistribution(generator), axisDistribution(generator));
+    return Vector3(axis.normalized());
+  };
+  const Reference deltas[] = {Reference(0), Reference(1e-12), Reference(1e-9), Reference(1e-6), Reference(1e-3)};
+
+  Samples samples;
+  for (int i = 0; i < numRandomSamples; i++) {
+    samples.push_back(Sample{kindr::RotationQuaternion<Reference>(AngleAxis(std::abs(angleDistribution(generator)), randomAxis())), InputClass::Random});
+  }
+  samples.push_back(Sample{kindr::RotationQuaternion<Reference>(), InputClass::Identity});
+  for (int i = 0; i < 20; i++) {
+    for (Reference delta : deltas) {
+      if (delta > Reference(0)) {
+        samples.push_back(Sample{kindr::RotationQuaternion<Reference>(AngleAxis(delta, randomAxis())), InputClass::SmallAngle});
+      }
+      samples.push_back(Sample{kindr::RotationQuaternion<Reference>(AngleAxis(pi - delta, randomAxis())), InputClass::AngleNearPi});
+      samples.push_back(Sample{kindr::RotationQuaternion<Reference>(EulerAnglesZyx(angleDistribution(generator), pi/2 - delta, angleDistribution(generator))), InputClass::PitchNearPlusHalfPi});
+      samples.push_back(Sample{kindr::RotationQuaternion<Reference>(EulerAnglesZyx(angleDistribution(generator), -pi/2 + delta, angleDistribution(generator))), InputClass::PitchNearMinusHalfPi});
+    }
+  }
+  return samples;
+}
+
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+ * Casting and error measures
+ * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+template<typename DestScalar_, typename SourceScalar_, int Rows_, int Cols_>
+inline Eigen::Matrix<DestScalar_, Rows_, Cols_> castTo(const Eigen::Matrix<SourceScalar_, Rows_, Cols_>& matrix) {
+  return matrix.template cast<DestScalar_>();
+}
+
+template<typename DestScalar_, template<typename> class Rotation_, typename SourceScalar_>
+inline Rotation_<DestScalar_> castTo(const Rotation_<SourceScalar_>& rotation) {
+  return Rotation_<DestScalar_>(rotation);
+}
+
+/*! \brief Selects the overloads for rotations.
+ *  The rotation overloads take the derived type since RotationMatrix would otherwise also match the Eigen overloads.
+ */
+template<typename Type_, typename Result_>
+using EnableIfRotation = typename std::enable_if<std::is_base_of<kindr::RotationBase<Type_>, Type_>::value, Result_>::type;
+
+template<typename Rotation_>
+inline EnableIfRotation<Rotation_, Reference> getError(const Rotation_& result, const kindr::RotationQuaternion<Reference>& reference) {
+  // The quaternion disparity angle is computed with atan2 since acos is badly conditioned for small angles.
+  const kindr::RotationQuaternion<Reference> difference(kindr::RotationQuaternion<Reference>(result).toImplementation()*reference.toImplementation().conjugate());
+  return Reference(2)*std::atan2(difference.imaginary().norm(), std::abs(difference.w()));
+}
+
+template<typename Scalar_, int Rows_, int Cols_>
+inline Reference getError(const Eigen::Matrix<Scalar_, Rows_, Cols_>& result, const Eigen::Matrix<Reference, Rows_, Cols_>& reference) {
+  const Reference scale = std::max(Reference(1), reference.cwiseAbs().maxCoeff());
+  return (result.template cast<Reference>() - reference).cwiseAbs().maxCoeff()/scale;
+}
+
+template<typename Rotation_>
+inline EnableIfRotation<Rotation_, kindr::RotationQuaternion<Reference>> toReferenceOutput(const Rotation_& rotation) {
+  return kindr::RotationQuaternion<Reference>(rotation);
+}
+
+inline const kindr::RotationQuaternion<Reference>& toReferenceOutput(const kindr::RotationQuaternion<Reference>& rotation) {
+  return rotation;
+}
+
+template<int Rows_, int Cols_>
+inline const Eigen::Matrix<Reference, Rows_, Cols_>& toReferenceOutput(const Eigen::Matrix<Reference, Rows_, Cols_>& matrix) {
+  return matrix;
+}
+
+/*! \brief Keeps the optimizer from removing the timed kernel calls.
+ *  The checksum is taken from the native result, such that no conversion is timed.
+ */
+template<typename Derived_>
+inline double getChecksum(const Eigen::MatrixBase<Derived_>& matrix) {
+  return double(matrix.sum());
+}
+
+template<typename Scalar_>
+inline double getChecksum(const Eigen::Quaternion<Scalar_>& quaternion) {
+  return double(quaternion.coeffs().sum());
+}
+
+template<typename Scalar_>
+inline double getChecksum(const Eigen::AngleAxis<Scalar_>& angleAxis) {
+  return double(angleAxis.angle() + angleAxis.axis().sum());
+}
+
+template<typename Rotation_>
+inline EnableIfRotation<Rotation_, double> touch(const Rotation_& rotation) {
+  return getChecksum(rotation.toImplementation());
+}
+
+template<typename Scalar_, int Rows_, int Cols_>
+inline double touch(const Eigen::Matrix<Scalar_, Rows_, Cols_>& matrix) {
+  return getChecksum(matrix);
+}
+
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+ * Kernels
+ *  Each kernel provides its name, its input computed from a sample and the operation itself.
+ * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+#define KINDR_BENCHMARK_CONVERSION_KERNEL(NAME, SOURCE, DEST) \
+  struct NAME { \
+    static const char* name() { return #SOURCE " -> " #DEST; } \
+    template<typename Scalar_> \
+    static kindr::SOURCE<Scalar_> input(const kindr::RotationQuaternion<Reference>& sample) { \
+      return kindr::SOURCE<Scalar_>(kindr::RotationQuaternion<Scalar_>(sample)); \
+    } \
+    template<typename Scalar_> \
+    static kindr::DEST<Scalar_> run(const kindr::SOURCE<Scalar_>& input) { \
+      return kindr::DEST<Scalar_>(input); \
+    } \
+  };
+
+KINDR_BENCHMARK_CONVERSION_KERNEL(QuaternionToMatrix, RotationQuaternion, RotationMatrix)
+KINDR_BENCHMARK_CONVERSION_KERNEL(MatrixToQuaternion, RotationMatrix, RotationQuaternion)
+KINDR_BENCHMARK_CONVERSION_KERNEL(QuaternionToAngleAxis, RotationQuaternion, AngleAxis)
+KINDR_BENCHMARK_CONVERSION_KERNEL(AngleAxisToQuaternion, AngleAxis, RotationQuaternion)
+KINDR_BENCHMARK_CONVERSION_KERNEL(QuaternionToRotationVector, RotationQuaternion, RotationVector)
+KINDR_BENCHMARK_CONVERSION_KERNEL(RotationVectorToQuaternion, RotationVector, RotationQuaternion)
+KINDR_BENCHMARK_CONVERSION_KERNEL(MatrixToRotationVector, RotationMatrix, RotationVector)
+KINDR_BENCHMARK_CONVERSION_KERNEL(MatrixToAngleAxis, RotationMatrix, AngleAxis)
+KINDR_BENCHMARK_CONVERSION_KERNEL(QuaternionToEulerAnglesZyx, RotationQuaternion, EulerAnglesZyx)
+KINDR_BENCHMARK_CONVERSION_KERNEL(EulerAnglesZyxToQuaternion, EulerAnglesZyx, RotationQuaternion)
+KINDR_BENCHMARK_CONVERSION_KERNEL(EulerAnglesZyxToMatrix, EulerAnglesZyx, RotationMatrix)
+KINDR_BENCHMARK_CONVERSION_KERNEL(QuaternionToEulerAnglesXyz, RotationQuaternion, EulerAnglesXyz)
+KINDR_BENCHMARK_CONVERSION_KERNEL(EulerAnglesXyzToQuaternion, EulerAnglesXyz, RotationQuaternion)
+
+#undef KINDR_BENCHMARK_CONVERSION_KERNEL
+
+struct ExponentialMap {
+  static const char* name() { return "RotationQuaternion::exponentialMap"; }
+  template<typename Scalar_>
+  static Eigen::Matrix<Scalar_, 3, 1> input(const kindr::RotationQuaternion<Reference>& sample) {
+    return kindr::RotationVector<Scalar_>(kindr::RotationQuaternion<Scalar_>(sample)).vector();
+  }
+  template<typename Scalar_>
+  static kindr::RotationQuaternion<Scalar_> run(const Eigen::Matrix<Scalar_, 3, 1>& input) {
+    return kindr::RotationQuaternion<Scalar_>().exponentialMap(input);
+  }
+};
+
+//! The rotation vector is compared through its exponential, i.e. as a rotation.
+struct LogarithmicMap {
+  static const char* name() { return "RotationQuaternion::logarithmicMap"; }
+  template<typename Scalar_>
+  static kindr::RotationQuaternion<Scalar_> input(const kindr::RotationQuaternion<Reference>& sample) {
+    return kindr::RotationQuaternion<Scalar_>(sample);
+  }
+  template<typename Scalar_>
+  static kindr::RotationVector<Scalar_> run(const kindr::RotationQuaternion<Scalar_>& input) {
+    return kindr::RotationVector<Scalar_>(input.logarithmicMap());
+  }
+};
+
+struct BoxPlus {
+  static const char* name() { return "RotationQuaternion::boxPlus"; }
+  template<typename Scalar_>
+  static kindr::RotationQuaternion<Scalar_> input(const kindr::RotationQuaternion<Reference>& sample) {
+    return kindr::RotationQuaternion<Scalar_>(sample);
+  }
+  template<typename Scalar_>
+  static kindr::RotationQuaternion<Scalar_> run(const kindr::RotationQuaternion<Scalar_>& input) {
+    return input.boxPlus(Eigen::Matrix<Scalar_, 3, 1>(Scalar_(0.1), Scalar_(-0.2), Scalar_(0.3)));
+  }
+};
+
+struct BoxMinus {
+  static const char* name() { return "RotationQuaternion::boxMinus"; }
+  template<typename Scalar_>
+  static kindr::RotationQuaternion<Scalar_> input(const kindr::RotationQuaternion<Reference>& sample) {
+    return kindr::RotationQuaternion<Scalar_>(sample);
+  }
+  template<typename Scalar_>
+  static kindr::RotationVector<Scalar_> run(const kindr::RotationQuaternion<Scalar_>& input) {
+    return kindr::RotationVector<Scalar_>(input.boxMinus(kindr::RotationQuaternion<Scalar_>(kindr::AngleAxis<Scalar_>(Scalar_(0.3), Scalar_(0), Scalar_(1), Scalar_(0)))));
+  }
+};
+
+struct RotateVector {
+  static const char* name() { return "RotationQuaternion::rotate"; }
+  template<typename Scalar_>
+  static kindr::RotationQuaternion<Scalar_> input(const kindr::RotationQuaternion<Reference>& sample) {
+    return kindr::RotationQuaternion<Scalar_>(sample);
+  }
+  template<typename Scalar_>
+  static Eigen::Matrix<Scalar_, 3, 1> run(const kindr::RotationQuaternion<Scalar_>& input) {
+    return input.rotate(Eigen::Matrix<Scalar_, 3, 1>(Scalar_(1), Scalar_(-2), Scalar_(3)));
+  }
+};
+
+struct JacobianOfExponentialMap {
+  static const char* name() { return "getJacobianOfExponentialMap"; }
+  template<typename Scalar_>
+  static Eigen::Matrix<Scalar_, 3, 1> input(const kindr::RotationQuaternion<Reference>& sample) {
+    return kindr::RotationVector<Scalar_>(kindr::RotationQuaternion<Scalar_>(sample)).vector();
+  }
+  template<typename Scalar_>
+  static Eigen::Matrix<Scalar_, 3, 3> run(const Eigen::Matrix<Scalar_, 3, 1>& input) {
+    return kindr::getJacobianOfExponentialMap(input);
+  }
+};
+
+#define KINDR_BENCHMARK_MAPPING_KERNEL(NAME, ROTATION, MAPPING) \
+  struct NAME { \
+    static const char* name() { return #ROTATION "::" #MAPPING; } \
+    template<typename Scalar_> \
+    static kindr::ROTATION<Scalar_> input(const kindr::RotationQuaternion<Reference>& sample) { \
+      return kindr::ROTATION<Scalar_>(kindr::RotationQuaternion<Scalar_>(sample)); \
+    } \
+    template<typename Scalar_> \
+    static Eigen::Matrix<Scalar_, 3, 3> run(const kindr::ROTATION<Scalar_>& input) { \
+      return input.MAPPING(); \
+    } \
+  };
+
+KINDR_BENCHMARK_MAPPING_KERNEL(ZyxDiffToLocalAngularVelocity, EulerAnglesZyx, getMappingFromDiffToLocalAngularVelocity)
+KINDR_BENCHMARK_MAPPING_KERNEL(ZyxLocalAngularVelocityToDiff, EulerAnglesZyx, getMappingFromLocalAngularVelocityToDiff)
+KINDR_BENCHMARK_MAPPING_KERNEL(XyzDiffToLocalAngularVelocity, EulerAnglesXyz, getMappingFromDiffToLocalAngularVelocity)
+KINDR_BENCHMARK_MAPPING_KERNEL(XyzLocalAngularVelocityToDiff, EulerAnglesXyz, getMappingFromLocalAngularVelocityToDiff)
+
+#undef KINDR_BENCHMARK_MAPPING_KERNEL
+
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+ * Evaluation
+ * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+struct Report {
+  double nanosecondsPerCall = 0.0;
+  Reference maxError = Reference(0);
+  Reference rmsError = Reference(0);
+  InputClass worstInputClass = InputClass::Random;
+  int numFailedCalls = 0;
+};
+
+template<typename Scalar_> struct PrecisionName;
+template<> struct PrecisionName<float> { static const char* get() { return "float"; } };
+template<> struct PrecisionName<double> { static const char* get() { return "double"; } };
+
+template<typename Kernel_, typename Scalar_>
+Report evaluate(const Samples& samples, int repetitions) {
+  typedef decltype(Kernel_::template input<Scalar_>(samples.front().rotation)) Input;
+  typedef std::vector<Input, Eigen::aligned_allocator<Input>> Inputs;
+  Report report;
+
+  // Accuracy: compare with the long double evaluation on the same rounded input.
+  // Only the inputs on which the kernel does not throw are timed.
+  Inputs inputs;
+  Reference sumOfSquaredErrors = Reference(0);
+  int numEvaluatedCalls = 0;
+  for (const Sample& sample : samples) {
+    const Input input = Kernel_::template input<Scalar_>(sample.rotation);
+    try {
+      const auto result = Kernel_::template run<Scalar_>(input);
+      inputs.push_back(input);
+      const auto reference = Kernel_::template run<Reference>(castTo<Reference>(input));
+      Reference error = getError(result, toReferenceOutput(reference));
+      if (std::isnan(error)) {
+        error = std::numeric_limits<Reference>::infinity();
+      }
+      if (error > report.maxError) {
+        report.maxError = error;
+        report.worstInputClass = sample.inputClass;
+      }
+      if (std::isfinite(error)) {
+        sumOfSquaredErrors += error*error;
+        numEvaluatedCalls++;
+      }
+    } catch (const std::exception&) {
+      // Kernels may throw at singularities (e.g. gimbal lock).
+      report.numFailedCalls++;
+    }
+  }
+  report.rmsError = std::sqrt(sumOfSquaredErrors/Reference(std::max(numEvaluatedCalls, 1)));
+
+  // Speed
+  double sink = 0.0;
+  const auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < repetitions; r++) {
+    for (const Input& input : inputs) {
+      sink += touch(Kernel_::template run<Scalar_>(input));
+    }
+  }
+  const auto stop = std::chrono::steady_clock::now();
+  const double numTimedCalls = double(repetitions)*double(inputs.size());
+  report.nanosecondsPerCall = std::chrono::duration<double, std::nano>(stop - start).count()/std::max(numTimedCalls, 1.0);
+  if (sink == 0.123456789) { // never true, but the compiler cannot know
+    std::printf(" ");
+  }
+  return report;
+}
+
+template<typename Kernel_, typename Scalar_>
+bool printReport(const Samples& samples, int repetitions) {
+  const Report report = evaluate<Kernel_, Scalar_>(samples, repetitions);
+  const Scalar_ tolerance = kindr::internal::NumTraits<Scalar_>::dummy_precision();
+  const bool isWithinTolerance = (report.maxError <= Reference(tolerance));
+  std::printf("%-58s %-7s %10.1f %12.3Le %12.3Le %10.1e %-4s %-17s",
+              Kernel_::name(), PrecisionName<Scalar_>::get(), report.nanosecondsPerCall,
+              report.maxError, report.rmsError, double(tolerance), isWithinTolerance ? "ok" : "FAIL",
+              inputClassNames[static_cast<int>(report.worstInputClass)]);
+  if (report.numFailedCalls > 0) {
+    std::printf(" (%d calls threw)", report.numFailedCalls);
+  }
+  std::printf("\n");
+  return isWithinTolerance;
+}
+
+template<typename Kernel_>
+int printReports(const Samples& samples, int repetitions) {
+  int numFailures = 0;
+  numFailures += printReport<Kernel_, float>(samples, repetitions) ? 0 : 1;
+  numFailures += printReport<Kernel_, double>(samples, repetitions) ? 0 : 1;
+  return numFailures;
+}
+
+} // namespace kindr_benchmark
+
+
+int main(int argc, char** argv) {
+  using namespace kindr_benchmark;
+  const int numRandomSamples = (argc > 1) ? std::atoi(argv[1]) : 1000;
+  const int repetitions = (argc > 2) ? std::atoi(argv[2]) : 100;
+  const Samples samples = generateSamples(numRandomSamples);
+
+  std::printf("%d inputs, %d repetitions for timing, reference precision: long double\n", int(samples.size()), repetitions);
+  std::printf("tolerance: kindr::internal::NumTraits<Scalar>::dummy_precision()\n\n");
+  std::printf("%-58s %-7s %10s %12s %12s %10s %-4s %-17s\n", "kernel", "scalar", "ns/call", "max error", "rms error", "tolerance", "", "worst input");
+
+  int numFailures = 0;
+  numFailures += printReports<QuaternionToMatrix>(samples, repetitions);
+  numFailures += printReports<MatrixToQuaternion>(samples, repetitions);
+  numFailures += printReports<QuaternionToAngleAxis>(samples, repetitions);
+  numFailures += printReports<AngleAxisToQuaternion>(samples, repetitions);
+  numFailures += printReports<QuaternionToRotationVector>(samples, repetitions);
+  numFailures += printReports<RotationVectorToQuaternion>(samples, repetitions);
+  numFailures += printReports<MatrixToRotationVector>(samples, repetitions);
+  numFailures += printReports<MatrixToAngleAxis>(samples, repetitions);
+  numFailures += printReports<QuaternionToEulerAnglesZyx>(samples, repetitions);
+  numFailures += printReports<EulerAnglesZyxToQuaternion>(samples, repetitions);
+  numFailures += printReports<EulerAnglesZyxToMatrix>(samples, repetitions);
+  numFailures += printReports<QuaternionToEulerAnglesXyz>(samples, repetitions);
+  numFailures += printReports<EulerAnglesXyzToQuaternion>(samples, repetitions);
+  numFailures += printReports<ExponentialMap>(samples, repetitions);
+  numFailures += printReports<LogarithmicMap>(samples, repetitions);
+  numFailures += printReports<BoxPlus>(samples, repetitions);
+  numFailures += printReports<BoxMinus>(samples, repetitions);
+  numFailures += printReports<RotateVector>(samples, repetitions);
+  numFailures += printReports<JacobianOfExponentialMap>(samples, repetitions);
+  numFailures += printReports<ZyxDiffToLocalAngularVelocity>(samples, repetitions);
+  numFailures += printReports<ZyxLocalAngularVelocityToDiff>(samples, repetitions);
+  numFailures += printReports<XyzDiffToLocalAngularVelocity>(samples, repetitions);
+  numFailures += printReports<XyzLocalAngularVelocityToDiff>(samples, repetitions);
+
+  std::printf("\n%d kernel/precision combinations exceed the tolerance.\n", numFailures);
+  return (numFailures > 0) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
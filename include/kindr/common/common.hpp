@@ -35,7 +35,38 @@
 #include <random>
 #include <Eigen/Core>
 
+namespace Eigen {
+template<typename DerType_> class AutoDiffScalar;
+} // namespace Eigen
+
 namespace kindr {
+namespace internal {
+
+/*! \class FloorTraits
+ *  \brief Rounds down a scalar, the default uses floor found by argument-dependent lookup or std::floor.
+ *  (only for advanced users)
+ */
+template<typename T>
+class FloorTraits {
+ public:
+  inline static T floor(const T& x) {
+    using std::floor;
+    return floor(x);
+  }
+};
+
+/*! \brief Eigen::AutoDiffScalar does not provide floor, the result is constant and has zero derivatives.
+ */
+template<typename DerType_>
+class FloorTraits<Eigen::AutoDiffScalar<DerType_>> {
+ public:
+  inline static Eigen::AutoDiffScalar<DerType_> floor(const Eigen::AutoDiffScalar<DerType_>& x) {
+    using std::floor;
+    return Eigen::AutoDiffScalar<DerType_>(floor(x.value()));
+  }
+};
+
+} // namespace internal
 
 /*! \brief Floating-point modulo
  *
@@ -47,22 +78,22 @@ T floatingPointModulo(T x, T y)
 {
     static_assert(!std::numeric_limits<T>::is_exact , "floatingPointModulo: floating-point type expected");
 
-    if (y == 0.0)
+    if (y == T(0))
         return x;
 
-    double m= x - y * floor(x/y);
+    T m= x - y * internal::FloorTraits<T>::floor(T(x/y));
 
     // handle boundary cases resulted from floating-point cut off:
 
-    if (y > 0)              // modulo range: [0..y)
+    if (y > T(0))       // modulo range: [0..y)
     {
         if (m>=y)           // mod(-1e-16             , 360.    ): m= 360.
-            return 0;
+            return T(0);
 
-        if (m<0 )
+        if (m < T(0))
         {
             if (y+m == y)
-                return 0  ; // just in case...
+                return T(0); // just in case...
             else
                 return y+m; // Mod(106.81415022205296 , 2*M_PI ): m= -1.421e-14
         }
@@ -70,12 +101,12 @@ T floatingPointModulo(T x, T y)
     else                    // modulo range: (y..0]
     {
         if (m<=y)           // mod(1e-16              , -360.   ): m= -360.
-            return 0;
+            return T(0);
 
-        if (m>0 )
+        if (m > T(0))
         {
             if (y+m == y)
-                return 0  ; // just in case...
+                return T(0); // just in case...
             else
                 return y+m; // mod(-106.81415022205296, -2*M_PI): m= 1.421e-14
         }
@@ -88,14 +119,14 @@ T floatingPointModulo(T x, T y)
 template<typename T>
 inline T wrapAngle(T angle, T x1, T x2)
 {
-    return floatingPointModulo(angle-x1, x2-x1) + x1;
+    return floatingPointModulo(T(angle-x1), T(x2-x1)) + x1;
 }
 
 //! wrap angle to [-PI..PI)
 template<typename T>
 inline T wrapPosNegPI(T angle)
 {
-    return floatingPointModulo(angle + T(M_PI), T(2.0*M_PI)  ) - M_PI;
+    return floatingPointModulo(T(angle + T(M_PI)), T(2.0*M_PI)) - T(M_PI);
 }
 
 //! wrap angle to [0..2*PI)
@@ -162,9 +193,14 @@ class GenericNumTraits {
 
 };
 
+/*! \brief Numeric traits of scalars which are not built-in floating-point types.
+ *  The precision is taken from Eigen::NumTraits, which is specialized for custom scalars
+ *  like Eigen::AutoDiffScalar or jet types in order to use them in Eigen matrices.
+ */
 template<typename T>
 class NumTraits : GenericNumTraits<T> {
  public:
+  static inline T dummy_precision() { return T(Eigen::NumTraits<T>::dummy_precision()); }
 };
 
 template<>
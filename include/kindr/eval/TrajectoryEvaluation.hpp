@@ -0,0 +1,398 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Core>
+#include <Eigen/StdDeque>
+
+#include "kindr/common/common.hpp"
+#include "kindr/common/assert_macros.hpp"
+#include "kindr/poses/HomogeneousTransformation.hpp"
+#include "kindr/poses/Alignment.hpp"
+
+namespace kindr {
+//! Evaluation of estimated trajectories against ground truth
+namespace eval {
+
+/*! \class ErrorStatistics
+ *  \brief Streaming statistics (count, mean, standard deviation, RMSE, min, max) of error values.
+ *
+ *  The statistics need constant memory. Statistics of disjoint sets of values can be merged,
+ *  e.g. after evaluating chunks of a trajectory in parallel.
+ *  \tparam PrimType_ the primitive type of the data (double or float)
+ */
+template<typename PrimType_>
+class ErrorStatistics {
+ public:
+  typedef PrimType_ Scalar;
+
+  ErrorStatistics() {
+    setZero();
+  }
+
+  /*! \brief Removes all values.
+   *  \returns reference
+   */
+  ErrorStatistics& setZero() {
+    count_ = 0;
+    mean_ = Scalar(0);
+    m2_ = Scalar(0);
+    sumOfSquares_ = Scalar(0);
+    min_ = std::numeric_limits<Scalar>::max();
+    max_ = std::numeric_limits<Scalar>::lowest();
+    return *this;
+  }
+
+  /*! \brief Adds a value (Welford's update).
+   *  \returns reference
+   */
+  ErrorStatistics& add(Scalar value) {
+    ++count_;
+    const Scalar delta = value - mean_;
+    mean_ += delta/Scalar(count_);
+    m2_ += delta*(value - mean_);
+    sumOfSquares_ += value*value;
+    min_ = std::min(min_, value);
+    max_ = std::max(max_, value);
+    return *this;
+  }
+
+  /*! \brief Merges the values of other statistics (Chan's update).
+   *  \returns reference
+   */
+  ErrorStatistics& merge(const ErrorStatistics& other) {
+    if (other.count_ == 0) {
+      return *this;
+    }
+    const Scalar count = Scalar(count_ + other.count_);
+    const Scalar delta = other.mean_ - mean_;
+    m2_ += other.m2_ + delta*delta*Scalar(count_)*Scalar(other.count_)/count;
+    mean_ += delta*Scalar(other.count_)/count;
+    count_ += other.count_;
+    sumOfSquares_ += other.sumOfSquares_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+    return *this;
+  }
+
+  inline std::size_t getCount() const {
+    return count_;
+  }
+
+  inline Scalar getMean() const {
+    return mean_;
+  }
+
+  //! \returns the population standard deviation
+  inline Scalar getStandardDeviation() const {
+    using std::sqrt;
+    return (count_ > 0) ? sqrt(m2_/Scalar(count_)) : Scalar(0);
+  }
+
+  inline Scalar getRootMeanSquare() const {
+    using std::sqrt;
+    return (count_ > 0) ? sqrt(sumOfSquares_/Scalar(count_)) : Scalar(0);
+  }
+
+  inline Scalar getMin() const {
+    return min_;
+  }
+
+  inline Scalar getMax() const {
+    return max_;
+  }
+
+  /*! \brief Used for printing the object with std::cout.
+   *  \returns std::stream object
+   */
+  friend std::ostream& operator << (std::ostream& out, const ErrorStatistics& statistics) {
+    out << "count: " << statistics.getCount() << " rmse: " << statistics.getRootMeanSquare() << " mean: " << statistics.getMean()
+        << " std: " << statistics.getStandardDeviation() << " min: " << statistics.getMin() << " max: " << statistics.getMax();
+    return out;
+  }
+
+ private:
+  std::size_t count_;
+  Scalar mean_;
+  Scalar m2_;
+  Scalar sumOfSquares_;
+  Scalar min_;
+  Scalar max_;
+};
+
+
+/*! \brief Finds the sample with the closest timestamp by binary search.
+ *  \param timestamps          timestamps sorted in increasing order
+ *  \param time                query time
+ *  \param maxTimeDifference   maximal accepted time difference
+ *  \returns the index of the closest sample or -1 if no sample is closer than maxTimeDifference
+ */
+template<typename Time_>
+inline long associate(const std::vector<Time_>& timestamps, Time_ time, Time_ maxTimeDifference) {
+  using std::abs;
+  const typename std::vector<Time_>::const_iterator upper = std::lower_bound(timestamps.begin(), timestamps.end(), time);
+  long index = -1;
+  Time_ difference = maxTimeDifference;
+  if (upper != timestamps.end() && abs(*upper - time) <= difference) {
+    index = static_cast<long>(upper - timestamps.begin());
+    difference = abs(*upper - time);
+  }
+  if (upper != timestamps.begin() && abs(*(upper - 1) - time) <= difference) {
+    index = static_cast<long>(upper - timestamps.begin()) - 1;
+  }
+  return index;
+}
+
+
+/*! \class AbsoluteTrajectoryError
+ *  \brief Streaming absolute trajectory error (ATE) of estimated poses with respect to ground truth poses.
+ *
+ *  The estimated poses are mapped by the alignment transformation into the frame of the ground truth before
+ *  the translation error |p_gt - p_est| and the rotation error (disparity angle) are computed.
+ *  The alignment can be estimated in a first pass with an AlignmentAccumulator of the positions, see
+ *  evaluateAbsoluteTrajectoryError().
+ *  \tparam PrimType_ the primitive type of the data (double or float)
+ */
+template<typename PrimType_>
+class AbsoluteTrajectoryError {
+ public:
+  typedef PrimType_ Scalar;
+  typedef HomTransformQuat<PrimType_> Pose;
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  AbsoluteTrajectoryError() {
+    alignment_.setIdentity();
+  }
+
+  explicit AbsoluteTrajectoryError(const Pose& alignment)
+    : alignment_(alignment) {
+  }
+
+  inline const Pose& getAlignment() const {
+    return alignment_;
+  }
+
+  inline void setAlignment(const Pose& alignment) {
+    alignment_ = alignment;
+  }
+
+  /*! \brief Adds an associated pair of an estimated and a ground truth pose.
+   *  \returns reference
+   */
+  template<typename Estimate_, typename GroundTruth_>
+  AbsoluteTrajectoryError& add(const PoseBase<Estimate_>& estimate, const PoseBase<GroundTruth_>& groundTruth) {
+    const Estimate_& est = estimate.derived();
+    const GroundTruth_& gt = groundTruth.derived();
+    const Position<Scalar, 3> position = alignment_.transform(Position<Scalar, 3>(est.getPosition()));
+    translationError_.add((Position<Scalar, 3>(gt.getPosition()) - position).norm());
+    rotationError_.add(RotationQuaternion<Scalar>(gt.getRotation()).getDisparityAngle(alignment_.getRotation()*RotationQuaternion<Scalar>(est.getRotation())));
+    return *this;
+  }
+
+  /*! \brief Merges the errors of another evaluation with the same alignment.
+   *  \returns reference
+   */
+  AbsoluteTrajectoryError& merge(const AbsoluteTrajectoryError& other) {
+    translationError_.merge(other.translationError_);
+    rotationError_.merge(other.rotationError_);
+    return *this;
+  }
+
+  //! \returns the statistics of the translation errors
+  inline const ErrorStatistics<Scalar>& getTranslationError() const {
+    return translationError_;
+  }
+
+  //! \returns the statistics of the rotation errors in radians
+  inline const ErrorStatistics<Scalar>& getRotationError() const {
+    return rotationError_;
+  }
+
+ private:
+  Pose alignment_;
+  ErrorStatistics<Scalar> translationError_;
+  ErrorStatistics<Scalar> rotationError_;
+};
+
+
+/*! \class RelativePoseError
+ *  \brief Streaming relative pose error (RPE) over segments of a fixed number of poses.
+ *
+ *  For each segment (i, i+delta) the error E = (T_gt,i^-1*T_gt,i+delta)^-1*(T_est,i^-1*T_est,i+delta) is computed,
+ *  whose translation norm and rotation angle are accumulated. Only the last delta pairs are kept in memory.
+ *  When chunks of a trajectory are evaluated in parallel and merged, the chunks have to overlap by delta poses.
+ *  \tparam PrimType_ the primitive type of the data (double or float)
+ */
+template<typename PrimType_>
+class RelativePoseError {
+ public:
+  typedef PrimType_ Scalar;
+  typedef HomTransformQuat<PrimType_> Pose;
+
+  /*! \param delta   number of poses of a segment
+   */
+  explicit RelativePoseError(std::size_t delta = 1)
+    : delta_(delta) {
+    KINDR_ASSERT_TRUE(std::runtime_error, delta > 0, "The segment length has to be positive!");
+  }
+
+  inline std::size_t getDelta() const {
+    return delta_;
+  }
+
+  /*! \brief Adds the next associated pair of an estimated and a ground truth pose.
+   *  \returns reference
+   */
+  template<typename Estimate_, typename GroundTruth_>
+  RelativePoseError& add(const PoseBase<Estimate_>& estimate, const PoseBase<GroundTruth_>& groundTruth) {
+    const Estimate_& est = estimate.derived();
+    const GroundTruth_& gt = groundTruth.derived();
+    const Pose estimatePose(Position<Scalar, 3>(est.getPosition()), RotationQuaternion<Scalar>(est.getRotation()));
+    const Pose groundTruthPose(Position<Scalar, 3>(gt.getPosition()), RotationQuaternion<Scalar>(gt.getRotation()));
+    if (window_.size() == delta_) {
+      const Pose estimateMotion = window_.front().first.inverted()*estimatePose;
+      const Pose groundTruthMotion = window_.front().second.inverted()*groundTruthPose;
+      const Pose error = groundTruthMotion.inverted()*estimateMotion;
+      translationError_.add(error.getPosition().norm());
+      rotationError_.add(estimateMotion.getRotation().getDisparityAngle(groundTruthMotion.getRotation()));
+      window_.pop_front();
+    }
+    window_.push_back(std::make_pair(estimatePose, groundTruthPose));
+    return *this;
+  }
+
+  /*! \brief Starts a new trajectory, i.e. no segment spans the poses added before and after.
+   *  The statistics are kept.
+   */
+  inline void resetWindow() {
+    window_.clear();
+  }
+
+  /*! \brief Merges the errors of another evaluation.
+   *  \returns reference
+   */
+  RelativePoseError& merge(const RelativePoseError& other) {
+    translationError_.merge(other.translationError_);
+    rotationError_.merge(other.rotationError_);
+    return *this;
+  }
+
+  //! \returns the statistics of the translation errors of the segments
+  inline const ErrorStatistics<Scalar>& getTranslationError() const {
+    return translationError_;
+  }
+
+  //! \returns the statistics of the rotation errors of the segments in radians
+  inline const ErrorStatistics<Scalar>& getRotationError() const {
+    return rotationError_;
+  }
+
+ private:
+  std::size_t delta_;
+  std::deque<std::pair<Pose, Pose>, Eigen::aligned_allocator<std::pair<Pose, Pose>>> window_;
+  ErrorStatistics<Scalar> translationError_;
+  ErrorStatistics<Scalar> rotationError_;
+};
+
+
+/*! \brief Evaluates the absolute trajectory error of timestamped trajectories.
+ *  Each estimated pose is associated with the ground truth pose of the closest timestamp.
+ *  If alignment is enabled, the rigid transformation which best aligns the associated estimated positions with the
+ *  ground truth positions is estimated in a first pass.
+ *  \param estimateTimestamps      timestamps of the estimated poses sorted in increasing order
+ *  \param estimates               estimated poses
+ *  \param groundTruthTimestamps   timestamps of the ground truth poses sorted in increasing order
+ *  \param groundTruths            ground truth poses
+ *  \param maxTimeDifference       maximal time difference of associated poses
+ *  \param align                   true if the estimated trajectory is aligned with the ground truth
+ *  \returns the evaluation
+ */
+template<typename PrimType_, typename Time_, typename Estimate_, typename GroundTruth_>
+AbsoluteTrajectoryError<PrimType_> evaluateAbsoluteTrajectoryError(const std::vector<Time_>& estimateTimestamps, const std::vector<Estimate_>& estimates,
+                                                                   const std::vector<Time_>& groundTruthTimestamps, const std::vector<GroundTruth_>& groundTruths,
+                                                                   Time_ maxTimeDifference, bool align = true) {
+  KINDR_ASSERT_TRUE(std::runtime_error, estimateTimestamps.size() == estimates.size(), "The number of timestamps and estimates differs!");
+  KINDR_ASSERT_TRUE(std::runtime_error, groundTruthTimestamps.size() == groundTruths.size(), "The number of timestamps and ground truth poses differs!");
+  AbsoluteTrajectoryError<PrimType_> evaluation;
+  if (align) {
+    AlignmentAccumulator<PrimType_> accumulator;
+    for (std::size_t i = 0; i < estimates.size(); ++i) {
+      const long j = associate(groundTruthTimestamps, estimateTimestamps[i], maxTimeDifference);
+      if (j >= 0) {
+        accumulator.add(Position<PrimType_, 3>(estimates[i].getPosition()).toImplementation(),
+                        Position<PrimType_, 3>(groundTruths[j].getPosition()).toImplementation());
+      }
+    }
+    evaluation.setAlignment(accumulator.getTransformation());
+  }
+  for (std::size_t i = 0; i < estimates.size(); ++i) {
+    const long j = associate(groundTruthTimestamps, estimateTimestamps[i], maxTimeDifference);
+    if (j >= 0) {
+      evaluation.add(estimates[i], groundTruths[j]);
+    }
+  }
+  return evaluation;
+}
+
+/*! \brief Evaluates the relative pose error of timestamped trajectories over segments of delta associated poses.
+ *  \param estimateTimestamps      timestamps of the estimated poses sorted in increasing order
+ *  \param estimates               estimated poses
+ *  \param groundTruthTimestamps   timestamps of the ground truth poses sorted in increasing order
+ *  \param groundTruths            ground truth poses
+ *  \param maxTimeDifference       maximal time difference of associated poses
+ *  \param delta                   number of associated poses of a segment
+ *  \returns the evaluation
+ */
+template<typename PrimType_, typename Time_, typename Estimate_, typename GroundTruth_>
+RelativePoseError<PrimType_> evaluateRelativePoseError(const std::vector<Time_>& estimateTimestamps, const std::vector<Estimate_>& estimates,
+                                                       const std::vector<Time_>& groundTruthTimestamps, const std::vector<GroundTruth_>& groundTruths,
+                                                       Time_ maxTimeDifference, std::size_t delta = 1) {
+  KINDR_ASSERT_TRUE(std::runtime_error, estimateTimestamps.size() == estimates.size(), "The number of timestamps and estimates differs!");
+  KINDR_ASSERT_TRUE(std::runtime_error, groundTruthTimestamps.size() == groundTruths.size(), "The number of timestamps and ground truth poses differs!");
+  RelativePoseError<PrimType_> evaluation(delta);
+  for (std::size_t i = 0; i < estimates.size(); ++i) {
+    const long j = associate(groundTruthTimestamps, estimateTimestamps[i], maxTimeDifference);
+    if (j >= 0) {
+      evaluation.add(estimates[i], groundTruths[j]);
+    }
+  }
+  return evaluation;
+}
+
+} // namespace eval
+} // namespace kindr
@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include <Eigen/Core>
+#include <Eigen/StdVector>
+
+#include "kindr/common/common.hpp"
+#include "kindr/common/assert_macros.hpp"
+#include "kindr/math/LinearAlgebra.hpp"
+#include "kindr/rotations/Rotation.hpp"
+#include "kindr/poses/HomogeneousTransformation.hpp"
+#include "kindr/kinematics/KinematicChain.hpp"
+
+namespace kindr {
+
+/*! \class DampedLeastSquaresInverseKinematics
+ *  \brief Inverse kinematics of a serial chain for pose targets with damped least squares.
+ *
+ *  Every iteration updates the forward kinematics, computes the pose error [p_target - p_tool; R_target boxMinus R_tool]
+ *  in the base frame, which matches the geometric Jacobian of the chain, and applies the step
+ *  J^T*(J*J^T + lambda^2*I)^-1*error, limited to a maximum norm. Like in the Levenberg-Marquardt method, the damping
+ *  lambda = damping*min(1, |error|) decreases with the error, such that the iterations converge quickly close to the
+ *  solution (also close to singularities) and the steps stay bounded far from it. The joint positions passed to solve() are the
+ *  initial guess (warm start) and are overwritten by the solution.
+ *
+ *  The solver owns a copy of the chain and a pseudo-inverse workspace, such that the iterations do not allocate.
+ *  It is therefore not thread-safe; the batch solve() copies the solver for each thread and runs in parallel
+ *  with OpenMP if it is enabled.
+ *  \code{.cpp}
+ *  DampedLeastSquaresInverseKinematicsD solver(chain);
+ *  Eigen::VectorXd jointPositions = currentJointPositions;
+ *  if (solver.solve(target, jointPositions)) { ... }
+ *  \endcode
+ *
+ *  \tparam PrimType_ the primitive type of the data (double or float)
+ *  \ingroup kinematics
+ */
+template<typename PrimType_>
+class DampedLeastSquaresInverseKinematics {
+ public:
+  typedef PrimType_ Scalar;
+  typedef KinematicChain<PrimType_> Chain;
+  typedef HomTransformQuat<PrimType_> Target;
+  typedef std::vector<Target, Eigen::aligned_allocator<Target> > Targets;
+  typedef typename Chain::JointVector JointVector;
+  typedef Eigen::Matrix<PrimType_, Eigen::Dynamic, Eigen::Dynamic> JointMatrix;
+  typedef Eigen::Array<bool, Eigen::Dynamic, 1> Flags;
+  typedef Eigen::Matrix<PrimType_, 6, 1> Vector6;
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  /*! \brief Constructor allocating the workspace for the chain.
+   *  \param chain  kinematic chain, which is copied
+   */
+  explicit DampedLeastSquaresInverseKinematics(const Chain& chain)
+    : chain_(chain),
+      workspace_(6, chain.getNumberOfJoints()),
+      jacobianInverse_(chain.getNumberOfJoints(), 6),
+      step_(chain.getNumberOfJoints()),
+      error_(Vector6::Zero()),
+      damping_(Scalar(1.0e-2)),
+      maximumStepNorm_(Scalar(0.5)),
+      positionTolerance_(Scalar(1.0e-4)),
+      rotationTolerance_(Scalar(1.0e-4)),
+      maximumNumberOfIterations_(100),
+      numberOfIterations_(0) {
+  }
+
+  //! Sets the damping factor, which limits the steps close to singularities and is scaled by the error norm if smaller than one
+  inline void setDamping(Scalar damping) {
+    damping_ = damping;
+  }
+
+  //! Sets the maximum norm of a step of the joint positions
+  inline void setMaximumStepNorm(Scalar maximumStepNorm) {
+    maximumStepNorm_ = maximumStepNorm;
+  }
+
+  //! Sets the tolerances of the norms of the position and rotation errors
+  inline void setTolerances(Scalar positionTolerance, Scalar rotationTolerance) {
+    positionTolerance_ = positionTolerance;
+    rotationTolerance_ = rotationTolerance;
+  }
+
+  inline void setMaximumNumberOfIterations(int maximumNumberOfIterations) {
+    maximumNumberOfIterations_ = maximumNumberOfIterations;
+  }
+
+  inline const Chain& getChain() const {
+    return chain_;
+  }
+
+  //! Gets the number of iterations of the last solve
+  inline int getNumberOfIterations() const {
+    return numberOfIterations_;
+  }
+
+  //! Gets the pose error [position; rotation] of the last solve
+  inline const Vector6& getError() const {
+    return error_;
+  }
+
+  /*! \brief Solves for the joint positions reaching a target pose.
+   *  \param target          target pose of the tool in the base frame
+   *  \param jointPositions  initial guess, overwritten by the solution
+   *  \returns true if the tolerances were reached
+   */
+  bool solve(const Target& target, JointVector& jointPositions) {
+    using std::sqrt;
+    KINDR_ASSERT_TRUE(std::runtime_error, jointPositions.size() == chain_.getNumberOfJoints(), "The number of joint positions does not match the chain!");
+    const Scalar maximumStepSquaredNorm = maximumStepNorm_*maximumStepNorm_;
+    for (numberOfIterations_ = 0; numberOfIterations_ < maximumNumberOfIterations_; ++numberOfIterations_) {
+      if (updateError(target, jointPositions)) {
+        return true;
+      }
+      const Scalar damping = damping_*std::min(Scalar(1), error_.norm());
+      if (!workspace_.dampedPseudoInverse(chain_.getJacobian(), jacobianInverse_, damping)) {
+        return false;
+      }
+      step_.noalias() = jacobianInverse_*error_;
+      const Scalar stepSquaredNorm = step_.squaredNorm();
+      if (stepSquaredNorm > maximumStepSquaredNorm) {
+        step_ *= maximumStepNorm_/sqrt(stepSquaredNorm);
+      }
+      jointPositions += step_;
+    }
+    return updateError(target, jointPositions);
+  }
+
+  /*! \brief Solves many independent targets.
+   *  \param targets         target poses of the tool in the base frame
+   *  \param jointPositions  initial guesses as columns, overwritten by the solutions
+   *  \param converged       flags of the targets which reached the tolerances
+   *  \returns the number of targets which reached the tolerances
+   */
+  Eigen::DenseIndex solve(const Targets& targets, JointMatrix& jointPositions, Flags& converged) const {
+    const long numberOfTargets = static_cast<long>(targets.size());
+    KINDR_ASSERT_TRUE(std::runtime_error, jointPositions.rows() == chain_.getNumberOfJoints() && jointPositions.cols() == numberOfTargets,
+                      "The initial guesses must be a column for each target!");
+    converged.resize(numberOfTargets);
+#ifdef _OPENMP
+    #pragma omp parallel
+#endif
+    {
+      DampedLeastSquaresInverseKinematics solver(*this);
+      JointVector solution(jointPositions.rows());
+#ifdef _OPENMP
+      #pragma omp for schedule(dynamic, 16)
+#endif
+      for (long i = 0; i < numberOfTargets; ++i) {
+        solution = jointPositions.col(i);
+        converged(i) = solver.solve(targets[i], solution);
+        jointPositions.col(i) = solution;
+      }
+    }
+    return converged.count();
+  }
+
+ private:
+  //! Updates the chain and the error and returns true if the tolerances are reached
+  bool updateError(const Target& target, const JointVector& jointPositions) {
+    chain_.update(jointPositions);
+    const typename Chain::Pose& toolPose = chain_.getToolPose();
+    error_.template head<3>() = target.getPosition().toImplementation() - toolPose.getPosition().toImplementation();
+    error_.template tail<3>() = target.getRotation().boxMinus(RotationQuaternion<Scalar>(toolPose.getRotation()));
+    return error_.template head<3>().norm() <= positionTolerance_ && error_.template tail<3>().norm() <= rotationTolerance_;
+  }
+
+  Chain chain_;
+  PseudoInverseWorkspace<PrimType_, 6, Eigen::Dynamic> workspace_;
+  Eigen::Matrix<PrimType_, Eigen::Dynamic, 6> jacobianInverse_;
+  JointVector step_;
+  Vector6 error_;
+  Scalar damping_;
+  Scalar maximumStepNorm_;
+  Scalar positionTolerance_;
+  Scalar rotationTolerance_;
+  int maximumNumberOfIterations_;
+  int numberOfIterations_;
+};
+
+typedef DampedLeastSquaresInverseKinematics<double> DampedLeastSquaresInverseKinematicsD;
+typedef DampedLeastSquaresInverseKinematics<float> DampedLeastSquaresInverseKinematicsF;
+
+} // namespace kindr
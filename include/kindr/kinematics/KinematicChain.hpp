@@ -0,0 +1,349 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <vector>
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+#include <Eigen/StdVector>
+
+#include "kindr/common/common.hpp"
+#include "kindr/common/assert_macros.hpp"
+#include "kindr/math/LinearAlgebra.hpp"
+#include "kindr/rotations/Rotation.hpp"
+#include "kindr/poses/HomogeneousTransformation.hpp"
+#include "kindr/poses/Twist.hpp"
+
+namespace kindr {
+
+//! Type of a joint of a kinematic chain
+enum class JointType {
+  Revolute,   //!< rotation about the joint axis
+  Prismatic   //!< translation along the joint axis
+};
+
+namespace internal {
+
+/*! \brief Recursion step and Jacobian columns of a joint.
+ *  All quantities are expressed in the base frame, the Jacobian is ordered as [linear; angular] and
+ *  the linear part refers to the tool point.
+ *  (only for advanced users)
+ */
+template<JointType Type_>
+class JointTraits;
+
+template<>
+class JointTraits<JointType::Revolute> {
+ public:
+  /*! \brief Moves the link frame from the joint frame.
+   *  \param jointRotation             rotation of the joint frame, overwritten by the rotation of the link
+   *  \param linkPosition              position of the link origin, equal to the joint origin
+   *  \param linkVelocity              velocity of the link origin, equal to the one of the joint origin
+   *  \param angularVelocity           angular velocity of the parent link, overwritten by the one of the link
+   */
+  template<typename PrimType_>
+  inline static void moveLink(const Eigen::Matrix<PrimType_, 3, 1>& localAxis, const Eigen::Matrix<PrimType_, 3, 1>& axis,
+                              PrimType_ jointPosition, PrimType_ jointVelocity,
+                              Eigen::Matrix<PrimType_, 3, 3>& jointRotation, Eigen::Matrix<PrimType_, 3, 1>& /*linkPosition*/,
+                              Eigen::Matrix<PrimType_, 3, 1>& /*linkVelocity*/, Eigen::Matrix<PrimType_, 3, 1>& angularVelocity) {
+    jointRotation = jointRotation*Eigen::AngleAxis<PrimType_>(jointPosition, localAxis).toRotationMatrix();
+    angularVelocity += jointVelocity*axis;
+  }
+
+  template<typename PrimType_, typename Column_>
+  inline static void setJacobianColumn(const Eigen::Matrix<PrimType_, 3, 1>& axis, const Eigen::Matrix<PrimType_, 3, 1>& jointToTool,
+                                       Column_ column) {
+    column.template head<3>() = axis.cross(jointToTool);
+    column.template tail<3>() = axis;
+  }
+
+  /*! \brief Sets d/dt [z x (p_e - p_i); z] with dz/dt = w_parent x z.
+   */
+  template<typename PrimType_, typename Column_>
+  inline static void setJacobianTimeDerivativeColumn(const Eigen::Matrix<PrimType_, 3, 1>& axis, const Eigen::Matrix<PrimType_, 3, 1>& jointToTool,
+                                                     const Eigen::Matrix<PrimType_, 3, 1>& parentAngularVelocity,
+                                                     const Eigen::Matrix<PrimType_, 3, 1>& jointToToolVelocity, Column_ column) {
+    const Eigen::Matrix<PrimType_, 3, 1> axisDerivative = parentAngularVelocity.cross(axis);
+    column.template head<3>() = axisDerivative.cross(jointToTool) + axis.cross(jointToToolVelocity);
+    column.template tail<3>() = axisDerivative;
+  }
+};
+
+template<>
+class JointTraits<JointType::Prismatic> {
+ public:
+  template<typename PrimType_>
+  inline static void moveLink(const Eigen::Matrix<PrimType_, 3, 1>& /*localAxis*/, const Eigen::Matrix<PrimType_, 3, 1>& axis,
+                              PrimType_ jointPosition, PrimType_ jointVelocity,
+                              Eigen::Matrix<PrimType_, 3, 3>& /*jointRotation*/, Eigen::Matrix<PrimType_, 3, 1>& linkPosition,
+                              Eigen::Matrix<PrimType_, 3, 1>& linkVelocity, Eigen::Matrix<PrimType_, 3, 1>& angularVelocity) {
+    const Eigen::Matrix<PrimType_, 3, 1> displacement = jointPosition*axis;
+    linkPosition += displacement;
+    linkVelocity += angularVelocity.cross(displacement) + jointVelocity*axis;
+  }
+
+  template<typename PrimType_, typename Column_>
+  inline static void setJacobianColumn(const Eigen::Matrix<PrimType_, 3, 1>& axis, const Eigen::Matrix<PrimType_, 3, 1>& /*jointToTool*/,
+                                       Column_ column) {
+    column.template head<3>() = axis;
+    column.template tail<3>().setZero();
+  }
+
+  template<typename PrimType_, typename Column_>
+  inline static void setJacobianTimeDerivativeColumn(const Eigen::Matrix<PrimType_, 3, 1>& axis, const Eigen::Matrix<PrimType_, 3, 1>& /*jointToTool*/,
+                                                     const Eigen::Matrix<PrimType_, 3, 1>& parentAngularVelocity,
+                                                     const Eigen::Matrix<PrimType_, 3, 1>& /*jointToToolVelocity*/, Column_ column) {
+    column.template head<3>() = parentAngularVelocity.cross(axis);
+    column.template tail<3>().setZero();
+  }
+};
+
+} // namespace internal
+
+
+/*! \class KinematicChain
+ *  \brief Forward kinematics of a serial chain of revolute and prismatic joints.
+ *
+ *  The chain is described by the fixed transformation from the parent link (or the base) to each joint frame
+ *  and by the joint axis expressed in the joint frame. The link frame i is the joint frame i moved by the joint
+ *  position, and the tool frame is fixed in the last link.
+ *
+ *  A single recursion from the base to the tool computes the poses of all links, the twist of the tool, the
+ *  6xN geometric Jacobian of the tool and its time derivative. All quantities are expressed in the base frame and
+ *  the Jacobians are ordered as [linear; angular] like the twists, where the linear part is the velocity of the
+ *  tool point. The results are stored contiguously in the chain and do not allocate after the chain was built.
+ *
+ *  \tparam PrimType_ the primitive type of the data (double or float)
+ *  \ingroup kinematics
+ */
+template<typename PrimType_>
+class KinematicChain {
+ public:
+  typedef PrimType_ Scalar;
+  typedef HomTransformMatrix<PrimType_> Pose;
+  typedef std::vector<Pose, Eigen::aligned_allocator<Pose> > Poses;
+  typedef Eigen::Matrix<PrimType_, Eigen::Dynamic, 1> JointVector;
+  typedef Eigen::Matrix<PrimType_, 6, Eigen::Dynamic> Jacobian;
+  typedef TwistLinearVelocityGlobalAngularVelocity<PrimType_> Twist;
+  typedef Eigen::Matrix<PrimType_, 3, 1> Vector3;
+  typedef Eigen::Matrix<PrimType_, 3, 3> Matrix3;
+  typedef Eigen::Matrix<PrimType_, 3, Eigen::Dynamic> Matrix3X;
+
+  KinematicChain() {
+    toolPose_.setIdentity();
+    linkToTool_.setIdentity();
+    toolTwist_.setZero();
+  }
+
+  /*! \brief Appends a joint to the chain.
+   *  \param type           revolute or prismatic
+   *  \param parentToJoint  transformation from the previous link (or the base) to the joint frame
+   *  \param axis           joint axis expressed in the joint frame, normalized internally
+   *  \returns reference
+   */
+  KinematicChain& addJoint(JointType type, const Pose& parentToJoint, const Vector3& axis) {
+    KINDR_ASSERT_TRUE(std::runtime_error, axis.norm() > Scalar(0), "The joint axis must not be zero!");
+    const Eigen::DenseIndex numberOfJoints = getNumberOfJoints() + 1;
+    jointTypes_.push_back(type);
+    parentToJoints_.push_back(parentToJoint);
+    localAxes_.conservativeResize(Eigen::NoChange, numberOfJoints);
+    localAxes_.col(numberOfJoints - 1) = axis.normalized();
+    linkPoses_.resize(numberOfJoints);
+    axes_.setZero(3, numberOfJoints);
+    jointOrigins_.setZero(3, numberOfJoints);
+    jointOriginVelocities_.setZero(3, numberOfJoints);
+    parentAngularVelocities_.setZero(3, numberOfJoints);
+    jacobian_.setZero(6, numberOfJoints);
+    jacobianTimeDerivative_.setZero(6, numberOfJoints);
+    return *this;
+  }
+
+  /*! \brief Sets the transformation from the last link to the tool frame.
+   *  \returns reference
+   */
+  KinematicChain& setTool(const Pose& linkToTool) {
+    linkToTool_ = linkToTool;
+    return *this;
+  }
+
+  inline Eigen::DenseIndex getNumberOfJoints() const {
+    return static_cast<Eigen::DenseIndex>(jointTypes_.size());
+  }
+
+  inline JointType getJointType(Eigen::DenseIndex joint) const {
+    return jointTypes_[joint];
+  }
+
+  /*! \brief Computes the link poses, the tool pose and the Jacobian.
+   *  \param jointPositions  positions of the joints
+   */
+  void update(const JointVector& jointPositions) {
+    updateImpl<false>(jointPositions, jointPositions);
+  }
+
+  /*! \brief Computes the link poses, the tool pose and twist, the Jacobian and its time derivative.
+   *  \param jointPositions   positions of the joints
+   *  \param jointVelocities  velocities of the joints
+   */
+  void update(const JointVector& jointPositions, const JointVector& jointVelocities) {
+    KINDR_ASSERT_TRUE(std::runtime_error, jointVelocities.size() == getNumberOfJoints(), "The number of joint velocities does not match the chain!");
+    updateImpl<true>(jointPositions, jointVelocities);
+  }
+
+  //! Gets the pose of the link frame i in the base frame
+  inline const Pose& getLinkPose(Eigen::DenseIndex link) const {
+    return linkPoses_[link];
+  }
+
+  //! Gets the poses of all links in the base frame
+  inline const Poses& getLinkPoses() const {
+    return linkPoses_;
+  }
+
+  //! Gets the pose of the tool frame in the base frame
+  inline const Pose& getToolPose() const {
+    return toolPose_;
+  }
+
+  //! Gets the twist of the tool in the base frame (only computed with the joint velocities)
+  inline const Twist& getToolTwist() const {
+    return toolTwist_;
+  }
+
+  //! Gets the geometric 6xN Jacobian of the tool in the base frame
+  inline const Jacobian& getJacobian() const {
+    return jacobian_;
+  }
+
+  //! Gets the time derivative of the Jacobian (only computed with the joint velocities)
+  inline const Jacobian& getJacobianTimeDerivative() const {
+    return jacobianTimeDerivative_;
+  }
+
+  //! Gets the joint axes in the base frame as a 3xN matrix
+  inline const Matrix3X& getJointAxes() const {
+    return axes_;
+  }
+
+  //! Gets the origins of the joint frames in the base frame as a 3xN matrix
+  inline const Matrix3X& getJointOrigins() const {
+    return jointOrigins_;
+  }
+
+ private:
+  template<bool ComputeDerivative_>
+  void updateImpl(const JointVector& jointPositions, const JointVector& jointVelocities) {
+    KINDR_ASSERT_TRUE(std::runtime_error, jointPositions.size() == getNumberOfJoints(), "The number of joint positions does not match the chain!");
+    const Eigen::DenseIndex numberOfJoints = getNumberOfJoints();
+
+    // state of the current link: pose, velocity of its origin and angular velocity
+    Matrix3 rotation = Matrix3::Identity();
+    Vector3 position = Vector3::Zero();
+    Vector3 velocity = Vector3::Zero();
+    Vector3 angularVelocity = Vector3::Zero();
+
+    for (Eigen::DenseIndex i = 0; i < numberOfJoints; ++i) {
+      // joint frame from the previous link
+      const Pose& parentToJoint = parentToJoints_[i];
+      const Vector3 offset = rotation*parentToJoint.getPosition().toImplementation();
+      position += offset;
+      rotation = rotation*parentToJoint.getRotation().toImplementation();
+      if (ComputeDerivative_) {
+        velocity += angularVelocity.cross(offset);
+        parentAngularVelocities_.col(i) = angularVelocity;
+        jointOriginVelocities_.col(i) = velocity;
+      }
+      const Vector3 axis = rotation*localAxes_.col(i);
+      axes_.col(i) = axis;
+      jointOrigins_.col(i) = position;
+
+      // link frame moved by the joint
+      const Scalar jointVelocity = ComputeDerivative_ ? jointVelocities(i) : Scalar(0);
+      if (jointTypes_[i] == JointType::Revolute) {
+        internal::JointTraits<JointType::Revolute>::moveLink<Scalar>(localAxes_.col(i), axis, jointPositions(i), jointVelocity, rotation, position, velocity, angularVelocity);
+      } else {
+        internal::JointTraits<JointType::Prismatic>::moveLink<Scalar>(localAxes_.col(i), axis, jointPositions(i), jointVelocity, rotation, position, velocity, angularVelocity);
+      }
+      linkPoses_[i].getRotation().toImplementation() = rotation;
+      linkPoses_[i].getPosition().toImplementation() = position;
+    }
+
+    // tool frame
+    const Vector3 toolOffset = rotation*linkToTool_.getPosition().toImplementation();
+    const Vector3 toolPosition = position + toolOffset;
+    toolPose_.getRotation().toImplementation() = rotation*linkToTool_.getRotation().toImplementation();
+    toolPose_.getPosition().toImplementation() = toolPosition;
+    Vector3 toolVelocity = Vector3::Zero();
+    if (ComputeDerivative_) {
+      toolVelocity = velocity + angularVelocity.cross(toolOffset);
+      toolTwist_.getTranslationalVelocity().toImplementation() = toolVelocity;
+      toolTwist_.getRotationalVelocity().toImplementation() = angularVelocity;
+    }
+
+    // Jacobian columns reuse the composed poses and velocities
+    for (Eigen::DenseIndex i = 0; i < numberOfJoints; ++i) {
+      const Vector3 axis = axes_.col(i);
+      const Vector3 jointToTool = toolPosition - jointOrigins_.col(i);
+      if (jointTypes_[i] == JointType::Revolute) {
+        internal::JointTraits<JointType::Revolute>::setJacobianColumn<Scalar>(axis, jointToTool, jacobian_.col(i));
+        if (ComputeDerivative_) {
+          internal::JointTraits<JointType::Revolute>::setJacobianTimeDerivativeColumn<Scalar>(axis, jointToTool, parentAngularVelocities_.col(i),
+              toolVelocity - jointOriginVelocities_.col(i), jacobianTimeDerivative_.col(i));
+        }
+      } else {
+        internal::JointTraits<JointType::Prismatic>::setJacobianColumn<Scalar>(axis, jointToTool, jacobian_.col(i));
+        if (ComputeDerivative_) {
+          internal::JointTraits<JointType::Prismatic>::setJacobianTimeDerivativeColumn<Scalar>(axis, jointToTool, parentAngularVelocities_.col(i),
+              toolVelocity - jointOriginVelocities_.col(i), jacobianTimeDerivative_.col(i));
+        }
+      }
+    }
+  }
+
+  std::vector<JointType> jointTypes_;
+  Poses parentToJoints_;
+  Matrix3X localAxes_;
+  Pose linkToTool_;
+
+  Poses linkPoses_;
+  Pose toolPose_;
+  Twist toolTwist_;
+  Matrix3X axes_;
+  Matrix3X jointOrigins_;
+  Matrix3X jointOriginVelocities_;
+  Matrix3X parentAngularVelocities_;
+  Jacobian jacobian_;
+  Jacobian jacobianTimeDerivative_;
+};
+
+typedef KinematicChain<double> KinematicChainD;
+typedef KinematicChain<float> KinematicChainF;
+
+} // namespace kindr
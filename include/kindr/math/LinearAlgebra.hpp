@@ -27,7 +27,15 @@
 */
 #pragma once
 
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+
 #include <Eigen/SVD>
+#include <Eigen/Cholesky>
+#include <Eigen/Eigenvalues>
+
+#include "kindr/common/assert_macros.hpp"
 
 namespace kindr {
 
@@ -54,26 +62,454 @@ inline static Eigen::Matrix<PrimType_, 3, 1> getVectorFromSkewMatrix(const Eigen
   return Eigen::Matrix<PrimType_, 3, 1> (matrix(2,1), matrix(0,2), matrix(1,0));
 }
 
+/*!
+ * \brief Multiplies the skew-symmetric matrix of a vector from the left without forming it, i.e. [a]x*B = a x B column-wise.
+ *  The cross products are evaluated column by column, i.e. on contiguous memory of the column-major matrix.
+ * \param   a 3x1-matrix (column vector)
+ * \param   b 3xN-matrix
+ * \return  3xN-matrix
+ */
+template<typename Derived_>
+inline static Eigen::Matrix<typename Derived_::Scalar, 3, Derived_::ColsAtCompileTime> skewTimes(const Eigen::Matrix<typename Derived_::Scalar, 3, 1>& a, const Eigen::MatrixBase<Derived_>& b) {
+  static_assert(Derived_::RowsAtCompileTime == 3 || Derived_::RowsAtCompileTime == Eigen::Dynamic, "The matrix must have 3 rows.");
+  KINDR_ASSERT_TRUE_DBG(std::runtime_error, b.rows() == 3, "The matrix must have 3 rows.");
+  Eigen::Matrix<typename Derived_::Scalar, 3, Derived_::ColsAtCompileTime> result(3, b.cols());
+  for (Eigen::DenseIndex j = 0; j < b.cols(); ++j) {
+    result(0,j) = a(1)*b(2,j) - a(2)*b(1,j);
+    result(1,j) = a(2)*b(0,j) - a(0)*b(2,j);
+    result(2,j) = a(0)*b(1,j) - a(1)*b(0,j);
+  }
+  return result;
+}
+
+/*!
+ * \brief Multiplies the skew-symmetric matrix of a vector from the right without forming it, i.e. B*[a]x.
+ * \param   b Nx3-matrix
+ * \param   a 3x1-matrix (column vector)
+ * \return  Nx3-matrix
+ */
+template<typename Derived_>
+inline static Eigen::Matrix<typename Derived_::Scalar, Derived_::RowsAtCompileTime, 3> timesSkew(const Eigen::MatrixBase<Derived_>& b, const Eigen::Matrix<typename Derived_::Scalar, 3, 1>& a) {
+  static_assert(Derived_::ColsAtCompileTime == 3 || Derived_::ColsAtCompileTime == Eigen::Dynamic, "The matrix must have 3 columns.");
+  KINDR_ASSERT_TRUE_DBG(std::runtime_error, b.cols() == 3, "The matrix must have 3 columns.");
+  Eigen::Matrix<typename Derived_::Scalar, Derived_::RowsAtCompileTime, 3> result(b.rows(), 3);
+  result.col(0) = a(2)*b.col(1) - a(1)*b.col(2);
+  result.col(1) = a(0)*b.col(2) - a(2)*b.col(0);
+  result.col(2) = a(1)*b.col(0) - a(0)*b.col(1);
+  return result;
+}
+
+/*!
+ * \brief Multiplies the squared skew-symmetric matrix of a vector without forming it, i.e. [a]x^2*B = a*(a^T*B) - |a|^2*B.
+ * \param   a 3x1-matrix (column vector)
+ * \param   b 3xN-matrix
+ * \return  3xN-matrix
+ */
+template<typename Derived_>
+inline static Eigen::Matrix<typename Derived_::Scalar, 3, Derived_::ColsAtCompileTime> skewSquaredTimes(const Eigen::Matrix<typename Derived_::Scalar, 3, 1>& a, const Eigen::MatrixBase<Derived_>& b) {
+  static_assert(Derived_::RowsAtCompileTime == 3 || Derived_::RowsAtCompileTime == Eigen::Dynamic, "The matrix must have 3 rows.");
+  KINDR_ASSERT_TRUE_DBG(std::runtime_error, b.rows() == 3, "The matrix must have 3 rows.");
+  Eigen::Matrix<typename Derived_::Scalar, 3, Derived_::ColsAtCompileTime> result(3, b.cols());
+  result.noalias() = a*(a.transpose()*b);
+  result -= a.squaredNorm()*b;
+  return result;
+}
+
+/*!
+ * \brief Computes the congruence [a]x*B*[a]x^T without forming the skew-symmetric matrix, e.g. to propagate a 3x3 covariance through a cross product.
+ * \param   a 3x1-matrix (column vector)
+ * \param   b 3x3-matrix
+ * \return  3x3-matrix
+ */
+template<typename Derived_>
+inline static Eigen::Matrix<typename Derived_::Scalar, 3, 3> skewTimesTimesSkewTranspose(const Eigen::Matrix<typename Derived_::Scalar, 3, 1>& a, const Eigen::MatrixBase<Derived_>& b) {
+  // [a]x^T = -[a]x
+  return -timesSkew(skewTimes(a, b), a);
+}
+
+
+
+namespace internal {
+
+/*! \brief Products with the Gram matrix G = A*A^T (wide A) or G = A^T*A (tall A) used by the pseudo-inverses.
+ *  (only for advanced users)
+ */
+template<bool IsWide_>
+class PseudoInverseGramProducts {
+ public:
+  //! G = A*A^T + damping^2*I
+  template<typename Derived_, typename Gram_>
+  inline static void computeGram(const Eigen::MatrixBase<Derived_>& a, bool /*isWide*/, typename Derived_::Scalar damping, Gram_& gram) {
+    gram.noalias() = a.lazyProduct(a.transpose());
+    gram.diagonal().array() += damping*damping;
+  }
+
+  //! X = A^T*G^-1
+  template<typename Derived_, typename GramInverse_, typename Result_>
+  inline static void multiplyGramInverse(const Eigen::MatrixBase<Derived_>& a, bool /*isWide*/, const GramInverse_& gramInverse, Result_& result) {
+    result.noalias() = a.transpose().lazyProduct(gramInverse);
+  }
+};
+
+template<>
+class PseudoInverseGramProducts<false> {
+ public:
+  //! G = A^T*A + damping^2*I
+  template<typename Derived_, typename Gram_>
+  inline static void computeGram(const Eigen::MatrixBase<Derived_>& a, bool /*isWide*/, typename Derived_::Scalar damping, Gram_& gram) {
+    gram.noalias() = a.transpose().lazyProduct(a);
+    gram.diagonal().array() += damping*damping;
+  }
+
+  //! X = G^-1*A^T
+  template<typename Derived_, typename GramInverse_, typename Result_>
+  inline static void multiplyGramInverse(const Eigen::MatrixBase<Derived_>& a, bool /*isWide*/, const GramInverse_& gramInverse, Result_& result) {
+    result.noalias() = gramInverse.lazyProduct(a.transpose());
+  }
+};
+
+/*! \brief Chooses the side of the Gram matrix at run time if both dimensions are dynamic.
+ *  (only for advanced users)
+ */
+class PseudoInverseGramProductsDynamic {
+ public:
+  template<typename Derived_, typename Gram_>
+  inline static void computeGram(const Eigen::MatrixBase<Derived_>& a, bool isWide, typename Derived_::Scalar damping, Gram_& gram) {
+    isWide ? PseudoInverseGramProducts<true>::computeGram(a, isWide, damping, gram) : PseudoInverseGramProducts<false>::computeGram(a, isWide, damping, gram);
+  }
+
+  template<typename Derived_, typename GramInverse_, typename Result_>
+  inline static void multiplyGramInverse(const Eigen::MatrixBase<Derived_>& a, bool isWide, const GramInverse_& gramInverse, Result_& result) {
+    isWide ? PseudoInverseGramProducts<true>::multiplyGramInverse(a, isWide, gramInverse, result) : PseudoInverseGramProducts<false>::multiplyGramInverse(a, isWide, gramInverse, result);
+  }
+};
+
+/*! \brief Properties of the Gram matrix A*A^T (wide A) or A^T*A (tall A) used by the pseudo-inverses.
+ *  If one dimension of A is fixed, the side is chosen at run time and the Gram matrix is bounded by that dimension,
+ *  e.g. at most 6x6 for a 6xN Jacobian, such that it is never allocated.
+ *  (only for advanced users)
+ */
+template<typename Scalar_, int Rows_, int Cols_>
+class PseudoInverseGram {
+ public:
+  static constexpr bool isFixedAtCompileTime = Rows_ != Eigen::Dynamic && Cols_ != Eigen::Dynamic;
+  static constexpr bool isWideAtCompileTime = isFixedAtCompileTime && Rows_ <= Cols_;
+  static constexpr bool isTallAtCompileTime = isFixedAtCompileTime && Rows_ > Cols_;
+  static constexpr int Size = isWideAtCompileTime ? Rows_ : (isTallAtCompileTime ? Cols_ : Eigen::Dynamic);
+  static constexpr int MaxSize = isFixedAtCompileTime ? Size : (Rows_ != Eigen::Dynamic ? Rows_ : Cols_);
+
+  typedef Eigen::Matrix<Scalar_, Size, Size, Eigen::ColMajor, MaxSize, MaxSize> Matrix;
+  typedef typename std::conditional<isFixedAtCompileTime,
+                                    PseudoInverseGramProducts<isWideAtCompileTime>,
+                                    PseudoInverseGramProductsDynamic>::type Products;
+
+  inline static bool isWide(Eigen::DenseIndex rows, Eigen::DenseIndex cols) {
+    return isFixedAtCompileTime ? isWideAtCompileTime : rows <= cols;
+  }
+};
+
+/*! \brief Computes the pseudo-inverse with the singular value decomposition.
+ *  (only for advanced users)
+ */
+template<typename Svd_, typename Result_>
+inline bool getPseudoInverseFromSvd(const Svd_& svd, Result_& result, typename Result_::Scalar epsilon) {
+  typedef typename Result_::Scalar Scalar;
+  const Eigen::DenseIndex size = svd.singularValues().size();
+  if (size == 0 || !svd.singularValues().allFinite()) {
+    return false;
+  }
+  const Scalar tolerance = epsilon*Scalar(std::max(svd.matrixU().rows(), svd.matrixV().rows()))*svd.singularValues().maxCoeff();
+  const typename Svd_::SingularValuesType singularValuesInverse = (svd.singularValues().array() > tolerance).select(svd.singularValues().array().inverse(), Scalar(0));
+  result.noalias() = svd.matrixV().leftCols(size)*singularValuesInverse.asDiagonal()*svd.matrixU().leftCols(size).adjoint();
+  return true;
+}
+
+/*! \brief Computes the pseudo-inverse with the eigendecomposition of the Gram matrix.
+ *  (only for advanced users)
+ */
+template<typename Gram_, typename Derived_, typename GramMatrix_, typename Result_>
+inline bool getPseudoInverseFromGram(const Eigen::MatrixBase<Derived_>& a, bool isWide, typename Derived_::Scalar epsilon,
+                                     GramMatrix_& gram, Eigen::SelfAdjointEigenSolver<GramMatrix_>& solver, GramMatrix_& gramInverse, Result_& result) {
+  typedef typename Derived_::Scalar Scalar;
+  if (a.size() == 0) {
+    return false;
+  }
+  Gram_::Products::computeGram(a, isWide, Scalar(0), gram);
+  solver.compute(gram);
+  if (solver.info() != Eigen::Success) {
+    return false;
+  }
+  // the eigenvalues are the squared singular values
+  const Scalar tolerance = epsilon*Scalar(std::max(a.rows(), a.cols()))*solver.eigenvalues().maxCoeff();
+  gramInverse.noalias() = solver.eigenvectors()*(solver.eigenvalues().array() > tolerance).select(solver.eigenvalues().array().inverse(), Scalar(0)).matrix().asDiagonal()*solver.eigenvectors().transpose();
+  Gram_::Products::multiplyGramInverse(a, isWide, gramInverse, result);
+  return true;
+}
+
+/*! \brief Computes the pseudo-inverse with the singular value decomposition, which does not allocate if both dimensions are fixed.
+ *  (only for advanced users)
+ */
+template<typename Scalar_, int Rows_, int Cols_>
+class PseudoInverseTraits {
+ public:
+  template<typename Derived_, typename Result_>
+  inline static bool compute(const Eigen::MatrixBase<Derived_>& a, Result_& result, Scalar_ epsilon) {
+    typedef Eigen::Matrix<Scalar_, Rows_, Cols_> Matrix;
+    if (a.size() == 0) {
+      return false;
+    }
+    const Eigen::JacobiSVD<Matrix> svd(a, (Cols_ == Eigen::Dynamic) ? (Eigen::ComputeThinU | Eigen::ComputeThinV) : (Eigen::ComputeFullU | Eigen::ComputeFullV));
+    return getPseudoInverseFromSvd(svd, result, epsilon);
+  }
+};
+
+/*! \brief Computes the damped least-squares inverse with the LDLT decomposition of the Gram matrix.
+ *  The inverse of the Gram matrix is formed explicitly, since it is small (e.g. 6x6 for a 6xN Jacobian),
+ *  such that no intermediate matrix with the dimensions of A is needed.
+ *  (only for advanced users)
+ */
+template<typename Gram_, typename Derived_, typename GramMatrix_, typename Result_>
+inline bool getDampedPseudoInverseFromGram(const Eigen::MatrixBase<Derived_>& a, bool isWide, typename Derived_::Scalar damping,
+                                           GramMatrix_& gram, Eigen::LDLT<GramMatrix_>& ldlt, GramMatrix_& gramInverse, Result_& result) {
+  Gram_::Products::computeGram(a, isWide, damping, gram);
+  ldlt.compute(gram);
+  if (ldlt.info() != Eigen::Success) {
+    return false;
+  }
+  gramInverse.setIdentity(gram.rows(), gram.cols());
+  ldlt.solveInPlace(gramInverse);
+  Gram_::Products::multiplyGramInverse(a, isWide, gramInverse, result);
+  return true;
+}
+
+/*! \brief Computes the pseudo-inverse of a matrix with full row or column rank with the LDLT decomposition of the Gram matrix.
+ *  (only for advanced users)
+ */
+template<typename Gram_, typename Derived_, typename GramMatrix_, typename Result_>
+inline bool getFullRankPseudoInverseFromGram(const Eigen::MatrixBase<Derived_>& a, bool isWide, typename Derived_::Scalar epsilon,
+                                             GramMatrix_& gram, Eigen::LDLT<GramMatrix_>& ldlt, GramMatrix_& gramInverse, Result_& result) {
+  typedef typename Derived_::Scalar Scalar;
+  Gram_::Products::computeGram(a, isWide, Scalar(0), gram);
+  ldlt.compute(gram);
+  if (ldlt.info() != Eigen::Success || gram.size() == 0) {
+    return false;
+  }
+  const Scalar tolerance = epsilon*Scalar(std::max(a.rows(), a.cols()))*ldlt.vectorD().cwiseAbs().maxCoeff();
+  if (!ldlt.isPositive() || !(ldlt.vectorD().minCoeff() > tolerance)) {
+    return false;
+  }
+  gramInverse.setIdentity(gram.rows(), gram.cols());
+  ldlt.solveInPlace(gramInverse);
+  Gram_::Products::multiplyGramInverse(a, isWide, gramInverse, result);
+  return true;
+}
+
+} // namespace internal
 
 
 /*!
  * \brief Computes the Moore–Penrose pseudoinverse
  * info: http://eigen.tuxfamily.org/bz/show_bug.cgi?id=257
+ *
+ * The singular value decomposition is fixed-size and does not allocate for fixed-size matrices (e.g. 3x3, 6x6),
+ * and is thin otherwise. See gramPseudoInverse() for an allocation-free alternative for 3xN and 6xN Jacobians.
+ *
  * \param a: Matrix to invert
- * \param result: Result is written here
+ * \param result: Result is written here, e.g. a matrix with the transposed size of a
  * \param epsilon: Numerical precision (for example 1e-6)
- * \return true if successful
+ * \return true if successful, false if the matrix is empty or the decomposition failed
  */
-template<typename _Matrix_Type_>
-bool static pseudoInverse(const _Matrix_Type_ &a, _Matrix_Type_ &result, double epsilon = std::numeric_limits<typename _Matrix_Type_::Scalar>::epsilon())
+template<typename _Matrix_Type_, typename _Result_Type_>
+bool static pseudoInverse(const _Matrix_Type_ &a, _Result_Type_ &result, typename _Matrix_Type_::Scalar epsilon = std::numeric_limits<typename _Matrix_Type_::Scalar>::epsilon())
 {
-  Eigen::JacobiSVD< _Matrix_Type_ > svd = a.jacobiSvd(Eigen::ComputeThinU | Eigen::ComputeThinV);
+  return internal::PseudoInverseTraits<typename _Matrix_Type_::Scalar, _Matrix_Type_::RowsAtCompileTime, _Matrix_Type_::ColsAtCompileTime>::compute(a, result, epsilon);
+}
 
-  typename _Matrix_Type_::Scalar tolerance = epsilon * std::max(a.cols(), a.rows()) * svd.singularValues().array().abs().maxCoeff();
+/*!
+ * \brief Computes the Moore–Penrose pseudoinverse with the eigendecomposition of the Gram matrix A*A^T (wide) or A^T*A (tall).
+ * Nothing is allocated apart from the result if one dimension of the matrix is fixed (e.g. 3xN, 6xN), since the
+ * Gram matrix is bounded by it. The Gram matrix squares the condition number, i.e. the result loses about twice as
+ * many digits as with pseudoInverse(), and epsilon applies to the eigenvalues, i.e. to the squared singular values.
+ * Use pseudoInverse() unless the matrix is well-conditioned and the allocation matters.
+ * \param a: Matrix to invert
+ * \param result: Result is written here
+ * \param epsilon: Numerical precision relative to the largest squared singular value
+ * \return true if successful, false if the matrix is empty or the decomposition failed
+ */
+template<typename Derived_>
+bool static gramPseudoInverse(const Eigen::MatrixBase<Derived_>& a, Eigen::Matrix<typename Derived_::Scalar, Derived_::ColsAtCompileTime, Derived_::RowsAtCompileTime>& result,
+                              typename Derived_::Scalar epsilon = std::numeric_limits<typename Derived_::Scalar>::epsilon())
+{
+  typedef internal::PseudoInverseGram<typename Derived_::Scalar, Derived_::RowsAtCompileTime, Derived_::ColsAtCompileTime> Gram;
+  typedef typename Gram::Matrix GramMatrix;
+  const bool isWide = Gram::isWide(a.rows(), a.cols());
+  const Eigen::DenseIndex size = isWide ? a.rows() : a.cols();
+  GramMatrix gram(size, size);
+  Eigen::SelfAdjointEigenSolver<GramMatrix> solver(size);
+  GramMatrix gramInverse(size, size);
+  return internal::getPseudoInverseFromGram<Gram>(a, isWide, epsilon, gram, solver, gramInverse, result);
+}
 
-  result = svd.matrixV() * _Matrix_Type_( (svd.singularValues().array().abs() > tolerance).select(svd.singularValues().array().inverse(), 0) ).asDiagonal() * svd.matrixU().adjoint();
 
-  return true;
+/*! \class PseudoInverseWorkspace
+ * \brief Reusable memory for repeated pseudo-inverses of matrices with the same dimensions.
+ *
+ * The Gram matrix, its decomposition and its inverse are allocated once in the constructor, such that repeated
+ * damped and full-rank pseudo-inverses of matrices with the same dimensions do not allocate. The Gram matrix has a
+ * fixed size if one dimension is fixed (e.g. 6x6 for a 6xN Jacobian), and then nothing is allocated at all.
+ * The singular value decomposition for pseudoInverse() is only allocated by its first call. Eigen still allocates
+ * temporaries inside the decomposition of dynamic-size matrices, i.e. only the fixed-size SVD is allocation-free.
+ * \code{.cpp}
+ * PseudoInverseWorkspace<double, 6, Eigen::Dynamic> workspace(6, numberOfJoints);
+ * workspace.dampedPseudoInverse(jacobian, jacobianInverse, 0.01); // every control cycle
+ * \endcode
+ *
+ * \tparam Scalar_ the primitive type of the data (double or float)
+ * \tparam Rows_ number of rows of the matrix or Eigen::Dynamic
+ * \tparam Cols_ number of columns of the matrix or Eigen::Dynamic
+ */
+template<typename Scalar_, int Rows_ = Eigen::Dynamic, int Cols_ = Eigen::Dynamic>
+class PseudoInverseWorkspace {
+ public:
+  typedef Scalar_ Scalar;
+  typedef Eigen::Matrix<Scalar_, Rows_, Cols_> Matrix;
+  typedef Eigen::Matrix<Scalar_, Cols_, Rows_> InverseMatrix;
+ private:
+  typedef internal::PseudoInverseGram<Scalar_, Rows_, Cols_> Gram;
+  typedef typename Gram::Matrix GramMatrix;
+ public:
+
+  /*! \brief Constructor allocating the memory for a matrix with the given dimensions.
+   *  \param rows   number of rows
+   *  \param cols   number of columns
+   */
+  explicit PseudoInverseWorkspace(Eigen::DenseIndex rows = (Rows_ == Eigen::Dynamic ? 0 : Rows_), Eigen::DenseIndex cols = (Cols_ == Eigen::Dynamic ? 0 : Cols_))
+    : rows_(rows),
+      cols_(cols),
+      isWide_(Gram::isWide(rows, cols)),
+      gram_(isWide_ ? rows : cols, isWide_ ? rows : cols),
+      ldlt_(isWide_ ? rows : cols),
+      solver_(isWide_ ? rows : cols),
+      gramInverse_(isWide_ ? rows : cols, isWide_ ? rows : cols) {
+  }
+
+  inline Eigen::DenseIndex rows() const {
+    return rows_;
+  }
+
+  inline Eigen::DenseIndex cols() const {
+    return cols_;
+  }
+
+  /*! \brief Computes the Moore–Penrose pseudoinverse with the singular value decomposition.
+   * \param a: Matrix to invert with the dimensions of the workspace
+   * \param result: Result is written here
+   * \param epsilon: Numerical precision
+   * \return true if successful
+   */
+  bool pseudoInverse(const Matrix& a, InverseMatrix& result, Scalar epsilon = std::numeric_limits<Scalar>::epsilon()) {
+    checkDimensions(a);
+    svd_.compute(a, (Cols_ == Eigen::Dynamic) ? (Eigen::ComputeThinU | Eigen::ComputeThinV) : (Eigen::ComputeFullU | Eigen::ComputeFullV));
+    return internal::getPseudoInverseFromSvd(svd_, result, epsilon);
+  }
+
+  /*! \brief Computes the Moore–Penrose pseudoinverse with the eigendecomposition of the Gram matrix, see kindr::gramPseudoInverse().
+   * \param a: Matrix to invert with the dimensions of the workspace
+   * \param result: Result is written here
+   * \param epsilon: Numerical precision relative to the largest squared singular value
+   * \return true if successful
+   */
+  bool gramPseudoInverse(const Matrix& a, InverseMatrix& result, Scalar epsilon = std::numeric_limits<Scalar>::epsilon()) {
+    checkDimensions(a);
+    return internal::getPseudoInverseFromGram<Gram>(a, isWide_, epsilon, gram_, solver_, gramInverse_, result);
+  }
+
+  /*! \brief Computes the damped least-squares inverse A^T*(A*A^T + damping^2*I)^-1 (wide) or (A^T*A + damping^2*I)^-1*A^T (tall).
+   * The Gram matrix squares the condition number, which the damping bounds by (largest singular value/damping)^2.
+   * \param a: Matrix to invert with the dimensions of the workspace
+   * \param result: Result is written here
+   * \param damping: Damping factor, which limits the norm of the result close to singularities
+   * \return true if successful
+   */
+  bool dampedPseudoInverse(const Matrix& a, InverseMatrix& result, Scalar damping) {
+    checkDimensions(a);
+    return internal::getDampedPseudoInverseFromGram<Gram>(a, isWide_, damping, gram_, ldlt_, gramInverse_, result);
+  }
+
+  /*! \brief Computes the pseudo-inverse of a matrix with full row or column rank with the LDLT decomposition
+   *  of the Gram matrix, which is considerably faster than the singular value decomposition.
+   *  The Gram matrix squares the condition number, i.e. the result loses about twice as many digits as with
+   *  pseudoInverse(). Use pseudoInverse() for matrices whose condition number approaches 1/sqrt(epsilon).
+   * \param a: Matrix to invert with the dimensions of the workspace
+   * \param result: Result is written here
+   * \param epsilon: Numerical precision to detect rank deficiency
+   * \return true if successful, false if the matrix is rank deficient
+   */
+  bool fullRankPseudoInverse(const Matrix& a, InverseMatrix& result, Scalar epsilon = std::numeric_limits<Scalar>::epsilon()) {
+    checkDimensions(a);
+    return internal::getFullRankPseudoInverseFromGram<Gram>(a, isWide_, epsilon, gram_, ldlt_, gramInverse_, result);
+  }
+
+ private:
+  inline void checkDimensions(const Matrix& a) const {
+    KINDR_ASSERT_TRUE(std::runtime_error, a.rows() == rows_ && a.cols() == cols_, "The dimensions of the matrix differ from the workspace!");
+  }
+
+  Eigen::DenseIndex rows_;
+  Eigen::DenseIndex cols_;
+  bool isWide_;
+  Eigen::JacobiSVD<Matrix> svd_;
+  GramMatrix gram_;
+  Eigen::LDLT<GramMatrix> ldlt_;
+  Eigen::SelfAdjointEigenSolver<GramMatrix> solver_;
+  GramMatrix gramInverse_;
+};
+
+
+/*!
+ * \brief Computes the damped least-squares inverse A^T*(A*A^T + damping^2*I)^-1 (wide) or (A^T*A + damping^2*I)^-1*A^T (tall).
+ * The Gram matrix and its decomposition are fixed-size if one dimension of the matrix is fixed, and then nothing
+ * is allocated apart from the result. The Gram matrix squares the condition number, which the damping bounds.
+ * \param a: Matrix to invert
+ * \param result: Result is written here
+ * \param damping: Damping factor, which limits the norm of the result close to singularities
+ * \return true if successful
+ */
+template<typename Derived_>
+bool static dampedPseudoInverse(const Eigen::MatrixBase<Derived_>& a, Eigen::Matrix<typename Derived_::Scalar, Derived_::ColsAtCompileTime, Derived_::RowsAtCompileTime>& result,
+                                typename Derived_::Scalar damping)
+{
+  typedef internal::PseudoInverseGram<typename Derived_::Scalar, Derived_::RowsAtCompileTime, Derived_::ColsAtCompileTime> Gram;
+  typedef typename Gram::Matrix GramMatrix;
+  const bool isWide = Gram::isWide(a.rows(), a.cols());
+  const Eigen::DenseIndex size = isWide ? a.rows() : a.cols();
+  GramMatrix gram(size, size);
+  Eigen::LDLT<GramMatrix> ldlt(size);
+  GramMatrix gramInverse(size, size);
+  return internal::getDampedPseudoInverseFromGram<Gram>(a, isWide, damping, gram, ldlt, gramInverse, result);
+}
+
+/*!
+ * \brief Computes the pseudo-inverse of a matrix with full row or column rank with the LDLT decomposition of the Gram matrix.
+ * Nothing is allocated apart from the result if one dimension of the matrix is fixed. The Gram matrix squares the
+ * condition number, hence pseudoInverse() is more accurate for matrices close to rank deficiency.
+ * \param a: Matrix to invert
+ * \param result: Result is written here
+ * \param epsilon: Numerical precision to detect rank deficiency
+ * \return true if successful, false if the matrix is rank deficient
+ */
+template<typename Derived_>
+bool static fullRankPseudoInverse(const Eigen::MatrixBase<Derived_>& a, Eigen::Matrix<typename Derived_::Scalar, Derived_::ColsAtCompileTime, Derived_::RowsAtCompileTime>& result,
+                                  typename Derived_::Scalar epsilon = std::numeric_limits<typename Derived_::Scalar>::epsilon())
+{
+  typedef internal::PseudoInverseGram<typename Derived_::Scalar, Derived_::RowsAtCompileTime, Derived_::ColsAtCompileTime> Gram;
+  typedef typename Gram::Matrix GramMatrix;
+  const bool isWide = Gram::isWide(a.rows(), a.cols());
+  const Eigen::DenseIndex size = isWide ? a.rows() : a.cols();
+  GramMatrix gram(size, size);
+  Eigen::LDLT<GramMatrix> ldlt(size);
+  GramMatrix gramInverse(size, size);
+  return internal::getFullRankPseudoInverseFromGram<Gram>(a, isWide, epsilon, gram, ldlt, gramInverse, result);
 }
 
 } // end namespace kindr
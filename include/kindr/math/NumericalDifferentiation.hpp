@@ -0,0 +1,352 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+#include <Eigen/Core>
+
+#include "kindr/common/common.hpp"
+#include "kindr/common/assert_macros.hpp"
+#include "kindr/vectors/Vector.hpp"
+#include "kindr/rotations/Rotation.hpp"
+#include "kindr/poses/HomogeneousTransformation.hpp"
+
+namespace kindr {
+
+namespace internal {
+
+/*! \brief Box operations of the types which can be differentiated numerically.
+ *  A specialization defines the Scalar, the Dimension of the tangent space (or Eigen::Dynamic), the Tangent vector and
+ *
+ *    static Eigen::DenseIndex getDimension(const Type& x);
+ *    static Type boxPlus(const Type& x, const Tangent& vector);
+ *    template<typename Result_> static void boxMinus(const Type& a, const Type& b, Result_ result); // result = a boxMinus b
+ *
+ *  (only for advanced users)
+ */
+template<typename Type_, typename Enable_ = void>
+class ManifoldTraits;
+
+//! Floating point numbers
+template<typename Type_>
+class ManifoldTraits<Type_, typename std::enable_if<std::is_floating_point<Type_>::value>::type> {
+ public:
+  typedef Type_ Scalar;
+  static constexpr int Dimension = 1;
+  typedef Eigen::Matrix<Scalar, 1, 1> Tangent;
+
+  inline static Eigen::DenseIndex getDimension(const Type_& /*x*/) {
+    return 1;
+  }
+  inline static Type_ boxPlus(const Type_& x, const Tangent& vector) {
+    return x + vector(0);
+  }
+  template<typename Result_>
+  inline static void boxMinus(const Type_& a, const Type_& b, Result_ result) {
+    result(0) = a - b;
+  }
+};
+
+//! Eigen matrices, whose coefficients are stacked in the storage order
+template<typename Scalar_, int Rows_, int Cols_, int Options_, int MaxRows_, int MaxCols_>
+class ManifoldTraits<Eigen::Matrix<Scalar_, Rows_, Cols_, Options_, MaxRows_, MaxCols_> > {
+ public:
+  typedef Eigen::Matrix<Scalar_, Rows_, Cols_, Options_, MaxRows_, MaxCols_> Type;
+  typedef Scalar_ Scalar;
+  static constexpr int Dimension = (Rows_ == Eigen::Dynamic || Cols_ == Eigen::Dynamic) ? Eigen::Dynamic : Rows_*Cols_;
+  typedef Eigen::Matrix<Scalar, Dimension, 1> Tangent;
+
+  inline static Eigen::DenseIndex getDimension(const Type& x) {
+    return x.size();
+  }
+  inline static Type boxPlus(const Type& x, const Tangent& vector) {
+    Type result = x;
+    Eigen::Map<Tangent>(result.data(), result.size()) += vector;
+    return result;
+  }
+  template<typename Result_>
+  inline static void boxMinus(const Type& a, const Type& b, Result_ result) {
+    result = Eigen::Map<const Tangent>(a.data(), a.size()) - Eigen::Map<const Tangent>(b.data(), b.size());
+  }
+};
+
+//! Vectors with physical type
+template<enum PhysicalType PhysicalType_, typename PrimType_, int Dimension_>
+class ManifoldTraits<Vector<PhysicalType_, PrimType_, Dimension_> > {
+ public:
+  typedef Vector<PhysicalType_, PrimType_, Dimension_> Type;
+  typedef PrimType_ Scalar;
+  static constexpr int Dimension = Dimension_;
+  typedef Eigen::Matrix<Scalar, Dimension, 1> Tangent;
+
+  inline static Eigen::DenseIndex getDimension(const Type& x) {
+    return x.toImplementation().size();
+  }
+  inline static Type boxPlus(const Type& x, const Tangent& vector) {
+    return Type(Tangent(x.toImplementation() + vector));
+  }
+  template<typename Result_>
+  inline static void boxMinus(const Type& a, const Type& b, Result_ result) {
+    result = a.toImplementation() - b.toImplementation();
+  }
+};
+
+//! Rotations with boxPlus(v) = exp(v)*R
+template<typename Type_>
+class ManifoldTraits<Type_, typename std::enable_if<std::is_base_of<RotationBase<Type_>, Type_>::value>::type> {
+ public:
+  typedef typename get_scalar<Type_>::Scalar Scalar;
+  static constexpr int Dimension = 3;
+  typedef Eigen::Matrix<Scalar, 3, 1> Tangent;
+
+  inline static Eigen::DenseIndex getDimension(const Type_& /*x*/) {
+    return 3;
+  }
+  inline static Type_ boxPlus(const Type_& x, const Tangent& vector) {
+    return x.boxPlus(vector);
+  }
+  template<typename Result_>
+  inline static void boxMinus(const Type_& a, const Type_& b, Result_ result) {
+    result = a.boxMinus(b);
+  }
+};
+
+//! Poses with the tangent [position; rotation], i.e. the product of the position and rotation manifolds
+template<typename PrimType_, typename Position_, typename Rotation_>
+class ManifoldTraits<HomogeneousTransformation<PrimType_, Position_, Rotation_> > {
+ public:
+  typedef HomogeneousTransformation<PrimType_, Position_, Rotation_> Type;
+  typedef PrimType_ Scalar;
+  static constexpr int Dimension = 6;
+  typedef Eigen::Matrix<Scalar, 6, 1> Tangent;
+
+  inline static Eigen::DenseIndex getDimension(const Type& /*x*/) {
+    return 6;
+  }
+  inline static Type boxPlus(const Type& x, const Tangent& vector) {
+    return Type(Position_(x.getPosition().toImplementation() + vector.template head<3>()), x.getRotation().boxPlus(vector.template tail<3>()));
+  }
+  template<typename Result_>
+  inline static void boxMinus(const Type& a, const Type& b, Result_ result) {
+    result.template head<3>() = a.getPosition().toImplementation() - b.getPosition().toImplementation();
+    result.template tail<3>() = a.getRotation().boxMinus(b.getRotation());
+  }
+};
+
+} // namespace internal
+
+
+//! Finite-difference scheme of the numerical differentiation
+enum class FiniteDifferenceScheme {
+  Central,    //!< (f(x + h) - f(x - h))/(2*h), error O(h^2)
+  Richardson  //!< Richardson extrapolation (4*D(h/2) - D(h))/3 of the central differences D, error O(h^4)
+};
+
+/*! \class NumericalJacobian
+ *  \brief Numerical Jacobians of functions between kindr manifold types with boxPlus and boxMinus.
+ *
+ *  The column k of the Jacobian of y = f(x) is the finite difference of f(x boxPlus h*e_k) boxMinus f(x boxPlus -h*e_k)
+ *  in the tangent spaces. The input and output types can be floating point numbers, Eigen matrices (stacked in storage
+ *  order), vectors with physical type, rotations (boxPlus(v) = exp(v)*R) and homogeneous transformations (tangent
+ *  [position; rotation]), see internal::ManifoldTraits. The Jacobian is stored in the object and reused, such that
+ *  repeated evaluations with the same dimensions do not reallocate it.
+ *
+ *  The columns can be evaluated in parallel with OpenMP if it is enabled, see setParallel(). This is disabled by
+ *  default, since the function must then be thread-safe.
+ *  \code{.cpp}
+ *  NumericalJacobian<Eigen::Vector3d, RotationQuaternionD> numericalJacobian(FiniteDifferenceScheme::Richardson);
+ *  const Eigen::Matrix3d& jacobian = numericalJacobian.compute([](const Eigen::Vector3d& v) { return RotationQuaternionD().exponentialMap(v); }, v);
+ *  \endcode
+ *
+ *  \tparam Input_ type of the argument of the function
+ *  \tparam Output_ type of the value of the function
+ *  \ingroup math
+ */
+template<typename Input_, typename Output_>
+class NumericalJacobian {
+ public:
+  typedef internal::ManifoldTraits<Input_> InputTraits;
+  typedef internal::ManifoldTraits<Output_> OutputTraits;
+  typedef typename InputTraits::Scalar Scalar;
+  typedef typename InputTraits::Tangent InputTangent;
+  typedef typename OutputTraits::Tangent OutputTangent;
+  typedef Eigen::Matrix<Scalar, OutputTraits::Dimension, InputTraits::Dimension> Jacobian;
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  /*! \brief Constructor
+   *  \param scheme  finite-difference scheme
+   *  \param step    step size h, which defaults to the optimal step for the scheme and unit scaled arguments
+   */
+  explicit NumericalJacobian(FiniteDifferenceScheme scheme = FiniteDifferenceScheme::Central, Scalar step = Scalar(0))
+    : scheme_(scheme),
+      step_(step > Scalar(0) ? step : getDefaultStep(scheme)),
+      isParallel_(false) {
+  }
+
+  //! Gets the step size, which balances the truncation and rounding errors: eps^(1/3) for central differences and eps^(1/5) with extrapolation
+  static Scalar getDefaultStep(FiniteDifferenceScheme scheme) {
+    using std::pow;
+    return pow(std::numeric_limits<Scalar>::epsilon(), scheme == FiniteDifferenceScheme::Central ? Scalar(1.0/3.0) : Scalar(1.0/5.0));
+  }
+
+  inline void setStep(Scalar step) {
+    step_ = step;
+  }
+
+  inline Scalar getStep() const {
+    return step_;
+  }
+
+  //! Enables the evaluation of the columns in parallel with OpenMP, which requires a thread-safe function (default: false)
+  inline void setParallel(bool isParallel) {
+    isParallel_ = isParallel;
+  }
+
+  /*! \brief Computes the Jacobian of a function.
+   *  \param function  callable object y = function(x)
+   *  \param x         argument at which the Jacobian is computed
+   *  \returns reference to the Jacobian, which is valid until the next computation
+   */
+  template<typename Function_>
+  const Jacobian& compute(const Function_& function, const Input_& x) {
+    const Eigen::DenseIndex cols = InputTraits::getDimension(x);
+    const Eigen::DenseIndex rows = (OutputTraits::Dimension == Eigen::Dynamic) ? OutputTraits::getDimension(function(x)) : OutputTraits::Dimension;
+    jacobian_.resize(rows, cols);
+    if (scheme_ == FiniteDifferenceScheme::Richardson) {
+      halfStepJacobian_.resize(rows, cols);
+    }
+#ifdef _OPENMP
+    #pragma omp parallel for if(isParallel_)
+#endif
+    for (Eigen::DenseIndex k = 0; k < cols; ++k) {
+      InputTangent direction = InputTangent::Zero(cols);
+      direction(k) = Scalar(1);
+      setDifference(function, x, direction, step_, jacobian_.col(k));
+      if (scheme_ == FiniteDifferenceScheme::Richardson) {
+        setDifference(function, x, direction, Scalar(0.5)*step_, halfStepJacobian_.col(k));
+        jacobian_.col(k) = (Scalar(4)*halfStepJacobian_.col(k) - jacobian_.col(k))/Scalar(3);
+      }
+    }
+    return jacobian_;
+  }
+
+  /*! \brief Computes the directional derivative J*v of a function, e.g. the time derivative of f(x(t)) with v = dx/dt.
+   *  This needs two (central) or four (Richardson) evaluations of the function instead of the whole Jacobian.
+   *  \param function   callable object y = function(x)
+   *  \param x          argument at which the derivative is computed
+   *  \param direction  tangent vector of the argument
+   *  \returns the derivative in the tangent space of the value
+   */
+  template<typename Function_>
+  OutputTangent computeDirectionalDerivative(const Function_& function, const Input_& x, const InputTangent& direction) const {
+    KINDR_ASSERT_TRUE(std::runtime_error, direction.size() == InputTraits::getDimension(x), "The direction does not match the dimension of the argument!");
+    auto curve = [&function, &x, &direction](Scalar time) {
+      return function(InputTraits::boxPlus(x, InputTangent(time*direction)));
+    };
+    return getDerivativeOfCurve(curve);
+  }
+
+  /*! \brief Computes the total time derivative of a function f(x, dx/dt) of an argument and its time derivative.
+   *
+   *  This is the numerical counterpart of matlab/utils/fulldiff2.m, i.e. df/dt = df/dx*dx/dt + df/d(dx/dt)*d2x/dt2,
+   *  which is evaluated as the derivative along the curve (x boxPlus t*v, v + t*a) without the partial Jacobians.
+   *  For rotations, v and a are the global angular velocity and acceleration due to boxPlus(v) = exp(v)*R.
+   *  Higher derivatives are obtained by differentiating a function which returns the total derivative again.
+   *  \param function      callable object y = function(x, v)
+   *  \param x             argument at which the derivative is computed
+   *  \param velocity      time derivative v of the argument
+   *  \param acceleration  time derivative a of the velocity
+   *  \returns the derivative in the tangent space of the value
+   */
+  template<typename Function_>
+  OutputTangent computeTotalTimeDerivative(const Function_& function, const Input_& x, const InputTangent& velocity, const InputTangent& acceleration) const {
+    KINDR_ASSERT_TRUE(std::runtime_error, velocity.size() == InputTraits::getDimension(x) && acceleration.size() == velocity.size(),
+                      "The velocity and the acceleration do not match the dimension of the argument!");
+    auto curve = [&function, &x, &velocity, &acceleration](Scalar time) {
+      return function(InputTraits::boxPlus(x, InputTangent(time*velocity)), InputTangent(velocity + time*acceleration));
+    };
+    return getDerivativeOfCurve(curve);
+  }
+
+ private:
+  //! Sets the central difference (f(x boxPlus h*v) boxMinus f(x boxPlus -h*v))/(2*h)
+  template<typename Function_, typename Result_>
+  static void setDifference(const Function_& function, const Input_& x, const InputTangent& direction, Scalar step, Result_ result) {
+    setDifferenceOfCurve([&function, &x, &direction](Scalar time) { return function(InputTraits::boxPlus(x, InputTangent(time*direction))); }, step, result);
+  }
+
+  //! Sets the central difference (c(h) boxMinus c(-h))/(2*h) of a curve c(t) of values
+  template<typename Curve_, typename Result_>
+  static void setDifferenceOfCurve(const Curve_& curve, Scalar step, Result_ result) {
+    const Output_ valuePlus = curve(step);
+    const Output_ valueMinus = curve(-step);
+    OutputTraits::boxMinus(valuePlus, valueMinus, result);
+    result /= Scalar(2)*step;
+  }
+
+  //! Gets the derivative of a curve c(t) of values at t = 0 with the finite-difference scheme
+  template<typename Curve_>
+  OutputTangent getDerivativeOfCurve(const Curve_& curve) const {
+    const Eigen::DenseIndex rows = (OutputTraits::Dimension == Eigen::Dynamic) ? OutputTraits::getDimension(curve(Scalar(0))) : OutputTraits::Dimension;
+    OutputTangent derivative(rows);
+    setDifferenceOfCurve(curve, step_, derivative.col(0));
+    if (scheme_ == FiniteDifferenceScheme::Richardson) {
+      OutputTangent halfStepDerivative(rows);
+      setDifferenceOfCurve(curve, Scalar(0.5)*step_, halfStepDerivative.col(0));
+      derivative = (Scalar(4)*halfStepDerivative - derivative)/Scalar(3);
+    }
+    return derivative;
+  }
+
+  FiniteDifferenceScheme scheme_;
+  Scalar step_;
+  bool isParallel_;
+  Jacobian jacobian_;
+  Jacobian halfStepJacobian_;
+};
+
+
+/*! \brief Computes the numerical Jacobian of a function between kindr manifold types.
+ *  \param function  callable object y = function(x)
+ *  \param x         argument at which the Jacobian is computed
+ *  \param scheme    finite-difference scheme
+ *  \returns the Jacobian
+ */
+template<typename Output_, typename Input_, typename Function_>
+inline typename NumericalJacobian<Input_, Output_>::Jacobian getNumericalJacobian(const Function_& function, const Input_& x,
+                                                                                 FiniteDifferenceScheme scheme = FiniteDifferenceScheme::Central) {
+  NumericalJacobian<Input_, Output_> numericalJacobian(scheme);
+  return numericalJacobian.compute(function, x);
+}
+
+} // namespace kindr
@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <kindr/phys_quant/WrenchBase.hpp>
+#include <kindr/phys_quant/Wrench.hpp>
+#include <kindr/phys_quant/PhysicalQuantities.hpp>
+
+namespace kindr {
+
+/*! \class Wrench2D
+ *  \brief Planar wrench consisting of a 2D force and the torque about the z-axis.
+ *  \tparam PrimType_ the primitive type of the data (double or float)
+ */
+template <typename PrimType_>
+class Wrench2D : public WrenchBase<Wrench2D<PrimType_>> {
+public:
+  typedef PrimType_ Scalar;
+  typedef Vector<PhysicalType::Force, PrimType_, 2> Force;
+  typedef PrimType_ Torque;
+  typedef Eigen::Matrix<PrimType_, 3, 1> Vector3;
+  typedef Eigen::Matrix<PrimType_, 2, 1> Vector2;
+
+  explicit Wrench2D() : force_(Force::Zero()), torque_(Torque(0)) {
+
+  }
+
+  explicit Wrench2D(const Force& force, Torque torque) :
+    force_(force),
+    torque_(torque) {
+  }
+
+  explicit Wrench2D(const Vector2& force, Torque torque) :
+    force_(Force(force)),
+    torque_(torque) {
+  }
+
+  /*! Sets the wrench by a 3D-vector [force, torque]'
+   */
+  explicit Wrench2D(const Vector3& wrench) :
+    force_(Force(Vector2(wrench.template head<2>()))),
+    torque_(wrench(2)) {
+  }
+
+  /*! \brief Constructor using a 3D wrench, which is projected onto the xy-plane.
+   */
+  explicit Wrench2D(const Wrench6<PrimType_>& wrench) :
+    force_(Force(Vector2(wrench.getForce().toImplementation().template head<2>()))),
+    torque_(wrench.getTorque()(2)) {
+  }
+
+  inline Force & getForce() {
+    return force_;
+  }
+
+  inline const Force & getForce() const {
+    return force_;
+  }
+
+  inline Torque & getTorque() {
+    return torque_;
+  }
+
+  inline Torque getTorque() const {
+    return torque_;
+  }
+
+  inline void setForce(const Force& force) {
+    force_ = force;
+  }
+
+  inline void setForce(const Vector2& force) {
+    force_ = Force(force);
+  }
+
+  inline void setTorque(Torque torque) {
+    torque_ = torque;
+  }
+
+  inline void setVector(const Vector3& wrench) {
+    *this = Wrench2D(wrench);
+  }
+
+  inline Vector3 getVector() const {
+    Vector3 vector;
+    vector.template head<2>() = getForce().toImplementation();
+    vector(2) = torque_;
+    return vector;
+  }
+
+  /*! \returns the corresponding 3D wrench in the xy-plane
+   */
+  inline Wrench6<PrimType_> getWrench3D() const {
+    return Wrench6<PrimType_>(Eigen::Matrix<PrimType_, 3, 1>(force_(0), force_(1), Scalar(0)),
+                              Eigen::Matrix<PrimType_, 3, 1>(Scalar(0), Scalar(0), torque_));
+  }
+
+  Wrench2D& setZero() {
+    force_.setZero();
+    torque_ = Torque(0);
+    return *this;
+  }
+
+  /*! \brief Addition of two wrenches.
+   * \param other   other wrench
+   * \returns sum
+   */
+  Wrench2D operator+(const Wrench2D& other) const {
+    return Wrench2D(this->getForce() + other.getForce(), this->getTorque() + other.getTorque());
+  }
+
+  /*! \brief Subtraction of two wrenches.
+   * \param other   other wrench
+   * \returns difference
+   */
+  Wrench2D operator-(const Wrench2D& other) const {
+    return Wrench2D(this->getForce() - other.getForce(), this->getTorque() - other.getTorque());
+  }
+
+  /*! \brief Multiplies the wrench with a scalar.
+   * \param factor   factor
+   * \returns product
+   */
+  template<typename PrimTypeFactor_>
+  Wrench2D operator*(PrimTypeFactor_ factor) const {
+    return Wrench2D(this->getForce()*(PrimType_)factor, this->getTorque()*(PrimType_)factor);
+  }
+
+  /*! \brief Addition and assignment of two wrenches.
+   * \param other   other wrench
+   * \returns reference
+   */
+  Wrench2D& operator+=(const Wrench2D& other) {
+    this->getForce() += other.getForce();
+    this->getTorque() += other.getTorque();
+    return *this;
+  }
+
+  /*! \brief Subtraction and assignment of two wrenches.
+   * \param other   other wrench
+   * \returns reference
+   */
+  Wrench2D& operator-=(const Wrench2D& other) {
+    this->getForce() -= other.getForce();
+    this->getTorque() -= other.getTorque();
+    return *this;
+  }
+
+  /*! \brief Negation of a wrench.
+   * \returns negative wrench
+   */
+  Wrench2D operator-() const {
+    return Wrench2D(-this->getForce(), -this->getTorque());
+  }
+
+  /*! \brief Comparison operator.
+   * \param other   other wrench
+   * \returns true if equal
+   */
+  bool operator==(const Wrench2D& other) const {
+    return ((this->getForce() == other.getForce()) && (this->getTorque() == other.getTorque()));
+  }
+
+  /*! \brief Used for printing the object with std::cout.
+   *  \returns std::stream object
+   */
+  friend std::ostream & operator << (std::ostream & out, const Wrench2D & wrench) {
+    out << wrench.getForce() << " " << wrench.getTorque();
+    return out;
+  }
+protected:
+  Force force_;
+  Torque torque_;
+};
+
+typedef Wrench2D<double> Wrench2DD;
+typedef Wrench2D<float> Wrench2DF;
+
+
+} // namespace kindr
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <algorithm>
+
+#include <Eigen/Core>
+
+#include "kindr/common/common.hpp"
+#include "kindr/common/assert_macros.hpp"
+#include "kindr/phys_quant/PhysicalQuantities.hpp"
+#include "kindr/phys_quant/Wrench.hpp"
+#include "kindr/rotations/RotationQuaternionChunks.hpp"
+
+namespace kindr {
+
+/*
+ * The batched wrench functions take the contacts in structure-of-arrays form: the positions, forces and torques
+ * are Nx3 matrices and the rotations are Nx4 matrices of quaternion coefficients (w, x, y, z), i.e. each column
+ * holds one component of all contacts. The loops over the contacts therefore run over contiguous memory and are
+ * vectorized, and none of the functions allocates.
+ */
+
+namespace internal {
+
+//! Number of contacts processed at once by the batched wrench functions
+static constexpr int WrenchChunkSize = 32;
+
+} // namespace internal
+
+/*! \brief Shifts the reference point of a wrench, i.e. torque' = torque + (from - to) x force.
+ *  \param wrench  wrench about the point from
+ *  \param from    current reference point
+ *  \param to      new reference point
+ *  \returns the wrench about the point to
+ */
+template<typename PrimType_>
+inline Wrench6<PrimType_> shiftWrench(const Wrench6<PrimType_>& wrench, const Position<PrimType_, 3>& from, const Position<PrimType_, 3>& to) {
+  const Eigen::Matrix<PrimType_, 3, 1> lever = from.toImplementation() - to.toImplementation();
+  return Wrench6<PrimType_>(wrench.getForce(), wrench.getTorque() + typename Wrench6<PrimType_>::Torque(lever.cross(wrench.getForce().toImplementation())));
+}
+
+/*! \brief Sums wrenches about a common reference point.
+ *  The wrenches are expressed in the common frame and applied at the contact positions.
+ *  \param positions       Nx3-matrix of the contact positions
+ *  \param forces          Nx3-matrix of the contact forces
+ *  \param torques         Nx3-matrix of the contact torques
+ *  \param referencePoint  reference point of the total wrench
+ *  \returns the total wrench about the reference point
+ */
+template<typename Positions_, typename Forces_, typename Torques_>
+inline Wrench6<typename Positions_::Scalar> aggregateWrenches(const Eigen::MatrixBase<Positions_>& positions, const Eigen::MatrixBase<Forces_>& forces,
+                                                              const Eigen::MatrixBase<Torques_>& torques, const Position<typename Positions_::Scalar, 3>& referencePoint) {
+  typedef typename Positions_::Scalar Scalar;
+  typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+  KINDR_ASSERT_TRUE(std::runtime_error, positions.cols() == 3 && forces.cols() == 3 && torques.cols() == 3, "The contacts must be stored as Nx3 matrices!");
+  KINDR_ASSERT_TRUE(std::runtime_error, forces.rows() == positions.rows() && torques.rows() == positions.rows(), "The numbers of contacts differ!");
+  const Vector3 totalForce = forces.colwise().sum().transpose();
+  // sum of p x f, reduced per component
+  const Vector3 momentOfForces(
+      (positions.col(1).array()*forces.col(2).array() - positions.col(2).array()*forces.col(1).array()).sum(),
+      (positions.col(2).array()*forces.col(0).array() - positions.col(0).array()*forces.col(2).array()).sum(),
+      (positions.col(0).array()*forces.col(1).array() - positions.col(1).array()*forces.col(0).array()).sum());
+  const Vector3 totalTorque = torques.colwise().sum().transpose() + momentOfForces - referencePoint.toImplementation().cross(totalForce);
+  return Wrench6<Scalar>(totalForce, totalTorque);
+}
+
+/*! \brief Expresses contact wrenches in the common frame about a reference point and sums them.
+ *  The contact i has the position p_i and the rotation R_i of its frame in the common frame, and its wrench is
+ *  expressed in the contact frame. The wrench in the common frame is f_i' = R_i*f_i and
+ *  torque_i' = R_i*torque_i + (p_i - r) x f_i', such that the wrenches sum to the total wrench.
+ *  \param positions       Nx3-matrix of the contact positions in the common frame
+ *  \param quaternions     Nx4-matrix of the unit quaternions (w, x, y, z) of the contact frames
+ *  \param forces          Nx3-matrix of the contact forces in the contact frames
+ *  \param torques         Nx3-matrix of the contact torques in the contact frames
+ *  \param referencePoint  reference point in the common frame
+ *  \param resultForces    Nx3-matrix of the forces in the common frame
+ *  \param resultTorques   Nx3-matrix of the torques about the reference point in the common frame
+ *  \returns the total wrench about the reference point
+ */
+template<typename Positions_, typename Quaternions_, typename Forces_, typename Torques_, typename ResultForces_, typename ResultTorques_>
+inline Wrench6<typename Positions_::Scalar> aggregateWrenches(const Eigen::MatrixBase<Positions_>& positions, const Eigen::MatrixBase<Quaternions_>& quaternions,
+                                                              const Eigen::MatrixBase<Forces_>& forces, const Eigen::MatrixBase<Torques_>& torques,
+                                                              const Position<typename Positions_::Scalar, 3>& referencePoint,
+                                                              Eigen::MatrixBase<ResultForces_>& resultForces, Eigen::MatrixBase<ResultTorques_>& resultTorques) {
+  typedef typename Positions_::Scalar Scalar;
+  const Eigen::DenseIndex size = positions.rows();
+  KINDR_ASSERT_TRUE(std::runtime_error, positions.cols() == 3 && forces.cols() == 3 && torques.cols() == 3, "The contacts must be stored as Nx3 matrices!");
+  KINDR_ASSERT_TRUE(std::runtime_error, quaternions.cols() == 4, "The rotations must be stored as a Nx4 matrix!");
+  KINDR_ASSERT_TRUE(std::runtime_error, quaternions.rows() == size && forces.rows() == size && torques.rows() == size, "The numbers of contacts differ!");
+  KINDR_ASSERT_TRUE(std::runtime_error, resultForces.rows() == size && resultForces.cols() == 3 && resultTorques.rows() == size && resultTorques.cols() == 3,
+                    "The results must be Nx3 matrices!");
+  // the contacts are processed in chunks, whose temporaries live on the stack
+  typedef Eigen::Array<Scalar, Eigen::Dynamic, 1, 0, internal::WrenchChunkSize, 1> Chunk;
+  for (Eigen::DenseIndex begin = 0; begin < size; begin += internal::WrenchChunkSize) {
+    const Eigen::DenseIndex n = std::min<Eigen::DenseIndex>(internal::WrenchChunkSize, size - begin);
+    const Chunk w = quaternions.col(0).segment(begin, n).array();
+    const Chunk x = quaternions.col(1).segment(begin, n).array();
+    const Chunk y = quaternions.col(2).segment(begin, n).array();
+    const Chunk z = quaternions.col(3).segment(begin, n).array();
+    // forces and torques in the common frame, the torques are then shifted by l x f
+    Chunk gx(n), gy(n), gz(n), rx(n), ry(n), rz(n);
+    internal::rotateByQuaternions<Chunk>(w, x, y, z, forces.col(0).segment(begin, n).array(), forces.col(1).segment(begin, n).array(), forces.col(2).segment(begin, n).array(), gx, gy, gz);
+    internal::rotateByQuaternions<Chunk>(w, x, y, z, torques.col(0).segment(begin, n).array(), torques.col(1).segment(begin, n).array(), torques.col(2).segment(begin, n).array(), rx, ry, rz);
+    const Chunk lx = positions.col(0).segment(begin, n).array() - referencePoint.x();
+    const Chunk ly = positions.col(1).segment(begin, n).array() - referencePoint.y();
+    const Chunk lz = positions.col(2).segment(begin, n).array() - referencePoint.z();
+    resultForces.col(0).segment(begin, n) = gx.matrix();
+    resultForces.col(1).segment(begin, n) = gy.matrix();
+    resultForces.col(2).segment(begin, n) = gz.matrix();
+    resultTorques.col(0).segment(begin, n) = (rx + ly*gz - lz*gy).matrix();
+    resultTorques.col(1).segment(begin, n) = (ry + lz*gx - lx*gz).matrix();
+    resultTorques.col(2).segment(begin, n) = (rz + lx*gy - ly*gx).matrix();
+  }
+  return Wrench6<Scalar>(Eigen::Matrix<Scalar, 3, 1>(resultForces.colwise().sum().transpose()), Eigen::Matrix<Scalar, 3, 1>(resultTorques.colwise().sum().transpose()));
+}
+
+} // namespace kindr
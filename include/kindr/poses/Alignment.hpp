@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <Eigen/Core>
+#include <Eigen/SVD>
+#include <Eigen/Eigenvalues>
+
+#include "kindr/common/common.hpp"
+#include "kindr/common/assert_macros.hpp"
+#include "kindr/rotations/Rotation.hpp"
+#include "kindr/poses/HomogeneousTransformation.hpp"
+
+namespace kindr {
+
+/*! \class AlignmentAccumulator
+ *  \brief Accumulates weighted point correspondences to solve for the rotation or pose which aligns them.
+ *
+ *  The correspondences are given as pairs of a source point p_i and a target point q_i, such that the solvers
+ *  return the rotation R (and translation t and scale s) which minimize sum_i w_i*|q_i - (s*R*p_i + t)|^2.
+ *
+ *  The accumulator stores the weighted centroids and the centered cross-covariance only, i.e. it needs
+ *  constant memory independently of the number of correspondences. Batches of points are added with
+ *  vectorized Eigen expressions, and accumulators of disjoint sets of correspondences can be merged, e.g.
+ *  after a parallel reduction:
+ *  \code{.cpp}
+ *  AlignmentAccumulatorD accumulator;
+ *  accumulator.add(sourcePoints, targetPoints); // 3xN matrices
+ *  accumulator.merge(otherAccumulator);
+ *  const RotationQuaternionD rotation = accumulator.getRotation();
+ *  const HomTransformQuatD transformation = accumulator.getTransformation();
+ *  \endcode
+ *
+ *  The centered moments are updated with the pairwise update of Chan et al., which does not suffer from the
+ *  cancellation of the naive sums for points far from the origin.
+ *
+ *  \tparam PrimType_ the primitive type of the data (double or float)
+ *  \ingroup poses
+ */
+template<typename PrimType_>
+class AlignmentAccumulator {
+ public:
+  typedef PrimType_ Scalar;
+  typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+  typedef Eigen::Matrix<Scalar, 3, 3> Matrix3;
+  typedef Eigen::Matrix<Scalar, 4, 4> Matrix4;
+  typedef Eigen::Matrix<Scalar, 3, Eigen::Dynamic> Matrix3X;
+  typedef Eigen::Matrix<Scalar, 1, Eigen::Dynamic> RowVectorX;
+
+  AlignmentAccumulator() {
+    setZero();
+  }
+
+  /*! \brief Removes all correspondences.
+   *  \returns reference
+   */
+  AlignmentAccumulator& setZero() {
+    weight_ = Scalar(0);
+    sourceCentroid_.setZero();
+    targetCentroid_.setZero();
+    crossCovariance_.setZero();
+    sourceVariance_ = Scalar(0);
+    return *this;
+  }
+
+  /*! \brief Adds a single correspondence.
+   *  \param source   source point p
+   *  \param target   target point q
+   *  \param weight   non-negative weight
+   *  \returns reference
+   */
+  AlignmentAccumulator& add(const Vector3& source, const Vector3& target, Scalar weight = Scalar(1)) {
+    return merge(weight, source, target, Matrix3::Zero(), Scalar(0));
+  }
+
+  /*! \brief Adds a batch of correspondences with unit weights.
+   *  \param sources   3xN matrix of source points
+   *  \param targets   3xN matrix of target points
+   *  \returns reference
+   */
+  template<typename SourceDerived_, typename TargetDerived_>
+  AlignmentAccumulator& add(const Eigen::MatrixBase<SourceDerived_>& sources, const Eigen::MatrixBase<TargetDerived_>& targets) {
+    KINDR_ASSERT_TRUE(std::runtime_error, sources.cols() == targets.cols(), "The number of source and target points differs!");
+    if (sources.cols() == 0) {
+      return *this;
+    }
+    const Scalar weight = Scalar(sources.cols());
+    const Vector3 sourceCentroid = sources.rowwise().sum()/weight;
+    const Vector3 targetCentroid = targets.rowwise().sum()/weight;
+    const Matrix3X sourcesCentered = sources.colwise() - sourceCentroid;
+    const Matrix3 crossCovariance = (targets.colwise() - targetCentroid)*sourcesCentered.transpose();
+    return merge(weight, sourceCentroid, targetCentroid, crossCovariance, sourcesCentered.squaredNorm());
+  }
+
+  /*! \brief Adds a batch of weighted correspondences.
+   *  \param sources   3xN matrix of source points
+   *  \param targets   3xN matrix of target points
+   *  \param weights   1xN or Nx1 non-negative weights
+   *  \returns reference
+   */
+  template<typename SourceDerived_, typename TargetDerived_, typename WeightDerived_>
+  AlignmentAccumulator& add(const Eigen::MatrixBase<SourceDerived_>& sources, const Eigen::MatrixBase<TargetDerived_>& targets, const Eigen::MatrixBase<WeightDerived_>& weights) {
+    KINDR_ASSERT_TRUE(std::runtime_error, sources.cols() == targets.cols(), "The number of source and target points differs!");
+    KINDR_ASSERT_TRUE(std::runtime_error, sources.cols() == weights.size(), "The number of points and weights differs!");
+    RowVectorX w(weights.size());
+    for (int i = 0; i < weights.size(); ++i) {
+      w(i) = weights(i);
+    }
+    const Scalar weight = w.sum();
+    if (weight <= Scalar(0)) {
+      return *this;
+    }
+    const Vector3 sourceCentroid = (sources*w.transpose())/weight;
+    const Vector3 targetCentroid = (targets*w.transpose())/weight;
+    const Matrix3X sourcesCentered = sources.colwise() - sourceCentroid;
+    const Matrix3X weightedSourcesCentered = sourcesCentered.array().rowwise()*w.array();
+    const Matrix3 crossCovariance = (targets.colwise() - targetCentroid)*weightedSourcesCentered.transpose();
+    return merge(weight, sourceCentroid, targetCentroid, crossCovariance, (sourcesCentered.array()*weightedSourcesCentered.array()).sum());
+  }
+
+  /*! \brief Merges the correspondences of another accumulator.
+   *  \returns reference
+   */
+  AlignmentAccumulator& merge(const AlignmentAccumulator& other) {
+    return merge(other.weight_, other.sourceCentroid_, other.targetCentroid_, other.crossCovariance_, other.sourceVariance_);
+  }
+
+  AlignmentAccumulator& operator +=(const AlignmentAccumulator& other) {
+    return merge(other);
+  }
+
+  //! \returns the sum of the weights
+  inline Scalar getWeight() const {
+    return weight_;
+  }
+
+  //! \returns the weighted centroid of the source points
+  inline const Vector3& getSourceCentroid() const {
+    return sourceCentroid_;
+  }
+
+  //! \returns the weighted centroid of the target points
+  inline const Vector3& getTargetCentroid() const {
+    return targetCentroid_;
+  }
+
+  //! \returns sum_i w_i*(q_i - q_mean)*(p_i - p_mean)^T
+  inline const Matrix3& getCrossCovariance() const {
+    return crossCovariance_;
+  }
+
+  //! \returns sum_i w_i*|p_i - p_mean|^2
+  inline Scalar getSourceVariance() const {
+    return sourceVariance_;
+  }
+
+  /*! \brief Solves for the rotation with the singular value decomposition of the cross-covariance (Kabsch).
+   *  \returns the rotation R which minimizes sum_i w_i*|(q_i - q_mean) - R*(p_i - p_mean)|^2
+   */
+  RotationQuaternion<Scalar> getRotation() const {
+    Scalar scale;
+    return RotationQuaternion<Scalar>(RotationMatrix<Scalar>(getRotationMatrixAndScale(scale)));
+  }
+
+  /*! \brief Solves for the rotation with the eigenvector of the 4x4 matrix of Horn's method.
+   *  The result equals getRotation() up to the numerical precision.
+   *  \returns the rotation R which minimizes sum_i w_i*|(q_i - q_mean) - R*(p_i - p_mean)|^2
+   */
+  RotationQuaternion<Scalar> getRotationHorn() const {
+    const Matrix3 S = crossCovariance_.transpose(); // S(a,b) = sum_i w_i*p_a*q_b
+    Matrix4 N;
+    N << S(0,0) + S(1,1) + S(2,2), S(1,2) - S(2,1),            S(2,0) - S(0,2),            S(0,1) - S(1,0),
+         S(1,2) - S(2,1),          S(0,0) - S(1,1) - S(2,2),   S(0,1) + S(1,0),            S(2,0) + S(0,2),
+         S(2,0) - S(0,2),          S(0,1) + S(1,0),            -S(0,0) + S(1,1) - S(2,2),  S(1,2) + S(2,1),
+         S(0,1) - S(1,0),          S(2,0) + S(0,2),            S(1,2) + S(2,1),            -S(0,0) - S(1,1) + S(2,2);
+    const Eigen::SelfAdjointEigenSolver<Matrix4> solver(N);
+    const Eigen::Matrix<Scalar, 4, 1> q = solver.eigenvectors().col(3); // eigenvalues are sorted in increasing order
+    return RotationQuaternion<Scalar>(q(0), q(1), q(2), q(3)).getUnique();
+  }
+
+  /*! \brief Solves for the rigid transformation (Kabsch/Umeyama without scale).
+   *  \returns the transformation (t, R) which minimizes sum_i w_i*|q_i - (R*p_i + t)|^2
+   */
+  HomTransformQuat<Scalar> getTransformation() const {
+    Scalar scale;
+    const Matrix3 R = getRotationMatrixAndScale(scale);
+    return HomTransformQuat<Scalar>(Position<Scalar, 3>(Vector3(targetCentroid_ - R*sourceCentroid_)),
+                                    RotationQuaternion<Scalar>(RotationMatrix<Scalar>(R)));
+  }
+
+  /*! \brief Solves for the similarity transformation (Umeyama).
+   *  \param scale   returns the scale s
+   *  \returns the transformation (t, R) which, together with the scale s, minimizes sum_i w_i*|q_i - (s*R*p_i + t)|^2
+   */
+  HomTransformQuat<Scalar> getSimilarityTransformation(Scalar& scale) const {
+    const Matrix3 R = getRotationMatrixAndScale(scale);
+    return HomTransformQuat<Scalar>(Position<Scalar, 3>(Vector3(targetCentroid_ - scale*R*sourceCentroid_)),
+                                    RotationQuaternion<Scalar>(RotationMatrix<Scalar>(R)));
+  }
+
+ private:
+  AlignmentAccumulator& merge(Scalar weight, const Vector3& sourceCentroid, const Vector3& targetCentroid, const Matrix3& crossCovariance, Scalar sourceVariance) {
+    if (weight <= Scalar(0)) {
+      return *this;
+    }
+    const Scalar totalWeight = weight_ + weight;
+    const Vector3 sourceDelta = sourceCentroid - sourceCentroid_;
+    const Vector3 targetDelta = targetCentroid - targetCentroid_;
+    const Scalar factor = weight_*weight/totalWeight;
+    crossCovariance_ += crossCovariance + factor*targetDelta*sourceDelta.transpose();
+    sourceVariance_ += sourceVariance + factor*sourceDelta.squaredNorm();
+    sourceCentroid_ += (weight/totalWeight)*sourceDelta;
+    targetCentroid_ += (weight/totalWeight)*targetDelta;
+    weight_ = totalWeight;
+    return *this;
+  }
+
+  //! Kabsch/Umeyama: R = U*diag(1,1,det(U*V^T))*V^T and s = trace(diag(sigma)*diag(1,1,d))/var(p)
+  Matrix3 getRotationMatrixAndScale(Scalar& scale) const {
+    if (weight_ <= Scalar(0)) {
+      scale = Scalar(1);
+      return Matrix3::Identity();
+    }
+    const Eigen::JacobiSVD<Matrix3> svd(crossCovariance_, Eigen::ComputeFullU | Eigen::ComputeFullV);
+    Vector3 d = Vector3::Ones();
+    if ((svd.matrixU()*svd.matrixV().transpose()).determinant() < Scalar(0)) {
+      d(2) = Scalar(-1);
+    }
+    scale = (sourceVariance_ > Scalar(0)) ? svd.singularValues().dot(d)/sourceVariance_ : Scalar(1);
+    return svd.matrixU()*d.asDiagonal()*svd.matrixV().transpose();
+  }
+
+  Scalar weight_;
+  Vector3 sourceCentroid_;
+  Vector3 targetCentroid_;
+  Matrix3 crossCovariance_;
+  Scalar sourceVariance_;
+};
+
+typedef AlignmentAccumulator<double> AlignmentAccumulatorD;
+typedef AlignmentAccumulator<float> AlignmentAccumulatorF;
+
+
+/*! \brief Returns the rotation which aligns the source points with the target points (Kabsch).
+ *  \param sources   3xN matrix of source points p
+ *  \param targets   3xN matrix of target points q
+ *  \returns the rotation R which minimizes sum_i |(q_i - q_mean) - R*(p_i - p_mean)|^2
+ */
+template<typename PrimType_>
+inline RotationQuaternion<PrimType_> getRotationFromCorrespondences(const Eigen::Matrix<PrimType_, 3, Eigen::Dynamic>& sources, const Eigen::Matrix<PrimType_, 3, Eigen::Dynamic>& targets) {
+  return AlignmentAccumulator<PrimType_>().add(sources, targets).getRotation();
+}
+
+/*! \brief Returns the rigid transformation which aligns the source points with the target points.
+ *  \param sources   3xN matrix of source points p
+ *  \param targets   3xN matrix of target points q
+ *  \returns the transformation (t, R) which minimizes sum_i |q_i - (R*p_i + t)|^2
+ */
+template<typename PrimType_>
+inline HomTransformQuat<PrimType_> getTransformationFromCorrespondences(const Eigen::Matrix<PrimType_, 3, Eigen::Dynamic>& sources, const Eigen::Matrix<PrimType_, 3, Eigen::Dynamic>& targets) {
+  return AlignmentAccumulator<PrimType_>().add(sources, targets).getTransformation();
+}
+
+} // namespace kindr
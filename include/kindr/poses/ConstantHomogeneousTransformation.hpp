@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <utility>
+
+#include "kindr/rotations/ConstantRotation.hpp"
+#include "kindr/poses/HomogeneousTransformation.hpp"
+
+namespace kindr {
+
+/*! \class ConstantHomogeneousTransformation
+ *  \brief Homogeneous transformation which can be used in constant expressions.
+ *
+ *  Chains of fixed transformations (e.g. sensor mounting transforms) can be concatenated at compile time:
+ *  \code{.cpp}
+ *  constexpr ConstantHomTransformQuatD T_BI(ConstantPositionD(0.1, 0.0, 0.2), ConstantRotationQuaternionD(0.0, 0.0, 0.0, 1.0));
+ *  constexpr ConstantHomTransformQuatD T_IC(ConstantPositionD(0.0, 0.05, 0.0), ConstantRotationQuaternionD());
+ *  constexpr ConstantHomTransformQuatD T_BC = T_BI*T_IC;
+ *  const HomTransformQuatD pose = T_BC.toTransformation();
+ *  \endcode
+ *
+ *  \tparam PrimType_ the primitive type of the data (double or float)
+ *  \tparam Rotation_ the constant rotation type (ConstantRotationQuaternion or ConstantRotationMatrix)
+ *
+ *  \ingroup poses
+ */
+template<typename PrimType_, typename Rotation_>
+class ConstantHomogeneousTransformation {
+ private:
+  ConstantPosition<PrimType_> position_;
+  Rotation_ rotation_;
+ public:
+  typedef PrimType_ Scalar;
+  typedef ConstantPosition<PrimType_> Position;
+  typedef Rotation_ Rotation;
+
+  /*! \brief Default constructor using identity transformation.
+   */
+  constexpr ConstantHomogeneousTransformation()
+    : position_(), rotation_() {
+  }
+
+  constexpr ConstantHomogeneousTransformation(const Position& position, const Rotation& rotation)
+    : position_(position), rotation_(rotation) {
+  }
+
+  constexpr const Position& getPosition() const {
+    return position_;
+  }
+
+  constexpr const Rotation& getRotation() const {
+    return rotation_;
+  }
+
+  /*! \brief Concatenates two transformations.
+   */
+  constexpr ConstantHomogeneousTransformation operator *(const ConstantHomogeneousTransformation& other) const {
+    return ConstantHomogeneousTransformation(position_ + rotation_.rotate(other.position_), rotation_*other.rotation_);
+  }
+
+  /*! \brief Returns the inverse of the transformation.
+   */
+  constexpr ConstantHomogeneousTransformation inverted() const {
+    return ConstantHomogeneousTransformation(-rotation_.inverseRotate(position_), rotation_.inverted());
+  }
+
+  /*! \brief Transforms a position.
+   */
+  constexpr Position transform(const Position& position) const {
+    return rotation_.rotate(position) + position_;
+  }
+
+  /*! \brief Transforms a position in the inverse direction.
+   */
+  constexpr Position inverseTransform(const Position& position) const {
+    return rotation_.inverseRotate(position - position_);
+  }
+
+  /*! \brief Converts to a homogeneous transformation (not constexpr).
+   */
+  HomogeneousTransformation<Scalar, kindr::Position<Scalar, 3>, decltype(std::declval<Rotation_>().toRotation())> toTransformation() const {
+    return HomogeneousTransformation<Scalar, kindr::Position<Scalar, 3>, decltype(std::declval<Rotation_>().toRotation())>(
+        position_.toPosition(), rotation_.toRotation());
+  }
+};
+
+template <typename PrimType_>
+using ConstantHomTransformQuat = ConstantHomogeneousTransformation<PrimType_, ConstantRotationQuaternion<PrimType_>>;
+typedef ConstantHomTransformQuat<double> ConstantHomTransformQuatD;
+typedef ConstantHomTransformQuat<float> ConstantHomTransformQuatF;
+
+template <typename PrimType_>
+using ConstantHomTransformMatrix = ConstantHomogeneousTransformation<PrimType_, ConstantRotationMatrix<PrimType_>>;
+typedef ConstantHomTransformMatrix<double> ConstantHomTransformMatrixD;
+typedef ConstantHomTransformMatrix<float> ConstantHomTransformMatrixF;
+
+} // namespace kindr
@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <Eigen/Core>
+
+#include "kindr/common/common.hpp"
+#include "kindr/math/LinearAlgebra.hpp"
+#include "kindr/rotations/Rotation.hpp"
+#include "kindr/poses/PoseBase.hpp"
+
+namespace kindr {
+
+/*
+ * The covariance helpers read the upper triangle of the covariance only, compute the upper triangle of the
+ * result and mirror it into the lower triangle. The in-place variants do not need a temporary of the full
+ * covariance, and none of them allocates for fixed-size matrices.
+ */
+
+namespace internal {
+
+/*! \brief Copies the upper triangle of a square matrix into its lower triangle.
+ *  (only for advanced users)
+ */
+template<typename Derived_>
+inline void copyUpperToLowerTriangle(Eigen::MatrixBase<Derived_>& matrix) {
+  for (Eigen::DenseIndex col = 0; col < matrix.cols(); ++col) {
+    for (Eigen::DenseIndex row = col + 1; row < matrix.rows(); ++row) {
+      matrix(row, col) = matrix(col, row);
+    }
+  }
+}
+
+/*! \brief Computes the upper triangle of the 3x3 block M*R^T with M = R*P.
+ *  (only for advanced users)
+ */
+template<typename PrimType_, typename Block_>
+inline void setUpperTriangleOfRotatedBlock(const Eigen::Matrix<PrimType_, 3, 3>& rotatedFromLeft, const Eigen::Matrix<PrimType_, 3, 3>& rotationMatrix, Block_ block) {
+  block.template triangularView<Eigen::Upper>() = rotatedFromLeft.lazyProduct(rotationMatrix.transpose());
+}
+
+/*! \brief Rotates a 3Nx3N covariance by the block-diagonal matrix diag(R, ..., R).
+ *  (only for advanced users)
+ */
+template<typename PrimType_, typename Derived_>
+inline void rotateCovarianceBlocks(const Eigen::Matrix<PrimType_, 3, 3>& rotationMatrix, Eigen::MatrixBase<Derived_>& covariance) {
+  typedef Eigen::Matrix<PrimType_, 3, 3> Matrix3;
+  KINDR_ASSERT_TRUE(std::runtime_error, covariance.rows() == covariance.cols() && covariance.rows() % 3 == 0, "The covariance must be a square matrix of 3x3 blocks!");
+  const Eigen::DenseIndex numberOfBlocks = covariance.rows()/3;
+  for (Eigen::DenseIndex i = 0; i < numberOfBlocks; ++i) {
+    // diagonal block R*P_ii*R^T
+    const Matrix3 diagonalBlock = covariance.template block<3,3>(3*i, 3*i).template selfadjointView<Eigen::Upper>();
+    setUpperTriangleOfRotatedBlock<PrimType_>(rotationMatrix.lazyProduct(diagonalBlock), rotationMatrix, covariance.template block<3,3>(3*i, 3*i));
+    // off-diagonal blocks R*P_ij*R^T of the upper triangle
+    for (Eigen::DenseIndex j = i + 1; j < numberOfBlocks; ++j) {
+      const Matrix3 rotatedFromLeft = rotationMatrix.lazyProduct(covariance.template block<3,3>(3*i, 3*j));
+      covariance.template block<3,3>(3*i, 3*j).noalias() = rotatedFromLeft.lazyProduct(rotationMatrix.transpose());
+    }
+  }
+  copyUpperToLowerTriangle(covariance);
+}
+
+/*! \brief Transports a 6x6 twist covariance by a pure translation in place, i.e. P <- T*P*T^T with T = [I [p]x; 0 I].
+ *  The full covariance is read, i.e. its lower triangle must be set.
+ *  (only for advanced users)
+ */
+template<typename PrimType_, typename Derived_>
+inline void translateTwistCovariance(const Eigen::Matrix<PrimType_, 3, 1>& position, Eigen::MatrixBase<Derived_>& covariance) {
+  typedef Eigen::Matrix<PrimType_, 3, 3> Matrix3;
+  const Matrix3 angularBlock = covariance.template bottomRightCorner<3,3>();
+  const Matrix3 mixedBlock = covariance.template topRightCorner<3,3>();
+  // [p]x*B^T
+  const Matrix3 skewTimesMixedBlock = skewTimes(position, mixedBlock.transpose());
+  covariance.template topLeftCorner<3,3>() += skewTimesMixedBlock + skewTimesMixedBlock.transpose() + skewTimesTimesSkewTranspose(position, angularBlock);
+  covariance.template topRightCorner<3,3>() += skewTimes(position, angularBlock);
+  covariance.template bottomLeftCorner<3,3>() = covariance.template topRightCorner<3,3>().transpose();
+}
+
+} // namespace internal
+
+
+/*! \brief Rotates a covariance in place, i.e. P <- R*P*R^T.
+ *  The covariance is either 3x3 or consists of 3x3 blocks, e.g. a 6x6 twist covariance, which are all rotated.
+ *  \param rotation    any kindr rotation
+ *  \param covariance  symmetric matrix, of which only the upper triangle is read
+ */
+template<typename Rotation_, typename Derived_>
+inline void rotateCovarianceInPlace(const RotationBase<Rotation_>& rotation, Eigen::MatrixBase<Derived_>& covariance) {
+  typedef typename internal::get_scalar<Rotation_>::Scalar Scalar;
+  internal::rotateCovarianceBlocks<Scalar>(RotationMatrix<Scalar>(rotation.derived()).matrix(), covariance);
+}
+
+/*! \brief Rotates a covariance by the inverse rotation in place, i.e. P <- R^T*P*R.
+ *  \param rotation    any kindr rotation
+ *  \param covariance  symmetric matrix, of which only the upper triangle is read
+ */
+template<typename Rotation_, typename Derived_>
+inline void inverseRotateCovarianceInPlace(const RotationBase<Rotation_>& rotation, Eigen::MatrixBase<Derived_>& covariance) {
+  typedef typename internal::get_scalar<Rotation_>::Scalar Scalar;
+  // the inverse of a rotation matrix is its transpose
+  const Eigen::Matrix<Scalar, 3, 3> inverseRotationMatrix = RotationMatrix<Scalar>(rotation.derived()).matrix().transpose();
+  internal::rotateCovarianceBlocks<Scalar>(inverseRotationMatrix, covariance);
+}
+
+/*! \brief Rotates a covariance, i.e. returns R*P*R^T.
+ *  \param rotation    any kindr rotation
+ *  \param covariance  symmetric matrix, of which only the upper triangle is read
+ */
+template<typename Rotation_, typename Derived_>
+inline typename Derived_::PlainObject rotateCovariance(const RotationBase<Rotation_>& rotation, const Eigen::MatrixBase<Derived_>& covariance) {
+  typename Derived_::PlainObject result = covariance;
+  rotateCovarianceInPlace(rotation, result);
+  return result;
+}
+
+/*! \brief Rotates a covariance by the inverse rotation, i.e. returns R^T*P*R.
+ *  \param rotation    any kindr rotation
+ *  \param covariance  symmetric matrix, of which only the upper triangle is read
+ */
+template<typename Rotation_, typename Derived_>
+inline typename Derived_::PlainObject inverseRotateCovariance(const RotationBase<Rotation_>& rotation, const Eigen::MatrixBase<Derived_>& covariance) {
+  typename Derived_::PlainObject result = covariance;
+  inverseRotateCovarianceInPlace(rotation, result);
+  return result;
+}
+
+/*! \brief Propagates a covariance through a linear(ized) map, i.e. computes J*P*J^T, e.g. with the Jacobian of the exponential map.
+ *  \param jacobian    MxN-matrix
+ *  \param covariance  symmetric NxN-matrix, of which only the upper triangle is read
+ *  \param result      symmetric MxM-matrix, which must not alias the covariance
+ */
+template<typename Jacobian_, typename Covariance_, typename Result_>
+inline void propagateCovariance(const Eigen::MatrixBase<Jacobian_>& jacobian, const Eigen::MatrixBase<Covariance_>& covariance, Eigen::MatrixBase<Result_>& result) {
+  typedef Eigen::Matrix<typename Jacobian_::Scalar, Jacobian_::RowsAtCompileTime, Covariance_::ColsAtCompileTime> Product;
+  typedef Eigen::Matrix<typename Covariance_::Scalar, Covariance_::RowsAtCompileTime, Covariance_::ColsAtCompileTime> Covariance;
+  const Covariance symmetricCovariance = covariance.template selfadjointView<Eigen::Upper>();
+  const Product product = jacobian.lazyProduct(symmetricCovariance);
+  result.template triangularView<Eigen::Upper>() = product.lazyProduct(jacobian.transpose());
+  internal::copyUpperToLowerTriangle(result);
+}
+
+/*! \brief Propagates a covariance through a linear(ized) map, i.e. returns J*P*J^T.
+ *  \param jacobian    MxN-matrix
+ *  \param covariance  symmetric NxN-matrix, of which only the upper triangle is read
+ */
+template<typename Jacobian_, typename Covariance_>
+inline Eigen::Matrix<typename Jacobian_::Scalar, Jacobian_::RowsAtCompileTime, Jacobian_::RowsAtCompileTime> propagateCovariance(const Eigen::MatrixBase<Jacobian_>& jacobian, const Eigen::MatrixBase<Covariance_>& covariance) {
+  Eigen::Matrix<typename Jacobian_::Scalar, Jacobian_::RowsAtCompileTime, Jacobian_::RowsAtCompileTime> result(jacobian.rows(), jacobian.rows());
+  propagateCovariance(jacobian, covariance, result);
+  return result;
+}
+
+/*! \brief Transports a 6x6 twist covariance between frames in place, i.e. P <- Ad*P*Ad^T.
+ *
+ *  The twist is ordered as [linear velocity; angular velocity] like Twist::getVector(), and the adjoint of the
+ *  pose (R, p) is Ad = [R [p]x*R; 0 R]. The blocks are computed from the rotated blocks with the fused skew
+ *  products, i.e. neither the adjoint nor the skew-symmetric matrix are formed.
+ *  \param pose        any kindr pose
+ *  \param covariance  symmetric 6x6-matrix, of which only the upper triangle is read
+ */
+template<typename Pose_, typename Derived_>
+inline void transformCovarianceInPlace(const PoseBase<Pose_>& pose, Eigen::MatrixBase<Derived_>& covariance) {
+  KINDR_ASSERT_TRUE(std::runtime_error, covariance.rows() == 6 && covariance.cols() == 6, "The covariance must be a 6x6 matrix!");
+  rotateCovarianceInPlace(pose.derived().getRotation(), covariance);
+  const Eigen::Matrix<typename Derived_::Scalar, 3, 1> position = pose.derived().getPosition().toImplementation();
+  internal::translateTwistCovariance(position, covariance);
+}
+
+/*! \brief Transports a 6x6 twist covariance between frames, i.e. returns Ad*P*Ad^T.
+ *  \param pose        any kindr pose
+ *  \param covariance  symmetric 6x6-matrix, of which only the upper triangle is read
+ */
+template<typename Pose_, typename Derived_>
+inline typename Derived_::PlainObject transformCovariance(const PoseBase<Pose_>& pose, const Eigen::MatrixBase<Derived_>& covariance) {
+  typename Derived_::PlainObject result = covariance;
+  transformCovarianceInPlace(pose, result);
+  return result;
+}
+
+/*! \brief Transports a 6x6 twist covariance by the inverse pose in place, i.e. P <- Ad^-1*P*Ad^-T.
+ *
+ *  The inverse adjoint Ad^-1 = [R^T -R^T*[p]x; 0 R^T] is applied as the translation by -p followed by the
+ *  inverse rotation, i.e. the pose is not inverted.
+ *  \param pose        any kindr pose
+ *  \param covariance  symmetric 6x6-matrix, of which only the upper triangle is read
+ */
+template<typename Pose_, typename Derived_>
+inline void inverseTransformCovarianceInPlace(const PoseBase<Pose_>& pose, Eigen::MatrixBase<Derived_>& covariance) {
+  KINDR_ASSERT_TRUE(std::runtime_error, covariance.rows() == 6 && covariance.cols() == 6, "The covariance must be a 6x6 matrix!");
+  internal::copyUpperToLowerTriangle(covariance);
+  const Eigen::Matrix<typename Derived_::Scalar, 3, 1> position = -pose.derived().getPosition().toImplementation();
+  internal::translateTwistCovariance(position, covariance);
+  inverseRotateCovarianceInPlace(pose.derived().getRotation(), covariance);
+}
+
+/*! \brief Transports a 6x6 twist covariance by the inverse pose, i.e. returns Ad^-1*P*Ad^-T.
+ *  \param pose        any kindr pose
+ *  \param covariance  symmetric 6x6-matrix, of which only the upper triangle is read
+ */
+template<typename Pose_, typename Derived_>
+inline typename Derived_::PlainObject inverseTransformCovariance(const PoseBase<Pose_>& pose, const Eigen::MatrixBase<Derived_>& covariance) {
+  typename Derived_::PlainObject result = covariance;
+  inverseTransformCovarianceInPlace(pose, result);
+  return result;
+}
+
+} // namespace kindr
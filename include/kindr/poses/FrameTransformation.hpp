@@ -0,0 +1,312 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <type_traits>
+
+#include "kindr/rotations/Rotation.hpp"
+#include "kindr/poses/HomogeneousTransformation.hpp"
+
+namespace kindr {
+
+template<typename ToFrame_, typename FromFrame_, typename Transformation_>
+class FrameTransformation;
+
+template<typename Left_, typename Right_>
+class FrameTransformationChain;
+
+namespace internal {
+
+/*! \class is_frame_expression
+ *  \brief Is true for frame transformations and chains of frame transformations.
+ */
+template<typename Type_>
+class is_frame_expression : public std::false_type {};
+
+template<typename ToFrame_, typename FromFrame_, typename Transformation_>
+class is_frame_expression<FrameTransformation<ToFrame_, FromFrame_, Transformation_>> : public std::true_type {};
+
+template<typename Left_, typename Right_>
+class is_frame_expression<FrameTransformationChain<Left_, Right_>> : public std::true_type {};
+
+/*! \class get_frame_expression_storage
+ *  \brief Frame transformations are stored by reference in a chain, sub-chains by value.
+ */
+template<typename Expression_>
+class get_frame_expression_storage {
+ public:
+  typedef Expression_ Storage;
+};
+
+template<typename ToFrame_, typename FromFrame_, typename Transformation_>
+class get_frame_expression_storage<FrameTransformation<ToFrame_, FromFrame_, Transformation_>> {
+ public:
+  typedef const FrameTransformation<ToFrame_, FromFrame_, Transformation_>& Storage;
+};
+
+/*! \class FrameTransformationTraits
+ *  \brief Applies, concatenates and inverts the wrapped rotations and poses.
+ *
+ *  The default implementation is used for rotations.
+ */
+template<typename Transformation_>
+class FrameTransformationTraits {
+ public:
+  template<typename Vector_>
+  inline static Vector_ apply(const Transformation_& rotation, const Vector_& vector) {
+    return rotation.rotate(vector);
+  }
+
+  template<typename Other_>
+  inline static void concatenate(Transformation_& result, const Other_& other) {
+    result = result*other;
+  }
+
+  inline static Transformation_ invert(const Transformation_& rotation) {
+    return rotation.inverted();
+  }
+};
+
+template<typename PrimType_, typename Position_, typename Rotation_>
+class FrameTransformationTraits<HomogeneousTransformation<PrimType_, Position_, Rotation_>> {
+ public:
+  typedef HomogeneousTransformation<PrimType_, Position_, Rotation_> Pose;
+
+  template<typename Vector_>
+  inline static Vector_ apply(const Pose& pose, const Vector_& vector) {
+    return pose.transform(vector);
+  }
+
+  //! Updates the result in place instead of creating a temporary pose
+  template<typename Other_>
+  inline static void concatenate(Pose& result, const Other_& other) {
+    result.getPosition() += result.getRotation().rotate(Position_(other.getPosition()));
+    result.getRotation() = result.getRotation()*other.getRotation();
+  }
+
+  inline static Pose invert(const Pose& pose) {
+    return pose.inverted();
+  }
+};
+
+} // namespace internal
+
+
+/*! \class FrameTransformation
+ *  \brief Rotation or pose which is tagged with the frames it transforms between.
+ *
+ *  FrameTransformation<World, Base, Transformation> (T_WB) maps coordinates expressed in the frame Base
+ *  to coordinates expressed in the frame World. The frames are arbitrary (empty) types, they only exist at compile time
+ *  and the wrapper has the same size and run time as the wrapped type.
+ *
+ *  The product T_WB*T_BC only compiles if the frames match and yields a lazy FrameTransformationChain T_WC.
+ *  The chain is evaluated once if it is assigned to a FrameTransformation, or applied to a position right to left without
+ *  computing the intermediate poses.
+ *  \code{.cpp}
+ *  struct World {}; struct Base {}; struct Camera {};
+ *  FrameHomTransformQuatD<World, Base> T_WB(...);
+ *  FrameHomTransformQuatD<Base, Camera> T_BC(...);
+ *  FrameHomTransformQuatD<World, Camera> T_WC = T_WB*T_BC;
+ *  // FrameHomTransformQuatD<World, Camera> T_error = T_BC*T_WB; // does not compile
+ *  \endcode
+ *
+ *  \tparam ToFrame_         the frame of the transformed coordinates
+ *  \tparam FromFrame_       the frame of the coordinates which are transformed
+ *  \tparam Transformation_  the rotation or pose (e.g. RotationQuaternionD or HomTransformQuatD)
+ *
+ *  \ingroup poses
+ */
+template<typename ToFrame_, typename FromFrame_, typename Transformation_>
+class FrameTransformation {
+ private:
+  Transformation_ transformation_;
+ public:
+  typedef ToFrame_ ToFrame;
+  typedef FromFrame_ FromFrame;
+  typedef Transformation_ Transformation;
+  //! The type an expression is evaluated to
+  typedef Transformation_ Result;
+
+  /*! \brief Default constructor using the identity.
+   */
+  FrameTransformation()
+    : transformation_() {
+  }
+
+  /*! \brief Constructor tagging a rotation or pose with frames.
+   */
+  explicit FrameTransformation(const Transformation_& transformation)
+    : transformation_(transformation) {
+  }
+
+  /*! \brief Constructor evaluating a chain of frame transformations.
+   */
+  template<typename Left_, typename Right_>
+  FrameTransformation(const FrameTransformationChain<Left_, Right_>& chain)
+    : transformation_(chain.evaluate()) {
+    static_assert(std::is_same<ToFrame_, typename FrameTransformationChain<Left_, Right_>::ToFrame>::value, "FrameTransformation: the frames do not match (ToFrame).");
+    static_assert(std::is_same<FromFrame_, typename FrameTransformationChain<Left_, Right_>::FromFrame>::value, "FrameTransformation: the frames do not match (FromFrame).");
+  }
+
+  /*! \brief Assignment operator evaluating a chain of frame transformations.
+   */
+  template<typename Left_, typename Right_>
+  FrameTransformation& operator =(const FrameTransformationChain<Left_, Right_>& chain) {
+    static_assert(std::is_same<ToFrame_, typename FrameTransformationChain<Left_, Right_>::ToFrame>::value, "FrameTransformation: the frames do not match (ToFrame).");
+    static_assert(std::is_same<FromFrame_, typename FrameTransformationChain<Left_, Right_>::FromFrame>::value, "FrameTransformation: the frames do not match (FromFrame).");
+    transformation_ = chain.evaluate();
+    return *this;
+  }
+
+  inline Transformation_& getTransformation() {
+    return transformation_;
+  }
+
+  inline const Transformation_& getTransformation() const {
+    return transformation_;
+  }
+
+  /*! \brief Returns the inverse transformation, i.e. the frames are swapped.
+   */
+  FrameTransformation<FromFrame_, ToFrame_, Transformation_> inverted() const {
+    return FrameTransformation<FromFrame_, ToFrame_, Transformation_>(internal::FrameTransformationTraits<Transformation_>::invert(transformation_));
+  }
+
+  /*! \brief Transforms a position expressed in FromFrame to ToFrame.
+   */
+  template<typename Vector_>
+  Vector_ transform(const Vector_& vector) const {
+    return internal::FrameTransformationTraits<Transformation_>::apply(transformation_, vector);
+  }
+
+  /*! \brief Evaluates the transformation (only for chains).
+   */
+  inline const Transformation_& evaluate() const {
+    return transformation_;
+  }
+
+  /*! \brief Initializes the result of a chain with this transformation.
+   */
+  template<typename Result_>
+  inline void initialize(Result_& result) const {
+    result = Result_(transformation_);
+  }
+
+  /*! \brief Concatenates this transformation to the result of a chain.
+   */
+  template<typename Result_>
+  inline void concatenateTo(Result_& result) const {
+    internal::FrameTransformationTraits<Result_>::concatenate(result, transformation_);
+  }
+};
+
+
+/*! \class FrameTransformationChain
+ *  \brief Lazy product of frame transformations.
+ *
+ *  The chain stores references to the frame transformations and is evaluated once, either by assigning it to a
+ *  FrameTransformation or by calling evaluate(). The result has the type of the leftmost transformation
+ *  and every other transformation is converted at most once. A chain must not outlive the transformations it refers to.
+ *
+ *  \ingroup poses
+ */
+template<typename Left_, typename Right_>
+class FrameTransformationChain {
+ private:
+  typename internal::get_frame_expression_storage<Left_>::Storage left_;
+  typename internal::get_frame_expression_storage<Right_>::Storage right_;
+ public:
+  typedef typename Left_::ToFrame ToFrame;
+  typedef typename Right_::FromFrame FromFrame;
+  typedef typename Left_::Result Result;
+
+  FrameTransformationChain(const Left_& left, const Right_& right)
+    : left_(left), right_(right) {
+    static_assert(std::is_same<typename Left_::FromFrame, typename Right_::ToFrame>::value, "FrameTransformationChain: the frames do not match.");
+  }
+
+  /*! \brief Evaluates the chain.
+   */
+  Result evaluate() const {
+    Result result;
+    initialize(result);
+    return result;
+  }
+
+  /*! \brief Transforms a position expressed in FromFrame to ToFrame.
+   *  The transformations are applied right to left, i.e. no intermediate pose is computed.
+   */
+  template<typename Vector_>
+  Vector_ transform(const Vector_& vector) const {
+    return left_.transform(right_.transform(vector));
+  }
+
+  template<typename Result_>
+  inline void initialize(Result_& result) const {
+    left_.initialize(result);
+    right_.concatenateTo(result);
+  }
+
+  template<typename Result_>
+  inline void concatenateTo(Result_& result) const {
+    left_.concatenateTo(result);
+    right_.concatenateTo(result);
+  }
+};
+
+/*! \brief Concatenates two frame transformations.
+ *  Only compiles if the FromFrame of the left transformation is the ToFrame of the right transformation.
+ *  \returns lazy chain of the transformations
+ */
+template<typename Left_, typename Right_>
+inline typename std::enable_if<internal::is_frame_expression<Left_>::value && internal::is_frame_expression<Right_>::value, FrameTransformationChain<Left_, Right_>>::type
+operator *(const Left_& left, const Right_& right) {
+  return FrameTransformationChain<Left_, Right_>(left, right);
+}
+
+
+template<typename ToFrame_, typename FromFrame_>
+using FrameRotationQuaternionD = FrameTransformation<ToFrame_, FromFrame_, RotationQuaternionD>;
+template<typename ToFrame_, typename FromFrame_>
+using FrameRotationQuaternionF = FrameTransformation<ToFrame_, FromFrame_, RotationQuaternionF>;
+template<typename ToFrame_, typename FromFrame_>
+using FrameRotationMatrixD = FrameTransformation<ToFrame_, FromFrame_, RotationMatrixD>;
+template<typename ToFrame_, typename FromFrame_>
+using FrameRotationMatrixF = FrameTransformation<ToFrame_, FromFrame_, RotationMatrixF>;
+
+template<typename ToFrame_, typename FromFrame_>
+using FrameHomTransformQuatD = FrameTransformation<ToFrame_, FromFrame_, HomTransformQuatD>;
+template<typename ToFrame_, typename FromFrame_>
+using FrameHomTransformQuatF = FrameTransformation<ToFrame_, FromFrame_, HomTransformQuatF>;
+template<typename ToFrame_, typename FromFrame_>
+using FrameHomTransformMatrixD = FrameTransformation<ToFrame_, FromFrame_, HomTransformMatrixD>;
+template<typename ToFrame_, typename FromFrame_>
+using FrameHomTransformMatrixF = FrameTransformation<ToFrame_, FromFrame_, HomTransformMatrixF>;
+
+} // namespace kindr
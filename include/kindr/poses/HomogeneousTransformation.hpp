@@ -101,6 +101,21 @@ class HomogeneousTransformation : public PoseBase<HomogeneousTransformation<Prim
    */
   using PoseBase<HomogeneousTransformation<PrimType_, Position_, Rotation_> >::operator*;
 
+  /*! \brief Returns the inverse of the transformation.
+   *  \returns the inverse of the transformation
+   */
+  HomogeneousTransformation inverted() const {
+    return HomogeneousTransformation(-Position(rotation_.inverseRotate(position_)), rotation_.inverted());
+  }
+
+  /*! \brief Inverts the transformation.
+   *  \returns reference
+   */
+  HomogeneousTransformation& invert() {
+    *this = inverted();
+    return *this;
+  }
+
   inline TransformationMatrix getTransformationMatrix() const {
     TransformationMatrix mat = TransformationMatrix::Zero();
     mat.template topLeftCorner<3,3>() =  RotationMatrix<Scalar>(getRotation()).toImplementation();
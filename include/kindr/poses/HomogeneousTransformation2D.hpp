@@ -0,0 +1,323 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <cmath>
+
+#include <Eigen/Core>
+
+#include "kindr/common/common.hpp"
+#include "kindr/phys_quant/PhysicalQuantities.hpp"
+#include "kindr/rotations/Rotation2D.hpp"
+#include "kindr/poses/PoseBase.hpp"
+#include "kindr/poses/HomogeneousTransformation.hpp"
+
+namespace kindr {
+
+namespace internal {
+
+/*! \brief Returns 1-cos(angle) without cancellation for small angles.
+ *  (only for advanced users)
+ */
+template<typename PrimType_>
+inline PrimType_ getOneMinusCos(PrimType_ sinAngle, PrimType_ cosAngle) {
+  return (cosAngle > PrimType_(0)) ? sinAngle*sinAngle/(PrimType_(1) + cosAngle) : PrimType_(1) - cosAngle;
+}
+
+/*! \brief Returns the matrix V(angle) of the exponential map of SE(2), i.e. exp([v; angle]) = (V(angle)*v, R(angle)).
+ *  (only for advanced users)
+ */
+template<typename PrimType_>
+inline Eigen::Matrix<PrimType_, 2, 2> getSE2LeftJacobian(PrimType_ angle, PrimType_ sinAngle, PrimType_ cosAngle) {
+  using std::abs;
+  PrimType_ a, b;
+  if (abs(angle) < internal::NumTraits<PrimType_>::dummy_precision()) {
+    // Taylor expansion
+    a = PrimType_(1) - angle*angle/PrimType_(6);
+    b = PrimType_(0.5)*angle;
+  } else {
+    a = sinAngle/angle;
+    b = getOneMinusCos(sinAngle, cosAngle)/angle;
+  }
+  Eigen::Matrix<PrimType_, 2, 2> V;
+  V << a, -b,
+       b, a;
+  return V;
+}
+
+/*! \brief Returns the inverse of getSE2LeftJacobian().
+ *  (only for advanced users)
+ */
+template<typename PrimType_>
+inline Eigen::Matrix<PrimType_, 2, 2> getSE2LeftJacobianInverse(PrimType_ angle, PrimType_ sinAngle, PrimType_ cosAngle) {
+  using std::abs;
+  const PrimType_ b = PrimType_(0.5)*angle;
+  PrimType_ a;
+  if (abs(angle) < internal::NumTraits<PrimType_>::dummy_precision()) {
+    // Taylor expansion of angle/2*cot(angle/2)
+    a = PrimType_(1) - angle*angle/PrimType_(12);
+  } else {
+    a = b*sinAngle/getOneMinusCos(sinAngle, cosAngle);
+  }
+  Eigen::Matrix<PrimType_, 2, 2> Vinv;
+  Vinv << a, b,
+          -b, a;
+  return Vinv;
+}
+
+} // namespace internal
+
+
+/*! \class HomogeneousTransformation2D
+ *  \brief Planar pose (SE(2)) consisting of a 2D position and a rotation about the z-axis.
+ *
+ *  The tangent space is parameterized by the vector [v_x, v_y, omega]', which has the same layout as
+ *  Twist2D::getVector(). The box operators follow the convention of the 3D rotations, i.e.
+ *  T.boxPlus(v) = exp(v)*T and T.boxMinus(S) = log(T*S^-1).
+ *
+ *  The following typedefs are provided for convenience:
+ *   - \ref kindr::HomTransform2D "HomTransform2D" for primitive type double
+ *   - \ref kindr::HomTransform2F "HomTransform2F" for primitive type float
+ *
+ *  \tparam PrimType_ the primitive type of the data (double or float)
+ *  \ingroup poses
+ */
+template<typename PrimType_>
+class HomogeneousTransformation2D : public PoseBase<HomogeneousTransformation2D<PrimType_>> {
+ public:
+  typedef PrimType_ Scalar;
+  typedef kindr::Position<PrimType_, 2> Position;
+  typedef Rotation2D<PrimType_> Rotation;
+  typedef Eigen::Matrix<PrimType_, 3, 3> TransformationMatrix;
+  //! Tangent vector [v_x, v_y, omega]'
+  typedef Eigen::Matrix<PrimType_, 3, 1> Vector3;
+  typedef Eigen::Matrix<PrimType_, 2, 1> Vector2;
+  //! 2xN matrix of points
+  template<int Cols_>
+  using Matrix2X = Eigen::Matrix<PrimType_, 2, Cols_>;
+
+  HomogeneousTransformation2D()
+    : position_(Position::Zero()), rotation_() {
+  }
+
+  HomogeneousTransformation2D(const Position& position, const Rotation& rotation)
+    : position_(position), rotation_(rotation) {
+  }
+
+  HomogeneousTransformation2D(Scalar x, Scalar y, Scalar angle)
+    : position_(Vector2(x, y)), rotation_(angle) {
+  }
+
+  /*! \brief Constructor using a 3D transformation, which is projected onto the xy-plane.
+   *  \param other   3D transformation
+   */
+  template<typename OtherPosition_, typename OtherRotation_>
+  explicit HomogeneousTransformation2D(const HomogeneousTransformation<PrimType_, OtherPosition_, OtherRotation_>& other)
+    : position_(Vector2(other.getPosition().toImplementation().template head<2>())), rotation_(other.getRotation()) {
+  }
+
+  inline Position& getPosition() {
+    return position_;
+  }
+
+  inline const Position& getPosition() const {
+    return position_;
+  }
+
+  inline Rotation& getRotation() {
+    return rotation_;
+  }
+
+  inline const Rotation& getRotation() const {
+    return rotation_;
+  }
+
+  /*! \brief Returns the corresponding 3D transformation in the xy-plane.
+   *  \tparam Rotation3_ the type of the 3D rotation
+   */
+  template<typename Rotation3_ = RotationQuaternion<PrimType_>>
+  HomogeneousTransformation<PrimType_, kindr::Position<PrimType_, 3>, Rotation3_> getTransformation3D() const {
+    return HomogeneousTransformation<PrimType_, kindr::Position<PrimType_, 3>, Rotation3_>(
+        kindr::Position<PrimType_, 3>(position_(0), position_(1), Scalar(0)), Rotation3_(rotation_.getRotation3D()));
+  }
+
+  /*! \brief Concenation operator.
+   *  \returns the concenation of two tansformations
+   */
+  using PoseBase<HomogeneousTransformation2D<PrimType_>>::operator*;
+
+  using PoseBase<HomogeneousTransformation2D<PrimType_>>::transform;
+  using PoseBase<HomogeneousTransformation2D<PrimType_>>::inverseTransform;
+
+  /*! \brief Transforms a 2xN matrix of points.
+   *  \returns the transformed points
+   */
+  template<int Cols_>
+  inline Matrix2X<Cols_> transform(const Matrix2X<Cols_>& points) const {
+    Matrix2X<Cols_> result = rotation_.rotate(points);
+    result.colwise() += position_.toImplementation();
+    return result;
+  }
+
+  /*! \brief Transforms a 2xN matrix of points in reverse.
+   *  \returns the transformed points
+   */
+  template<int Cols_>
+  inline Matrix2X<Cols_> inverseTransform(const Matrix2X<Cols_>& points) const {
+    return rotation_.inverseRotate(Matrix2X<Cols_>(points.colwise() - position_.toImplementation()));
+  }
+
+  /*! \brief Returns the inverse of the transformation.
+   *  \returns the inverse of the transformation
+   */
+  HomogeneousTransformation2D inverted() const {
+    return HomogeneousTransformation2D(-rotation_.inverseRotate(position_), rotation_.inverted());
+  }
+
+  /*! \brief Inverts the transformation.
+   *  \returns reference
+   */
+  HomogeneousTransformation2D& invert() {
+    *this = inverted();
+    return *this;
+  }
+
+  inline TransformationMatrix getTransformationMatrix() const {
+    TransformationMatrix mat = TransformationMatrix::Zero();
+    mat.template topLeftCorner<2,2>() = rotation_.getRotationMatrix();
+    mat.template topRightCorner<2,1>() = position_.toImplementation();
+    mat(2,2) = Scalar(1);
+    return mat;
+  }
+
+  /*! \brief Sets the transformation using the exponential map.
+   *  \param vector   tangent vector [v_x, v_y, omega]'
+   *  \returns reference
+   */
+  HomogeneousTransformation2D& exponentialMap(const Vector3& vector) {
+    rotation_.setAngle(vector(2));
+    position_ = Position(internal::getSE2LeftJacobian(vector(2), rotation_.getSinAngle(), rotation_.getCosAngle())*vector.template head<2>());
+    return *this;
+  }
+
+  /*! \returns the logarithmic map [v_x, v_y, omega]' with omega in [-pi,pi]
+   */
+  Vector3 logarithmicMap() const {
+    Vector3 vector;
+    vector(2) = rotation_.angle();
+    vector.template head<2>() = internal::getSE2LeftJacobianInverse(vector(2), rotation_.getSinAngle(), rotation_.getCosAngle())*position_.toImplementation();
+    return vector;
+  }
+
+  /*! \brief Applies a perturbation, i.e. exp(vector)*this.
+   *  \returns the perturbed transformation
+   */
+  HomogeneousTransformation2D boxPlus(const Vector3& vector) const {
+    return HomogeneousTransformation2D().exponentialMap(vector)*(*this);
+  }
+
+  /*! \returns log(this*other^-1)
+   */
+  Vector3 boxMinus(const HomogeneousTransformation2D& other) const {
+    return ((*this)*other.inverted()).logarithmicMap();
+  }
+
+  /*! \brief Interpolates along the geodesic between this transformation (t=0) and another transformation (t=1).
+   *  \returns the interpolated transformation
+   */
+  HomogeneousTransformation2D interpolate(const HomogeneousTransformation2D& other, Scalar t) const {
+    return boxPlus(t*other.boxMinus(*this));
+  }
+
+  /*! \brief Compares two transformations with a tolerance for the position and the angle.
+   *  \returns true if the transformations are similar
+   */
+  bool isNear(const HomogeneousTransformation2D& other, Scalar tol) const {
+    return (position_ - other.position_).norm() < tol && rotation_.isNear(other.rotation_, tol);
+  }
+
+  /*! \brief Sets the transformation to identity
+   *  \returns reference
+   */
+  HomogeneousTransformation2D& setIdentity() {
+    position_.setZero();
+    rotation_.setIdentity();
+    return *this;
+  }
+
+  /*! \brief Used for printing the object with std::cout.
+   *  \returns std::stream object
+   */
+  friend std::ostream& operator << (std::ostream& out, const HomogeneousTransformation2D& pose) {
+    out << pose.getTransformationMatrix();
+    return out;
+  }
+
+ private:
+  Position position_;
+  Rotation rotation_;
+};
+
+typedef HomogeneousTransformation2D<double> HomTransform2D;
+typedef HomogeneousTransformation2D<float> HomTransform2F;
+
+
+namespace internal {
+
+template<typename PrimType_>
+class get_position<HomogeneousTransformation2D<PrimType_>> {
+ public:
+  //! Position
+  typedef kindr::Position<PrimType_, 2> Position;
+};
+
+template<typename PrimType_>
+class TransformationTraits<HomogeneousTransformation2D<PrimType_>> {
+ private:
+  typedef HomogeneousTransformation2D<PrimType_> Pose;
+  typedef typename get_position<Pose>::Position Translation;
+ public:
+  inline static Translation transform(const Pose& pose, const Translation& position) {
+    return pose.getRotation().rotate(position) + pose.getPosition();
+  }
+  inline static Translation inverseTransform(const Pose& pose, const Translation& position) {
+    return pose.getRotation().inverseRotate(position - pose.getPosition());
+  }
+};
+
+template<typename PrimType_>
+class MultiplicationTraits<PoseBase<HomogeneousTransformation2D<PrimType_>>, PoseBase<HomogeneousTransformation2D<PrimType_>>> {
+ public:
+  inline static HomogeneousTransformation2D<PrimType_> mult(const HomogeneousTransformation2D<PrimType_>& lhs, const HomogeneousTransformation2D<PrimType_>& rhs) {
+    return HomogeneousTransformation2D<PrimType_>(lhs.getPosition() + lhs.getRotation().rotate(rhs.getPosition()), lhs.getRotation()*rhs.getRotation());
+  }
+};
+
+} // namespace internal
+} // namespace kindr
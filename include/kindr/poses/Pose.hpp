@@ -29,6 +29,9 @@
 #pragma once
 
 #include "kindr/poses/HomogeneousTransformation.hpp"
+#include "kindr/poses/ConstantHomogeneousTransformation.hpp"
+#include "kindr/poses/FrameTransformation.hpp"
+#include "kindr/poses/HomogeneousTransformation2D.hpp"
 
 namespace kindr {
 
@@ -29,3 +29,4 @@
 #pragma once
 
 #include "kindr/poses/Twist.hpp"
+#include "kindr/poses/Twist2D.hpp"
@@ -0,0 +1,301 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <Eigen/Core>
+
+#include "kindr/common/common.hpp"
+#include "kindr/common/assert_macros.hpp"
+#include "kindr/math/LinearAlgebra.hpp"
+#include "kindr/rotations/Rotation.hpp"
+#include "kindr/rotations/RotationDiff.hpp"
+#include "kindr/rotations/RotationQuaternionChunks.hpp"
+#include "kindr/poses/HomogeneousTransformation.hpp"
+#include "kindr/poses/Twist.hpp"
+
+namespace kindr {
+
+/*
+ * The pose T = (p, R) maps the body frame to the world frame. A twist with local angular velocity is a body twist,
+ * i.e. the linear velocity and the angular velocity are both expressed in the body frame and dT/dt = T*[v; w]^.
+ * A twist with global angular velocity has the linear velocity of the body origin and the angular velocity
+ * expressed in the world frame, i.e. dp/dt = v and dR/dt = [w]x*R.
+ *
+ * The batched functions take the bodies or timesteps in structure-of-arrays form like the batched wrench functions:
+ * the positions and velocities are Nx3 matrices and the rotations are Nx4 matrices of quaternion coefficients
+ * (w, x, y, z). They are vectorized with Eigen arrays over chunks of rows and do not allocate.
+ */
+
+/*! \brief Integrates a pose with a constant body twist by the exponential map of SE(3).
+ *  T(t + dt) = T(t)*exp(dt*[v; w]^) with the rotation exp(dt*w) and the translation J(dt*w)*v*dt, where J is the
+ *  Jacobian of the exponential map of SO(3). The result is exact for a constant twist.
+ *  \param pose       pose at the time t
+ *  \param twist      body twist
+ *  \param timeStep   dt
+ *  \returns the pose at the time t + dt
+ */
+template<typename PrimType_>
+inline HomTransformQuat<PrimType_> integratePose(const HomTransformQuat<PrimType_>& pose, const TwistLinearVelocityLocalAngularVelocity<PrimType_>& twist, PrimType_ timeStep) {
+  typedef Eigen::Matrix<PrimType_, 3, 1> Vector3;
+  const Vector3 rotationVector = timeStep*twist.getRotationalVelocity().toImplementation();
+  const Vector3 translation = getJacobianOfExponentialMap<PrimType_>(rotationVector)*(timeStep*twist.getTranslationalVelocity().toImplementation());
+  return pose*HomTransformQuat<PrimType_>(Position<PrimType_, 3>(translation), RotationQuaternion<PrimType_>().exponentialMap(rotationVector));
+}
+
+/*! \brief Integrates a pose with a constant twist of the body origin with global angular velocity.
+ *  p(t + dt) = p(t) + v*dt and R(t + dt) = exp(dt*w)*R(t), which is exact for a constant twist.
+ *  \param pose       pose at the time t
+ *  \param twist      twist with linear velocity and angular velocity in the world frame
+ *  \param timeStep   dt
+ *  \returns the pose at the time t + dt
+ */
+template<typename PrimType_>
+inline HomTransformQuat<PrimType_> integratePose(const HomTransformQuat<PrimType_>& pose, const TwistLinearVelocityGlobalAngularVelocity<PrimType_>& twist, PrimType_ timeStep) {
+  return HomTransformQuat<PrimType_>(Position<PrimType_, 3>(pose.getPosition().toImplementation() + timeStep*twist.getTranslationalVelocity().toImplementation()),
+                                     pose.getRotation().boxPlus(timeStep*twist.getRotationalVelocity().toImplementation()));
+}
+
+/*! \brief Integrates a pose with a body twist sampled at the midpoint of the time step (second order).
+ *  T(t + dt) = T(t)*exp(dt*[v; w]^(t + dt/2)), i.e. the exponential midpoint rule on SE(3).
+ *  \param pose          pose at the time t
+ *  \param twistMidpoint body twist at the time t + dt/2
+ *  \param timeStep      dt
+ *  \returns the pose at the time t + dt
+ */
+template<typename PrimType_>
+inline HomTransformQuat<PrimType_> integratePoseMidpoint(const HomTransformQuat<PrimType_>& pose, const TwistLinearVelocityLocalAngularVelocity<PrimType_>& twistMidpoint, PrimType_ timeStep) {
+  return integratePose(pose, twistMidpoint, timeStep);
+}
+
+/*! \brief Integrates a pose with a body twist sampled at the start and the end of the time step (second order).
+ *  The pose is integrated exactly with the mean of the samples, i.e. with the trapezoidal rule. See
+ *  integratePoseMidpoint() if the twist at the midpoint is available.
+ *  \returns the pose at the time t + dt
+ */
+template<typename PrimType_>
+inline HomTransformQuat<PrimType_> integratePoseTrapezoidal(const HomTransformQuat<PrimType_>& pose, const TwistLinearVelocityLocalAngularVelocity<PrimType_>& twistStart,
+                                                            const TwistLinearVelocityLocalAngularVelocity<PrimType_>& twistEnd, PrimType_ timeStep) {
+  const TwistLinearVelocityLocalAngularVelocity<PrimType_> twistMean(PrimType_(0.5)*(twistStart.getVector() + twistEnd.getVector()));
+  return integratePose(pose, twistMean, timeStep);
+}
+
+/*! \brief Integrates a pose with a body twist sampled at the start, the midpoint and the end of the time step (fourth order).
+ *  The fourth-order Runge-Kutta scheme on SE(3) is the commutator-free Lie group method with the Runge-Kutta 4 nodes,
+ *  T(t + dt) = T(t)*exp(dt/12*(3*k_s + 4*k_m - k_e))*exp(dt/12*(-k_s + 4*k_m + 3*k_e)) for the samples k_s, k_m and k_e,
+ *  see Celledoni et al., "Commutator-free Lie group methods". It stays on SE(3) and avoids the commutators of the
+ *  Magnus expansion.
+ *  \returns the pose at the time t + dt
+ */
+template<typename PrimType_>
+inline HomTransformQuat<PrimType_> integratePoseRungeKutta4(const HomTransformQuat<PrimType_>& pose, const TwistLinearVelocityLocalAngularVelocity<PrimType_>& twistStart,
+                                                            const TwistLinearVelocityLocalAngularVelocity<PrimType_>& twistMidpoint,
+                                                            const TwistLinearVelocityLocalAngularVelocity<PrimType_>& twistEnd, PrimType_ timeStep) {
+  typedef TwistLinearVelocityLocalAngularVelocity<PrimType_> Twist;
+  const typename Twist::Vector6 start = twistStart.getVector();
+  const typename Twist::Vector6 midpoint = twistMidpoint.getVector();
+  const typename Twist::Vector6 end = twistEnd.getVector();
+  const Twist first((PrimType_(3)*start + PrimType_(4)*midpoint - end)/PrimType_(12));
+  const Twist second((-start + PrimType_(4)*midpoint + PrimType_(3)*end)/PrimType_(12));
+  return integratePose(integratePose(pose, first, timeStep), second, timeStep);
+}
+
+
+namespace internal {
+
+//! Number of rows processed at once by the batched pose integration
+static constexpr int PoseIntegrationChunkSize = 32;
+
+/*! \brief Exponential map of SE(3) for chunks of constant body twists.
+ *  Computes the quaternion q = exp(dt*w) and the translation J(dt*w)*v*dt of every row.
+ *  (only for advanced users)
+ */
+template<typename Chunk_>
+inline void getExponentialOfBodyTwists(const Chunk_& vx, const Chunk_& vy, const Chunk_& vz,
+                                       const Chunk_& wx, const Chunk_& wy, const Chunk_& wz, typename Chunk_::Scalar timeStep,
+                                       Chunk_& qw, Chunk_& qx, Chunk_& qy, Chunk_& qz, Chunk_& px, Chunk_& py, Chunk_& pz) {
+  typedef typename Chunk_::Scalar Scalar;
+  using std::sqrt;
+  const Scalar smallAngle = sqrt(sqrt(std::numeric_limits<Scalar>::epsilon()));
+  const Chunk_ ax = timeStep*wx;
+  const Chunk_ ay = timeStep*wy;
+  const Chunk_ az = timeStep*wz;
+  const Chunk_ bx = timeStep*vx;
+  const Chunk_ by = timeStep*vy;
+  const Chunk_ bz = timeStep*vz;
+  const Chunk_ squaredAngle = ax*ax + ay*ay + az*az;
+  const Chunk_ angle = squaredAngle.sqrt();
+  const Chunk_ sine = angle.sin();
+  const auto isSmall = angle < smallAngle;
+  // sin(a/2)/a, (1 - cos(a))/a^2 and (a - sin(a))/a^3 with their Taylor expansions below eps^(1/4) like in
+  // getJacobianOfExponentialMap(), where 1 - cos(a) = 2*sin^2(a/2) does not cancel
+  const Chunk_ halfSine = (Scalar(0.5)*angle).sin();
+  const Chunk_ safeAngle = isSmall.select(Chunk_::Ones(angle.size()), angle);
+  const Chunk_ safeSquaredAngle = safeAngle*safeAngle;
+  const Chunk_ rotationFactor = isSmall.select(Scalar(0.5) - squaredAngle*(Scalar(1.0/48.0) - squaredAngle*Scalar(1.0/3840.0)), halfSine/safeAngle);
+  const Chunk_ skewFactor = isSmall.select(Scalar(0.5) - squaredAngle*(Scalar(1.0/24.0) - squaredAngle*Scalar(1.0/720.0)),
+                                           Scalar(2)*halfSine*halfSine/safeSquaredAngle);
+  const Chunk_ skewSquaredFactor = isSmall.select(Scalar(1.0/6.0) - squaredAngle*(Scalar(1.0/120.0) - squaredAngle*Scalar(1.0/5040.0)),
+                                                  (safeAngle - sine)/(safeSquaredAngle*safeAngle));
+  qw = (Scalar(0.5)*angle).cos();
+  qx = rotationFactor*ax;
+  qy = rotationFactor*ay;
+  qz = rotationFactor*az;
+  // J(a)*b = b + c1*(a x b) + c2*(a x (a x b))
+  const Chunk_ cx = ay*bz - az*by;
+  const Chunk_ cy = az*bx - ax*bz;
+  const Chunk_ cz = ax*by - ay*bx;
+  px = bx + skewFactor*cx + skewSquaredFactor*(ay*cz - az*cy);
+  py = by + skewFactor*cy + skewSquaredFactor*(az*cx - ax*cz);
+  pz = bz + skewFactor*cz + skewSquaredFactor*(ax*cy - ay*cx);
+}
+
+/*! \brief Exponential map of SO(3) for chunks of rotation vectors, i.e. the quaternions q = exp(a) of every row.
+ *  (only for advanced users)
+ */
+template<typename Chunk_>
+inline void getExponentialOfRotationVectors(const Chunk_& ax, const Chunk_& ay, const Chunk_& az, Chunk_& qw, Chunk_& qx, Chunk_& qy, Chunk_& qz) {
+  typedef typename Chunk_::Scalar Scalar;
+  using std::sqrt;
+  const Scalar smallAngle = sqrt(sqrt(std::numeric_limits<Scalar>::epsilon()));
+  const Chunk_ squaredAngle = ax*ax + ay*ay + az*az;
+  const Chunk_ angle = squaredAngle.sqrt();
+  const auto isSmall = angle < smallAngle;
+  // sin(a/2)/a with its Taylor expansion below eps^(1/4)
+  const Chunk_ safeAngle = isSmall.select(Chunk_::Ones(angle.size()), angle);
+  const Chunk_ rotationFactor = isSmall.select(Scalar(0.5) - squaredAngle*(Scalar(1.0/48.0) - squaredAngle*Scalar(1.0/3840.0)), (Scalar(0.5)*angle).sin()/safeAngle);
+  qw = (Scalar(0.5)*angle).cos();
+  qx = rotationFactor*ax;
+  qy = rotationFactor*ay;
+  qz = rotationFactor*az;
+}
+
+} // namespace internal
+
+
+/*! \brief Integrates many bodies with constant body twists by the exponential map of SE(3), in place.
+ *  \param positions          Nx3-matrix of the positions, overwritten
+ *  \param quaternions        Nx4-matrix of the unit quaternions (w, x, y, z), overwritten and renormalized
+ *  \param linearVelocities   Nx3-matrix of the linear velocities in the body frames
+ *  \param angularVelocities  Nx3-matrix of the angular velocities in the body frames
+ *  \param timeStep           dt
+ */
+template<typename Positions_, typename Quaternions_, typename LinearVelocities_, typename AngularVelocities_>
+inline void integratePoses(Eigen::MatrixBase<Positions_>& positions, Eigen::MatrixBase<Quaternions_>& quaternions,
+                           const Eigen::MatrixBase<LinearVelocities_>& linearVelocities, const Eigen::MatrixBase<AngularVelocities_>& angularVelocities,
+                           typename Positions_::Scalar timeStep) {
+  typedef typename Positions_::Scalar Scalar;
+  typedef Eigen::Array<Scalar, Eigen::Dynamic, 1, 0, internal::PoseIntegrationChunkSize, 1> Chunk;
+  const Eigen::DenseIndex size = positions.rows();
+  KINDR_ASSERT_TRUE(std::runtime_error, positions.cols() == 3 && linearVelocities.cols() == 3 && angularVelocities.cols() == 3, "The positions and velocities must be stored as Nx3 matrices!");
+  KINDR_ASSERT_TRUE(std::runtime_error, quaternions.cols() == 4, "The rotations must be stored as a Nx4 matrix!");
+  KINDR_ASSERT_TRUE(std::runtime_error, quaternions.rows() == size && linearVelocities.rows() == size && angularVelocities.rows() == size, "The numbers of bodies differ!");
+  for (Eigen::DenseIndex begin = 0; begin < size; begin += internal::PoseIntegrationChunkSize) {
+    const Eigen::DenseIndex n = std::min<Eigen::DenseIndex>(internal::PoseIntegrationChunkSize, size - begin);
+    Chunk dw(n), dx(n), dy(n), dz(n), tx(n), ty(n), tz(n);
+    internal::getExponentialOfBodyTwists<Chunk>(
+        linearVelocities.col(0).segment(begin, n).array(), linearVelocities.col(1).segment(begin, n).array(), linearVelocities.col(2).segment(begin, n).array(),
+        angularVelocities.col(0).segment(begin, n).array(), angularVelocities.col(1).segment(begin, n).array(), angularVelocities.col(2).segment(begin, n).array(),
+        timeStep, dw, dx, dy, dz, tx, ty, tz);
+    const Chunk w = quaternions.col(0).segment(begin, n).array();
+    const Chunk x = quaternions.col(1).segment(begin, n).array();
+    const Chunk y = quaternions.col(2).segment(begin, n).array();
+    const Chunk z = quaternions.col(3).segment(begin, n).array();
+    // p += R*t and q = q*dq
+    Chunk rx(n), ry(n), rz(n);
+    internal::rotateByQuaternions<Chunk>(w, x, y, z, tx, ty, tz, rx, ry, rz);
+    positions.col(0).segment(begin, n).array() += rx;
+    positions.col(1).segment(begin, n).array() += ry;
+    positions.col(2).segment(begin, n).array() += rz;
+    Chunk qw(n), qx(n), qy(n), qz(n);
+    internal::multiplyQuaternions<Chunk>(w, x, y, z, dw, dx, dy, dz, qw, qx, qy, qz);
+    // renormalize, since the quaternions are fed back at every time step
+    const Chunk inverseNorm = (qw*qw + qx*qx + qy*qy + qz*qz).sqrt().inverse();
+    quaternions.col(0).segment(begin, n) = (qw*inverseNorm).matrix();
+    quaternions.col(1).segment(begin, n) = (qx*inverseNorm).matrix();
+    quaternions.col(2).segment(begin, n) = (qy*inverseNorm).matrix();
+    quaternions.col(3).segment(begin, n) = (qz*inverseNorm).matrix();
+  }
+}
+
+/*! \brief Integrates a pose with a stream of body twists, each constant over a time step.
+ *  The increments of all time steps are computed vectorized, only their concatenation is sequential.
+ *  \param pose               initial pose
+ *  \param linearVelocities   Nx3-matrix of the linear velocities in the body frame
+ *  \param angularVelocities  Nx3-matrix of the angular velocities in the body frame
+ *  \param timeStep           dt
+ *  \param positions          Nx3-matrix of the positions after each time step
+ *  \param quaternions        Nx4-matrix of the quaternions (w, x, y, z) after each time step
+ *  \returns the pose after the last time step
+ */
+template<typename LinearVelocities_, typename AngularVelocities_, typename Positions_, typename Quaternions_>
+inline HomTransformQuat<typename Positions_::Scalar> integratePoseStream(const HomTransformQuat<typename Positions_::Scalar>& pose,
+                                                                         const Eigen::MatrixBase<LinearVelocities_>& linearVelocities,
+                                                                         const Eigen::MatrixBase<AngularVelocities_>& angularVelocities,
+                                                                         typename Positions_::Scalar timeStep,
+                                                                         Eigen::MatrixBase<Positions_>& positions, Eigen::MatrixBase<Quaternions_>& quaternions) {
+  typedef typename Positions_::Scalar Scalar;
+  typedef Eigen::Array<Scalar, Eigen::Dynamic, 1, 0, internal::PoseIntegrationChunkSize, 1> Chunk;
+  const Eigen::DenseIndex size = linearVelocities.rows();
+  KINDR_ASSERT_TRUE(std::runtime_error, positions.cols() == 3 && linearVelocities.cols() == 3 && angularVelocities.cols() == 3, "The positions and velocities must be stored as Nx3 matrices!");
+  KINDR_ASSERT_TRUE(std::runtime_error, quaternions.cols() == 4, "The rotations must be stored as a Nx4 matrix!");
+  KINDR_ASSERT_TRUE(std::runtime_error, angularVelocities.rows() == size && positions.rows() == size && quaternions.rows() == size, "The numbers of time steps differ!");
+  // increments of all time steps
+  for (Eigen::DenseIndex begin = 0; begin < size; begin += internal::PoseIntegrationChunkSize) {
+    const Eigen::DenseIndex n = std::min<Eigen::DenseIndex>(internal::PoseIntegrationChunkSize, size - begin);
+    Chunk dw(n), dx(n), dy(n), dz(n), tx(n), ty(n), tz(n);
+    internal::getExponentialOfBodyTwists<Chunk>(
+        linearVelocities.col(0).segment(begin, n).array(), linearVelocities.col(1).segment(begin, n).array(), linearVelocities.col(2).segment(begin, n).array(),
+        angularVelocities.col(0).segment(begin, n).array(), angularVelocities.col(1).segment(begin, n).array(), angularVelocities.col(2).segment(begin, n).array(),
+        timeStep, dw, dx, dy, dz, tx, ty, tz);
+    quaternions.col(0).segment(begin, n) = dw.matrix();
+    quaternions.col(1).segment(begin, n) = dx.matrix();
+    quaternions.col(2).segment(begin, n) = dy.matrix();
+    quaternions.col(3).segment(begin, n) = dz.matrix();
+    positions.col(0).segment(begin, n) = tx.matrix();
+    positions.col(1).segment(begin, n) = ty.matrix();
+    positions.col(2).segment(begin, n) = tz.matrix();
+  }
+  // concatenation
+  Eigen::Quaternion<Scalar> rotation = pose.getRotation().toImplementation();
+  Eigen::Matrix<Scalar, 3, 1> position = pose.getPosition().toImplementation();
+  for (Eigen::DenseIndex k = 0; k < size; ++k) {
+    position += rotation*Eigen::Matrix<Scalar, 3, 1>(positions(k, 0), positions(k, 1), positions(k, 2));
+    rotation = rotation*Eigen::Quaternion<Scalar>(quaternions(k, 0), quaternions(k, 1), quaternions(k, 2), quaternions(k, 3));
+    rotation.normalize();
+    positions.row(k) = position.transpose();
+    quaternions.row(k) << rotation.w(), rotation.x(), rotation.y(), rotation.z();
+  }
+  return HomTransformQuat<Scalar>(Position<Scalar, 3>(position), RotationQuaternion<Scalar>(rotation));
+}
+
+} // namespace kindr
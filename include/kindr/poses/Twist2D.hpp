@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <Eigen/Core>
+
+#include "kindr/common/common.hpp"
+#include "kindr/phys_quant/PhysicalQuantities.hpp"
+#include "kindr/poses/PoseDiffBase.hpp"
+#include "kindr/poses/Twist.hpp"
+
+namespace kindr {
+
+/*! \class Twist2D
+ *  \brief Planar twist consisting of a 2D linear velocity and the angular velocity about the z-axis.
+ *
+ *  The vector [v_x, v_y, omega]' of the twist is the tangent vector of HomogeneousTransformation2D, e.g.
+ *  \code{.cpp}
+ *  const HomTransform2D T_next = T.boxPlus(twist.getVector()*dt);
+ *  \endcode
+ *  \tparam PrimType_ the primitive type of the data (double or float)
+ *  \ingroup poses
+ */
+template<typename PrimType_>
+class Twist2D : public PoseDiffBase<Twist2D<PrimType_>> {
+ public:
+  typedef PrimType_ Scalar;
+  typedef Velocity<PrimType_, 2> PositionDiff;
+  typedef PrimType_ RotationDiff;
+  typedef Eigen::Matrix<PrimType_, 3, 1> Vector3;
+  typedef Eigen::Matrix<PrimType_, 2, 1> Vector2;
+
+  Twist2D()
+    : linearVelocity_(PositionDiff::Zero()), angularVelocity_(Scalar(0)) {
+  }
+
+  Twist2D(const PositionDiff& linearVelocity, Scalar angularVelocity)
+    : linearVelocity_(linearVelocity), angularVelocity_(angularVelocity) {
+  }
+
+  Twist2D(const Vector2& linearVelocity, Scalar angularVelocity)
+    : linearVelocity_(linearVelocity), angularVelocity_(angularVelocity) {
+  }
+
+  /*! Sets the twist by a 3D-vector [linear velocity, angular velocity]'
+   */
+  explicit Twist2D(const Vector3& vector3)
+    : linearVelocity_(Vector2(vector3.template head<2>())), angularVelocity_(vector3(2)) {
+  }
+
+  /*! \brief Constructor using a 3D twist, which is projected onto the xy-plane.
+   */
+  explicit Twist2D(const TwistLinearVelocityLocalAngularVelocity<PrimType_>& twist)
+    : linearVelocity_(Vector2(twist.getTranslationalVelocity().toImplementation().template head<2>())),
+      angularVelocity_(twist.getRotationalVelocity().toImplementation()(2)) {
+  }
+
+  inline PositionDiff& getTranslationalVelocity() {
+    return linearVelocity_;
+  }
+
+  inline const PositionDiff& getTranslationalVelocity() const {
+    return linearVelocity_;
+  }
+
+  inline Scalar& getRotationalVelocity() {
+    return angularVelocity_;
+  }
+
+  inline Scalar getRotationalVelocity() const {
+    return angularVelocity_;
+  }
+
+  /*!
+   * @returns the twist in a 3D-vector [linear velocity, angular velocity]'
+   */
+  inline Vector3 getVector() const {
+    Vector3 vector;
+    vector.template head<2>() = linearVelocity_.toImplementation();
+    vector(2) = angularVelocity_;
+    return vector;
+  }
+
+  /*! Sets the twist by a 3D-vector [linear velocity, angular velocity]'
+   */
+  inline void setVector(const Vector3& vector3) {
+    *this = Twist2D(vector3);
+  }
+
+  /*! \returns the corresponding 3D twist in the xy-plane
+   */
+  inline TwistLinearVelocityLocalAngularVelocity<PrimType_> getTwist3D() const {
+    return TwistLinearVelocityLocalAngularVelocity<PrimType_>(Eigen::Matrix<PrimType_, 3, 1>(linearVelocity_(0), linearVelocity_(1), Scalar(0)),
+                                                              Eigen::Matrix<PrimType_, 3, 1>(Scalar(0), Scalar(0), angularVelocity_));
+  }
+
+  /*! \brief Used for printing the object with std::cout.
+   *  \returns std::stream object
+   */
+  friend std::ostream& operator << (std::ostream& out, const Twist2D& twist) {
+    out << twist.getTranslationalVelocity() << " " << twist.getRotationalVelocity();
+    return out;
+  }
+
+  /*! \brief Sets twist to zero
+   *  \returns reference
+   */
+  Twist2D& setZero() {
+    linearVelocity_.setZero();
+    angularVelocity_ = Scalar(0);
+    return *this;
+  }
+
+ private:
+  PositionDiff linearVelocity_;
+  Scalar angularVelocity_;
+};
+
+typedef Twist2D<double> Twist2DD;
+typedef Twist2D<float> Twist2DF;
+
+} // namespace kindr
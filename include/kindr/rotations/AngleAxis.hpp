@@ -252,15 +252,15 @@ class AngleAxis : public RotationBase<AngleAxis<PrimType_>> {
   AngleAxis getUnique() const {
     const Scalar anglePosNegPi = kindr::wrapPosNegPI(angle());
     AngleAxis aa(anglePosNegPi, axis()); // first wraps angle into [-pi,pi)
-    if(aa.angle() > 0.0)  {
+    if(aa.angle() > Scalar(0))  {
         return aa;
     }
-    else if(aa.angle() < 0.0) {
-      if(aa.angle() != -M_PI) {
+    else if(aa.angle() < Scalar(0)) {
+      if(aa.angle() != -Scalar(M_PI)) {
         return AngleAxis(-aa.angle(),-aa.axis());
       }
       else { // angle == -pi, so axis must be viewed further, because -pi,axis does the same as -pi,-axis
-        if(aa.axis()[0] < 0.0) {
+        if(aa.axis()[0] < Scalar(0)) {
           return AngleAxis(-aa.angle(),-aa.axis());
         }
         else if(aa.axis()[0] > 0) {
@@ -268,7 +268,7 @@ class AngleAxis : public RotationBase<AngleAxis<PrimType_>> {
         }
         else { // v1 == 0
 
-          if(aa.axis()[1] < 0.0) {
+          if(aa.axis()[1] < Scalar(0)) {
             return AngleAxis(-aa.angle(),-aa.axis());
           }
           else if(aa.axis()[1] > 0) {
@@ -276,7 +276,7 @@ class AngleAxis : public RotationBase<AngleAxis<PrimType_>> {
           }
           else { // v2 == 0
 
-            if(aa.axis()[2] < 0.0) { // v3 must be -1 or 1
+            if(aa.axis()[2] < Scalar(0)) { // v3 must be -1 or 1
               return AngleAxis(-aa.angle(),-aa.axis());
             }
             else  {
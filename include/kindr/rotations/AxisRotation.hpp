@@ -0,0 +1,708 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <cmath>
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include "kindr/common/common.hpp"
+#include "kindr/common/assert_macros.hpp"
+#include "kindr/rotations/Rotation.hpp"
+
+namespace kindr {
+
+//! Axis index of an AxisRotation whose axis is chosen at run time
+constexpr int DynamicAxis = -1;
+
+namespace internal {
+
+/*! \brief Stores the axis of an AxisRotation, which is a compile-time constant unless it is DynamicAxis.
+ *  (only for advanced users)
+ */
+template<int Axis_>
+class AxisRotationAxis {
+ public:
+  static_assert(0 <= Axis_ && Axis_ < 3, "The axis has to be 0 (x), 1 (y), 2 (z) or DynamicAxis!");
+
+  explicit AxisRotationAxis(int axis = Axis_) {
+    KINDR_ASSERT_TRUE(std::runtime_error, axis == Axis_, "The axis does not match the axis of the type!");
+  }
+
+  static constexpr int axis() {
+    return Axis_;
+  }
+};
+
+template<>
+class AxisRotationAxis<DynamicAxis> {
+ public:
+  explicit AxisRotationAxis(int axis = 2)
+    : axis_(axis) {
+    KINDR_ASSERT_TRUE(std::runtime_error, 0 <= axis && axis < 3, "The axis has to be 0 (x), 1 (y) or 2 (z)!");
+  }
+
+  int axis() const {
+    return axis_;
+  }
+
+ private:
+  int axis_;
+};
+
+} // namespace internal
+
+
+/*! \class AxisRotation
+ *  \brief Rotation about a coordinate axis, e.g. the rotation of a revolute joint.
+ *
+ *  Only the angle is stored together with its sine and cosine, such that no trigonometric functions have to be
+ *  evaluated when the rotation is applied. Concatenations with rotation matrices and rotation quaternions only
+ *  modify the two rows or columns (or quaternion components) which are affected by the rotation.
+ *  The concatenation of an AxisRotation with another rotation type yields the other type, e.g.
+ *  \code{.cpp}
+ *  const RotationMatrixD R_IB = R_IA*AxisRotationZD(jointAngle);
+ *  \endcode
+ *  Both rotations of a concatenation have to use the same primitive type.
+ *
+ *  Conversions from other rotation types are projections: the result is the rotation about the axis which is
+ *  closest to the given rotation, i.e. the components about the other two axes are discarded without a warning.
+ *  Only rotations about the axis are converted exactly. Converting an AxisRotation about another fixed axis
+ *  throws, since the projection would discard the whole rotation.
+ *
+ *  The following typedefs are provided for convenience:
+ *   - AxisRotationXD, AxisRotationYD, AxisRotationZD, AxisRotationDynD for primitive type double
+ *   - AxisRotationXF, AxisRotationYF, AxisRotationZF, AxisRotationDynF for primitive type float
+ *
+ *  \tparam PrimType_ the primitive type of the data (double or float)
+ *  \tparam Axis_ the axis 0 (x), 1 (y), 2 (z) or DynamicAxis if the axis is chosen at run time
+ *  \ingroup rotations
+ */
+template<typename PrimType_, int Axis_>
+class AxisRotation : public RotationBase<AxisRotation<PrimType_, Axis_>>, private internal::AxisRotationAxis<Axis_> {
+ private:
+  /*! \brief The axis storage.
+   */
+  typedef internal::AxisRotationAxis<Axis_> AxisStorage;
+ public:
+  /*! \brief The primitive type.
+   *  Float/Double
+   */
+  typedef PrimType_ Scalar;
+
+  /*! \brief Default constructor using identity rotation.
+   */
+  AxisRotation()
+    : AxisStorage(), angle_(Scalar(0)), sinAngle_(Scalar(0)), cosAngle_(Scalar(1)) {
+  }
+
+  /*! \brief Constructor using the angle.
+   *  \param angle   rotation angle
+   */
+  explicit AxisRotation(Scalar angle)
+    : AxisStorage() {
+    setAngle(angle);
+  }
+
+  /*! \brief Constructor using the axis and the angle.
+   *  \param axis    axis 0 (x), 1 (y) or 2 (z), which has to match Axis_ unless it is DynamicAxis
+   *  \param angle   rotation angle
+   */
+  AxisRotation(int axis, Scalar angle)
+    : AxisStorage(axis) {
+    setAngle(angle);
+  }
+
+  /*! \brief Constructor using the angle and its precomputed sine and cosine.
+   *  \param axis       axis 0 (x), 1 (y) or 2 (z), which has to match Axis_ unless it is DynamicAxis
+   *  \param angle      rotation angle
+   *  \param sinAngle   sine of the angle
+   *  \param cosAngle   cosine of the angle
+   */
+  AxisRotation(int axis, Scalar angle, Scalar sinAngle, Scalar cosAngle)
+    : AxisStorage(axis), angle_(angle), sinAngle_(sinAngle), cosAngle_(cosAngle) {
+  }
+
+  /*! \brief Constructor using another rotation, which is projected onto the axis.
+   *  The components of the rotation about the other axes are discarded, see the class description.
+   *  For DynamicAxis, the axis with the largest component of the rotation vector is chosen.
+   *  \param other   other rotation
+   */
+  template<typename OtherDerived_>
+  inline explicit AxisRotation(const RotationBase<OtherDerived_>& other)
+    : AxisRotation(internal::ConversionTraits<AxisRotation, OtherDerived_>::convert(other.derived())) {
+  }
+
+  /*! \brief Assignment operator using another rotation, which is projected onto the axis.
+   *  The components of the rotation about the other axes are discarded, see the class description.
+   *  \param other   other rotation
+   *  \returns reference
+   */
+  template<typename OtherDerived_>
+  AxisRotation& operator =(const RotationBase<OtherDerived_>& other) {
+    *this = internal::ConversionTraits<AxisRotation, OtherDerived_>::convert(other.derived());
+    return *this;
+  }
+
+  using AxisStorage::axis;
+
+  /*! \brief Returns the unit vector of the axis.
+   */
+  Eigen::Matrix<Scalar, 3, 1> getAxis() const {
+    return Eigen::Matrix<Scalar, 3, 1>::Unit(axis());
+  }
+
+  inline Scalar angle() const {
+    return angle_;
+  }
+
+  inline Scalar getSinAngle() const {
+    return sinAngle_;
+  }
+
+  inline Scalar getCosAngle() const {
+    return cosAngle_;
+  }
+
+  /*! \brief Sets the angle and updates its sine and cosine.
+   *  \returns reference
+   */
+  AxisRotation& setAngle(Scalar angle) {
+    using std::sin;
+    using std::cos;
+    angle_ = angle;
+    sinAngle_ = sin(angle);
+    cosAngle_ = cos(angle);
+    return *this;
+  }
+
+  /*! \brief Returns the inverse of the rotation.
+   *  \returns the inverse of the rotation
+   */
+  AxisRotation inverted() const {
+    return AxisRotation(axis(), -angle_, -sinAngle_, cosAngle_);
+  }
+
+  /*! \brief Inverts the rotation.
+   *  \returns reference
+   */
+  AxisRotation& invert() {
+    angle_ = -angle_;
+    sinAngle_ = -sinAngle_;
+    return *this;
+  }
+
+  /*! \brief Sets the rotation to identity.
+   *  \returns reference
+   */
+  AxisRotation& setIdentity() {
+    angle_ = Scalar(0);
+    sinAngle_ = Scalar(0);
+    cosAngle_ = Scalar(1);
+    return *this;
+  }
+
+  /*! \brief Returns a unique rotation with angle in [-pi,pi).
+   *  This function is used to compare different rotations.
+   *  \returns copy of the rotation which is unique
+   */
+  AxisRotation getUnique() const {
+    return AxisRotation(axis(), kindr::wrapPosNegPI<Scalar>(angle_), sinAngle_, cosAngle_);
+  }
+
+  /*! \brief Modifies the rotation such that the angle lies in [-pi,pi).
+   *  \returns reference
+   */
+  AxisRotation& setUnique() {
+    angle_ = kindr::wrapPosNegPI<Scalar>(angle_);
+    return *this;
+  }
+
+  /*! \brief Returns the rotation matrix.
+   */
+  Eigen::Matrix<Scalar, 3, 3> getRotationMatrix() const {
+    const int b = (axis() + 1) % 3;
+    const int c = (axis() + 2) % 3;
+    Eigen::Matrix<Scalar, 3, 3> R = Eigen::Matrix<Scalar, 3, 3>::Zero();
+    R(axis(), axis()) = Scalar(1);
+    R(b, b) = cosAngle_;
+    R(b, c) = -sinAngle_;
+    R(c, b) = sinAngle_;
+    R(c, c) = cosAngle_;
+    return R;
+  }
+
+  /*! \brief Returns the quaternion with non-negative real part.
+   *  The half-angle sine and cosine are computed from the cached sine and cosine with the half-angle formulas.
+   *  The larger of the two is computed with the square root, such that the other one is well-conditioned.
+   */
+  Eigen::Quaternion<Scalar> getQuaternion() const {
+    using std::sqrt;
+    Scalar cosHalfAngle;
+    Scalar sinHalfAngle;
+    if (cosAngle_ >= Scalar(0)) {
+      cosHalfAngle = sqrt(Scalar(0.5)*(Scalar(1) + cosAngle_));
+      sinHalfAngle = Scalar(0.5)*sinAngle_/cosHalfAngle;
+    } else {
+      sinHalfAngle = sqrt(Scalar(0.5)*(Scalar(1) - cosAngle_));
+      if (sinAngle_ < Scalar(0)) {
+        sinHalfAngle = -sinHalfAngle;
+      }
+      cosHalfAngle = Scalar(0.5)*sinAngle_/sinHalfAngle;
+    }
+    Eigen::Quaternion<Scalar> q(cosHalfAngle, Scalar(0), Scalar(0), Scalar(0));
+    q.vec()(axis()) = sinHalfAngle;
+    return q;
+  }
+
+  /*! \brief Concenation operator.
+   *  \returns the concenation of two rotations
+   */
+  using RotationBase<AxisRotation<PrimType_, Axis_>>::operator*;
+
+  /*! \brief Equivalence operator.
+   *  \returns true if two rotations are similar.
+   */
+  using RotationBase<AxisRotation<PrimType_, Axis_>>::operator==;
+
+  /*! \brief Used for printing the object with std::cout.
+   *  \returns std::stream object
+   */
+  friend std::ostream& operator << (std::ostream& out, const AxisRotation& rotation) {
+    out << rotation.angle() << " (axis " << rotation.axis() << ")";
+    return out;
+  }
+
+ private:
+  Scalar angle_;
+  Scalar sinAngle_;
+  Scalar cosAngle_;
+};
+
+template <typename PrimType_>
+using AxisRotationX = AxisRotation<PrimType_, 0>;
+template <typename PrimType_>
+using AxisRotationY = AxisRotation<PrimType_, 1>;
+template <typename PrimType_>
+using AxisRotationZ = AxisRotation<PrimType_, 2>;
+template <typename PrimType_>
+using AxisRotationDyn = AxisRotation<PrimType_, DynamicAxis>;
+
+typedef AxisRotationX<double> AxisRotationXD;
+typedef AxisRotationX<float> AxisRotationXF;
+typedef AxisRotationY<double> AxisRotationYD;
+typedef AxisRotationY<float> AxisRotationYF;
+typedef AxisRotationZ<double> AxisRotationZD;
+typedef AxisRotationZ<float> AxisRotationZF;
+typedef AxisRotationDyn<double> AxisRotationDynD;
+typedef AxisRotationDyn<float> AxisRotationDynF;
+
+
+namespace internal {
+
+template<typename PrimType_, int Axis_>
+class get_scalar<AxisRotation<PrimType_, Axis_>> {
+ public:
+  typedef PrimType_ Scalar;
+};
+
+template<typename PrimType_, int Axis_>
+class get_matrix3X<AxisRotation<PrimType_, Axis_>>{
+ public:
+  typedef int  IndexType;
+
+  template <IndexType Cols>
+  using Matrix3X = Eigen::Matrix<PrimType_, 3, Cols>;
+};
+
+/*! \brief Returns the angle of the projection of a rotation matrix onto a coordinate axis.
+ *  The angle is exact if the matrix is a rotation about the axis.
+ *  (only for advanced users)
+ */
+template<typename PrimType_>
+inline PrimType_ getProjectedAngle(int axis, const Eigen::Matrix<PrimType_, 3, 3>& R) {
+  using std::atan2;
+  const int b = (axis + 1) % 3;
+  const int c = (axis + 2) % 3;
+  return atan2(R(c,b) - R(b,c), R(b,b) + R(c,c));
+}
+
+/*! \brief Chooses the axis of a rotation matrix for AxisRotation, which is fixed unless it is DynamicAxis.
+ *  (only for advanced users)
+ */
+template<int Axis_>
+class AxisRotationProjection {
+ public:
+  template<typename PrimType_>
+  inline static int getAxis(const Eigen::Matrix<PrimType_, 3, 3>& /*R*/) {
+    return Axis_;
+  }
+};
+
+template<>
+class AxisRotationProjection<DynamicAxis> {
+ public:
+  template<typename PrimType_>
+  inline static int getAxis(const Eigen::Matrix<PrimType_, 3, 3>& R) {
+    // axis with the largest component of the skew-symmetric part, i.e. of the rotation vector
+    int axis;
+    Eigen::Matrix<PrimType_, 3, 1>(R(2,1) - R(1,2), R(0,2) - R(2,0), R(1,0) - R(0,1)).cwiseAbs().maxCoeff(&axis);
+    return axis;
+  }
+};
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+ * Conversion Traits
+ * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/*! \brief Projection of a rotation onto the axis, which discards the components about the other axes.
+ */
+template<typename DestPrimType_, int Axis_, typename Source_>
+class ConversionTraits<AxisRotation<DestPrimType_, Axis_>, Source_> {
+ public:
+  inline static AxisRotation<DestPrimType_, Axis_> convert(const Source_& rotation) {
+    const Eigen::Matrix<DestPrimType_, 3, 3> R = RotationMatrix<DestPrimType_>(rotation).matrix();
+    const int axis = AxisRotationProjection<Axis_>::getAxis(R);
+    return AxisRotation<DestPrimType_, Axis_>(axis, getProjectedAngle(axis, R));
+  }
+};
+
+/*! \brief Conversion between rotations about the same axis.
+ *  The conversion to a different fixed axis throws, since its projection would be the identity.
+ */
+template<typename DestPrimType_, int DestAxis_, typename SourcePrimType_, int SourceAxis_>
+class ConversionTraits<AxisRotation<DestPrimType_, DestAxis_>, AxisRotation<SourcePrimType_, SourceAxis_>> {
+ public:
+  inline static AxisRotation<DestPrimType_, DestAxis_> convert(const AxisRotation<SourcePrimType_, SourceAxis_>& rotation) {
+    KINDR_ASSERT_TRUE(std::runtime_error, DestAxis_ == DynamicAxis || DestAxis_ == rotation.axis(),
+                      "Cannot convert a rotation about axis " << rotation.axis() << " to a rotation about axis " << DestAxis_ << "!");
+    return AxisRotation<DestPrimType_, DestAxis_>(rotation.axis(), DestPrimType_(rotation.angle()),
+                                                  DestPrimType_(rotation.getSinAngle()), DestPrimType_(rotation.getCosAngle()));
+  }
+};
+
+template<typename DestPrimType_, typename SourcePrimType_, int Axis_>
+class ConversionTraits<RotationMatrix<DestPrimType_>, AxisRotation<SourcePrimType_, Axis_>> {
+ public:
+  inline static RotationMatrix<DestPrimType_> convert(const AxisRotation<SourcePrimType_, Axis_>& rotation) {
+    return RotationMatrix<DestPrimType_>(rotation.getRotationMatrix().template cast<DestPrimType_>());
+  }
+};
+
+template<typename DestPrimType_, typename SourcePrimType_, int Axis_>
+class ConversionTraits<RotationQuaternion<DestPrimType_>, AxisRotation<SourcePrimType_, Axis_>> {
+ public:
+  inline static RotationQuaternion<DestPrimType_> convert(const AxisRotation<SourcePrimType_, Axis_>& rotation) {
+    return RotationQuaternion<DestPrimType_>(Eigen::Quaternion<DestPrimType_>(rotation.getQuaternion().template cast<DestPrimType_>()));
+  }
+};
+
+template<typename DestPrimType_, typename SourcePrimType_, int Axis_>
+class ConversionTraits<AngleAxis<DestPrimType_>, AxisRotation<SourcePrimType_, Axis_>> {
+ public:
+  inline static AngleAxis<DestPrimType_> convert(const AxisRotation<SourcePrimType_, Axis_>& rotation) {
+    return AngleAxis<DestPrimType_>(DestPrimType_(rotation.angle()), rotation.getAxis().template cast<DestPrimType_>());
+  }
+};
+
+template<typename DestPrimType_, typename SourcePrimType_, int Axis_>
+class ConversionTraits<RotationVector<DestPrimType_>, AxisRotation<SourcePrimType_, Axis_>> {
+ public:
+  inline static RotationVector<DestPrimType_> convert(const AxisRotation<SourcePrimType_, Axis_>& rotation) {
+    return RotationVector<DestPrimType_>((rotation.angle()*rotation.getAxis()).template cast<DestPrimType_>());
+  }
+};
+
+template<typename DestPrimType_, typename SourcePrimType_, int Axis_>
+class ConversionTraits<EulerAnglesZyx<DestPrimType_>, AxisRotation<SourcePrimType_, Axis_>> {
+ public:
+  inline static EulerAnglesZyx<DestPrimType_> convert(const AxisRotation<SourcePrimType_, Axis_>& rotation) {
+    return EulerAnglesZyx<DestPrimType_>(RotationMatrix<DestPrimType_>(rotation));
+  }
+};
+
+template<typename DestPrimType_, typename SourcePrimType_, int Axis_>
+class ConversionTraits<EulerAnglesXyz<DestPrimType_>, AxisRotation<SourcePrimType_, Axis_>> {
+ public:
+  inline static EulerAnglesXyz<DestPrimType_> convert(const AxisRotation<SourcePrimType_, Axis_>& rotation) {
+    return EulerAnglesXyz<DestPrimType_>(RotationMatrix<DestPrimType_>(rotation));
+  }
+};
+
+template<typename DestPrimType_, int A1_, int A2_, int A3_, typename SourcePrimType_, int Axis_>
+class ConversionTraits<EulerAngles<DestPrimType_, A1_, A2_, A3_>, AxisRotation<SourcePrimType_, Axis_>> {
+ public:
+  inline static EulerAngles<DestPrimType_, A1_, A2_, A3_> convert(const AxisRotation<SourcePrimType_, Axis_>& rotation) {
+    return EulerAngles<DestPrimType_, A1_, A2_, A3_>(RotationMatrix<DestPrimType_>(rotation));
+  }
+};
+
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+ * Multiplication Traits
+ * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/*! \brief Concatenation of two rotations about the same fixed axis using the angle addition theorems.
+ */
+template<typename PrimType_, int Axis_>
+class MultiplicationTraits<RotationBase<AxisRotation<PrimType_, Axis_>>, RotationBase<AxisRotation<PrimType_, Axis_>>> {
+ public:
+  inline static AxisRotation<PrimType_, Axis_> mult(const AxisRotation<PrimType_, Axis_>& lhs, const AxisRotation<PrimType_, Axis_>& rhs) {
+    return AxisRotation<PrimType_, Axis_>(Axis_, lhs.angle() + rhs.angle(),
+                                          lhs.getSinAngle()*rhs.getCosAngle() + lhs.getCosAngle()*rhs.getSinAngle(),
+                                          lhs.getCosAngle()*rhs.getCosAngle() - lhs.getSinAngle()*rhs.getSinAngle());
+  }
+};
+
+/*! \brief Concatenation of two rotations about different or run-time axes, which yields a rotation quaternion.
+ */
+template<typename PrimType_, int LeftAxis_, int RightAxis_>
+class MultiplicationTraits<RotationBase<AxisRotation<PrimType_, LeftAxis_>>, RotationBase<AxisRotation<PrimType_, RightAxis_>>> {
+ public:
+  inline static RotationQuaternion<PrimType_> mult(const AxisRotation<PrimType_, LeftAxis_>& lhs, const AxisRotation<PrimType_, RightAxis_>& rhs) {
+    return RotationQuaternion<PrimType_>(Eigen::Quaternion<PrimType_>(lhs.getQuaternion()*rhs.getQuaternion()));
+  }
+};
+
+template<typename PrimType_>
+class MultiplicationTraits<RotationBase<AxisRotation<PrimType_, DynamicAxis>>, RotationBase<AxisRotation<PrimType_, DynamicAxis>>> {
+ public:
+  inline static RotationQuaternion<PrimType_> mult(const AxisRotation<PrimType_, DynamicAxis>& lhs, const AxisRotation<PrimType_, DynamicAxis>& rhs) {
+    return RotationQuaternion<PrimType_>(Eigen::Quaternion<PrimType_>(lhs.getQuaternion()*rhs.getQuaternion()));
+  }
+};
+
+/*! \brief Concatenation of rotations about axes with different primitive types, which is not supported.
+ *  Without this specialization, the concatenation would be ambiguous.
+ */
+template<typename LeftPrimType_, int LeftAxis_, typename RightPrimType_, int RightAxis_>
+class MultiplicationTraits<RotationBase<AxisRotation<LeftPrimType_, LeftAxis_>>, RotationBase<AxisRotation<RightPrimType_, RightAxis_>>> {
+ public:
+  inline static RotationQuaternion<LeftPrimType_> mult(const AxisRotation<LeftPrimType_, LeftAxis_>& /*lhs*/, const AxisRotation<RightPrimType_, RightAxis_>& /*rhs*/) {
+    static_assert(std::is_same<LeftPrimType_, RightPrimType_>::value, "The rotations have to use the same primitive type, cast one of them first!");
+    return RotationQuaternion<LeftPrimType_>();
+  }
+};
+
+/*! \brief Concatenation of a rotation and a rotation about an axis, which yields the type of the other rotation.
+ */
+template<typename Left_, typename PrimType_, int Axis_>
+class MultiplicationTraits<RotationBase<Left_>, RotationBase<AxisRotation<PrimType_, Axis_>>> {
+ public:
+  inline static Left_ mult(const Left_& lhs, const AxisRotation<PrimType_, Axis_>& rhs) {
+    return Left_(RotationQuaternion<typename Left_::Scalar>(lhs)*RotationQuaternion<typename Left_::Scalar>(rhs));
+  }
+};
+
+template<typename PrimType_, int Axis_, typename Right_>
+class MultiplicationTraits<RotationBase<AxisRotation<PrimType_, Axis_>>, RotationBase<Right_>> {
+ public:
+  inline static Right_ mult(const AxisRotation<PrimType_, Axis_>& lhs, const Right_& rhs) {
+    return Right_(RotationQuaternion<typename Right_::Scalar>(lhs)*RotationQuaternion<typename Right_::Scalar>(rhs));
+  }
+};
+
+/*! \brief R*A only modifies the two columns of R which are orthogonal to the axis.
+ */
+template<typename PrimType_, int Axis_>
+class MultiplicationTraits<RotationBase<RotationMatrix<PrimType_>>, RotationBase<AxisRotation<PrimType_, Axis_>>> {
+ public:
+  inline static RotationMatrix<PrimType_> mult(const RotationMatrix<PrimType_>& lhs, const AxisRotation<PrimType_, Axis_>& rhs) {
+    const int b = (rhs.axis() + 1) % 3;
+    const int c = (rhs.axis() + 2) % 3;
+    const Eigen::Matrix<PrimType_, 3, 3>& R = lhs.matrix();
+    Eigen::Matrix<PrimType_, 3, 3> result;
+    result.col(rhs.axis()) = R.col(rhs.axis());
+    result.col(b) = rhs.getCosAngle()*R.col(b) + rhs.getSinAngle()*R.col(c);
+    result.col(c) = rhs.getCosAngle()*R.col(c) - rhs.getSinAngle()*R.col(b);
+    return RotationMatrix<PrimType_>(result);
+  }
+};
+
+/*! \brief A*R only modifies the two rows of R which are orthogonal to the axis.
+ */
+template<typename PrimType_, int Axis_>
+class MultiplicationTraits<RotationBase<AxisRotation<PrimType_, Axis_>>, RotationBase<RotationMatrix<PrimType_>>> {
+ public:
+  inline static RotationMatrix<PrimType_> mult(const AxisRotation<PrimType_, Axis_>& lhs, const RotationMatrix<PrimType_>& rhs) {
+    const int b = (lhs.axis() + 1) % 3;
+    const int c = (lhs.axis() + 2) % 3;
+    const Eigen::Matrix<PrimType_, 3, 3>& R = rhs.matrix();
+    Eigen::Matrix<PrimType_, 3, 3> result;
+    result.row(lhs.axis()) = R.row(lhs.axis());
+    result.row(b) = lhs.getCosAngle()*R.row(b) - lhs.getSinAngle()*R.row(c);
+    result.row(c) = lhs.getSinAngle()*R.row(b) + lhs.getCosAngle()*R.row(c);
+    return RotationMatrix<PrimType_>(result);
+  }
+};
+
+/*! \brief q*q_A only needs the half angle and two quaternion products per component.
+ */
+template<typename PrimType_, int Axis_>
+class MultiplicationTraits<RotationBase<RotationQuaternion<PrimType_>>, RotationBase<AxisRotation<PrimType_, Axis_>>> {
+ public:
+  inline static RotationQuaternion<PrimType_> mult(const RotationQuaternion<PrimType_>& lhs, const AxisRotation<PrimType_, Axis_>& rhs) {
+    const Eigen::Quaternion<PrimType_> qa = rhs.getQuaternion();
+    const PrimType_ ch = qa.w();
+    const PrimType_ sh = qa.vec()(rhs.axis());
+    const int a = rhs.axis();
+    const int b = (a + 1) % 3;
+    const int c = (a + 2) % 3;
+    const Eigen::Quaternion<PrimType_>& q = lhs.toImplementation();
+    Eigen::Quaternion<PrimType_> result;
+    result.w() = ch*q.w() - sh*q.vec()(a);
+    result.vec()(a) = ch*q.vec()(a) + sh*q.w();
+    result.vec()(b) = ch*q.vec()(b) + sh*q.vec()(c);
+    result.vec()(c) = ch*q.vec()(c) - sh*q.vec()(b);
+    return RotationQuaternion<PrimType_>(result);
+  }
+};
+
+/*! \brief q_A*q only needs the half angle and two quaternion products per component.
+ */
+template<typename PrimType_, int Axis_>
+class MultiplicationTraits<RotationBase<AxisRotation<PrimType_, Axis_>>, RotationBase<RotationQuaternion<PrimType_>>> {
+ public:
+  inline static RotationQuaternion<PrimType_> mult(const AxisRotation<PrimType_, Axis_>& lhs, const RotationQuaternion<PrimType_>& rhs) {
+    const Eigen::Quaternion<PrimType_> qa = lhs.getQuaternion();
+    const PrimType_ ch = qa.w();
+    const PrimType_ sh = qa.vec()(lhs.axis());
+    const int a = lhs.axis();
+    const int b = (a + 1) % 3;
+    const int c = (a + 2) % 3;
+    const Eigen::Quaternion<PrimType_>& q = rhs.toImplementation();
+    Eigen::Quaternion<PrimType_> result;
+    result.w() = ch*q.w() - sh*q.vec()(a);
+    result.vec()(a) = ch*q.vec()(a) + sh*q.w();
+    result.vec()(b) = ch*q.vec()(b) - sh*q.vec()(c);
+    result.vec()(c) = ch*q.vec()(c) + sh*q.vec()(b);
+    return RotationQuaternion<PrimType_>(result);
+  }
+};
+
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+ * Rotation Traits
+ * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
+template<typename PrimType_, int Axis_>
+class RotationTraits<RotationBase<AxisRotation<PrimType_, Axis_>>> {
+ public:
+  //! Only the two rows which are orthogonal to the axis are modified
+  template<typename get_matrix3X<AxisRotation<PrimType_, Axis_>>::IndexType Cols>
+  inline static typename get_matrix3X<AxisRotation<PrimType_, Axis_>>::template Matrix3X<Cols> rotate(const RotationBase<AxisRotation<PrimType_, Axis_>>& rotation, const typename get_matrix3X<AxisRotation<PrimType_, Axis_>>::template Matrix3X<Cols>& m) {
+    const AxisRotation<PrimType_, Axis_>& r = rotation.derived();
+    const int b = (r.axis() + 1) % 3;
+    const int c = (r.axis() + 2) % 3;
+    typename get_matrix3X<AxisRotation<PrimType_, Axis_>>::template Matrix3X<Cols> result(3, m.cols());
+    result.row(r.axis()) = m.row(r.axis());
+    result.row(b) = r.getCosAngle()*m.row(b) - r.getSinAngle()*m.row(c);
+    result.row(c) = r.getSinAngle()*m.row(b) + r.getCosAngle()*m.row(c);
+    return result;
+  }
+
+  template<typename Vector_>
+  inline static Vector_ rotate(const RotationBase<AxisRotation<PrimType_, Axis_>>& rotation, const Vector_& vector) {
+    return static_cast<Vector_>(rotation.derived().rotate(vector.toImplementation()));
+  }
+};
+
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+ * Comparison Traits
+ * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
+template<typename PrimType_, int Axis_, typename Right_>
+class ComparisonTraits<AxisRotation<PrimType_, Axis_>, Right_> {
+ public:
+  inline static bool isEqual(const AxisRotation<PrimType_, Axis_>& left, const Right_& right) {
+    return RotationQuaternion<PrimType_>(left).getUnique().toImplementation().coeffs() == RotationQuaternion<PrimType_>(right).getUnique().toImplementation().coeffs();
+  }
+};
+
+template<typename PrimType_, int LeftAxis_, int RightAxis_>
+class ComparisonTraits<AxisRotation<PrimType_, LeftAxis_>, AxisRotation<PrimType_, RightAxis_>> {
+ public:
+  inline static bool isEqual(const AxisRotation<PrimType_, LeftAxis_>& left, const AxisRotation<PrimType_, RightAxis_>& right) {
+    return (left.angle() == PrimType_(0) && right.angle() == PrimType_(0))
+        || (left.axis() == right.axis() && left.angle() == right.angle());
+  }
+};
+
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+ * Map Traits
+ * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
+template<typename PrimType_, int Axis_>
+class MapTraits<RotationBase<AxisRotation<PrimType_, Axis_>>> {
+ public:
+  //! Projects the vector onto the axis (for DynamicAxis onto the axis of the largest component)
+  inline static AxisRotation<PrimType_, Axis_> set_exponential_map(const typename internal::get_matrix3X<AxisRotation<PrimType_, Axis_>>::template Matrix3X<1>& vector) {
+    int axis = Axis_;
+    if (Axis_ == DynamicAxis) {
+      vector.cwiseAbs().maxCoeff(&axis);
+    }
+    return AxisRotation<PrimType_, Axis_>(axis, vector(axis));
+  }
+
+  inline static typename internal::get_matrix3X<AxisRotation<PrimType_, Axis_>>::template Matrix3X<1> get_logarithmic_map(const AxisRotation<PrimType_, Axis_>& rotation) {
+    return rotation.getUnique().angle()*rotation.getAxis();
+  }
+};
+
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+ * Box Operation Traits
+ * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
+template<typename PrimType_, int Axis_>
+class BoxOperationTraits<RotationBase<AxisRotation<PrimType_, Axis_>>, RotationBase<AxisRotation<PrimType_, Axis_>>> {
+ public:
+  inline static typename internal::get_matrix3X<AxisRotation<PrimType_, Axis_>>::template Matrix3X<1> box_minus(const RotationBase<AxisRotation<PrimType_, Axis_>>& lhs, const RotationBase<AxisRotation<PrimType_, Axis_>>& rhs) {
+    return (lhs.derived()*rhs.derived().inverted()).logarithmicMap();
+  }
+
+  //! Only the component along the axis is added
+  inline static AxisRotation<PrimType_, Axis_> box_plus(const RotationBase<AxisRotation<PrimType_, Axis_>>& rotation, const typename internal::get_matrix3X<AxisRotation<PrimType_, Axis_>>::template Matrix3X<1>& vector) {
+    const AxisRotation<PrimType_, Axis_>& r = rotation.derived();
+    return AxisRotation<PrimType_, Axis_>(r.axis(), r.angle() + vector(r.axis()));
+  }
+};
+
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+ * Fixing Traits
+ * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
+template<typename PrimType_, int Axis_>
+class FixingTraits<AxisRotation<PrimType_, Axis_>> {
+ public:
+  //! Recomputes the sine and cosine, which accumulate round-off errors in long concatenations
+  inline static void fix(AxisRotation<PrimType_, Axis_>& rotation) {
+    rotation.setAngle(rotation.angle());
+  }
+};
+
+} // namespace internal
+} // namespace kindr
@@ -0,0 +1,453 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <cstdint>
+
+#include "kindr/rotations/Rotation.hpp"
+
+namespace kindr {
+
+/*! \class CachedRotation
+ *  \brief Rotation which stores several parameterizations and computes them lazily.
+ *
+ *  The rotation keeps a rotation quaternion, a rotation matrix and Euler angles (ZYX) together with validity bits.
+ *  The representation that was set last is authoritative, the other ones are computed on the first access and cached
+ *  until the rotation is modified. Operations are dispatched to the cheapest available form:
+ *   - concatenations use the quaternions (or the matrices if both operands only have valid matrices),
+ *   - rotations of single vectors use the matrix if it is cached and the quaternion otherwise,
+ *   - rotations of several vectors compute and cache the matrix,
+ *   - conversions to RotationQuaternion, RotationMatrix and EulerAnglesZyx return the cached form.
+ *
+ *  The caches are modified by const member functions, hence a CachedRotation must not be accessed concurrently
+ *  from several threads without synchronization.
+ *
+ *  The following two typedefs are provided for convenience:
+ *   - \ref CachedRotationD "CachedRotationD" for primitive type double
+ *   - \ref CachedRotationF "CachedRotationF" for primitive type float
+ *
+ *  \tparam PrimType_ the primitive type of the data (double or float)
+ *
+ *  \ingroup rotations
+ */
+template<typename PrimType_>
+class CachedRotation : public RotationBase<CachedRotation<PrimType_>> {
+ public:
+  /*! \brief The primitive type.
+   *  Float/Double
+   */
+  typedef PrimType_ Scalar;
+  /*! \brief The implementation type.
+   *  The implementation type of the quaternion.
+   */
+  typedef typename RotationQuaternion<PrimType_>::Implementation Implementation;
+
+  /*! \brief Flags of the valid representations.
+   */
+  enum Representation : std::uint8_t {
+    QUATERNION = 1,
+    MATRIX = 2,
+    EULER_ANGLES_ZYX = 4
+  };
+
+  /*! \brief Default constructor using identity rotation.
+   */
+  CachedRotation()
+    : quaternion_(), matrix_(), eulerAnglesZyx_(), valid_(QUATERNION | MATRIX | EULER_ANGLES_ZYX) {
+  }
+
+  /*! \brief Constructor using a rotation quaternion, which becomes authoritative.
+   */
+  explicit CachedRotation(const RotationQuaternion<Scalar>& quaternion)
+    : quaternion_(quaternion), matrix_(), eulerAnglesZyx_(), valid_(QUATERNION) {
+  }
+
+  /*! \brief Constructor using a rotation matrix, which becomes authoritative.
+   */
+  explicit CachedRotation(const RotationMatrix<Scalar>& matrix)
+    : quaternion_(), matrix_(matrix), eulerAnglesZyx_(), valid_(MATRIX) {
+  }
+
+  /*! \brief Constructor using Euler angles (ZYX), which become authoritative.
+   */
+  explicit CachedRotation(const EulerAnglesZyx<Scalar>& eulerAnglesZyx)
+    : quaternion_(), matrix_(), eulerAnglesZyx_(eulerAnglesZyx), valid_(EULER_ANGLES_ZYX) {
+  }
+
+  /*! \brief Constructor using another rotation.
+   *  \param other   other rotation
+   */
+  template<typename OtherDerived_>
+  inline explicit CachedRotation(const RotationBase<OtherDerived_>& other)
+    : CachedRotation(internal::ConversionTraits<CachedRotation, OtherDerived_>::convert(other.derived())) {
+  }
+
+  /*! \brief Assignment operator using another rotation.
+   *  \param other   other rotation
+   *  \returns reference
+   */
+  template<typename OtherDerived_>
+  CachedRotation& operator =(const RotationBase<OtherDerived_>& other) {
+    *this = internal::ConversionTraits<CachedRotation, OtherDerived_>::convert(other.derived());
+    return *this;
+  }
+
+  /*! \brief Returns the rotation quaternion, which is computed if it is not cached.
+   */
+  const RotationQuaternion<Scalar>& getRotationQuaternion() const {
+    if (!isValid(QUATERNION)) {
+      if (isValid(MATRIX)) {
+        quaternion_ = RotationQuaternion<Scalar>(matrix_);
+      } else {
+        quaternion_ = RotationQuaternion<Scalar>(eulerAnglesZyx_);
+      }
+      valid_ |= QUATERNION;
+    }
+    return quaternion_;
+  }
+
+  /*! \brief Returns the rotation matrix, which is computed if it is not cached.
+   */
+  const RotationMatrix<Scalar>& getRotationMatrix() const {
+    if (!isValid(MATRIX)) {
+      if (isValid(QUATERNION)) {
+        matrix_ = RotationMatrix<Scalar>(quaternion_);
+      } else {
+        matrix_ = RotationMatrix<Scalar>(eulerAnglesZyx_);
+      }
+      valid_ |= MATRIX;
+    }
+    return matrix_;
+  }
+
+  /*! \brief Returns the Euler angles (ZYX), which are computed if they are not cached.
+   */
+  const EulerAnglesZyx<Scalar>& getEulerAnglesZyx() const {
+    if (!isValid(EULER_ANGLES_ZYX)) {
+      if (isValid(QUATERNION)) {
+        eulerAnglesZyx_ = EulerAnglesZyx<Scalar>(quaternion_);
+      } else {
+        eulerAnglesZyx_ = EulerAnglesZyx<Scalar>(matrix_);
+      }
+      valid_ |= EULER_ANGLES_ZYX;
+    }
+    return eulerAnglesZyx_;
+  }
+
+  /*! \brief Sets the rotation quaternion, which becomes authoritative.
+   *  \returns reference
+   */
+  CachedRotation& setRotationQuaternion(const RotationQuaternion<Scalar>& quaternion) {
+    quaternion_ = quaternion;
+    valid_ = QUATERNION;
+    return *this;
+  }
+
+  /*! \brief Sets the rotation matrix, which becomes authoritative.
+   *  \returns reference
+   */
+  CachedRotation& setRotationMatrix(const RotationMatrix<Scalar>& matrix) {
+    matrix_ = matrix;
+    valid_ = MATRIX;
+    return *this;
+  }
+
+  /*! \brief Sets the Euler angles (ZYX), which become authoritative.
+   *  \returns reference
+   */
+  CachedRotation& setEulerAnglesZyx(const EulerAnglesZyx<Scalar>& eulerAnglesZyx) {
+    eulerAnglesZyx_ = eulerAnglesZyx;
+    valid_ = EULER_ANGLES_ZYX;
+    return *this;
+  }
+
+  /*! \brief Returns true if the representation is cached.
+   *  \param representation   flag of the representation
+   */
+  bool isValid(Representation representation) const {
+    return (valid_ & representation) != 0;
+  }
+
+  /*! \brief Returns the implementation of the rotation quaternion.
+   */
+  const Implementation& toImplementation() const {
+    return getRotationQuaternion().toImplementation();
+  }
+
+  /*! \brief Returns the inverse of the rotation.
+   *  The cached quaternion and matrix are inverted as well.
+   *  \returns inverse of the rotation
+   */
+  CachedRotation inverted() const {
+    CachedRotation inverse(*this);
+    inverse.invert();
+    return inverse;
+  }
+
+  /*! \brief Inverts the rotation.
+   *  \returns reference
+   */
+  CachedRotation& invert() {
+    if (!isValid(QUATERNION) && !isValid(MATRIX)) {
+      getRotationQuaternion();
+    }
+    if (isValid(QUATERNION)) {
+      quaternion_.invert();
+    }
+    if (isValid(MATRIX)) {
+      matrix_.invert();
+    }
+    valid_ &= (QUATERNION | MATRIX);
+    return *this;
+  }
+
+  /*! \brief Sets the rotation to identity.
+   *  \returns reference
+   */
+  CachedRotation& setIdentity() {
+    *this = CachedRotation();
+    return *this;
+  }
+
+  /*! \brief Returns a unique rotation with a positive real part of the quaternion.
+   *  This function is used to compare different rotations.
+   *  \returns copy of the rotation which is unique
+   */
+  CachedRotation getUnique() const {
+    return CachedRotation(getRotationQuaternion().getUnique());
+  }
+
+  /*! \brief Modifies the rotation such that it becomes unique.
+   *  \returns reference
+   */
+  CachedRotation& setUnique() {
+    *this = getUnique();
+    return *this;
+  }
+
+  /*! \brief Concenation operator.
+   *  \returns the concenation of two rotations
+   */
+  using RotationBase<CachedRotation<PrimType_>>::operator*;
+
+  /*! \brief Equivalence operator.
+   *  \returns true if two rotations are similar.
+   */
+  using RotationBase<CachedRotation<PrimType_>>::operator==;
+
+  /*! \brief Used for printing the object with std::cout.
+   *  \returns std::stream object
+   */
+  friend std::ostream& operator << (std::ostream& out, const CachedRotation& rotation) {
+    out << rotation.getRotationQuaternion();
+    return out;
+  }
+
+ private:
+  mutable RotationQuaternion<Scalar> quaternion_;
+  mutable RotationMatrix<Scalar> matrix_;
+  mutable EulerAnglesZyx<Scalar> eulerAnglesZyx_;
+  mutable std::uint8_t valid_;
+};
+
+//! \brief Cached rotation with double primitive type
+typedef CachedRotation<double> CachedRotationD;
+//! \brief Cached rotation with float primitive type
+typedef CachedRotation<float> CachedRotationF;
+
+
+namespace internal {
+
+template<typename PrimType_>
+class get_scalar<CachedRotation<PrimType_>> {
+ public:
+  typedef PrimType_ Scalar;
+};
+
+template<typename PrimType_>
+class get_matrix3X<CachedRotation<PrimType_>>{
+ public:
+  typedef int IndexType;
+
+  template <IndexType Cols>
+  using Matrix3X = Eigen::Matrix<PrimType_, 3, Cols>;
+};
+
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+ * Conversion Traits
+ * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
+template<typename DestPrimType_, typename Source_>
+class ConversionTraits<CachedRotation<DestPrimType_>, Source_> {
+ public:
+  inline static CachedRotation<DestPrimType_> convert(const Source_& rotation) {
+    return CachedRotation<DestPrimType_>(RotationQuaternion<DestPrimType_>(rotation));
+  }
+};
+
+template<typename DestPrimType_, typename SourcePrimType_>
+class ConversionTraits<CachedRotation<DestPrimType_>, RotationMatrix<SourcePrimType_>> {
+ public:
+  inline static CachedRotation<DestPrimType_> convert(const RotationMatrix<SourcePrimType_>& rotation) {
+    return CachedRotation<DestPrimType_>(RotationMatrix<DestPrimType_>(rotation));
+  }
+};
+
+template<typename DestPrimType_, typename SourcePrimType_>
+class ConversionTraits<CachedRotation<DestPrimType_>, EulerAnglesZyx<SourcePrimType_>> {
+ public:
+  inline static CachedRotation<DestPrimType_> convert(const EulerAnglesZyx<SourcePrimType_>& rotation) {
+    return CachedRotation<DestPrimType_>(EulerAnglesZyx<DestPrimType_>(rotation));
+  }
+};
+
+template<typename DestPrimType_, typename SourcePrimType_>
+class ConversionTraits<CachedRotation<DestPrimType_>, CachedRotation<SourcePrimType_>> {
+ public:
+  inline static CachedRotation<DestPrimType_> convert(const CachedRotation<SourcePrimType_>& rotation) {
+    if (rotation.isValid(CachedRotation<SourcePrimType_>::QUATERNION)) {
+      return CachedRotation<DestPrimType_>(RotationQuaternion<DestPrimType_>(rotation.getRotationQuaternion()));
+    }
+    if (rotation.isValid(CachedRotation<SourcePrimType_>::MATRIX)) {
+      return CachedRotation<DestPrimType_>(RotationMatrix<DestPrimType_>(rotation.getRotationMatrix()));
+    }
+    return CachedRotation<DestPrimType_>(EulerAnglesZyx<DestPrimType_>(rotation.getEulerAnglesZyx()));
+  }
+};
+
+template<typename Dest_, typename SourcePrimType_>
+class ConversionTraits<Dest_, CachedRotation<SourcePrimType_>> {
+ public:
+  inline static Dest_ convert(const CachedRotation<SourcePrimType_>& rotation) {
+    return Dest_(rotation.getRotationQuaternion());
+  }
+};
+
+template<typename DestPrimType_, typename SourcePrimType_>
+class ConversionTraits<RotationVector<DestPrimType_>, CachedRotation<SourcePrimType_>> {
+ public:
+  inline static RotationVector<DestPrimType_> convert(const CachedRotation<SourcePrimType_>& rotation) {
+    return RotationVector<DestPrimType_>(rotation.getRotationQuaternion());
+  }
+};
+
+template<typename DestPrimType_, typename SourcePrimType_>
+class ConversionTraits<RotationMatrix<DestPrimType_>, CachedRotation<SourcePrimType_>> {
+ public:
+  inline static RotationMatrix<DestPrimType_> convert(const CachedRotation<SourcePrimType_>& rotation) {
+    return RotationMatrix<DestPrimType_>(rotation.getRotationMatrix());
+  }
+};
+
+template<typename DestPrimType_, typename SourcePrimType_>
+class ConversionTraits<EulerAnglesZyx<DestPrimType_>, CachedRotation<SourcePrimType_>> {
+ public:
+  inline static EulerAnglesZyx<DestPrimType_> convert(const CachedRotation<SourcePrimType_>& rotation) {
+    return EulerAnglesZyx<DestPrimType_>(rotation.getEulerAnglesZyx());
+  }
+};
+
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+ * Multiplication Traits
+ * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
+template<typename PrimType_>
+class MultiplicationTraits<RotationBase<CachedRotation<PrimType_>>, RotationBase<CachedRotation<PrimType_>>> {
+ public:
+  //! Multiplies the matrices if only these are cached and the quaternions otherwise
+  inline static CachedRotation<PrimType_> mult(const CachedRotation<PrimType_>& lhs, const CachedRotation<PrimType_>& rhs) {
+    typedef CachedRotation<PrimType_> Rotation;
+    if (lhs.isValid(Rotation::MATRIX) && rhs.isValid(Rotation::MATRIX)
+        && !(lhs.isValid(Rotation::QUATERNION) && rhs.isValid(Rotation::QUATERNION))) {
+      return Rotation(lhs.getRotationMatrix()*rhs.getRotationMatrix());
+    }
+    return Rotation(lhs.getRotationQuaternion()*rhs.getRotationQuaternion());
+  }
+};
+
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+ * Rotation Traits
+ * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
+template<typename PrimType_>
+class RotationTraits<RotationBase<CachedRotation<PrimType_>>> {
+ public:
+  //! Uses the cached matrix, or the quaternion for a single vector if no matrix is cached
+  template<typename get_matrix3X<CachedRotation<PrimType_>>::IndexType Cols>
+  inline static typename get_matrix3X<CachedRotation<PrimType_>>::template Matrix3X<Cols> rotate(const RotationBase<CachedRotation<PrimType_>>& rotation, const typename get_matrix3X<CachedRotation<PrimType_>>::template Matrix3X<Cols>& m) {
+    return rotateMatrix(rotation.derived(), m);
+  }
+
+  template<typename Vector_>
+  inline static Vector_ rotate(const RotationBase<CachedRotation<PrimType_>>& rotation, const Vector_& vector) {
+    return static_cast<Vector_>(rotation.derived().rotate(vector.toImplementation()));
+  }
+
+ private:
+  inline static Eigen::Matrix<PrimType_, 3, 1> rotateMatrix(const CachedRotation<PrimType_>& rotation, const Eigen::Matrix<PrimType_, 3, 1>& vector) {
+    if (!rotation.isValid(CachedRotation<PrimType_>::MATRIX) && rotation.isValid(CachedRotation<PrimType_>::QUATERNION)) {
+      return rotation.getRotationQuaternion().toImplementation()._transformVector(vector);
+    }
+    return rotation.getRotationMatrix().toImplementation()*vector;
+  }
+
+  template<int Cols>
+  inline static Eigen::Matrix<PrimType_, 3, Cols> rotateMatrix(const CachedRotation<PrimType_>& rotation, const Eigen::Matrix<PrimType_, 3, Cols>& m) {
+    return rotation.getRotationMatrix().toImplementation()*m;
+  }
+};
+
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+ * Comparison Traits
+ * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
+template<typename PrimType_>
+class ComparisonTraits<CachedRotation<PrimType_>, CachedRotation<PrimType_>> {
+ public:
+  inline static bool isEqual(const CachedRotation<PrimType_>& left, const CachedRotation<PrimType_>& right) {
+    return left.getRotationQuaternion().toImplementation().coeffs() == right.getRotationQuaternion().toImplementation().coeffs();
+  }
+};
+
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+ * Fixing Traits
+ * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
+template<typename PrimType_>
+class FixingTraits<CachedRotation<PrimType_>> {
+ public:
+  inline static void fix(CachedRotation<PrimType_>& rotation) {
+    RotationQuaternion<PrimType_> quaternion = rotation.getRotationQuaternion();
+    quaternion.fix();
+    rotation.setRotationQuaternion(quaternion);
+  }
+};
+
+} // namespace internal
+} // namespace kindr
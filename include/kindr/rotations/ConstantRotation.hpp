@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include "kindr/phys_quant/PhysicalQuantities.hpp"
+#include "kindr/rotations/Rotation.hpp"
+
+namespace kindr {
+
+/*! \class ConstantPosition
+ *  \brief Position in 3D-space which can be used in constant expressions.
+ *
+ *  The kindr types store their coefficients in Eigen objects, which cannot be constructed at compile time.
+ *  This literal type can be used to define fixed offsets (e.g. sensor mounting positions) as constexpr
+ *  and is converted to a Position by toPosition().
+ *
+ *  \tparam PrimType_ the primitive type of the data (double or float)
+ *
+ *  \ingroup rotations
+ */
+template<typename PrimType_>
+class ConstantPosition {
+ private:
+  PrimType_ x_;
+  PrimType_ y_;
+  PrimType_ z_;
+ public:
+  typedef PrimType_ Scalar;
+
+  /*! \brief Default constructor using zero position.
+   */
+  constexpr ConstantPosition()
+    : x_(Scalar(0)), y_(Scalar(0)), z_(Scalar(0)) {
+  }
+
+  /*! \brief Constructor using three scalars.
+   */
+  constexpr ConstantPosition(Scalar x, Scalar y, Scalar z)
+    : x_(x), y_(y), z_(z) {
+  }
+
+  constexpr Scalar x() const {
+    return x_;
+  }
+
+  constexpr Scalar y() const {
+    return y_;
+  }
+
+  constexpr Scalar z() const {
+    return z_;
+  }
+
+  constexpr ConstantPosition operator +(const ConstantPosition& other) const {
+    return ConstantPosition(x_ + other.x_, y_ + other.y_, z_ + other.z_);
+  }
+
+  constexpr ConstantPosition operator -(const ConstantPosition& other) const {
+    return ConstantPosition(x_ - other.x_, y_ - other.y_, z_ - other.z_);
+  }
+
+  constexpr ConstantPosition operator -() const {
+    return ConstantPosition(-x_, -y_, -z_);
+  }
+
+  /*! \brief Converts to a position (not constexpr).
+   */
+  Position<Scalar, 3> toPosition() const {
+    return Position<Scalar, 3>(x_, y_, z_);
+  }
+};
+
+
+/*! \class ConstantRotationMatrix
+ *  \brief Rotation matrix which can be used in constant expressions.
+ *
+ *  The coefficients are not checked, the matrix has to be orthonormal.
+ *  The rotation is converted to a RotationMatrix by toRotation().
+ *
+ *  \tparam PrimType_ the primitive type of the data (double or float)
+ *
+ *  \ingroup rotations
+ */
+template<typename PrimType_>
+class ConstantRotationMatrix {
+ private:
+  PrimType_ m_[3][3];
+
+  constexpr PrimType_ product(int row, int col, const ConstantRotationMatrix& other) const {
+    return m_[row][0]*other.m_[0][col] + m_[row][1]*other.m_[1][col] + m_[row][2]*other.m_[2][col];
+  }
+ public:
+  typedef PrimType_ Scalar;
+
+  /*! \brief Default constructor using identity rotation.
+   */
+  constexpr ConstantRotationMatrix()
+    : m_{{Scalar(1), Scalar(0), Scalar(0)}, {Scalar(0), Scalar(1), Scalar(0)}, {Scalar(0), Scalar(0), Scalar(1)}} {
+  }
+
+  /*! \brief Constructor using the coefficients in row-major order.
+   */
+  constexpr ConstantRotationMatrix(Scalar r11, Scalar r12, Scalar r13,
+                                   Scalar r21, Scalar r22, Scalar r23,
+                                   Scalar r31, Scalar r32, Scalar r33)
+    : m_{{r11, r12, r13}, {r21, r22, r23}, {r31, r32, r33}} {
+  }
+
+  /*! \brief Returns the coefficient at the given row and column.
+   */
+  constexpr Scalar operator ()(int row, int col) const {
+    return m_[row][col];
+  }
+
+  /*! \brief Returns the inverse of the rotation, i.e. the transposed matrix.
+   */
+  constexpr ConstantRotationMatrix inverted() const {
+    return ConstantRotationMatrix(m_[0][0], m_[1][0], m_[2][0],
+                                  m_[0][1], m_[1][1], m_[2][1],
+                                  m_[0][2], m_[1][2], m_[2][2]);
+  }
+
+  /*! \brief Concatenates two rotations.
+   */
+  constexpr ConstantRotationMatrix operator *(const ConstantRotationMatrix& other) const {
+    return ConstantRotationMatrix(product(0, 0, other), product(0, 1, other), product(0, 2, other),
+                                  product(1, 0, other), product(1, 1, other), product(1, 2, other),
+                                  product(2, 0, other), product(2, 1, other), product(2, 2, other));
+  }
+
+  /*! \brief Rotates a position.
+   */
+  constexpr ConstantPosition<Scalar> rotate(const ConstantPosition<Scalar>& position) const {
+    return ConstantPosition<Scalar>(m_[0][0]*position.x() + m_[0][1]*position.y() + m_[0][2]*position.z(),
+                                    m_[1][0]*position.x() + m_[1][1]*position.y() + m_[1][2]*position.z(),
+                                    m_[2][0]*position.x() + m_[2][1]*position.y() + m_[2][2]*position.z());
+  }
+
+  /*! \brief Rotates a position in the inverse direction.
+   */
+  constexpr ConstantPosition<Scalar> inverseRotate(const ConstantPosition<Scalar>& position) const {
+    return inverted().rotate(position);
+  }
+
+  /*! \brief Converts to a rotation matrix (not constexpr).
+   */
+  RotationMatrix<Scalar> toRotation() const {
+    return RotationMatrix<Scalar>(m_[0][0], m_[0][1], m_[0][2],
+                                  m_[1][0], m_[1][1], m_[1][2],
+                                  m_[2][0], m_[2][1], m_[2][2]);
+  }
+};
+
+
+/*! \class ConstantRotationQuaternion
+ *  \brief Rotation quaternion which can be used in constant expressions.
+ *
+ *  The quaternion is not normalized, the coefficients have to be of unit length.
+ *  The convention is the same as for RotationQuaternion, i.e. the concatenation uses the Hamilton product
+ *  and getRotationMatrix() returns the same matrix as RotationMatrix(RotationQuaternion(w,x,y,z)).
+ *  The rotation is converted to a RotationQuaternion by toRotation().
+ *
+ *  \tparam PrimType_ the primitive type of the data (double or float)
+ *
+ *  \ingroup rotations
+ */
+template<typename PrimType_>
+class ConstantRotationQuaternion {
+ private:
+  PrimType_ w_;
+  PrimType_ x_;
+  PrimType_ y_;
+  PrimType_ z_;
+ public:
+  typedef PrimType_ Scalar;
+
+  /*! \brief Default constructor using identity rotation.
+   */
+  constexpr ConstantRotationQuaternion()
+    : w_(Scalar(1)), x_(Scalar(0)), y_(Scalar(0)), z_(Scalar(0)) {
+  }
+
+  /*! \brief Constructor using four scalars.
+   *  \param w     first entry of the quaternion = cos(phi/2)
+   *  \param x     second entry of the quaternion = n1*sin(phi/2)
+   *  \param y     third entry of the quaternion = n2*sin(phi/2)
+   *  \param z     fourth entry of the quaternion = n3*sin(phi/2)
+   */
+  constexpr ConstantRotationQuaternion(Scalar w, Scalar x, Scalar y, Scalar z)
+    : w_(w), x_(x), y_(y), z_(z) {
+  }
+
+  constexpr Scalar w() const {
+    return w_;
+  }
+
+  constexpr Scalar x() const {
+    return x_;
+  }
+
+  constexpr Scalar y() const {
+    return y_;
+  }
+
+  constexpr Scalar z() const {
+    return z_;
+  }
+
+  /*! \brief Returns the inverse of the rotation, i.e. the conjugated quaternion.
+   */
+  constexpr ConstantRotationQuaternion inverted() const {
+    return ConstantRotationQuaternion(w_, -x_, -y_, -z_);
+  }
+
+  /*! \brief Concatenates two rotations.
+   */
+  constexpr ConstantRotationQuaternion operator *(const ConstantRotationQuaternion& other) const {
+    return ConstantRotationQuaternion(w_*other.w_ - x_*other.x_ - y_*other.y_ - z_*other.z_,
+                                      w_*other.x_ + x_*other.w_ + y_*other.z_ - z_*other.y_,
+                                      w_*other.y_ - x_*other.z_ + y_*other.w_ + z_*other.x_,
+                                      w_*other.z_ + x_*other.y_ - y_*other.x_ + z_*other.w_);
+  }
+
+  /*! \brief Returns the corresponding rotation matrix.
+   */
+  constexpr ConstantRotationMatrix<Scalar> getRotationMatrix() const {
+    return ConstantRotationMatrix<Scalar>(
+        Scalar(1) - Scalar(2)*(y_*y_ + z_*z_), Scalar(2)*(x_*y_ - w_*z_), Scalar(2)*(x_*z_ + w_*y_),
+        Scalar(2)*(x_*y_ + w_*z_), Scalar(1) - Scalar(2)*(x_*x_ + z_*z_), Scalar(2)*(y_*z_ - w_*x_),
+        Scalar(2)*(x_*z_ - w_*y_), Scalar(2)*(y_*z_ + w_*x_), Scalar(1) - Scalar(2)*(x_*x_ + y_*y_));
+  }
+
+  /*! \brief Rotates a position.
+   */
+  constexpr ConstantPosition<Scalar> rotate(const ConstantPosition<Scalar>& position) const {
+    return getRotationMatrix().rotate(position);
+  }
+
+  /*! \brief Rotates a position in the inverse direction.
+   */
+  constexpr ConstantPosition<Scalar> inverseRotate(const ConstantPosition<Scalar>& position) const {
+    return inverted().rotate(position);
+  }
+
+  /*! \brief Converts to a rotation quaternion (not constexpr).
+   */
+  RotationQuaternion<Scalar> toRotation() const {
+    return RotationQuaternion<Scalar>(w_, x_, y_, z_);
+  }
+};
+
+typedef ConstantPosition<double> ConstantPositionD;
+typedef ConstantPosition<float> ConstantPositionF;
+typedef ConstantRotationMatrix<double> ConstantRotationMatrixD;
+typedef ConstantRotationMatrix<float> ConstantRotationMatrixF;
+typedef ConstantRotationQuaternion<double> ConstantRotationQuaternionD;
+typedef ConstantRotationQuaternion<float> ConstantRotationQuaternionF;
+
+} // namespace kindr
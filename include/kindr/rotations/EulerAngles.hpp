@@ -0,0 +1,711 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <cmath>
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include "kindr/common/common.hpp"
+#include "kindr/common/assert_macros_eigen.hpp"
+#include "kindr/rotations/Rotation.hpp"
+
+namespace kindr {
+
+namespace internal {
+
+/*! \brief Compile-time description of an Euler angle sequence R = R_A1(a)*R_A2(b)*R_A3(c) with intrinsic axes.
+ *  Sequences with A1 == A3 are proper Euler angles, all others are Tait-Bryan angles.
+ *  (only for advanced users)
+ */
+template<int A1_, int A2_, int A3_>
+struct EulerAnglesSequence {
+  static_assert(0 <= A1_ && A1_ < 3 && 0 <= A2_ && A2_ < 3 && 0 <= A3_ && A3_ < 3, "The axes have to be 0 (x), 1 (y) or 2 (z)!");
+  static_assert(A1_ != A2_ && A2_ != A3_, "Consecutive axes have to be different!");
+
+  //! True for proper Euler angles (e.g. ZXZ), false for Tait-Bryan angles (e.g. ZYX)
+  static constexpr bool isProper = (A1_ == A3_);
+  //! First axis
+  static constexpr int i = A1_;
+  //! Second axis
+  static constexpr int j = A2_;
+  //! Remaining axis, which is the third axis for Tait-Bryan angles
+  static constexpr int k = 3 - A1_ - A2_;
+  //! +1 if (i,j,k) is a cyclic permutation of (x,y,z), -1 otherwise
+  static constexpr int sign = (A2_ == (A1_ + 1) % 3) ? 1 : -1;
+};
+
+template<int Axis_, typename PrimType_>
+inline Eigen::Matrix<PrimType_, 3, 3> getElementaryMatrix(PrimType_ angle);
+
+/*! \brief Returns the angles in a gimbal lock, where the first and third axis coincide.
+ *  The third angle is set to zero and the first angle is extracted from R*R_A2(b)^T = R_A1(a).
+ *  (only for advanced users)
+ */
+template<typename PrimType_, typename Sequence_>
+inline Eigen::Matrix<PrimType_, 3, 1> getGimbalLockAngles(const Eigen::Matrix<PrimType_, 3, 3>& R, PrimType_ b) {
+  using std::atan2;
+  const int i = Sequence_::i;
+  const int u = (i + 1) % 3;
+  const int v = (i + 2) % 3;
+  const Eigen::Matrix<PrimType_, 3, 3> R1 = R*getElementaryMatrix<Sequence_::j>(b).transpose();
+  return Eigen::Matrix<PrimType_, 3, 1>(atan2(R1(v,u), R1(u,u)), b, PrimType_(0));
+}
+
+/*! \brief Extracts the angles of a sequence from a rotation matrix.
+ *  The angles lie in (-pi,pi],[-pi/2,pi/2],(-pi,pi] for Tait-Bryan and in (-pi,pi],[0,pi],(-pi,pi] for proper Euler angles.
+ *  In a gimbal lock, the third angle is set to zero.
+ *  (only for advanced users)
+ */
+template<typename PrimType_, typename Sequence_, bool IsProper_ = Sequence_::isProper>
+class EulerAnglesExtraction;
+
+template<typename PrimType_, typename Sequence_>
+class EulerAnglesExtraction<PrimType_, Sequence_, false> {
+ public:
+  inline static Eigen::Matrix<PrimType_, 3, 1> fromMatrix(const Eigen::Matrix<PrimType_, 3, 3>& R) {
+    using std::atan2;
+    using std::sqrt;
+    const int i = Sequence_::i, j = Sequence_::j, k = Sequence_::k;
+    const PrimType_ s = PrimType_(Sequence_::sign);
+    const PrimType_ cosB = sqrt(R(i,i)*R(i,i) + R(i,j)*R(i,j));
+    const PrimType_ b = atan2(s*R(i,k), cosB);
+    if (cosB < internal::NumTraits<PrimType_>::dummy_precision()) {
+      return getGimbalLockAngles<PrimType_, Sequence_>(R, b);
+    }
+    return Eigen::Matrix<PrimType_, 3, 1>(atan2(-s*R(j,k), R(k,k)), b, atan2(-s*R(i,j), R(i,i)));
+  }
+};
+
+template<typename PrimType_, typename Sequence_>
+class EulerAnglesExtraction<PrimType_, Sequence_, true> {
+ public:
+  inline static Eigen::Matrix<PrimType_, 3, 1> fromMatrix(const Eigen::Matrix<PrimType_, 3, 3>& R) {
+    using std::atan2;
+    using std::sqrt;
+    const int i = Sequence_::i, j = Sequence_::j, k = Sequence_::k;
+    const PrimType_ s = PrimType_(Sequence_::sign);
+    const PrimType_ sinB = sqrt(R(i,j)*R(i,j) + R(i,k)*R(i,k));
+    const PrimType_ b = atan2(sinB, R(i,i));
+    if (sinB < internal::NumTraits<PrimType_>::dummy_precision()) {
+      return getGimbalLockAngles<PrimType_, Sequence_>(R, b);
+    }
+    return Eigen::Matrix<PrimType_, 3, 1>(atan2(R(j,i), -s*R(k,i)), b, atan2(R(i,j), s*R(i,k)));
+  }
+};
+
+/*! \brief Composes the rotation matrix R = R_A1(a)*R_A2(b)*R_A3(c) of a sequence in closed form.
+ *  The entries are those of XYZ (Tait-Bryan) or XYX (proper) with the axes relabeled to (i,j,k).
+ *  Odd permutations of the axes flip the signs of the sines.
+ *  (only for advanced users)
+ */
+template<typename PrimType_, typename Sequence_, bool IsProper_ = Sequence_::isProper>
+class EulerAnglesComposition;
+
+template<typename PrimType_, typename Sequence_>
+class EulerAnglesComposition<PrimType_, Sequence_, false> {
+ public:
+  inline static Eigen::Matrix<PrimType_, 3, 3> toMatrix(PrimType_ a, PrimType_ b, PrimType_ c) {
+    using std::sin;
+    using std::cos;
+    const int i = Sequence_::i, j = Sequence_::j, k = Sequence_::k;
+    const PrimType_ s = PrimType_(Sequence_::sign);
+    const PrimType_ ca = cos(a), cb = cos(b), cc = cos(c);
+    const PrimType_ sa = s*sin(a), sb = s*sin(b), sc = s*sin(c);
+    Eigen::Matrix<PrimType_, 3, 3> R;
+    R(i,i) = cb*cc;
+    R(i,j) = -cb*sc;
+    R(i,k) = sb;
+    R(j,i) = ca*sc + sa*sb*cc;
+    R(j,j) = ca*cc - sa*sb*sc;
+    R(j,k) = -sa*cb;
+    R(k,i) = sa*sc - ca*sb*cc;
+    R(k,j) = sa*cc + ca*sb*sc;
+    R(k,k) = ca*cb;
+    return R;
+  }
+};
+
+template<typename PrimType_, typename Sequence_>
+class EulerAnglesComposition<PrimType_, Sequence_, true> {
+ public:
+  inline static Eigen::Matrix<PrimType_, 3, 3> toMatrix(PrimType_ a, PrimType_ b, PrimType_ c) {
+    using std::sin;
+    using std::cos;
+    const int i = Sequence_::i, j = Sequence_::j, k = Sequence_::k;
+    const PrimType_ s = PrimType_(Sequence_::sign);
+    const PrimType_ ca = cos(a), cb = cos(b), cc = cos(c);
+    const PrimType_ sa = s*sin(a), sb = s*sin(b), sc = s*sin(c);
+    Eigen::Matrix<PrimType_, 3, 3> R;
+    R(i,i) = cb;
+    R(i,j) = sb*sc;
+    R(i,k) = sb*cc;
+    R(j,i) = sa*sb;
+    R(j,j) = ca*cc - sa*cb*sc;
+    R(j,k) = -ca*sc - sa*cb*cc;
+    R(k,i) = -ca*sb;
+    R(k,j) = sa*cc + ca*cb*sc;
+    R(k,k) = ca*cb*cc - sa*sc;
+    return R;
+  }
+};
+
+/*! \brief Returns the quaternion of an elementary rotation about a coordinate axis.
+ *  (only for advanced users)
+ */
+template<int Axis_, typename PrimType_>
+inline Eigen::Quaternion<PrimType_> getElementaryQuaternion(PrimType_ angle) {
+  using std::sin;
+  using std::cos;
+  Eigen::Quaternion<PrimType_> q(cos(PrimType_(0.5)*angle), PrimType_(0), PrimType_(0), PrimType_(0));
+  q.vec()(Axis_) = sin(PrimType_(0.5)*angle);
+  return q;
+}
+
+/*! \brief Returns the rotation matrix of an elementary rotation about a coordinate axis.
+ *  (only for advanced users)
+ */
+template<int Axis_, typename PrimType_>
+inline Eigen::Matrix<PrimType_, 3, 3> getElementaryMatrix(PrimType_ angle) {
+  using std::sin;
+  using std::cos;
+  const int b = (Axis_ + 1) % 3;
+  const int c = (Axis_ + 2) % 3;
+  const PrimType_ ca = cos(angle);
+  const PrimType_ sa = sin(angle);
+  Eigen::Matrix<PrimType_, 3, 3> R = Eigen::Matrix<PrimType_, 3, 3>::Zero();
+  R(Axis_, Axis_) = PrimType_(1);
+  R(b, b) = ca;
+  R(b, c) = -sa;
+  R(c, b) = sa;
+  R(c, c) = ca;
+  return R;
+}
+
+} // namespace internal
+
+
+/*! \class EulerAngles
+ *  \brief Implementation of Euler angles for an arbitrary sequence of intrinsic rotations R = R_A1(a)*R_A2(b)*R_A3(c).
+ *
+ *  The conversions, rate mappings and the canonicalization are generated at compile time from the axis indices
+ *  (0: x, 1: y, 2: z) without run-time branching on the sequence.
+ *  All 12 sequences are supported, i.e. the six Tait-Bryan sequences (XYZ, XZY, YXZ, YZX, ZXY, ZYX)
+ *  and the six proper Euler sequences (XYX, XZX, YXY, YZY, ZXZ, ZYZ).
+ *
+ *  The sequences ZYX and XYZ are also available as the classes EulerAnglesZyx and EulerAnglesXyz, which
+ *  convert directly to and from EulerAngles<PrimType_, 2, 1, 0> and EulerAngles<PrimType_, 0, 1, 2>.
+ *  The following aliases are provided for the other sequences:
+ *   - EulerAnglesXzy, EulerAnglesYxz, EulerAnglesYzx, EulerAnglesZxy
+ *   - EulerAnglesXyx, EulerAnglesXzx, EulerAnglesYxy, EulerAnglesYzy, EulerAnglesZxz, EulerAnglesZyz
+ *
+ *  \tparam PrimType_ the primitive type of the data (double or float)
+ *  \tparam A1_ axis of the first rotation
+ *  \tparam A2_ axis of the second rotation
+ *  \tparam A3_ axis of the third rotation
+ *  \ingroup rotations
+ */
+template<typename PrimType_, int A1_, int A2_, int A3_>
+class EulerAngles : public RotationBase<EulerAngles<PrimType_, A1_, A2_, A3_>> {
+ private:
+  /*! \brief The base type.
+   */
+  typedef Eigen::Matrix<PrimType_, 3, 1> Base;
+
+  /*! \brief vector of Euler angles [a; b; c]
+   */
+  Base angles_;
+ public:
+  /*! \brief The implementation type.
+   *  The implementation type is always an Eigen object.
+   */
+  typedef Base Implementation;
+  /*! \brief The primitive type.
+   *  Float/Double
+   */
+  typedef PrimType_ Scalar;
+
+  /*! \brief Euler angles as 3x1-matrix
+   */
+  typedef Base Vector;
+
+  /*! \brief The sequence of the axes.
+   */
+  typedef internal::EulerAnglesSequence<A1_, A2_, A3_> Sequence;
+
+  /*! \brief Default constructor using identity rotation.
+   */
+  EulerAngles()
+    : angles_(Base::Zero()) {
+  }
+
+  /*! \brief Constructor using three scalars.
+   *  \param a     first rotation angle around axis A1
+   *  \param b     second rotation angle around axis A2'
+   *  \param c     third rotation angle around axis A3''
+   */
+  EulerAngles(Scalar a, Scalar b, Scalar c)
+    : angles_(a, b, c) {
+  }
+
+  /*! \brief Constructor using Eigen::Matrix.
+   *  \param other   Eigen::Matrix<PrimType_,3,1> [a; b; c]
+   */
+  explicit EulerAngles(const Base& other)
+    : angles_(other) {
+  }
+
+  /*! \brief Constructor using another rotation.
+   *  \param other   other rotation
+   */
+  template<typename OtherDerived_>
+  inline explicit EulerAngles(const RotationBase<OtherDerived_>& other)
+    : angles_(internal::ConversionTraits<EulerAngles, OtherDerived_>::convert(other.derived()).toImplementation()) {
+  }
+
+  /*! \brief Assignment operator using another rotation.
+   *  \param other   other rotation
+   *  \returns referece
+   */
+  template<typename OtherDerived_>
+  EulerAngles& operator =(const RotationBase<OtherDerived_>& other) {
+    this->toImplementation() = internal::ConversionTraits<EulerAngles, OtherDerived_>::convert(other.derived()).toImplementation();
+    return *this;
+  }
+
+  /*! \brief Returns the inverse of the rotation.
+   *  \returns the inverse of the rotation
+   */
+  EulerAngles inverted() const {
+    return EulerAngles(RotationMatrix<PrimType_>(getRotationMatrix().transpose()));
+  }
+
+  /*! \brief Inverts the rotation.
+   *  \returns reference
+   */
+  EulerAngles& invert() {
+    *this = this->inverted();
+    return *this;
+  }
+
+  /*! \brief Returns the Euler angles in a vector.
+   *  \returns  vector Eigen::Matrix<Scalar,3, 1>
+   */
+  inline const Vector vector() const {
+    return this->toImplementation();
+  }
+
+  /*! \brief Cast to the implementation type.
+   *  \returns the implementation for direct manipulation (recommended only for advanced users)
+   */
+  inline Base& toImplementation() {
+    return static_cast<Base&>(angles_);
+  }
+
+  /*! \brief Cast to the implementation type.
+   *  \returns the implementation for direct manipulation (recommended only for advanced users)
+   */
+  inline const Base& toImplementation() const {
+    return static_cast<const Base&>(angles_);
+  }
+
+  /*! \brief Gets the first angle (around axis A1).
+   */
+  inline Scalar a() const {
+    return angles_(0);
+  }
+
+  /*! \brief Gets the second angle (around axis A2').
+   */
+  inline Scalar b() const {
+    return angles_(1);
+  }
+
+  /*! \brief Gets the third angle (around axis A3'').
+   */
+  inline Scalar c() const {
+    return angles_(2);
+  }
+
+  inline void setA(Scalar a) {
+    angles_(0) = a;
+  }
+
+  inline void setB(Scalar b) {
+    angles_(1) = b;
+  }
+
+  inline void setC(Scalar c) {
+    angles_(2) = c;
+  }
+
+  /*! \brief Sets the rotation to identity.
+   *  \returns reference
+   */
+  EulerAngles& setIdentity() {
+    angles_.setZero();
+    return *this;
+  }
+
+  /*! \brief Returns the rotation matrix R = R_A1(a)*R_A2(b)*R_A3(c).
+   */
+  Eigen::Matrix<PrimType_, 3, 3> getRotationMatrix() const {
+    return internal::EulerAnglesComposition<PrimType_, internal::EulerAnglesSequence<A1_, A2_, A3_>>::toMatrix(a(), b(), c());
+  }
+
+  /*! \brief Returns the quaternion q = q_A1(a)*q_A2(b)*q_A3(c).
+   */
+  Eigen::Quaternion<PrimType_> getQuaternion() const {
+    return internal::getElementaryQuaternion<A1_>(a())*internal::getElementaryQuaternion<A2_>(b())*internal::getElementaryQuaternion<A3_>(c());
+  }
+
+  /*! \brief Returns a unique Euler angles rotation.
+   *  The angles lie in [-pi,pi),[-pi/2,pi/2],[-pi,pi) for Tait-Bryan and in [-pi,pi),[0,pi],[-pi,pi) for proper Euler angles.
+   *  This function is used to compare different rotations.
+   *  \returns copy of the Euler angles rotation which is unique
+   */
+  EulerAngles getUnique() const {
+    using std::abs;
+    const Scalar pi = Scalar(M_PI);
+    Base angles(kindr::wrapPosNegPI<Scalar>(a()),
+                kindr::wrapPosNegPI<Scalar>(b()),
+                kindr::wrapPosNegPI<Scalar>(c())); // wrap all angles into [-pi,pi)
+    // The rotation (a+pi, pi-b, c+pi) is equal to (a, b, c) for Tait-Bryan and (a+pi, -b, c+pi) for proper Euler angles.
+    const bool flip = Sequence::isProper ? (angles(1) < Scalar(0)) : (abs(angles(1)) > pi/Scalar(2));
+    if (flip) {
+      angles(0) = kindr::wrapPosNegPI<Scalar>(angles(0) + pi);
+      angles(1) = Sequence::isProper ? -angles(1) : kindr::wrapPosNegPI<Scalar>(pi - angles(1));
+      angles(2) = kindr::wrapPosNegPI<Scalar>(angles(2) + pi);
+    }
+    return EulerAngles(angles);
+  }
+
+  /*! \brief Modifies the Euler angles rotation such that the angles are unique.
+   *  \returns reference
+   */
+  EulerAngles& setUnique() {
+    *this = getUnique();
+    return *this;
+  }
+
+  /*! \brief Returns the matrix which maps the time derivative of the angles to the angular velocity in the global frame.
+   *  The columns are the axes of the three rotations expressed in the global frame.
+   */
+  Eigen::Matrix<PrimType_, 3, 3> getMappingFromDiffToGlobalAngularVelocity() const {
+    Eigen::Matrix<PrimType_, 3, 3> mat;
+    const Eigen::Matrix<PrimType_, 3, 3> R1 = internal::getElementaryMatrix<A1_>(a());
+    mat.col(0) = Base::Unit(A1_);
+    mat.col(1) = R1.col(A2_);
+    mat.col(2) = R1*internal::getElementaryMatrix<A2_>(b()).col(A3_);
+    return mat;
+  }
+
+  /*! \brief Returns the matrix which maps the time derivative of the angles to the angular velocity in the local frame.
+   *  The columns are the axes of the three rotations expressed in the local frame.
+   */
+  Eigen::Matrix<PrimType_, 3, 3> getMappingFromDiffToLocalAngularVelocity() const {
+    Eigen::Matrix<PrimType_, 3, 3> mat;
+    const Eigen::Matrix<PrimType_, 3, 3> R3T = internal::getElementaryMatrix<A3_>(c()).transpose();
+    mat.col(0) = R3T*internal::getElementaryMatrix<A2_>(b()).row(A1_).transpose();
+    mat.col(1) = R3T.col(A2_);
+    mat.col(2) = Base::Unit(A3_);
+    return mat;
+  }
+
+  /*! \brief Returns the matrix which maps the angular velocity in the global frame to the time derivative of the angles.
+   *  An exception is thrown in case of a gimbal lock.
+   */
+  Eigen::Matrix<PrimType_, 3, 3> getMappingFromGlobalAngularVelocityToDiff() const {
+    return invertMapping(getMappingFromDiffToGlobalAngularVelocity());
+  }
+
+  /*! \brief Returns the matrix which maps the angular velocity in the local frame to the time derivative of the angles.
+   *  An exception is thrown in case of a gimbal lock.
+   */
+  Eigen::Matrix<PrimType_, 3, 3> getMappingFromLocalAngularVelocityToDiff() const {
+    return invertMapping(getMappingFromDiffToLocalAngularVelocity());
+  }
+
+  /*! \brief Concenation operator.
+   *  This is explicitly specified, because Eigen::Matrix provides also an operator*.
+   *  \returns the concenation of two rotations
+   */
+  using RotationBase<EulerAngles<PrimType_, A1_, A2_, A3_>>::operator*;
+
+  /*! \brief Equivalence operator.
+   *  This is explicitly specified, because Eigen::Matrix provides also an operator==.
+   *  \returns true if two rotations are similar.
+   */
+  using RotationBase<EulerAngles<PrimType_, A1_, A2_, A3_>>::operator==;
+
+  /*! \brief Used for printing the object with std::cout.
+   *  \returns std::stream object
+   */
+  friend std::ostream& operator << (std::ostream& out, const EulerAngles& angles) {
+    out << angles.toImplementation().transpose();
+    return out;
+  }
+
+ private:
+  static Eigen::Matrix<PrimType_, 3, 3> invertMapping(const Eigen::Matrix<PrimType_, 3, 3>& mapping) {
+    // The determinant is +-cos(b) for Tait-Bryan and +-sin(b) for proper Euler angles.
+    KINDR_ASSERT_TRUE(std::runtime_error, mapping.determinant() != PrimType_(0), "Gimbal lock: the mapping is singular!");
+    return mapping.inverse();
+  }
+};
+
+//! \brief Euler angles rotation (X,Z',Y'') class
+template <typename PrimType_>
+using EulerAnglesXzy = EulerAngles<PrimType_, 0, 2, 1>;
+//! \brief Euler angles rotation (Y,X',Z'') class
+template <typename PrimType_>
+using EulerAnglesYxz = EulerAngles<PrimType_, 1, 0, 2>;
+//! \brief Euler angles rotation (Y,Z',X'') class
+template <typename PrimType_>
+using EulerAnglesYzx = EulerAngles<PrimType_, 1, 2, 0>;
+//! \brief Euler angles rotation (Z,X',Y'') class
+template <typename PrimType_>
+using EulerAnglesZxy = EulerAngles<PrimType_, 2, 0, 1>;
+//! \brief Euler angles rotation (X,Y',X'') class
+template <typename PrimType_>
+using EulerAnglesXyx = EulerAngles<PrimType_, 0, 1, 0>;
+//! \brief Euler angles rotation (X,Z',X'') class
+template <typename PrimType_>
+using EulerAnglesXzx = EulerAngles<PrimType_, 0, 2, 0>;
+//! \brief Euler angles rotation (Y,X',Y'') class
+template <typename PrimType_>
+using EulerAnglesYxy = EulerAngles<PrimType_, 1, 0, 1>;
+//! \brief Euler angles rotation (Y,Z',Y'') class
+template <typename PrimType_>
+using EulerAnglesYzy = EulerAngles<PrimType_, 1, 2, 1>;
+//! \brief Euler angles rotation (Z,X',Z'') class
+template <typename PrimType_>
+using EulerAnglesZxz = EulerAngles<PrimType_, 2, 0, 2>;
+//! \brief Euler angles rotation (Z,Y',Z'') class
+template <typename PrimType_>
+using EulerAnglesZyz = EulerAngles<PrimType_, 2, 1, 2>;
+
+typedef EulerAnglesXzy<double> EulerAnglesXzyD;
+typedef EulerAnglesXzy<float> EulerAnglesXzyF;
+typedef EulerAnglesYxz<double> EulerAnglesYxzD;
+typedef EulerAnglesYxz<float> EulerAnglesYxzF;
+typedef EulerAnglesYzx<double> EulerAnglesYzxD;
+typedef EulerAnglesYzx<float> EulerAnglesYzxF;
+typedef EulerAnglesZxy<double> EulerAnglesZxyD;
+typedef EulerAnglesZxy<float> EulerAnglesZxyF;
+typedef EulerAnglesXyx<double> EulerAnglesXyxD;
+typedef EulerAnglesXyx<float> EulerAnglesXyxF;
+typedef EulerAnglesXzx<double> EulerAnglesXzxD;
+typedef EulerAnglesXzx<float> EulerAnglesXzxF;
+typedef EulerAnglesYxy<double> EulerAnglesYxyD;
+typedef EulerAnglesYxy<float> EulerAnglesYxyF;
+typedef EulerAnglesYzy<double> EulerAnglesYzyD;
+typedef EulerAnglesYzy<float> EulerAnglesYzyF;
+typedef EulerAnglesZxz<double> EulerAnglesZxzD;
+typedef EulerAnglesZxz<float> EulerAnglesZxzF;
+typedef EulerAnglesZyz<double> EulerAnglesZyzD;
+typedef EulerAnglesZyz<float> EulerAnglesZyzF;
+
+
+namespace internal {
+
+template<typename PrimType_, int A1_, int A2_, int A3_>
+class get_scalar<EulerAngles<PrimType_, A1_, A2_, A3_>> {
+ public:
+  typedef PrimType_ Scalar;
+};
+
+template<typename PrimType_, int A1_, int A2_, int A3_>
+class get_matrix3X<EulerAngles<PrimType_, A1_, A2_, A3_>>{
+ public:
+  typedef int  IndexType;
+
+  template <IndexType Cols>
+  using Matrix3X = Eigen::Matrix<PrimType_, 3, Cols>;
+};
+
+/*! \brief Converts a rotation matrix to Euler angles of any sequence.
+ *  (only for advanced users)
+ */
+template<typename DestPrimType_, int A1_, int A2_, int A3_, typename SourcePrimType_>
+inline EulerAngles<DestPrimType_, A1_, A2_, A3_> getEulerAnglesFromMatrix(const Eigen::Matrix<SourcePrimType_, 3, 3>& R) {
+  typedef EulerAngles<DestPrimType_, A1_, A2_, A3_> Dest;
+  return Dest(EulerAnglesExtraction<SourcePrimType_, typename Dest::Sequence>::fromMatrix(R).template cast<DestPrimType_>());
+}
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+ * Conversion Traits
+ * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
+template<typename DestPrimType_, int A1_, int A2_, int A3_, typename SourcePrimType_>
+class ConversionTraits<EulerAngles<DestPrimType_, A1_, A2_, A3_>, AngleAxis<SourcePrimType_>> {
+ public:
+  inline static EulerAngles<DestPrimType_, A1_, A2_, A3_> convert(const AngleAxis<SourcePrimType_>& aa) {
+    return getEulerAnglesFromMatrix<DestPrimType_, A1_, A2_, A3_>(RotationMatrix<SourcePrimType_>(aa).toImplementation());
+  }
+};
+
+template<typename DestPrimType_, int A1_, int A2_, int A3_, typename SourcePrimType_>
+class ConversionTraits<EulerAngles<DestPrimType_, A1_, A2_, A3_>, RotationVector<SourcePrimType_>> {
+ public:
+  inline static EulerAngles<DestPrimType_, A1_, A2_, A3_> convert(const RotationVector<SourcePrimType_>& rotationVector) {
+    return getEulerAnglesFromMatrix<DestPrimType_, A1_, A2_, A3_>(RotationMatrix<SourcePrimType_>(rotationVector).toImplementation());
+  }
+};
+
+template<typename DestPrimType_, int A1_, int A2_, int A3_, typename SourcePrimType_>
+class ConversionTraits<EulerAngles<DestPrimType_, A1_, A2_, A3_>, RotationQuaternion<SourcePrimType_>> {
+ public:
+  inline static EulerAngles<DestPrimType_, A1_, A2_, A3_> convert(const RotationQuaternion<SourcePrimType_>& q) {
+    return getEulerAnglesFromMatrix<DestPrimType_, A1_, A2_, A3_>(q.toImplementation().toRotationMatrix());
+  }
+};
+
+template<typename DestPrimType_, int A1_, int A2_, int A3_, typename SourcePrimType_>
+class ConversionTraits<EulerAngles<DestPrimType_, A1_, A2_, A3_>, RotationMatrix<SourcePrimType_>> {
+ public:
+  inline static EulerAngles<DestPrimType_, A1_, A2_, A3_> convert(const RotationMatrix<SourcePrimType_>& R) {
+    return getEulerAnglesFromMatrix<DestPrimType_, A1_, A2_, A3_>(R.toImplementation());
+  }
+};
+
+template<typename DestPrimType_, int A1_, int A2_, int A3_, typename SourcePrimType_>
+class ConversionTraits<EulerAngles<DestPrimType_, A1_, A2_, A3_>, EulerAnglesZyx<SourcePrimType_>> {
+ public:
+  inline static EulerAngles<DestPrimType_, A1_, A2_, A3_> convert(const EulerAnglesZyx<SourcePrimType_>& zyx) {
+    return getEulerAnglesFromMatrix<DestPrimType_, A1_, A2_, A3_>(EulerAngles<SourcePrimType_, 2, 1, 0>(zyx.toImplementation()).getRotationMatrix());
+  }
+};
+
+template<typename DestPrimType_, typename SourcePrimType_>
+class ConversionTraits<EulerAngles<DestPrimType_, 2, 1, 0>, EulerAnglesZyx<SourcePrimType_>> {
+ public:
+  inline static EulerAngles<DestPrimType_, 2, 1, 0> convert(const EulerAnglesZyx<SourcePrimType_>& zyx) {
+    return EulerAngles<DestPrimType_, 2, 1, 0>(zyx.toImplementation().template cast<DestPrimType_>());
+  }
+};
+
+template<typename DestPrimType_, int A1_, int A2_, int A3_, typename SourcePrimType_>
+class ConversionTraits<EulerAngles<DestPrimType_, A1_, A2_, A3_>, EulerAnglesXyz<SourcePrimType_>> {
+ public:
+  inline static EulerAngles<DestPrimType_, A1_, A2_, A3_> convert(const EulerAnglesXyz<SourcePrimType_>& xyz) {
+    return getEulerAnglesFromMatrix<DestPrimType_, A1_, A2_, A3_>(EulerAngles<SourcePrimType_, 0, 1, 2>(xyz.toImplementation()).getRotationMatrix());
+  }
+};
+
+template<typename DestPrimType_, typename SourcePrimType_>
+class ConversionTraits<EulerAngles<DestPrimType_, 0, 1, 2>, EulerAnglesXyz<SourcePrimType_>> {
+ public:
+  inline static EulerAngles<DestPrimType_, 0, 1, 2> convert(const EulerAnglesXyz<SourcePrimType_>& xyz) {
+    return EulerAngles<DestPrimType_, 0, 1, 2>(xyz.toImplementation().template cast<DestPrimType_>());
+  }
+};
+
+template<typename DestPrimType_, int A1_, int A2_, int A3_, typename SourcePrimType_, int B1_, int B2_, int B3_>
+class ConversionTraits<EulerAngles<DestPrimType_, A1_, A2_, A3_>, EulerAngles<SourcePrimType_, B1_, B2_, B3_>> {
+ public:
+  inline static EulerAngles<DestPrimType_, A1_, A2_, A3_> convert(const EulerAngles<SourcePrimType_, B1_, B2_, B3_>& angles) {
+    return getEulerAnglesFromMatrix<DestPrimType_, A1_, A2_, A3_>(angles.getRotationMatrix());
+  }
+};
+
+template<typename DestPrimType_, int A1_, int A2_, int A3_, typename SourcePrimType_>
+class ConversionTraits<EulerAngles<DestPrimType_, A1_, A2_, A3_>, EulerAngles<SourcePrimType_, A1_, A2_, A3_>> {
+ public:
+  inline static EulerAngles<DestPrimType_, A1_, A2_, A3_> convert(const EulerAngles<SourcePrimType_, A1_, A2_, A3_>& angles) {
+    return EulerAngles<DestPrimType_, A1_, A2_, A3_>(angles.toImplementation().template cast<DestPrimType_>());
+  }
+};
+
+template<typename DestPrimType_, typename SourcePrimType_, int A1_, int A2_, int A3_>
+class ConversionTraits<AngleAxis<DestPrimType_>, EulerAngles<SourcePrimType_, A1_, A2_, A3_>> {
+ public:
+  inline static AngleAxis<DestPrimType_> convert(const EulerAngles<SourcePrimType_, A1_, A2_, A3_>& angles) {
+    return AngleAxis<DestPrimType_>(RotationQuaternion<DestPrimType_>(Eigen::Quaternion<DestPrimType_>(angles.getQuaternion().template cast<DestPrimType_>())));
+  }
+};
+
+template<typename DestPrimType_, typename SourcePrimType_, int A1_, int A2_, int A3_>
+class ConversionTraits<RotationVector<DestPrimType_>, EulerAngles<SourcePrimType_, A1_, A2_, A3_>> {
+ public:
+  inline static RotationVector<DestPrimType_> convert(const EulerAngles<SourcePrimType_, A1_, A2_, A3_>& angles) {
+    return RotationVector<DestPrimType_>(RotationQuaternion<DestPrimType_>(Eigen::Quaternion<DestPrimType_>(angles.getQuaternion().template cast<DestPrimType_>())));
+  }
+};
+
+template<typename DestPrimType_, typename SourcePrimType_, int A1_, int A2_, int A3_>
+class ConversionTraits<RotationQuaternion<DestPrimType_>, EulerAngles<SourcePrimType_, A1_, A2_, A3_>> {
+ public:
+  inline static RotationQuaternion<DestPrimType_> convert(const EulerAngles<SourcePrimType_, A1_, A2_, A3_>& angles) {
+    return RotationQuaternion<DestPrimType_>(Eigen::Quaternion<DestPrimType_>(angles.getQuaternion().template cast<DestPrimType_>()));
+  }
+};
+
+template<typename DestPrimType_, typename SourcePrimType_, int A1_, int A2_, int A3_>
+class ConversionTraits<RotationMatrix<DestPrimType_>, EulerAngles<SourcePrimType_, A1_, A2_, A3_>> {
+ public:
+  inline static RotationMatrix<DestPrimType_> convert(const EulerAngles<SourcePrimType_, A1_, A2_, A3_>& angles) {
+    return RotationMatrix<DestPrimType_>(angles.getRotationMatrix().template cast<DestPrimType_>());
+  }
+};
+
+template<typename DestPrimType_, typename SourcePrimType_, int A1_, int A2_, int A3_>
+class ConversionTraits<EulerAnglesZyx<DestPrimType_>, EulerAngles<SourcePrimType_, A1_, A2_, A3_>> {
+ public:
+  inline static EulerAnglesZyx<DestPrimType_> convert(const EulerAngles<SourcePrimType_, A1_, A2_, A3_>& angles) {
+    return EulerAnglesZyx<DestPrimType_>(getEulerAnglesFromMatrix<DestPrimType_, 2, 1, 0>(angles.getRotationMatrix()).toImplementation());
+  }
+};
+
+template<typename DestPrimType_, typename SourcePrimType_>
+class ConversionTraits<EulerAnglesZyx<DestPrimType_>, EulerAngles<SourcePrimType_, 2, 1, 0>> {
+ public:
+  inline static EulerAnglesZyx<DestPrimType_> convert(const EulerAngles<SourcePrimType_, 2, 1, 0>& angles) {
+    return EulerAnglesZyx<DestPrimType_>(angles.toImplementation().template cast<DestPrimType_>());
+  }
+};
+
+template<typename DestPrimType_, typename SourcePrimType_, int A1_, int A2_, int A3_>
+class ConversionTraits<EulerAnglesXyz<DestPrimType_>, EulerAngles<SourcePrimType_, A1_, A2_, A3_>> {
+ public:
+  inline static EulerAnglesXyz<DestPrimType_> convert(const EulerAngles<SourcePrimType_, A1_, A2_, A3_>& angles) {
+    return EulerAnglesXyz<DestPrimType_>(getEulerAnglesFromMatrix<DestPrimType_, 0, 1, 2>(angles.getRotationMatrix()).toImplementation());
+  }
+};
+
+template<typename DestPrimType_, typename SourcePrimType_>
+class ConversionTraits<EulerAnglesXyz<DestPrimType_>, EulerAngles<SourcePrimType_, 0, 1, 2>> {
+ public:
+  inline static EulerAnglesXyz<DestPrimType_> convert(const EulerAngles<SourcePrimType_, 0, 1, 2>& angles) {
+    return EulerAnglesXyz<DestPrimType_>(angles.toImplementation().template cast<DestPrimType_>());
+  }
+};
+
+} // namespace internal
+} // namespace kindr
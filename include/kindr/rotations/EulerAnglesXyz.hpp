@@ -254,58 +254,59 @@ class EulerAnglesXyz : public RotationBase<EulerAnglesXyz<PrimType_>> {
    *  \returns copy of the Euler angles rotation which is unique
    */
   EulerAnglesXyz getUnique() const {
-    Base xyz(kindr::floatingPointModulo(x()+M_PI,2*M_PI)-M_PI,
-             kindr::floatingPointModulo(y()+M_PI,2*M_PI)-M_PI,
-             kindr::floatingPointModulo(z()+M_PI,2*M_PI)-M_PI); // wrap all angles into [-pi,pi)
+    Base xyz(kindr::wrapPosNegPI<Scalar>(x()),
+             kindr::wrapPosNegPI<Scalar>(y()),
+             kindr::wrapPosNegPI<Scalar>(z())); // wrap all angles into [-pi,pi)
 
-    const double tol = 1e-3;
+    const Scalar pi = Scalar(M_PI);
+    const Scalar tol = Scalar(1e-3);
 
     // wrap angles into [-pi,pi),[-pi/2,pi/2),[-pi,pi)
-    if(xyz.y() < -M_PI/2 - tol)
+    if(xyz.y() < -pi/2 - tol)
     {
-      if(xyz.x() < 0) {
-        xyz.x() = xyz.x() + M_PI;
+      if(xyz.x() < Scalar(0)) {
+        xyz.x() = xyz.x() + pi;
       } else {
-        xyz.x() = xyz.x() - M_PI;
+        xyz.x() = xyz.x() - pi;
       }
 
-      xyz.y() = -(xyz.y() + M_PI);
+      xyz.y() = -(xyz.y() + pi);
 
-      if(xyz.z() < 0) {
-        xyz.z() = xyz.z() + M_PI;
+      if(xyz.z() < Scalar(0)) {
+        xyz.z() = xyz.z() + pi;
       } else {
-        xyz.z() = xyz.z() - M_PI;
+        xyz.z() = xyz.z() - pi;
       }
     }
-    else if(-M_PI/2 - tol <= xyz.y() && xyz.y() <= -M_PI/2 + tol)
+    else if(-pi/2 - tol <= xyz.y() && xyz.y() <= -pi/2 + tol)
     {
       xyz.x() -= xyz.z();
-      xyz.z() = 0;
+      xyz.z() = Scalar(0);
     }
-    else if(-M_PI/2 + tol < xyz.y() && xyz.y() < M_PI/2 - tol)
+    else if(-pi/2 + tol < xyz.y() && xyz.y() < pi/2 - tol)
     {
       // ok
     }
-    else if(M_PI/2 - tol <= xyz.y() && xyz.y() <= M_PI/2 + tol)
+    else if(pi/2 - tol <= xyz.y() && xyz.y() <= pi/2 + tol)
     {
       // todo: M_PI/2 should not be in range, other formula?
       xyz.x() += xyz.z();
-      xyz.z() = 0;
+      xyz.z() = Scalar(0);
     }
     else // M_PI/2 + tol < xyz.y()
     {
-      if(xyz.x() < 0) {
-        xyz.x() = xyz.x() + M_PI;
+      if(xyz.x() < Scalar(0)) {
+        xyz.x() = xyz.x() + pi;
       } else {
-        xyz.x() = xyz.x() - M_PI;
+        xyz.x() = xyz.x() - pi;
       }
 
-      xyz.y() = -(xyz.y() - M_PI);
+      xyz.y() = -(xyz.y() - pi);
 
-      if(xyz.z() < 0) {
-        xyz.z() = xyz.z() + M_PI;
+      if(xyz.z() < Scalar(0)) {
+        xyz.z() = xyz.z() + pi;
       } else {
-        xyz.z() = xyz.z() - M_PI;
+        xyz.z() = xyz.z() - pi;
       }
     }
 
@@ -336,7 +337,7 @@ class EulerAnglesXyz : public RotationBase<EulerAnglesXyz<PrimType_>> {
     mat(1, 0) = -t2*t3;
     mat(1, 1) = t4;
     mat(2, 0) = sin(y);
-    mat(2, 2) = 1.0;
+    mat(2, 2) = PrimType_(1);
 
     return mat;
   }
@@ -351,7 +352,7 @@ class EulerAnglesXyz : public RotationBase<EulerAnglesXyz<PrimType_>> {
 
     const PrimType_ t2 = cos(y);
     KINDR_ASSERT_TRUE(std::runtime_error, t2 != PrimType_(0.0), "Gimbal lock: cos(y) is zero!");
-    const PrimType_ t3 = 1.0/t2;
+    const PrimType_ t3 = PrimType_(1)/t2;
     const PrimType_ t4 = sin(z);
     const PrimType_ t5 = cos(z);
     const PrimType_ t6 = sin(y);
@@ -361,7 +362,7 @@ class EulerAnglesXyz : public RotationBase<EulerAnglesXyz<PrimType_>> {
     mat(1,1) = t5;
     mat(2,0) = -t3*t5*t6;
     mat(2,1) = t3*t4*t6;
-    mat(2,2) = 1.0;
+    mat(2,2) = PrimType_(1);
 
     return mat;
   }
@@ -375,11 +376,11 @@ class EulerAnglesXyz : public RotationBase<EulerAnglesXyz<PrimType_>> {
     const PrimType_ z = this->z();
     const PrimType_ t2 = cos(y);
     KINDR_ASSERT_TRUE(std::runtime_error, t2 != PrimType_(0.0), "Gimbal lock: cos(y) is zero!");
-    const PrimType_ t3 = 1.0/t2;
+    const PrimType_ t3 = PrimType_(1)/t2;
     const PrimType_ t4 = sin(y);
     const PrimType_ t5 = cos(x);
     const PrimType_ t6 = sin(x);
-    mat(0,0) = 1.0;
+    mat(0,0) = PrimType_(1);
     mat(0,1) = t3*t4*t6;
     mat(0,2) = -t3*t4*t5;
     mat(1,1) = t5;
@@ -400,7 +401,7 @@ class EulerAnglesXyz : public RotationBase<EulerAnglesXyz<PrimType_>> {
     const PrimType_ t2 = sin(x);
     const PrimType_ t3 = cos(x);
     const PrimType_ t4 = cos(y);
-    mat(0,0) = 1.0;
+    mat(0,0) = PrimType_(1);
     mat(0,2) = sin(y);
     mat(1,1) = t3;
     mat(1,2) = -t2*t4;
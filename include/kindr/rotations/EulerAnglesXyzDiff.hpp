@@ -242,9 +242,9 @@ class EulerAnglesXyzDiff : public RotationDiffBase<EulerAnglesXyzDiff<PrimType_>
      const PrimType_ dz = this->z();
      const PrimType_ t2 = cos(y);
      KINDR_ASSERT_TRUE(std::runtime_error, t2 != PrimType_(0), "Gimbal lock: cos(y) is zero!");
-     const PrimType_ t3 = 1.0/t2;
+     const PrimType_ t3 = PrimType_(1)/t2;
      const PrimType_ t4 = cos(z);
-     const PrimType_ t5 = 1.0/(t2*t2);
+     const PrimType_ t5 = PrimType_(1)/(t2*t2);
      const PrimType_ t6 = sin(y);
      const PrimType_ t7 = sin(z);
      const PrimType_ t8 = t6*t6;
@@ -295,9 +295,9 @@ class EulerAnglesXyzDiff : public RotationDiffBase<EulerAnglesXyzDiff<PrimType_>
      const PrimType_ t4 = cos(y);
      const PrimType_ t5 = cos(x);
      KINDR_ASSERT_TRUE(std::runtime_error, t4 != PrimType_(0), "Gimbal lock: cos(y) is zero!");
-     const PrimType_ t6 = 1.0/(t4*t4);
+     const PrimType_ t6 = PrimType_(1)/(t4*t4);
      const PrimType_ t7 = t3*t3;
-     const PrimType_ t8 = 1.0/t4;
+     const PrimType_ t8 = PrimType_(1)/t4;
      mat(0,1) = dy*(t2+t2*t6*t7)+dx*t3*t5*t8;
      mat(0,2) = -dy*(t5+t5*t6*t7)+dx*t2*t3*t8;
      mat(1,1) = -dx*t2;
@@ -323,58 +323,59 @@ class EulerAnglesZyx : public RotationBase<EulerAnglesZyx<PrimType_>> {
    *  \returns copy of the Euler angles rotation which is unique
    */
   EulerAnglesZyx getUnique() const {
-    Base zyx(kindr::floatingPointModulo(z()+M_PI,2*M_PI)-M_PI,
-             kindr::floatingPointModulo(y()+M_PI,2*M_PI)-M_PI,
-             kindr::floatingPointModulo(x()+M_PI,2*M_PI)-M_PI); // wrap all angles into [-pi,pi)
+    Base zyx(kindr::wrapPosNegPI<Scalar>(z()),
+             kindr::wrapPosNegPI<Scalar>(y()),
+             kindr::wrapPosNegPI<Scalar>(x())); // wrap all angles into [-pi,pi)
 
-    const double tol = 1e-3;
+    const Scalar pi = Scalar(M_PI);
+    const Scalar tol = Scalar(1e-3);
 
     // wrap angles into [-pi,pi),[-pi/2,pi/2),[-pi,pi)
-    if(zyx.y() < -M_PI/2 - tol)
+    if(zyx.y() < -pi/2 - tol)
     {
-      if(zyx.x() < 0) {
-        zyx.x() = zyx.x() + M_PI;
+      if(zyx.x() < Scalar(0)) {
+        zyx.x() = zyx.x() + pi;
       } else {
-        zyx.x() = zyx.x() - M_PI;
+        zyx.x() = zyx.x() - pi;
       }
 
-      zyx.y() = -(zyx.y() + M_PI);
+      zyx.y() = -(zyx.y() + pi);
 
-      if(zyx.z() < 0) {
-        zyx.z() = zyx.z() + M_PI;
+      if(zyx.z() < Scalar(0)) {
+        zyx.z() = zyx.z() + pi;
       } else {
-        zyx.z() = zyx.z() - M_PI;
+        zyx.z() = zyx.z() - pi;
       }
     }
-    else if(-M_PI/2 - tol <= zyx.y() && zyx.y() <= -M_PI/2 + tol)
+    else if(-pi/2 - tol <= zyx.y() && zyx.y() <= -pi/2 + tol)
     {
       zyx.x() -= zyx.z();
-      zyx.z() = 0;
+      zyx.z() = Scalar(0);
     }
-    else if(-M_PI/2 + tol < zyx.y() && zyx.y() < M_PI/2 - tol)
+    else if(-pi/2 + tol < zyx.y() && zyx.y() < pi/2 - tol)
     {
       // ok
     }
-    else if(M_PI/2 - tol <= zyx.y() && zyx.y() <= M_PI/2 + tol)
+    else if(pi/2 - tol <= zyx.y() && zyx.y() <= pi/2 + tol)
     {
       // todo: M_PI/2 should not be in range, other formula?
       zyx.x() += zyx.z();
-      zyx.z() = 0;
+      zyx.z() = Scalar(0);
     }
     else // M_PI/2 + tol < zyx.y()
     {
-      if(zyx.x() < 0) {
-        zyx.x() = zyx.x() + M_PI;
+      if(zyx.x() < Scalar(0)) {
+        zyx.x() = zyx.x() + pi;
       } else {
-        zyx.x() = zyx.x() - M_PI;
+        zyx.x() = zyx.x() - pi;
       }
 
-      zyx.y() = -(zyx.y() - M_PI);
+      zyx.y() = -(zyx.y() - pi);
 
-      if(zyx.z() < 0) {
-        zyx.z() = zyx.z() + M_PI;
+      if(zyx.z() < Scalar(0)) {
+        zyx.z() = zyx.z() + pi;
       } else {
-        zyx.z() = zyx.z() - M_PI;
+        zyx.z() = zyx.z() - pi;
       }
     }
 
@@ -401,7 +402,7 @@ class EulerAnglesZyx : public RotationBase<EulerAnglesZyx<PrimType_>> {
     const PrimType_ t3 = cos(y);
     const PrimType_ t4 = sin(x);
     mat(0, 0) = -sin(y);
-    mat(0, 2) = 1.0;
+    mat(0, 2) = PrimType_(1);
     mat(1, 0) = t3*t4;
     mat(1, 1) = t2;
     mat(2, 0) = t2*t3;
@@ -417,7 +418,7 @@ class EulerAnglesZyx : public RotationBase<EulerAnglesZyx<PrimType_>> {
     const PrimType_ y = this->y();
     const PrimType_ z = this->z();
     const PrimType_ t2 = cos(y);
-    const PrimType_ t3 = 1.0/t2;
+    const PrimType_ t3 = PrimType_(1)/t2;
     KINDR_ASSERT_TRUE(std::runtime_error, t2 != PrimType_(0.0), "Gimbal lock: cos(y) is zero!");
     const PrimType_ t4 = cos(x);
     const PrimType_ t5 = sin(x);
@@ -426,7 +427,7 @@ class EulerAnglesZyx : public RotationBase<EulerAnglesZyx<PrimType_>> {
     mat(0,2) = t3*t4;
     mat(1,1) = t4;
     mat(1,2) = -t5;
-    mat(2,0) = 1.0;
+    mat(2,0) = PrimType_(1);
     mat(2,1) = t3*t5*t6;
     mat(2,2) = t3*t4*t6;
     return mat;
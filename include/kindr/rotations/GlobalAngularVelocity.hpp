@@ -226,7 +226,7 @@ template<typename PrimType_>
 class RotationDiffConversionTraits<GlobalAngularVelocity<PrimType_>, RotationQuaternionDiff<PrimType_>, RotationQuaternion<PrimType_>> {
  public:
   inline static GlobalAngularVelocity<PrimType_> convert(const RotationQuaternion<PrimType_>& rquat, const RotationQuaternionDiff<PrimType_>& rquatdiff) {
-    return GlobalAngularVelocity<PrimType_>(2.0*rquat.getGlobalQuaternionDiffMatrix()*rquatdiff.toQuaternion().vector());
+    return GlobalAngularVelocity<PrimType_>(PrimType_(2)*rquat.getGlobalQuaternionDiffMatrix()*rquatdiff.toQuaternion().vector());
   }
 };
 
@@ -222,7 +222,7 @@ template<typename PrimType_>
 class RotationDiffConversionTraits<LocalAngularVelocity<PrimType_>, RotationQuaternionDiff<PrimType_>, RotationQuaternion<PrimType_>> {
  public:
   inline static LocalAngularVelocity<PrimType_> convert(const RotationQuaternion<PrimType_>& rquat, const RotationQuaternionDiff<PrimType_>& rquatdiff) {
-    return LocalAngularVelocity<PrimType_>(2.0*rquat.getLocalQuaternionDiffMatrix()*rquatdiff.toQuaternion().vector());
+    return LocalAngularVelocity<PrimType_>(PrimType_(2)*rquat.getLocalQuaternionDiffMatrix()*rquatdiff.toQuaternion().vector());
   }
 };
 
@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <type_traits>
+
+#include <Eigen/Core>
+
+#include "kindr/rotations/Rotation.hpp"
+
+namespace kindr {
+
+/*! \class PrecisionPolicy
+ *  \brief Separates the storage precision of rotations from the precision used for computations.
+ *
+ *  Long chains of concatenations or integrations of float rotations drift, because every intermediate
+ *  result is rounded to float. The accumulators and batch kernels of this file carry out their computations
+ *  in ComputePrimType_ and round to StoragePrimType_ only once when the result is read.
+ *  If both types are the same, no conversions are generated and float computations stay in float.
+ *
+ *  \tparam StoragePrimType_ the primitive type of the stored data (double or float)
+ *  \tparam ComputePrimType_ the primitive type used for the computations (defaults to StoragePrimType_)
+ *
+ *  \ingroup rotations
+ */
+template<typename StoragePrimType_, typename ComputePrimType_ = StoragePrimType_>
+struct PrecisionPolicy {
+  //! The primitive type of the stored data
+  typedef StoragePrimType_ StorageScalar;
+  //! The primitive type used for the computations
+  typedef ComputePrimType_ ComputeScalar;
+};
+
+//! \brief Float storage and float computations
+typedef PrecisionPolicy<float> PrecisionPolicyF;
+//! \brief Float storage and double computations
+typedef PrecisionPolicy<float, double> PrecisionPolicyFD;
+//! \brief Double storage and double computations
+typedef PrecisionPolicy<double> PrecisionPolicyD;
+
+
+/*! \class RotationQuaternionAccumulator
+ *  \brief Accumulates concatenations and integrations of rotations in the compute precision of a policy.
+ *
+ *  \code{.cpp}
+ *  RotationQuaternionAccumulator<PrecisionPolicyFD> accumulator;
+ *  for (const RotationQuaternionF& increment : increments) {
+ *    accumulator.concatenate(increment);
+ *  }
+ *  const RotationQuaternionF rotation = accumulator.getRotation();
+ *  \endcode
+ *
+ *  \tparam Policy_ the precision policy
+ *
+ *  \ingroup rotations
+ */
+template<typename Policy_>
+class RotationQuaternionAccumulator {
+ public:
+  typedef typename Policy_::StorageScalar StorageScalar;
+  typedef typename Policy_::ComputeScalar ComputeScalar;
+  typedef RotationQuaternion<StorageScalar> Rotation;
+  typedef RotationQuaternion<ComputeScalar> ComputeRotation;
+
+  /*! \brief Default constructor using identity rotation.
+   */
+  RotationQuaternionAccumulator()
+    : rotation_() {
+  }
+
+  /*! \brief Constructor using an initial rotation.
+   *  \param rotation   initial rotation
+   */
+  template<typename OtherDerived_>
+  explicit RotationQuaternionAccumulator(const RotationBase<OtherDerived_>& rotation)
+    : rotation_(rotation.derived()) {
+  }
+
+  /*! \brief Concatenates the rotation on the right side, i.e. accumulated = accumulated*rotation.
+   *  \returns reference
+   */
+  template<typename OtherDerived_>
+  RotationQuaternionAccumulator& concatenate(const RotationBase<OtherDerived_>& rotation) {
+    rotation_ = rotation_*ComputeRotation(rotation.derived());
+    return *this;
+  }
+
+  /*! \brief Integrates a rotation vector with the box plus operation, i.e. accumulated = exp(vector)*accumulated.
+   *  \param vector   rotation vector (e.g. global angular velocity times time step)
+   *  \returns reference
+   */
+  template<typename OtherDerived_>
+  RotationQuaternionAccumulator& boxPlus(const Eigen::MatrixBase<OtherDerived_>& vector) {
+    rotation_ = rotation_.boxPlus(vector.template cast<ComputeScalar>());
+    return *this;
+  }
+
+  /*! \brief Normalizes the accumulated quaternion.
+   *  \returns reference
+   */
+  RotationQuaternionAccumulator& fix() {
+    rotation_.fix();
+    return *this;
+  }
+
+  /*! \brief Returns the accumulated rotation in compute precision.
+   */
+  const ComputeRotation& getComputeRotation() const {
+    return rotation_;
+  }
+
+  /*! \brief Returns the accumulated rotation rounded to storage precision.
+   */
+  Rotation getRotation() const {
+    ComputeRotation rotation(rotation_);
+    rotation.fix();
+    return Rotation(rotation);
+  }
+
+  /*! \brief Resets the accumulator to identity.
+   *  \returns reference
+   */
+  RotationQuaternionAccumulator& setIdentity() {
+    rotation_.setIdentity();
+    return *this;
+  }
+
+ private:
+  ComputeRotation rotation_;
+};
+
+
+/*! \brief Concatenates a range of rotations in the compute precision of a policy.
+ *  \param begin  iterator to the first (leftmost) rotation
+ *  \param end    iterator past the last rotation
+ *  \returns the concatenation rounded to storage precision
+ */
+template<typename Policy_, typename Iterator_>
+RotationQuaternion<typename Policy_::StorageScalar> concatenate(Iterator_ begin, Iterator_ end) {
+  RotationQuaternionAccumulator<Policy_> accumulator;
+  for (; begin != end; ++begin) {
+    accumulator.concatenate(*begin);
+  }
+  return accumulator.getRotation();
+}
+
+/*! \brief Rotates all columns of a 3xN matrix in the compute precision of a policy.
+ *  The rotation is converted once to a rotation matrix, such that the columns are rotated by a single
+ *  matrix product. If the compute and storage precision agree, no casts are generated.
+ *  \param rotation   rotation
+ *  \param matrix     3xN matrix of storage precision
+ *  \returns rotated matrix
+ */
+template<typename Policy_, typename Rotation_, typename Derived_>
+Eigen::Matrix<typename Policy_::StorageScalar, 3, Derived_::ColsAtCompileTime> rotateBatch(
+    const RotationBase<Rotation_>& rotation, const Eigen::MatrixBase<Derived_>& matrix) {
+  typedef typename Policy_::StorageScalar StorageScalar;
+  typedef typename Policy_::ComputeScalar ComputeScalar;
+  static_assert(std::is_same<typename Derived_::Scalar, StorageScalar>::value, "The matrix has to be of storage precision!");
+  const Eigen::Matrix<ComputeScalar, 3, 3> rotationMatrix = RotationMatrix<ComputeScalar>(rotation.derived()).matrix();
+  return (rotationMatrix*matrix.template cast<ComputeScalar>()).template cast<StorageScalar>();
+}
+
+} // namespace kindr
@@ -54,6 +54,9 @@ class EulerAnglesZyx;
 template<typename PrimType_>
 class EulerAnglesXyz;
 
+template<typename PrimType_, int A1_, int A2_, int A3_>
+class EulerAngles;
+
 
 namespace internal {
 
@@ -137,8 +140,9 @@ class ComparisonTraits<RotationBase<Left_>, RotationBase<Right_>> {
    *  \returns disparity angle in [-pi,pi) @todo: is this range correct?
    */
   inline static typename Left_::Scalar get_disparity_angle(const RotationBase<Left_>& left, const RotationBase<Right_>& right) {
+    using std::abs;
     typedef typename Left_::Scalar Scalar;
-    return std::abs(floatingPointModulo(AngleAxis<Scalar>(left.derived()*right.derived().inverted()).angle() + Scalar(M_PI), Scalar(2.0*M_PI))-M_PI);
+    return abs(wrapPosNegPI<Scalar>(AngleAxis<Scalar>(left.derived()*right.derived().inverted()).angle()));
   }
 };
 
@@ -232,5 +236,7 @@ class RandomTraits<RotationBase<Rotation_>> {
 #include "kindr/rotations/RotationMatrix.hpp"
 #include "kindr/rotations/EulerAnglesZyx.hpp"
 #include "kindr/rotations/EulerAnglesXyz.hpp"
+#include "kindr/rotations/EulerAngles.hpp"
+#include "kindr/rotations/AxisRotation.hpp"
 
 
@@ -0,0 +1,300 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <cmath>
+
+#include <Eigen/Core>
+
+#include "kindr/common/common.hpp"
+#include "kindr/common/assert_macros.hpp"
+#include "kindr/phys_quant/PhysicalQuantities.hpp"
+#include "kindr/rotations/Rotation.hpp"
+
+namespace kindr {
+
+/*! \class Rotation2D
+ *  \brief Planar rotation (SO(2)) about the z-axis.
+ *
+ *  The rotation is stored as the unit complex number (cos(angle), sin(angle)), such that concatenations and
+ *  rotations of points only need multiplications and additions.
+ *  The angle of a 3D rotation is obtained by the projection onto the z-axis, and getRotation3D() returns the
+ *  corresponding AxisRotationZ, which can be converted to all 3D rotation types, e.g.
+ *  \code{.cpp}
+ *  const RotationQuaternionD rotation3D(Rotation2DD(yaw).getRotation3D());
+ *  \endcode
+ *
+ *  The following typedefs are provided for convenience:
+ *   - \ref kindr::Rotation2DD "Rotation2DD" for primitive type double
+ *   - \ref kindr::Rotation2DF "Rotation2DF" for primitive type float
+ *
+ *  \tparam PrimType_ the primitive type of the data (double or float)
+ *  \ingroup rotations
+ */
+template<typename PrimType_>
+class Rotation2D {
+ public:
+  /*! \brief The primitive type.
+   *  Float/Double
+   */
+  typedef PrimType_ Scalar;
+
+  //! 2D vector
+  typedef Eigen::Matrix<Scalar, 2, 1> Vector2;
+
+  //! 2x2 rotation matrix
+  typedef Eigen::Matrix<Scalar, 2, 2> Matrix2;
+
+  //! 2xN matrix of points
+  template<int Cols_>
+  using Matrix2X = Eigen::Matrix<Scalar, 2, Cols_>;
+
+  /*! \brief Default constructor using identity rotation.
+   */
+  Rotation2D()
+    : cosAngle_(Scalar(1)), sinAngle_(Scalar(0)) {
+  }
+
+  /*! \brief Constructor using the angle.
+   *  \param angle   rotation angle
+   */
+  explicit Rotation2D(Scalar angle) {
+    setAngle(angle);
+  }
+
+  /*! \brief Constructor using the cosine and sine of the angle.
+   *  The pair has to have unit norm.
+   *  \param cosAngle   cosine of the angle
+   *  \param sinAngle   sine of the angle
+   */
+  Rotation2D(Scalar cosAngle, Scalar sinAngle)
+    : cosAngle_(cosAngle), sinAngle_(sinAngle) {
+    KINDR_ASSERT_SCALAR_NEAR_DBG(std::runtime_error, cosAngle*cosAngle + sinAngle*sinAngle, Scalar(1), static_cast<Scalar>(1e-4), "The complex number is not normalized!");
+  }
+
+  /*! \brief Constructor using a 2x2 rotation matrix.
+   *  \param matrix   rotation matrix
+   */
+  explicit Rotation2D(const Matrix2& matrix)
+    : Rotation2D(matrix(0,0), matrix(1,0)) {
+  }
+
+  /*! \brief Constructor using a 3D rotation, which is projected onto the z-axis.
+   *  \param other   3D rotation
+   */
+  template<typename OtherDerived_>
+  explicit Rotation2D(const RotationBase<OtherDerived_>& other)
+    : Rotation2D(AxisRotationZ<Scalar>(other.derived()).angle()) {
+  }
+
+  /*! \returns the angle in [-pi,pi]
+   */
+  inline Scalar angle() const {
+    using std::atan2;
+    return atan2(sinAngle_, cosAngle_);
+  }
+
+  inline Scalar getCosAngle() const {
+    return cosAngle_;
+  }
+
+  inline Scalar getSinAngle() const {
+    return sinAngle_;
+  }
+
+  /*! \brief Sets the angle.
+   *  \returns reference
+   */
+  Rotation2D& setAngle(Scalar angle) {
+    using std::cos;
+    using std::sin;
+    cosAngle_ = cos(angle);
+    sinAngle_ = sin(angle);
+    return *this;
+  }
+
+  /*! \returns the 2x2 rotation matrix
+   */
+  inline Matrix2 getRotationMatrix() const {
+    Matrix2 matrix;
+    matrix << cosAngle_, -sinAngle_,
+              sinAngle_, cosAngle_;
+    return matrix;
+  }
+
+  /*! \returns the 3D rotation about the z-axis
+   */
+  inline AxisRotationZ<Scalar> getRotation3D() const {
+    return AxisRotationZ<Scalar>(2, angle(), sinAngle_, cosAngle_);
+  }
+
+  /*! \brief Returns the inverse of the rotation.
+   *  \returns the inverse of the rotation
+   */
+  inline Rotation2D inverted() const {
+    return Rotation2D(cosAngle_, -sinAngle_);
+  }
+
+  /*! \brief Inverts the rotation.
+   *  \returns reference
+   */
+  Rotation2D& invert() {
+    sinAngle_ = -sinAngle_;
+    return *this;
+  }
+
+  /*! \brief Sets the rotation to identity.
+   *  \returns reference
+   */
+  Rotation2D& setIdentity() {
+    cosAngle_ = Scalar(1);
+    sinAngle_ = Scalar(0);
+    return *this;
+  }
+
+  /*! \brief Concatenates two rotations.
+   *  \returns the concatenation of two rotations
+   */
+  inline Rotation2D operator *(const Rotation2D& other) const {
+    return Rotation2D(cosAngle_*other.cosAngle_ - sinAngle_*other.sinAngle_,
+                      sinAngle_*other.cosAngle_ + cosAngle_*other.sinAngle_);
+  }
+
+  /*! \brief Rotates a vector or a 2xN matrix of points.
+   *  \returns the rotated vector or matrix
+   */
+  template<int Cols_>
+  inline Matrix2X<Cols_> rotate(const Matrix2X<Cols_>& matrix) const {
+    Matrix2X<Cols_> result(2, matrix.cols());
+    result.row(0) = cosAngle_*matrix.row(0) - sinAngle_*matrix.row(1);
+    result.row(1) = sinAngle_*matrix.row(0) + cosAngle_*matrix.row(1);
+    return result;
+  }
+
+  /*! \brief Rotates a vector or a 2xN matrix of points in reverse.
+   *  \returns the reverse rotated vector or matrix
+   */
+  template<int Cols_>
+  inline Matrix2X<Cols_> inverseRotate(const Matrix2X<Cols_>& matrix) const {
+    return inverted().rotate(matrix);
+  }
+
+  /*! \brief Rotates a 2D kindr vector.
+   *  \returns the rotated vector
+   */
+  template<enum PhysicalType PhysicalType_>
+  inline Vector<PhysicalType_, Scalar, 2> rotate(const Vector<PhysicalType_, Scalar, 2>& vector) const {
+    return Vector<PhysicalType_, Scalar, 2>(rotate<1>(vector.toImplementation()));
+  }
+
+  /*! \brief Rotates a 2D kindr vector in reverse.
+   *  \returns the reverse rotated vector
+   */
+  template<enum PhysicalType PhysicalType_>
+  inline Vector<PhysicalType_, Scalar, 2> inverseRotate(const Vector<PhysicalType_, Scalar, 2>& vector) const {
+    return Vector<PhysicalType_, Scalar, 2>(inverseRotate<1>(vector.toImplementation()));
+  }
+
+  /*! \brief Sets the rotation using the exponential map, i.e. the angle.
+   *  \returns reference
+   */
+  Rotation2D& exponentialMap(Scalar angle) {
+    return setAngle(angle);
+  }
+
+  /*! \returns the logarithmic map, i.e. the angle in [-pi,pi]
+   */
+  inline Scalar logarithmicMap() const {
+    return angle();
+  }
+
+  /*! \brief Adds an angle to the rotation, i.e. exp(angle)*this.
+   *  \returns the perturbed rotation
+   */
+  inline Rotation2D boxPlus(Scalar angle) const {
+    return Rotation2D(angle)*(*this);
+  }
+
+  /*! \brief Returns the angle log(this*other^-1) in [-pi,pi].
+   */
+  inline Scalar boxMinus(const Rotation2D& other) const {
+    return ((*this)*other.inverted()).angle();
+  }
+
+  /*! \brief Interpolates along the shortest arc between this rotation (t=0) and another rotation (t=1).
+   *  \returns the interpolated rotation
+   */
+  inline Rotation2D interpolate(const Rotation2D& other, Scalar t) const {
+    return boxPlus(t*other.boxMinus(*this));
+  }
+
+  /*! \returns the absolute angle of this*other^-1 in [0,pi]
+   */
+  inline Scalar getDisparityAngle(const Rotation2D& other) const {
+    using std::abs;
+    return abs(boxMinus(other));
+  }
+
+  /*! \brief Compares two rotations with a tolerance.
+   *  \returns true if the disparity angle is smaller than the tolerance
+   */
+  inline bool isNear(const Rotation2D& other, Scalar tol) const {
+    return getDisparityAngle(other) < tol;
+  }
+
+  /*! \brief Normalizes the complex number to remove round-off errors of long concatenations.
+   *  \returns reference
+   */
+  Rotation2D& fix() {
+    using std::sqrt;
+    const Scalar norm = sqrt(cosAngle_*cosAngle_ + sinAngle_*sinAngle_);
+    cosAngle_ /= norm;
+    sinAngle_ /= norm;
+    return *this;
+  }
+
+  /*! \brief Used for printing the object with std::cout.
+   *  \returns std::stream object
+   */
+  friend std::ostream& operator << (std::ostream& out, const Rotation2D& rotation) {
+    out << rotation.angle();
+    return out;
+  }
+
+ private:
+  Scalar cosAngle_;
+  Scalar sinAngle_;
+};
+
+//! \brief Planar rotation with primitive type double
+typedef Rotation2D<double> Rotation2DD;
+//! \brief Planar rotation with primitive type float
+typedef Rotation2D<float> Rotation2DF;
+
+} // namespace kindr
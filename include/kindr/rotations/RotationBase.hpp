@@ -28,6 +28,8 @@
 
 #pragma once
 
+#include <utility>
+
 #include "kindr/common/common.hpp"
 #include "kindr/quaternions/QuaternionBase.hpp"
 #include "kindr/vectors/VectorBase.hpp"
@@ -246,10 +248,12 @@ class RotationBase {
 
 
   /*! \brief Concatenates two rotations.
+   *  The type of the result is defined by the multiplication traits and is usually the type of this rotation.
    *  \returns the concatenation of two rotations
    */
   template<typename OtherDerived_>
-  Derived_ operator *(const RotationBase<OtherDerived_>& other) const {
+  auto operator *(const RotationBase<OtherDerived_>& other) const
+    -> decltype(internal::MultiplicationTraits<RotationBase<Derived_>,RotationBase<OtherDerived_>>::mult(std::declval<const Derived_&>(), std::declval<const OtherDerived_&>())) {
     return internal::MultiplicationTraits<RotationBase<Derived_>,RotationBase<OtherDerived_>>::mult(this->derived(), other.derived()); // todo: 1. ok? 2. may be optimized
   }
 
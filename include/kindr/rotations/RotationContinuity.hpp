@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <cmath>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "kindr/common/common.hpp"
+#include "kindr/common/assert_macros.hpp"
+#include "kindr/rotations/Rotation.hpp"
+
+namespace kindr {
+
+/*! \class RotationQuaternionContinuityFilter
+ *  \brief Streaming filter which keeps a sequence of rotation quaternions in one hemisphere.
+ *
+ *  The quaternions q and -q describe the same rotation. Sensors and conversions return either of them,
+ *  which breaks interpolation, averaging and finite differences. The filter flips the sign of a quaternion
+ *  such that q_k*q_{k-1} >= 0 holds for the dot product of consecutive quaternions.
+ *  \tparam PrimType_ the primitive type of the data (double or float)
+ *  \ingroup rotations
+ */
+template<typename PrimType_>
+class RotationQuaternionContinuityFilter {
+ public:
+  typedef PrimType_ Scalar;
+  typedef RotationQuaternion<Scalar> Rotation;
+
+  RotationQuaternionContinuityFilter() = default;
+
+  //! Constructor using the quaternion preceding the stream
+  explicit RotationQuaternionContinuityFilter(const Rotation& previous)
+    : previous_(previous),
+      hasPrevious_(true) {
+  }
+
+  /*! \brief Gets the quaternion or its negation, whichever is in the hemisphere of the previous one.
+   *  \returns continuous quaternion
+   */
+  Rotation filter(const Rotation& quaternion) {
+    const bool isFlipped = hasPrevious_ && quaternion.toImplementation().coeffs().dot(previous_.toImplementation().coeffs()) < Scalar(0);
+    previous_ = quaternion;
+    if (isFlipped) {
+      previous_.toImplementation().coeffs() *= Scalar(-1);
+    }
+    hasPrevious_ = true;
+    return previous_;
+  }
+
+  //! Forgets the previous quaternion
+  void reset() {
+    hasPrevious_ = false;
+  }
+
+  bool hasPrevious() const {
+    return hasPrevious_;
+  }
+
+  const Rotation& getPrevious() const {
+    return previous_;
+  }
+
+ private:
+  Rotation previous_;
+  bool hasPrevious_ = false;
+
+ public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+//! \brief Continuity filter of rotation quaternions with primitive type double
+typedef RotationQuaternionContinuityFilter<double> RotationQuaternionContinuityFilterD;
+//! \brief Continuity filter of rotation quaternions with primitive type float
+typedef RotationQuaternionContinuityFilter<float> RotationQuaternionContinuityFilterF;
+
+
+/*! \brief Flips the signs of quaternions stored as the columns of a 4xN matrix such that q_k*q_{k-1} >= 0.
+ *
+ *  The dot products of the consecutive columns and the sign flips are vectorized over the columns, only the
+ *  accumulation of the signs is sequential. The order of the coefficients within a column does not matter.
+ *  \param quaternions  4xN-matrix of quaternion coefficients, modified in place
+ *  \param previous     coefficients of the quaternion preceding the first column, e.g. the last one of the previous batch
+ */
+template<typename Derived_>
+inline void makeRotationQuaternionsContinuous(Eigen::MatrixBase<Derived_>& quaternions, const Eigen::Matrix<typename Derived_::Scalar, 4, 1>& previous) {
+  typedef typename Derived_::Scalar Scalar;
+  static_assert(Derived_::RowsAtCompileTime == 4 || Derived_::RowsAtCompileTime == Eigen::Dynamic, "The quaternions must be stored as columns of a 4xN matrix.");
+  KINDR_ASSERT_TRUE(std::runtime_error, quaternions.rows() == 4, "The quaternions must be stored as columns of a 4xN matrix!");
+  const Eigen::DenseIndex size = quaternions.cols();
+  if (size == 0) {
+    return;
+  }
+  Eigen::Matrix<Scalar, 1, Eigen::Dynamic> signs(size);
+  signs(0) = previous.dot(quaternions.col(0));
+  signs.tail(size - 1) = quaternions.leftCols(size - 1).cwiseProduct(quaternions.rightCols(size - 1)).colwise().sum();
+  // a flip propagates to all following quaternions
+  Scalar sign = Scalar(1);
+  for (Eigen::DenseIndex k = 0; k < size; ++k) {
+    if (signs(k) < Scalar(0)) {
+      sign = -sign;
+    }
+    signs(k) = sign;
+  }
+  quaternions.array().rowwise() *= signs.array();
+}
+
+/*! \brief Flips the signs of quaternions stored as the columns of a 4xN matrix such that q_k*q_{k-1} >= 0.
+ *  The first quaternion is kept.
+ *  \param quaternions  4xN-matrix of quaternion coefficients, modified in place
+ */
+template<typename Derived_>
+inline void makeRotationQuaternionsContinuous(Eigen::MatrixBase<Derived_>& quaternions) {
+  if (quaternions.cols() > 0) {
+    const Eigen::Matrix<typename Derived_::Scalar, 4, 1> first = quaternions.col(0);
+    makeRotationQuaternionsContinuous(quaternions, first);
+  }
+}
+
+/*! \brief Flips the signs of rotation quaternions such that q_k*q_{k-1} >= 0. The first quaternion is kept.
+ *  \param quaternions  sequence of rotation quaternions, modified in place
+ */
+template<typename PrimType_, typename Allocator_>
+inline void makeRotationQuaternionsContinuous(std::vector<RotationQuaternion<PrimType_>, Allocator_>& quaternions) {
+  RotationQuaternionContinuityFilter<PrimType_> filter;
+  for (RotationQuaternion<PrimType_>& quaternion : quaternions) {
+    quaternion = filter.filter(quaternion);
+  }
+}
+
+
+/*! \class EulerAnglesZyxContinuityFilter
+ *  \brief Streaming filter which unwraps a sequence of Euler angles ZYX into a continuous one.
+ *
+ *  The angles (z, y, x) describe the same rotation as (z + pi, pi - y, x + pi) and as any angles shifted by
+ *  multiples of 2*pi. The filter picks the equivalent angles closest to the previous ones instead of mapping
+ *  every sample to the unique range, which jumps at +-pi and at the singularity. Only the equivalent set
+ *  and the shifts by 2*pi are evaluated, i.e. the rotation is never converted.
+ *  \tparam PrimType_ the primitive type of the data (double or float)
+ *  \ingroup rotations
+ */
+template<typename PrimType_>
+class EulerAnglesZyxContinuityFilter {
+ public:
+  typedef PrimType_ Scalar;
+  typedef EulerAnglesZyx<Scalar> Rotation;
+  typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+
+  EulerAnglesZyxContinuityFilter() = default;
+
+  //! Constructor using the angles preceding the stream
+  explicit EulerAnglesZyxContinuityFilter(const Rotation& previous)
+    : previous_(previous.toImplementation()),
+      hasPrevious_(true) {
+  }
+
+  /*! \brief Gets the equivalent Euler angles closest to the previous ones.
+   *  \returns continuous Euler angles
+   */
+  Rotation filter(const Rotation& eulerAngles) {
+    const Vector3& angles = eulerAngles.toImplementation();
+    if (hasPrevious_) {
+      const Scalar pi = Scalar(M_PI);
+      const Vector3 direct = unwrap(angles);
+      const Vector3 flipped = unwrap(Vector3(angles.x() + pi, pi - angles.y(), angles.z() + pi));
+      previous_ = ((direct - previous_).squaredNorm() <= (flipped - previous_).squaredNorm()) ? direct : flipped;
+    } else {
+      previous_ = angles;
+      hasPrevious_ = true;
+    }
+    return Rotation(previous_);
+  }
+
+  //! Forgets the previous angles
+  void reset() {
+    hasPrevious_ = false;
+  }
+
+  bool hasPrevious() const {
+    return hasPrevious_;
+  }
+
+  Rotation getPrevious() const {
+    return Rotation(previous_);
+  }
+
+ private:
+  //! Shifts every angle by the multiple of 2*pi closest to the previous angle
+  Vector3 unwrap(const Vector3& angles) const {
+    using std::floor;
+    const Scalar twoPi = Scalar(2.0*M_PI);
+    const Vector3 difference = previous_ - angles;
+    return angles + twoPi*(difference/twoPi + Vector3::Constant(Scalar(0.5))).unaryExpr([](Scalar value) { return floor(value); });
+  }
+
+  Vector3 previous_ = Vector3::Zero();
+  bool hasPrevious_ = false;
+};
+
+//! \brief Continuity filter of Euler angles ZYX with primitive type double
+typedef EulerAnglesZyxContinuityFilter<double> EulerAnglesZyxContinuityFilterD;
+//! \brief Continuity filter of Euler angles ZYX with primitive type float
+typedef EulerAnglesZyxContinuityFilter<float> EulerAnglesZyxContinuityFilterF;
+
+/*! \brief Unwraps Euler angles ZYX into a continuous sequence. The first angles are kept.
+ *  \param eulerAngles  sequence of Euler angles, modified in place
+ */
+template<typename PrimType_, typename Allocator_>
+inline void makeEulerAnglesZyxContinuous(std::vector<EulerAnglesZyx<PrimType_>, Allocator_>& eulerAngles) {
+  EulerAnglesZyxContinuityFilter<PrimType_> filter;
+  for (EulerAnglesZyx<PrimType_>& angles : eulerAngles) {
+    angles = filter.filter(angles);
+  }
+}
+
+} // namespace kindr
@@ -60,12 +60,51 @@ class EulerAnglesXyzDiff;
  */
 template<typename PrimType_>
 inline static Eigen::Matrix<PrimType_, 3, 3> getJacobianOfExponentialMap(const Eigen::Matrix<PrimType_, 3, 1>& vector) {
-  const PrimType_ norm = vector.norm();
-  const Eigen::Matrix<PrimType_, 3, 3> skewMatrix = getSkewMatrixFromVector(vector);
-  if (norm < 1.0e-4) {
-    return Eigen::Matrix<PrimType_, 3, 3>::Identity() + 0.5*skewMatrix;
+  using std::sin;
+  using std::sqrt;
+  const PrimType_ normSquared = vector.squaredNorm();
+  const PrimType_ norm = sqrt(normSquared);
+  // (1 - cos|v|)/|v|^2 and (|v| - sin|v|)/|v|^3
+  PrimType_ skewFactor;
+  PrimType_ skewSquaredFactor;
+  if (norm < sqrt(sqrt(std::numeric_limits<PrimType_>::epsilon()))) {
+    // Taylor expansions, since the closed forms cancel for small angles (in particular in float)
+    skewFactor = PrimType_(0.5) - normSquared*(PrimType_(1.0/24.0) - normSquared*PrimType_(1.0/720.0));
+    skewSquaredFactor = PrimType_(1.0/6.0) - normSquared*(PrimType_(1.0/120.0) - normSquared*PrimType_(1.0/5040.0));
+  } else {
+    // 1 - cos|v| = 2*sin^2(|v|/2) does not cancel
+    const PrimType_ sinHalfNorm = sin(PrimType_(0.5)*norm);
+    skewFactor = PrimType_(2.0)*sinHalfNorm*sinHalfNorm/normSquared;
+    skewSquaredFactor = (norm - sin(norm))/(normSquared*norm);
   }
-  return Eigen::Matrix<PrimType_, 3, 3>::Identity() + (PrimType_(1.0) - cos(norm))/(norm*norm)*skewMatrix + (norm - sin(norm))/(norm*norm*norm)*(skewMatrix*skewMatrix);
+  // [v]x^2 = v*v^T - |v|^2*I avoids the product of the skew-symmetric matrices
+  Eigen::Matrix<PrimType_, 3, 3> jacobian = skewFactor*getSkewMatrixFromVector(vector);
+  jacobian.noalias() += skewSquaredFactor*vector*vector.transpose();
+  jacobian.diagonal().array() += PrimType_(1.0) - skewSquaredFactor*normSquared;
+  return jacobian;
+}
+
+/*!
+ * \brief Gets the inverse of the 3x3 Jacobian of the exponential map.
+ *  The inverse is well-defined for rotation angles up to pi, i.e. for the logarithmic map of any rotation.
+ * \param   vector 3x1-matrix
+ * \return  matrix  (3x3-matrix)
+ */
+template<typename PrimType_>
+inline static Eigen::Matrix<PrimType_, 3, 3> getInverseJacobianOfExponentialMap(const Eigen::Matrix<PrimType_, 3, 1>& vector) {
+  using std::sin;
+  using std::cos;
+  using std::sqrt;
+  const PrimType_ normSquared = vector.squaredNorm();
+  const PrimType_ norm = sqrt(normSquared);
+  // 1/|v|^2 - cot(|v|/2)/(2*|v|), which cancels for small angles and is replaced by its Taylor expansion there
+  const PrimType_ skewSquaredFactor = (norm < sqrt(sqrt(std::numeric_limits<PrimType_>::epsilon()))) ?
+      PrimType_(1.0/12.0) + normSquared*(PrimType_(1.0/720.0) + normSquared*PrimType_(1.0/30240.0)) :
+      PrimType_(1.0)/normSquared - cos(PrimType_(0.5)*norm)/(PrimType_(2.0)*norm*sin(PrimType_(0.5)*norm));
+  Eigen::Matrix<PrimType_, 3, 3> jacobian = PrimType_(-0.5)*getSkewMatrixFromVector(vector);
+  jacobian.noalias() += skewSquaredFactor*vector*vector.transpose();
+  jacobian.diagonal().array() += PrimType_(1.0) - skewSquaredFactor*normSquared;
+  return jacobian;
 }
 
 
@@ -0,0 +1,308 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "kindr/common/common.hpp"
+#include "kindr/common/assert_macros.hpp"
+#include "kindr/rotations/Rotation.hpp"
+
+namespace kindr {
+
+namespace internal {
+
+/*! \brief Gets the index of the HEALPix pixel (ring scheme) which contains the point on the sphere.
+ *  See Gorski et al., "HEALPix: A Framework for High-Resolution Discretization and Fast Analysis of Data Distributed on the Sphere".
+ *  (only for advanced users)
+ *  \param nside  resolution, the sphere is divided into 12*nside^2 pixels of equal area
+ *  \param z      cosine of the polar angle
+ *  \param phi    azimuth in [0, 2*pi)
+ */
+template<typename PrimType_>
+inline std::int64_t getHealpixPixel(std::int64_t nside, PrimType_ z, PrimType_ phi) {
+  using std::abs;
+  using std::fmod;
+  using std::sqrt;
+  const std::int64_t ncap = 2*nside*(nside - 1);
+  const std::int64_t npix = 12*nside*nside;
+  const PrimType_ za = abs(z);
+  PrimType_ tt = fmod(phi*PrimType_(2.0/M_PI), PrimType_(4));
+  if (tt < PrimType_(0)) {
+    tt += PrimType_(4);
+  }
+  if (za <= PrimType_(2.0/3.0)) {
+    // equatorial region
+    const PrimType_ temp1 = PrimType_(nside)*(PrimType_(0.5) + tt);
+    const PrimType_ temp2 = PrimType_(nside)*z*PrimType_(0.75);
+    const std::int64_t jp = static_cast<std::int64_t>(temp1 - temp2);
+    const std::int64_t jm = static_cast<std::int64_t>(temp1 + temp2);
+    const std::int64_t ir = nside + 1 + jp - jm;
+    const std::int64_t kshift = 1 - (ir & 1);
+    std::int64_t ip = (jp + jm - nside + kshift + 1)/2;
+    ip = ((ip % (4*nside)) + 4*nside) % (4*nside);
+    return ncap + (ir - 1)*4*nside + ip;
+  }
+  // polar caps
+  const PrimType_ tp = tt - PrimType_(static_cast<std::int64_t>(tt));
+  const PrimType_ tmp = PrimType_(nside)*sqrt(PrimType_(3)*(PrimType_(1) - za));
+  const std::int64_t jp = static_cast<std::int64_t>(tp*tmp);
+  const std::int64_t jm = static_cast<std::int64_t>((PrimType_(1) - tp)*tmp);
+  const std::int64_t ir = jp + jm + 1;
+  std::int64_t ip = static_cast<std::int64_t>(tt*PrimType_(ir));
+  ip = ((ip % (4*ir)) + 4*ir) % (4*ir);
+  return (z > PrimType_(0)) ? 2*ir*(ir - 1) + ip : npix - 2*ir*(ir + 1) + ip;
+}
+
+/*! \brief Gets the center of a HEALPix pixel (ring scheme).
+ *  (only for advanced users)
+ *  \param nside  resolution, the sphere is divided into 12*nside^2 pixels of equal area
+ *  \param pixel  index of the pixel
+ *  \param z      cosine of the polar angle of the center
+ *  \param phi    azimuth of the center in [0, 2*pi)
+ */
+template<typename PrimType_>
+inline void getHealpixPixelCenter(std::int64_t nside, std::int64_t pixel, PrimType_& z, PrimType_& phi) {
+  using std::sqrt;
+  const std::int64_t ncap = 2*nside*(nside - 1);
+  const std::int64_t npix = 12*nside*nside;
+  const double fact2 = 4.0/double(npix);
+  const auto isqrt = [](std::int64_t value) { return static_cast<std::int64_t>(sqrt(double(value) + 0.5)); };
+  if (pixel < ncap) {
+    // north polar cap
+    const std::int64_t iring = (1 + isqrt(1 + 2*pixel)) >> 1;
+    const std::int64_t iphi = pixel + 1 - 2*iring*(iring - 1);
+    z = PrimType_(1.0 - double(iring*iring)*fact2);
+    phi = PrimType_((double(iphi) - 0.5)*M_PI/double(2*iring));
+  } else if (pixel < npix - ncap) {
+    // equatorial region
+    const std::int64_t ip = pixel - ncap;
+    const std::int64_t iring = ip/(4*nside) + nside;
+    const std::int64_t iphi = ip % (4*nside) + 1;
+    const double fodd = ((iring + nside) & 1) ? 1.0 : 0.5;
+    z = PrimType_(double(2*nside - iring)*double(2*nside)*fact2);
+    phi = PrimType_((double(iphi) - fodd)*M_PI/double(2*nside));
+  } else {
+    // south polar cap
+    const std::int64_t ip = npix - pixel;
+    const std::int64_t iring = (1 + isqrt(2*ip - 1)) >> 1;
+    const std::int64_t iphi = 4*iring + 1 - (ip - 2*iring*(iring - 1));
+    z = PrimType_(-1.0 + double(iring*iring)*fact2);
+    phi = PrimType_((double(iphi) - 0.5)*M_PI/double(2*iring));
+  }
+}
+
+} // namespace internal
+
+
+/*! \class HopfRotationGrid
+ *  \brief Deterministic, near-uniform grid on SO(3) based on the Hopf fibration, with constant-time lookup of the grid cell of a rotation.
+ *
+ *  A rotation quaternion q = (w, x, y, z) is parametrized by the Hopf coordinates (theta, phi, psi) with
+ *  w = cos(theta/2)*cos(psi/2), x = cos(theta/2)*sin(psi/2), y = sin(theta/2)*cos(phi + psi/2), z = sin(theta/2)*sin(phi + psi/2),
+ *  where (theta, phi) is a point on the sphere S^2 and psi in [0, 2*pi) is a point on the circle S^1.
+ *  The grid is the product of a HEALPix grid with 12*n^2 pixels on S^2 and 6*n equidistant points on S^1,
+ *  i.e. it has 72*n^3 points, see Yershova et al., "Generating Uniform Incremental Grids on SO(3) Using the Hopf Fibration".
+ *  The grid cells are the products of the HEALPix pixels and of the intervals on the circle, and the grid
+ *  points are their centers. The grid with resolution n = 2^l corresponds to the level l of Yershova et al.
+ *
+ *  The coordinate psi of the fibers is singular at the south pole theta = pi, where the cells would stretch
+ *  along the fibers. For pixels on the southern hemisphere, the circle is therefore measured by psi' = psi + 2*phi
+ *  instead, i.e. y = sin(theta/2)*cos(psi'/2) and z = sin(theta/2)*sin(psi'/2), which keeps all cells compact.
+ *
+ *  \tparam PrimType_ the primitive type of the data (double or float)
+ *  \ingroup rotations
+ */
+template<typename PrimType_>
+class HopfRotationGrid {
+ public:
+  typedef PrimType_ Scalar;
+  typedef RotationQuaternion<Scalar> Rotation;
+  typedef std::vector<Rotation, Eigen::aligned_allocator<Rotation>> Rotations;
+  typedef Eigen::Matrix<Scalar, Eigen::Dynamic, 1> VectorX;
+
+  /*! \brief Constructor.
+   *  \param resolution  resolution n >= 1 of the grid with 72*n^3 points
+   */
+  explicit HopfRotationGrid(std::int64_t resolution = 1)
+    : resolution_(resolution) {
+    KINDR_ASSERT_TRUE(std::runtime_error, resolution >= 1, "The resolution must be positive!");
+  }
+
+  std::int64_t getResolution() const {
+    return resolution_;
+  }
+
+  std::int64_t getNumberOfSpherePixels() const {
+    return 12*resolution_*resolution_;
+  }
+
+  std::int64_t getNumberOfCirclePoints() const {
+    return 6*resolution_;
+  }
+
+  std::int64_t size() const {
+    return getNumberOfSpherePixels()*getNumberOfCirclePoints();
+  }
+
+  //! Gets the grid point with the index
+  Rotation getRotation(std::int64_t index) const {
+    KINDR_ASSERT_TRUE(std::runtime_error, index >= 0 && index < size(), "The index " << index << " is outside of the grid!");
+    const std::int64_t circlePoints = getNumberOfCirclePoints();
+    Scalar z, phi;
+    internal::getHealpixPixelCenter(resolution_, index/circlePoints, z, phi);
+    return getRotationFromHopfCoordinates(z, phi, getCircleAngle(index % circlePoints), isSouthern(z));
+  }
+
+  /*! \brief Gets the index of the grid cell which contains the rotation.
+   *  The rotation of the returned grid point is the center of the cell.
+   */
+  template<typename Rotation_>
+  std::int64_t getIndex(const RotationBase<Rotation_>& rotation) const {
+    using std::atan2;
+    using std::floor;
+    using std::sqrt;
+    const Eigen::Quaternion<Scalar> quaternion = Rotation(rotation.derived()).toImplementation();
+    const Scalar twoPi = Scalar(2.0*M_PI);
+    // the arguments change by pi for -q, i.e. the base point (z, phi) and the circle angles modulo 2*pi are unique
+    const Scalar argumentNorth = atan2(quaternion.x(), quaternion.w());
+    const Scalar argumentSouth = atan2(quaternion.z(), quaternion.y());
+    const Scalar phi = wrapTwoPi(argumentSouth - argumentNorth);
+    // z = cos(theta) = cos^2(theta/2) - sin^2(theta/2)
+    const Scalar z = quaternion.w()*quaternion.w() + quaternion.x()*quaternion.x() - quaternion.y()*quaternion.y() - quaternion.z()*quaternion.z();
+    const std::int64_t pixel = internal::getHealpixPixel(resolution_, z, phi);
+    Scalar pixelZ, pixelPhi;
+    internal::getHealpixPixelCenter(resolution_, pixel, pixelZ, pixelPhi);
+    const Scalar psi = wrapTwoPi(Scalar(2)*(isSouthern(pixelZ) ? argumentSouth : argumentNorth));
+    const std::int64_t circlePoints = getNumberOfCirclePoints();
+    std::int64_t circleIndex = static_cast<std::int64_t>(floor(psi/twoPi*Scalar(circlePoints)));
+    circleIndex = std::min(std::max<std::int64_t>(circleIndex, 0), circlePoints - 1);
+    return pixel*circlePoints + circleIndex;
+  }
+
+  //! Gets the grid point of the cell which contains the rotation
+  template<typename Rotation_>
+  Rotation getNearestRotation(const RotationBase<Rotation_>& rotation) const {
+    return getRotation(getIndex(rotation));
+  }
+
+  /*! \brief Writes all grid points into a structure of arrays, i.e. a matrix with one row per grid point and the columns (w, x, y, z).
+   *  The coefficients are computed with vectorized expressions over the points on the circle.
+   */
+  template<typename Derived_>
+  void getQuaternions(Eigen::MatrixBase<Derived_>& quaternions) const {
+    using std::cos;
+    using std::sin;
+    using std::sqrt;
+    static_assert(Derived_::ColsAtCompileTime == 4 || Derived_::ColsAtCompileTime == Eigen::Dynamic, "The quaternions must be stored in a Nx4 matrix.");
+    KINDR_ASSERT_TRUE(std::runtime_error, quaternions.rows() == size() && quaternions.cols() == 4, "The matrix must have one row per grid point and four columns!");
+    const std::int64_t circlePoints = getNumberOfCirclePoints();
+    VectorX halfPsi(circlePoints);
+    for (std::int64_t k = 0; k < circlePoints; ++k) {
+      halfPsi(k) = Scalar(0.5)*getCircleAngle(k);
+    }
+    const VectorX cosHalfPsi = halfPsi.array().cos();
+    const VectorX sinHalfPsi = halfPsi.array().sin();
+    for (std::int64_t pixel = 0; pixel < getNumberOfSpherePixels(); ++pixel) {
+      Scalar z, phi;
+      internal::getHealpixPixelCenter(resolution_, pixel, z, phi);
+      const Scalar cosHalfTheta = sqrt(Scalar(0.5)*(Scalar(1) + z));
+      const Scalar sinHalfTheta = sqrt(Scalar(0.5)*(Scalar(1) - z));
+      const Scalar cosPhi = cos(phi);
+      const Scalar sinPhi = sin(phi);
+      const std::int64_t first = pixel*circlePoints;
+      if (isSouthern(z)) {
+        // cos(psi'/2 - phi) and sin(psi'/2 - phi)
+        quaternions.col(0).segment(first, circlePoints) = cosHalfTheta*(cosPhi*cosHalfPsi + sinPhi*sinHalfPsi);
+        quaternions.col(1).segment(first, circlePoints) = cosHalfTheta*(cosPhi*sinHalfPsi - sinPhi*cosHalfPsi);
+        quaternions.col(2).segment(first, circlePoints) = sinHalfTheta*cosHalfPsi;
+        quaternions.col(3).segment(first, circlePoints) = sinHalfTheta*sinHalfPsi;
+      } else {
+        quaternions.col(0).segment(first, circlePoints) = cosHalfTheta*cosHalfPsi;
+        quaternions.col(1).segment(first, circlePoints) = cosHalfTheta*sinHalfPsi;
+        // cos(phi + psi/2) and sin(phi + psi/2)
+        quaternions.col(2).segment(first, circlePoints) = sinHalfTheta*(cosPhi*cosHalfPsi - sinPhi*sinHalfPsi);
+        quaternions.col(3).segment(first, circlePoints) = sinHalfTheta*(sinPhi*cosHalfPsi + cosPhi*sinHalfPsi);
+      }
+    }
+  }
+
+  //! Gets all grid points as rotation quaternions
+  Rotations getRotations() const {
+    Eigen::Matrix<Scalar, Eigen::Dynamic, 4> quaternions(size(), 4);
+    getQuaternions(quaternions);
+    Rotations rotations;
+    rotations.reserve(size());
+    for (std::int64_t i = 0; i < size(); ++i) {
+      rotations.push_back(Rotation(quaternions(i, 0), quaternions(i, 1), quaternions(i, 2), quaternions(i, 3)));
+    }
+    return rotations;
+  }
+
+ private:
+  Scalar getCircleAngle(std::int64_t circleIndex) const {
+    return (Scalar(circleIndex) + Scalar(0.5))*Scalar(2.0*M_PI)/Scalar(getNumberOfCirclePoints());
+  }
+
+  //! The pixels with centers on the southern hemisphere measure the circle by psi' = psi + 2*phi
+  static bool isSouthern(Scalar z) {
+    return z < Scalar(0);
+  }
+
+  static Scalar wrapTwoPi(Scalar angle) {
+    using std::floor;
+    const Scalar twoPi = Scalar(2.0*M_PI);
+    return angle - twoPi*floor(angle/twoPi);
+  }
+
+  static Rotation getRotationFromHopfCoordinates(Scalar z, Scalar phi, Scalar psi, bool isSouthern) {
+    using std::cos;
+    using std::sin;
+    using std::sqrt;
+    const Scalar cosHalfTheta = sqrt(Scalar(0.5)*(Scalar(1) + z));
+    const Scalar sinHalfTheta = sqrt(Scalar(0.5)*(Scalar(1) - z));
+    const Scalar argumentNorth = isSouthern ? Scalar(0.5)*psi - phi : Scalar(0.5)*psi;
+    const Scalar argumentSouth = isSouthern ? Scalar(0.5)*psi : phi + Scalar(0.5)*psi;
+    return Rotation(cosHalfTheta*cos(argumentNorth), cosHalfTheta*sin(argumentNorth),
+                    sinHalfTheta*cos(argumentSouth), sinHalfTheta*sin(argumentSouth));
+  }
+
+  std::int64_t resolution_;
+};
+
+//! \brief Hopf grid on SO(3) with primitive type double
+typedef HopfRotationGrid<double> HopfRotationGridD;
+//! \brief Hopf grid on SO(3) with primitive type float
+typedef HopfRotationGrid<float> HopfRotationGridF;
+
+} // namespace kindr
@@ -389,7 +389,8 @@ template<typename PrimType_>
 class FixingTraits<RotationMatrix<PrimType_>> {
  public:
   inline static void fix(RotationMatrix<PrimType_>& R) {
-    const PrimType_ factor = 1/pow(R.determinant(), 1.0/3.0);
+    using std::pow;
+    const PrimType_ factor = PrimType_(1)/pow(R.determinant(), PrimType_(1)/PrimType_(3));
     R.setMatrix(factor*R.matrix()(0,0),
                 factor*R.matrix()(0,1),
                 factor*R.matrix()(0,2),
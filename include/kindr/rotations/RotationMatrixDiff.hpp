@@ -178,7 +178,7 @@ template<typename PrimType_>
 class RotationDiffConversionTraits<RotationMatrixDiff<PrimType_>, LocalAngularVelocity<PrimType_>, RotationMatrix<PrimType_>> {
  public:
   inline static RotationMatrixDiff<PrimType_> convert(const RotationMatrix<PrimType_>& rotationMatrix, const LocalAngularVelocity<PrimType_>& angularVelocity) {
-    return RotationMatrixDiff<PrimType_>(rotationMatrix.matrix()*getSkewMatrixFromVector(angularVelocity.vector()));
+    return RotationMatrixDiff<PrimType_>(timesSkew(rotationMatrix.matrix(), angularVelocity.vector()));
   }
 };
 
@@ -186,7 +186,7 @@ template<typename PrimType_>
 class RotationDiffConversionTraits<RotationMatrixDiff<PrimType_>, GlobalAngularVelocity<PrimType_>, RotationMatrix<PrimType_>> {
  public:
   inline static RotationMatrixDiff<PrimType_> convert(const RotationMatrix<PrimType_>& rotationMatrix, const GlobalAngularVelocity<PrimType_>& angularVelocity) {
-    return RotationMatrixDiff<PrimType_>(getSkewMatrixFromVector(angularVelocity.vector())*rotationMatrix.matrix());
+    return RotationMatrixDiff<PrimType_>(skewTimes(angularVelocity.vector(), rotationMatrix.matrix()));
   }
 };
 
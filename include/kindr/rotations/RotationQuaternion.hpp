@@ -491,7 +491,8 @@ class ConversionTraits<RotationQuaternion<DestPrimType_>, AngleAxis<SourcePrimTy
 
 template <typename Scalar_ = double>
 inline bool isLessThenEpsilons4thRoot(Scalar_ x){
-  static const Scalar_ epsilon4thRoot = pow(std::numeric_limits<Scalar_>::epsilon(), 1.0/4.0);
+  using std::sqrt;
+  static const Scalar_ epsilon4thRoot = sqrt(sqrt(std::numeric_limits<Scalar_>::epsilon()));
   return x < epsilon4thRoot;
 }
 
@@ -499,40 +500,34 @@ template<typename DestPrimType_, typename SourcePrimType_>
 class ConversionTraits<RotationQuaternion<DestPrimType_>, RotationVector<SourcePrimType_>> {
  public:
   inline static RotationQuaternion<DestPrimType_> convert(const RotationVector<SourcePrimType_>& rotationVector) {
+    using std::sqrt;
+    using std::sin;
+    using std::cos;
     typedef typename RotationQuaternion<DestPrimType_>::Scalar Scalar;
     typedef typename RotationQuaternion<DestPrimType_>::Imaginary Imaginary;
-//    const Scalar v = rotationVector.toImplementation().norm();
-//    Scalar real;
-//    Imaginary imaginary;
-//    if (v < internal::NumTraits<Scalar>::dummy_precision()) {
-//      real = 1.0;
-//      imaginary= 0.5*rotationVector.toImplementation().template cast<DestPrimType_>();
-//    }
-//    else {
-//      real = cos(v/2);
-//      imaginary = sin(v/2)/v*rotationVector.toImplementation().template cast<DestPrimType_>();
-//    }
-//    return RotationQuaternion<DestPrimType_>(real, imaginary);
-
-
-    Scalar theta = (Scalar)rotationVector.toImplementation().norm();
-
-    // na is 1/theta sin(theta/2)
-    double na;
+
+    const Imaginary vector = rotationVector.toImplementation().template cast<Scalar>();
+    const Scalar thetaSquared = vector.squaredNorm();
+
+    const Scalar theta = sqrt(thetaSquared);
+
+    // na is 1/theta sin(theta/2), ct is cos(theta/2)
+    Scalar na;
+    Scalar ct;
     if(isLessThenEpsilons4thRoot(theta))
     {
-        const Scalar one_over_48 = 1.0/48.0;
-        na = 0.5 + (theta * theta) * one_over_48;
+        // Taylor expansion in theta^2, which does not use the norm.
+        // This keeps the derivatives of automatic differentiation scalars finite at the identity.
+        na = Scalar(0.5) - thetaSquared*Scalar(1.0/48.0);
+        ct = Scalar(1) - thetaSquared*Scalar(0.125);
     }
     else
     {
-        na = sin(theta*0.5) / theta;
+        na = sin(theta*Scalar(0.5)) / theta;
+        ct = cos(theta*Scalar(0.5));
     }
-    Imaginary axis = rotationVector.toImplementation().template cast<Scalar>()*na;
-    Scalar ct = cos(theta*0.5);
+    const Imaginary axis = vector*na;
     return RotationQuaternion<DestPrimType_>(ct, axis[0],axis[1],axis[2]);
-//    return Eigen::Vector4d(axis[0],axis[1],axis[2],ct);
-
   }
 };
 
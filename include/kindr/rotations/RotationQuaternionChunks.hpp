@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <Eigen/Core>
+
+namespace kindr {
+namespace internal {
+
+/*
+ * Quaternion kernels on chunks of rows in structure-of-arrays form, i.e. every argument is an Eigen array with one
+ * coefficient per row, which are shared by the batched pose integration, resampling and wrench aggregation.
+ */
+
+/*! \brief Hamilton products q = a*b for chunks of quaternions. The results must not alias the factors.
+ *  (only for advanced users)
+ */
+template<typename Chunk_>
+inline void multiplyQuaternions(const Chunk_& aw, const Chunk_& ax, const Chunk_& ay, const Chunk_& az,
+                                const Chunk_& bw, const Chunk_& bx, const Chunk_& by, const Chunk_& bz,
+                                Chunk_& qw, Chunk_& qx, Chunk_& qy, Chunk_& qz) {
+  qw = aw*bw - ax*bx - ay*by - az*bz;
+  qx = aw*bx + ax*bw + ay*bz - az*by;
+  qy = aw*by - ax*bz + ay*bw + az*bx;
+  qz = aw*bz + ax*by - ay*bx + az*bw;
+}
+
+/*! \brief Rotates chunks of vectors by unit quaternions, R*v = v + w*s + u x s with s = 2*u x v and u = (x, y, z).
+ *  (only for advanced users)
+ */
+template<typename Chunk_>
+inline void rotateByQuaternions(const Chunk_& qw, const Chunk_& qx, const Chunk_& qy, const Chunk_& qz,
+                                const Chunk_& vx, const Chunk_& vy, const Chunk_& vz, Chunk_& rx, Chunk_& ry, Chunk_& rz) {
+  typedef typename Chunk_::Scalar Scalar;
+  const Chunk_ sx = Scalar(2)*(qy*vz - qz*vy);
+  const Chunk_ sy = Scalar(2)*(qz*vx - qx*vz);
+  const Chunk_ sz = Scalar(2)*(qx*vy - qy*vx);
+  rx = vx + qw*sx + qy*sz - qz*sy;
+  ry = vy + qw*sy + qz*sx - qx*sz;
+  rz = vz + qw*sz + qx*sy - qy*sx;
+}
+
+} // namespace internal
+} // namespace kindr
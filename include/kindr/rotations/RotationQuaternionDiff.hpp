@@ -194,7 +194,7 @@ template<typename PrimType_>
 class RotationDiffConversionTraits<RotationQuaternionDiff<PrimType_>, LocalAngularVelocity<PrimType_>, RotationQuaternion<PrimType_>> {
  public:
   inline static RotationQuaternionDiff<PrimType_> convert(const RotationQuaternion<PrimType_>& rquat, const LocalAngularVelocity<PrimType_>& angularVelocity) {
-    return RotationQuaternionDiff<PrimType_>(Quaternion<PrimType_>(0.5*(rquat.getLocalQuaternionDiffMatrix().transpose()*angularVelocity.vector())));
+    return RotationQuaternionDiff<PrimType_>(Quaternion<PrimType_>(PrimType_(0.5)*(rquat.getLocalQuaternionDiffMatrix().transpose()*angularVelocity.vector())));
   }
 };
 
@@ -202,7 +202,7 @@ template<typename PrimType_>
 class RotationDiffConversionTraits<RotationQuaternionDiff<PrimType_>, GlobalAngularVelocity<PrimType_>, RotationQuaternion<PrimType_>> {
  public:
   inline static RotationQuaternionDiff<PrimType_> convert(const RotationQuaternion<PrimType_>& rquat, const GlobalAngularVelocity<PrimType_>& angularVelocity) {
-    return RotationQuaternionDiff<PrimType_>(Quaternion<PrimType_>(0.5*(rquat.getGlobalQuaternionDiffMatrix().transpose()*angularVelocity.vector())));
+    return RotationQuaternionDiff<PrimType_>(Quaternion<PrimType_>(PrimType_(0.5)*(rquat.getGlobalQuaternionDiffMatrix().transpose()*angularVelocity.vector())));
   }
 };
 
@@ -235,6 +235,10 @@ class RotationVector : public RotationBase<RotationVector<PrimType_>> {
    *  \returns copy of the rotation vector which is unique
    */
   RotationVector getUnique() const {
+    // Rotation vectors with norm clearly smaller than pi are already unique (this also keeps derivatives at the identity).
+    if (vector_.squaredNorm() < Scalar(9)) {
+      return *this;
+    }
     AngleAxis<PrimType_> angleAxis(*this);
     RotationVector rotationVector(angleAxis.getUnique());
     return rotationVector;
@@ -324,7 +328,7 @@ class ConversionTraits<RotationVector<DestPrimType_>, RotationQuaternion<SourceP
     const DestPrimType_ imaginaryVectorNormSquared = DestPrimType_(1.0)-q.real()*q.real();
 
     if (imaginaryVectorNormSquared < internal::NumTraits<SourcePrimType_>::dummy_precision()) {
-      if (q.real() > 0.0) {
+      if (q.real() > SourcePrimType_(0)) {
         return RotationVector<DestPrimType_>(DestPrimType_(2.0)*q.imaginary().template cast<DestPrimType_>());
       }
       else {
@@ -0,0 +1,419 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <queue>
+#include <vector>
+
+#include <Eigen/Core>
+#include <Eigen/StdVector>
+
+#include "kindr/common/common.hpp"
+#include "kindr/common/assert_macros.hpp"
+#include "kindr/rotations/Rotation.hpp"
+#include "kindr/poses/HomogeneousTransformation.hpp"
+
+namespace kindr {
+
+/*! \class RotationDisparityMetric
+ *  \brief Disparity angle in [0, pi] between two rotation quaternions, consistent with RotationBase::getDisparityAngle().
+ *
+ *  The angle is computed as 2*atan2(|v|, |w|) from the relative quaternion (w, v), which is accurate for small
+ *  angles as well, and does not depend on the signs of the quaternions.
+ *  \tparam PrimType_ the primitive type of the data (double or float)
+ *  \ingroup rotations
+ */
+template<typename PrimType_>
+class RotationDisparityMetric {
+ public:
+  typedef PrimType_ Scalar;
+  typedef RotationQuaternion<Scalar> Element;
+
+  inline Scalar operator()(const Element& left, const Element& right) const {
+    using std::abs;
+    using std::atan2;
+    const Eigen::Quaternion<Scalar>& a = left.toImplementation();
+    const Eigen::Quaternion<Scalar>& b = right.toImplementation();
+    const Scalar w = a.coeffs().dot(b.coeffs());
+    const Eigen::Matrix<Scalar, 3, 1> v = a.w()*b.vec() - b.w()*a.vec() - a.vec().cross(b.vec());
+    return Scalar(2)*atan2(v.norm(), abs(w));
+  }
+};
+
+/*! \class PoseDisparityMetric
+ *  \brief Weighted distance sqrt(w_p*|p_1 - p_2|^2 + w_r*angle^2) between two poses, where angle is the disparity angle of the rotations.
+ *  \tparam PrimType_ the primitive type of the data (double or float)
+ *  \ingroup poses
+ */
+template<typename PrimType_>
+class PoseDisparityMetric {
+ public:
+  typedef PrimType_ Scalar;
+  typedef HomTransformQuat<Scalar> Element;
+
+  /*! \brief Constructor using the weights.
+   *  \param positionWeight  weight of the squared distance of the positions
+   *  \param rotationWeight  weight of the squared disparity angle, e.g. the squared characteristic length
+   */
+  explicit PoseDisparityMetric(Scalar positionWeight = Scalar(1), Scalar rotationWeight = Scalar(1))
+    : positionWeight_(positionWeight),
+      rotationWeight_(rotationWeight) {
+    KINDR_ASSERT_TRUE(std::runtime_error, positionWeight >= Scalar(0) && rotationWeight >= Scalar(0), "The weights must not be negative!");
+  }
+
+  inline Scalar operator()(const Element& left, const Element& right) const {
+    using std::sqrt;
+    const Scalar angle = rotationMetric_(left.getRotation(), right.getRotation());
+    return sqrt(positionWeight_*(left.getPosition() - right.getPosition()).toImplementation().squaredNorm() + rotationWeight_*angle*angle);
+  }
+
+ private:
+  Scalar positionWeight_;
+  Scalar rotationWeight_;
+  RotationDisparityMetric<Scalar> rotationMetric_;
+};
+
+
+/*! \class VantagePointTree
+ *  \brief Vantage-point tree for exact nearest neighbor and radius queries under a metric, e.g. over libraries of rotations or poses.
+ *
+ *  The tree partitions the elements recursively into the ones inside and outside of the median distance to a
+ *  vantage point, and prunes subtrees with the triangle inequality. The tree is stored implicitly in the order
+ *  of the elements, i.e. it only needs one threshold per element. Small subtrees are scanned linearly.
+ *
+ *  The build and the batch queries are parallelized with OpenMP if it is enabled, and run sequentially otherwise:
+ *  \code{.cpp}
+ *  RotationVantagePointTreeD tree(rotations);
+ *  const std::vector<RotationVantagePointTreeD::Neighbor> neighbors = tree.getNearestNeighbors(query, 5);
+ *  \endcode
+ *
+ *  \tparam Metric_ functor which returns the distance between two elements and defines the types Element and Scalar
+ */
+template<typename Metric_>
+class VantagePointTree {
+ public:
+  typedef Metric_ Metric;
+  typedef typename Metric::Scalar Scalar;
+  typedef typename Metric::Element Element;
+  typedef std::vector<Element, Eigen::aligned_allocator<Element>> Elements;
+
+  //! Result of a query
+  struct Neighbor {
+    //! index of the element in the elements given to the constructor
+    std::size_t index;
+    Scalar distance;
+
+    bool operator<(const Neighbor& other) const {
+      return distance < other.distance;
+    }
+  };
+  typedef std::vector<Neighbor> Neighbors;
+
+  /*! \brief Builds the tree.
+   *  \param elements  elements, which are copied
+   *  \param metric    metric
+   *  \param leafSize  maximal number of elements which are scanned linearly
+   */
+  explicit VantagePointTree(const Elements& elements, const Metric& metric = Metric(), std::size_t leafSize = 8)
+    : metric_(metric),
+      leafSize_(std::max<std::size_t>(leafSize, 1)),
+      elements_(elements),
+      indices_(elements.size()),
+      thresholds_(elements.size(), Scalar(0)) {
+    for (std::size_t i = 0; i < indices_.size(); ++i) {
+      indices_[i] = i;
+    }
+    BuildWorkspace workspace(elements_.size());
+#ifdef _OPENMP
+    #pragma omp parallel
+#endif
+    {
+#ifdef _OPENMP
+      #pragma omp single nowait
+#endif
+      build(0, elements_.size(), workspace);
+    }
+    positions_.resize(indices_.size());
+    for (std::size_t i = 0; i < indices_.size(); ++i) {
+      positions_[indices_[i]] = i;
+    }
+  }
+
+  std::size_t size() const {
+    return elements_.size();
+  }
+
+  //! Gets the element with the index given to the constructor
+  const Element& getElement(std::size_t index) const {
+    return elements_[positions_[index]];
+  }
+
+  /*! \brief Gets the k nearest neighbors sorted by increasing distance.
+   */
+  Neighbors getNearestNeighbors(const Element& query, std::size_t k) const {
+    std::priority_queue<Neighbor> heap;
+    if (k > 0) {
+      Scalar radius = std::numeric_limits<Scalar>::infinity();
+      searchNearest(query, k, 0, elements_.size(), heap, radius);
+    }
+    return getSortedNeighbors(heap);
+  }
+
+  //! Gets the nearest neighbor, the tree must not be empty
+  Neighbor getNearestNeighbor(const Element& query) const {
+    KINDR_ASSERT_TRUE(std::runtime_error, !elements_.empty(), "The tree is empty!");
+    return getNearestNeighbors(query, 1).front();
+  }
+
+  /*! \brief Gets all neighbors within the radius (inclusive) sorted by increasing distance.
+   */
+  Neighbors getNeighborsWithinRadius(const Element& query, Scalar radius) const {
+    Neighbors neighbors;
+    searchRadius(query, radius, 0, elements_.size(), neighbors);
+    std::sort(neighbors.begin(), neighbors.end());
+    return neighbors;
+  }
+
+  //! Gets the k nearest neighbors of many queries
+  std::vector<Neighbors> getNearestNeighbors(const Elements& queries, std::size_t k) const {
+    std::vector<Neighbors> neighbors(queries.size());
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic, 64)
+#endif
+    for (long i = 0; i < static_cast<long>(queries.size()); ++i) {
+      neighbors[i] = getNearestNeighbors(queries[i], k);
+    }
+    return neighbors;
+  }
+
+  //! Gets the neighbors within the radius of many queries
+  std::vector<Neighbors> getNeighborsWithinRadius(const Elements& queries, Scalar radius) const {
+    std::vector<Neighbors> neighbors(queries.size());
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic, 64)
+#endif
+    for (long i = 0; i < static_cast<long>(queries.size()); ++i) {
+      neighbors[i] = getNeighborsWithinRadius(queries[i], radius);
+    }
+    return neighbors;
+  }
+
+ private:
+  //! Subtrees larger than this are built in separate tasks
+  static constexpr std::size_t parallelBuildSize = 4096;
+
+  /*! \brief Buffers of the build with one entry per element.
+   *  The subtree [begin, end) only uses the entries [begin, end), i.e. the subtrees share the buffers without
+   *  synchronization and the build allocates once instead of at every level.
+   */
+  struct BuildWorkspace {
+    explicit BuildWorkspace(std::size_t size)
+      : distances(size),
+        order(size),
+        elements(size),
+        indices(size) {
+    }
+
+    std::vector<Scalar> distances;
+    std::vector<std::size_t> order;
+    Elements elements;
+    std::vector<std::size_t> indices;
+  };
+
+  bool isLeaf(std::size_t begin, std::size_t end) const {
+    return end - begin <= leafSize_;
+  }
+
+  //! The vantage point of [begin, end) is at begin, the inner subtree is [begin + 1, median), the outer one is [median, end)
+  static std::size_t getMedian(std::size_t begin, std::size_t end) {
+    return begin + 1 + (end - begin - 1)/2;
+  }
+
+  void build(std::size_t begin, std::size_t end, BuildWorkspace& workspace) {
+    if (isLeaf(begin, end)) {
+      return;
+    }
+    // the element in the middle is a cheap, data-independent choice of the vantage point
+    swapElements(begin, begin + (end - begin)/2);
+    const std::vector<Scalar>& distances = workspace.distances;
+    for (std::size_t i = begin + 1; i < end; ++i) {
+      workspace.distances[i] = metric_(elements_[begin], elements_[i]);
+    }
+    const std::size_t median = getMedian(begin, end);
+    const typename std::vector<std::size_t>::iterator orderBegin = workspace.order.begin() + (begin + 1);
+    const typename std::vector<std::size_t>::iterator orderEnd = workspace.order.begin() + end;
+    for (std::size_t i = begin + 1; i < end; ++i) {
+      workspace.order[i] = i;
+    }
+    std::nth_element(orderBegin, orderBegin + (median - begin - 1), orderEnd, [&distances](std::size_t a, std::size_t b) {
+      return distances[a] < distances[b];
+    });
+    thresholds_[begin] = distances[workspace.order[median]];
+    permute(begin + 1, end, workspace);
+
+    if (end - begin > parallelBuildSize) {
+#ifdef _OPENMP
+      #pragma omp task shared(workspace)
+#endif
+      build(begin + 1, median, workspace);
+#ifdef _OPENMP
+      #pragma omp task shared(workspace)
+#endif
+      build(median, end, workspace);
+#ifdef _OPENMP
+      #pragma omp taskwait
+#endif
+    } else {
+      build(begin + 1, median, workspace);
+      build(median, end, workspace);
+    }
+  }
+
+  void swapElements(std::size_t a, std::size_t b) {
+    std::swap(elements_[a], elements_[b]);
+    std::swap(indices_[a], indices_[b]);
+  }
+
+  //! Reorders the elements in [first, last) such that the element workspace.order[i] ends up at i
+  void permute(std::size_t first, std::size_t last, BuildWorkspace& workspace) {
+    for (std::size_t i = first; i < last; ++i) {
+      workspace.elements[i] = elements_[workspace.order[i]];
+      workspace.indices[i] = indices_[workspace.order[i]];
+    }
+    std::copy(workspace.elements.begin() + first, workspace.elements.begin() + last, elements_.begin() + first);
+    std::copy(workspace.indices.begin() + first, workspace.indices.begin() + last, indices_.begin() + first);
+  }
+
+  void searchNearest(const Element& query, std::size_t k, std::size_t begin, std::size_t end, std::priority_queue<Neighbor>& heap, Scalar& radius) const {
+    if (begin >= end) {
+      return;
+    }
+    if (isLeaf(begin, end)) {
+      for (std::size_t i = begin; i < end; ++i) {
+        addCandidate(i, metric_(query, elements_[i]), k, heap, radius);
+      }
+      return;
+    }
+    const Scalar distance = metric_(query, elements_[begin]);
+    addCandidate(begin, distance, k, heap, radius);
+    const std::size_t median = getMedian(begin, end);
+    const Scalar threshold = thresholds_[begin];
+    // descend into the side of the query first, the radius shrinks meanwhile
+    if (distance <= threshold) {
+      if (distance - radius <= threshold) {
+        searchNearest(query, k, begin + 1, median, heap, radius);
+      }
+      if (distance + radius >= threshold) {
+        searchNearest(query, k, median, end, heap, radius);
+      }
+    } else {
+      if (distance + radius >= threshold) {
+        searchNearest(query, k, median, end, heap, radius);
+      }
+      if (distance - radius <= threshold) {
+        searchNearest(query, k, begin + 1, median, heap, radius);
+      }
+    }
+  }
+
+  void addCandidate(std::size_t position, Scalar distance, std::size_t k, std::priority_queue<Neighbor>& heap, Scalar& radius) const {
+    if (heap.size() < k) {
+      heap.push(Neighbor{indices_[position], distance});
+    } else if (distance < heap.top().distance) {
+      heap.pop();
+      heap.push(Neighbor{indices_[position], distance});
+    }
+    if (heap.size() == k) {
+      radius = heap.top().distance;
+    }
+  }
+
+  void searchRadius(const Element& query, Scalar radius, std::size_t begin, std::size_t end, Neighbors& neighbors) const {
+    if (begin >= end) {
+      return;
+    }
+    if (isLeaf(begin, end)) {
+      for (std::size_t i = begin; i < end; ++i) {
+        const Scalar distance = metric_(query, elements_[i]);
+        if (distance <= radius) {
+          neighbors.push_back(Neighbor{indices_[i], distance});
+        }
+      }
+      return;
+    }
+    const Scalar distance = metric_(query, elements_[begin]);
+    if (distance <= radius) {
+      neighbors.push_back(Neighbor{indices_[begin], distance});
+    }
+    const std::size_t median = getMedian(begin, end);
+    if (distance - radius <= thresholds_[begin]) {
+      searchRadius(query, radius, begin + 1, median, neighbors);
+    }
+    if (distance + radius >= thresholds_[begin]) {
+      searchRadius(query, radius, median, end, neighbors);
+    }
+  }
+
+  static Neighbors getSortedNeighbors(std::priority_queue<Neighbor>& heap) {
+    Neighbors neighbors(heap.size());
+    for (std::size_t i = neighbors.size(); i > 0; --i) {
+      neighbors[i - 1] = heap.top();
+      heap.pop();
+    }
+    return neighbors;
+  }
+
+  Metric metric_;
+  std::size_t leafSize_;
+  //! elements in the order of the tree
+  Elements elements_;
+  //! indices of the elements of the tree in the elements given to the constructor
+  std::vector<std::size_t> indices_;
+  //! positions in the tree of the elements given to the constructor
+  std::vector<std::size_t> positions_;
+  //! median distance of the subtree to its vantage point
+  std::vector<Scalar> thresholds_;
+};
+
+template<typename Metric_>
+constexpr std::size_t VantagePointTree<Metric_>::parallelBuildSize;
+
+//! \brief Vantage-point tree of rotation quaternions with primitive type double
+typedef VantagePointTree<RotationDisparityMetric<double>> RotationVantagePointTreeD;
+//! \brief Vantage-point tree of rotation quaternions with primitive type float
+typedef VantagePointTree<RotationDisparityMetric<float>> RotationVantagePointTreeF;
+//! \brief Vantage-point tree of poses with primitive type double
+typedef VantagePointTree<PoseDisparityMetric<double>> PoseVantagePointTreeD;
+//! \brief Vantage-point tree of poses with primitive type float
+typedef VantagePointTree<PoseDisparityMetric<float>> PoseVantagePointTreeF;
+
+} // namespace kindr
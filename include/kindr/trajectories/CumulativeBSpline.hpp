@@ -0,0 +1,716 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <Eigen/Core>
+#include <Eigen/StdVector>
+
+#include "kindr/common/common.hpp"
+#include "kindr/common/assert_macros.hpp"
+#include "kindr/math/LinearAlgebra.hpp"
+#include "kindr/phys_quant/PhysicalQuantities.hpp"
+#include "kindr/rotations/Rotation.hpp"
+#include "kindr/rotations/RotationDiff.hpp"
+#include "kindr/poses/HomogeneousTransformation.hpp"
+#include "kindr/poses/Twist.hpp"
+
+namespace kindr {
+
+namespace internal {
+
+/*! \brief Cumulative basis functions lambda_0..3 of the uniform cubic B-spline and their derivatives
+ *  with respect to the normalized time u in [0,1] of a segment.
+ *  (only for advanced users)
+ */
+template<typename PrimType_>
+class CubicBSplineBasis {
+ public:
+  typedef Eigen::Matrix<PrimType_, 4, 1> Vector4;
+  typedef Eigen::Matrix<PrimType_, 4, 4> Matrix4;
+
+  //! Cumulative basis matrix, lambda(u) = C*[1 u u^2 u^3]^T
+  inline static Matrix4 getCumulativeBasisMatrix() {
+    Matrix4 matrix;
+    matrix << PrimType_(6), PrimType_(0), PrimType_( 0), PrimType_( 0),
+              PrimType_(5), PrimType_(3), PrimType_(-3), PrimType_( 1),
+              PrimType_(1), PrimType_(3), PrimType_( 3), PrimType_(-2),
+              PrimType_(0), PrimType_(0), PrimType_( 0), PrimType_( 1);
+    return matrix/PrimType_(6);
+  }
+
+  inline static Vector4 getCumulativeBasis(PrimType_ u) {
+    return getCumulativeBasisMatrix()*Vector4(PrimType_(1), u, u*u, u*u*u);
+  }
+
+  inline static Vector4 getCumulativeBasisDerivative(PrimType_ u) {
+    return getCumulativeBasisMatrix()*Vector4(PrimType_(0), PrimType_(1), PrimType_(2)*u, PrimType_(3)*u*u);
+  }
+
+  inline static Vector4 getCumulativeBasisSecondDerivative(PrimType_ u) {
+    return getCumulativeBasisMatrix()*Vector4(PrimType_(0), PrimType_(0), PrimType_(2), PrimType_(6)*u);
+  }
+};
+
+/*! \brief Maps a time to the segment index and the normalized time u in [0,1] of a uniform B-spline.
+ *  (only for advanced users)
+ */
+template<typename PrimType_>
+inline std::size_t getBSplineSegmentIndex(PrimType_ startTime, PrimType_ timeInterval, std::size_t numberOfSegments, PrimType_ time, PrimType_& u) {
+  using std::floor;
+  KINDR_ASSERT_TRUE(std::runtime_error, numberOfSegments > 0, "The spline needs at least four control points!");
+  const PrimType_ normalizedTime = (time - startTime)/timeInterval;
+  KINDR_ASSERT_TRUE(std::runtime_error, normalizedTime >= PrimType_(0) && normalizedTime <= PrimType_(numberOfSegments), "The time " << time << " is outside of the spline!");
+  const std::size_t index = std::min(static_cast<std::size_t>(floor(normalizedTime)), numberOfSegments - 1);
+  u = normalizedTime - PrimType_(index);
+  return index;
+}
+
+} // namespace internal
+
+
+/*! \class RotationBSplineSegment
+ *  \brief Segment of a cumulative cubic B-spline on SO(3), which depends on four consecutive control points.
+ *
+ *  The rotation at the normalized time u in [0,1] is
+ *  R(u) = R_0*exp(lambda_1(u)*d_1)*exp(lambda_2(u)*d_2)*exp(lambda_3(u)*d_3) with d_j = log(R_{j-1}^-1*R_j),
+ *  see Kim et al., "A General Construction Scheme for Unit Quaternion Curves with Simple High Order Derivatives".
+ *  The segment caches the logarithms d_j such that many queries within the segment are cheap.
+ *
+ *  The derivatives are expressed in the local (body) frame of R(u). The Jacobians with respect to the
+ *  control points use local perturbations, i.e. R_k <- R_k*exp(delta_k) and R(u) <- R(u)*exp(epsilon),
+ *  and are stacked as a 3x12 matrix [d(epsilon)/d(delta_0) ... d(epsilon)/d(delta_3)],
+ *  see Sommer et al., "Efficient Derivative Computation for Cumulative B-Splines on Lie Groups".
+ *
+ *  \tparam PrimType_ the primitive type of the data (double or float)
+ *  \ingroup rotations
+ */
+template<typename PrimType_>
+class RotationBSplineSegment {
+ public:
+  typedef PrimType_ Scalar;
+  typedef RotationQuaternion<Scalar> Rotation;
+  typedef LocalAngularVelocity<Scalar> AngularVelocity;
+  typedef kindr::AngularAcceleration<Scalar, 3> AngularAcceleration;
+  typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+  typedef Eigen::Matrix<Scalar, 3, 3> Matrix3;
+  typedef Eigen::Matrix<Scalar, 4, 1> Vector4;
+  typedef Eigen::Matrix<Scalar, 3, 12> Jacobian;
+  typedef internal::CubicBSplineBasis<Scalar> Basis;
+
+  RotationBSplineSegment() = default;
+
+  /*! \brief Constructor using four consecutive control points.
+   *  \param timeInterval  time between two control points
+   */
+  RotationBSplineSegment(const Rotation& controlPoint0, const Rotation& controlPoint1, const Rotation& controlPoint2, const Rotation& controlPoint3, Scalar timeInterval)
+    : controlPoint_(controlPoint0),
+      timeInterval_(timeInterval) {
+    deltas_.col(0) = (controlPoint0.inverted()*controlPoint1).logarithmicMap();
+    deltas_.col(1) = (controlPoint1.inverted()*controlPoint2).logarithmicMap();
+    deltas_.col(2) = (controlPoint2.inverted()*controlPoint3).logarithmicMap();
+  }
+
+  /*! \brief Gets the rotation.
+   *  \param u  normalized time in [0,1]
+   */
+  Rotation getRotation(Scalar u) const {
+    const Vector4 lambda = Basis::getCumulativeBasis(u);
+    Rotation rotation = controlPoint_;
+    for (int j = 0; j < 3; ++j) {
+      rotation = rotation*Rotation().exponentialMap(lambda(j + 1)*deltas_.col(j));
+    }
+    return rotation;
+  }
+
+  /*! \brief Gets the rotation, the local angular velocity and the local angular acceleration.
+   *  \param u  normalized time in [0,1]
+   */
+  void evaluate(Scalar u, Rotation& rotation, AngularVelocity& angularVelocity, AngularAcceleration& angularAcceleration) const {
+    const Vector4 lambda = Basis::getCumulativeBasis(u);
+    const Vector4 lambdaDot = Basis::getCumulativeBasisDerivative(u)/timeInterval_;
+    const Vector4 lambdaDDot = Basis::getCumulativeBasisSecondDerivative(u)/(timeInterval_*timeInterval_);
+    rotation = controlPoint_;
+    Vector3 omega = Vector3::Zero();
+    Vector3 omegaDot = Vector3::Zero();
+    for (int j = 0; j < 3; ++j) {
+      const Vector3 delta = deltas_.col(j);
+      const Rotation increment = Rotation().exponentialMap(lambda(j + 1)*delta);
+      rotation = rotation*increment;
+      // omega_j = A_j^T*omega_{j-1} + lambdaDot_j*d_j
+      omega = increment.inverseRotate(omega);
+      omegaDot = increment.inverseRotate(omegaDot) + lambdaDDot(j + 1)*delta + lambdaDot(j + 1)*omega.cross(delta);
+      omega += lambdaDot(j + 1)*delta;
+    }
+    angularVelocity = AngularVelocity(omega);
+    angularAcceleration = AngularAcceleration(omegaDot);
+  }
+
+  /*! \brief Gets the Jacobian of the rotation with respect to the four control points.
+   *  \param u  normalized time in [0,1]
+   */
+  void getRotationJacobian(Scalar u, Jacobian& jacobian) const {
+    const Vector4 lambda = Basis::getCumulativeBasis(u);
+    jacobian.setZero();
+    // product A_{j+1}*...*A_3 of the increments after the current one
+    Matrix3 tail = Matrix3::Identity();
+    for (int j = 2; j >= 0; --j) {
+      const Vector3 delta = lambda(j + 1)*deltas_.col(j);
+      const Matrix3 jacobianOfDelta = tail.transpose()*(lambda(j + 1)*getJacobianOfExponentialMap<Scalar>(-delta));
+      addJacobianOfDelta(j, jacobianOfDelta, jacobian);
+      tail = RotationMatrix<Scalar>(Rotation().exponentialMap(delta)).matrix()*tail;
+    }
+    jacobian.template leftCols<3>() += tail.transpose();
+  }
+
+  /*! \brief Gets the Jacobian of the local angular velocity with respect to the four control points.
+   *  \param u  normalized time in [0,1]
+   */
+  void getAngularVelocityJacobian(Scalar u, Jacobian& jacobian) const {
+    const Vector4 lambda = Basis::getCumulativeBasis(u);
+    const Vector4 lambdaDot = Basis::getCumulativeBasisDerivative(u)/timeInterval_;
+    Rotation increments[3];
+    Vector3 rotatedOmegas[3];
+    Vector3 omega = Vector3::Zero();
+    for (int j = 0; j < 3; ++j) {
+      increments[j] = Rotation().exponentialMap(lambda(j + 1)*deltas_.col(j));
+      rotatedOmegas[j] = increments[j].inverseRotate(omega);
+      omega = rotatedOmegas[j] + lambdaDot(j + 1)*deltas_.col(j);
+    }
+    jacobian.setZero();
+    Matrix3 tail = Matrix3::Identity();
+    for (int j = 2; j >= 0; --j) {
+      Matrix3 jacobianOfDelta = skewTimes(rotatedOmegas[j], lambda(j + 1)*getJacobianOfExponentialMap<Scalar>(-lambda(j + 1)*deltas_.col(j)));
+      jacobianOfDelta.diagonal().array() += lambdaDot(j + 1);
+      addJacobianOfDelta(j, tail.transpose()*jacobianOfDelta, jacobian);
+      tail = RotationMatrix<Scalar>(increments[j]).matrix()*tail;
+    }
+  }
+
+  //! Gets the logarithms d_1..3 of the relative rotations between the control points as columns
+  const Matrix3& getDeltas() const {
+    return deltas_;
+  }
+
+ private:
+  //! Chain rule through d_j = log(R_{j-1}^-1*R_j), i.e. d(d_j) = Jr^-1(d_j)*delta_j - Jr^-1(d_j)^T*delta_{j-1}
+  void addJacobianOfDelta(int j, const Matrix3& jacobianOfDelta, Jacobian& jacobian) const {
+    const Matrix3 rightJacobianInverse = getInverseJacobianOfExponentialMap<Scalar>(-deltas_.col(j));
+    jacobian.template block<3,3>(0, 3*(j + 1)) += jacobianOfDelta*rightJacobianInverse;
+    jacobian.template block<3,3>(0, 3*j) -= jacobianOfDelta*rightJacobianInverse.transpose();
+  }
+
+  Rotation controlPoint_;
+  Matrix3 deltas_ = Matrix3::Zero();
+  Scalar timeInterval_ = Scalar(1);
+
+ public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+
+/*! \class PositionBSplineSegment
+ *  \brief Segment of a cumulative cubic B-spline in R^3, which depends on four consecutive control points.
+ *
+ *  The position at the normalized time u in [0,1] is p(u) = p_0 + sum_j lambda_j(u)*(p_j - p_{j-1}).
+ *  The Jacobian with respect to the control points is stacked as a 3x12 matrix and is the same for the
+ *  position and its derivatives up to the basis functions.
+ *
+ *  \tparam PrimType_ the primitive type of the data (double or float)
+ *  \ingroup vectors
+ */
+template<typename PrimType_>
+class PositionBSplineSegment {
+ public:
+  typedef PrimType_ Scalar;
+  typedef kindr::Position<Scalar, 3> Position;
+  typedef kindr::Velocity<Scalar, 3> Velocity;
+  typedef kindr::Acceleration<Scalar, 3> Acceleration;
+  typedef Eigen::Matrix<Scalar, 3, 3> Matrix3;
+  typedef Eigen::Matrix<Scalar, 4, 1> Vector4;
+  typedef Eigen::Matrix<Scalar, 3, 12> Jacobian;
+  typedef internal::CubicBSplineBasis<Scalar> Basis;
+
+  PositionBSplineSegment() = default;
+
+  /*! \brief Constructor using four consecutive control points.
+   *  \param timeInterval  time between two control points
+   */
+  PositionBSplineSegment(const Position& controlPoint0, const Position& controlPoint1, const Position& controlPoint2, const Position& controlPoint3, Scalar timeInterval)
+    : timeInterval_(timeInterval) {
+    controlPoints_ << controlPoint0.toImplementation(), controlPoint1.toImplementation(), controlPoint2.toImplementation(), controlPoint3.toImplementation();
+  }
+
+  /*! \brief Gets the position.
+   *  \param u  normalized time in [0,1]
+   */
+  Position getPosition(Scalar u) const {
+    return Position(controlPoints_*getWeights(Basis::getCumulativeBasis(u)));
+  }
+
+  /*! \brief Gets the position, the velocity and the acceleration.
+   *  \param u  normalized time in [0,1]
+   */
+  void evaluate(Scalar u, Position& position, Velocity& velocity, Acceleration& acceleration) const {
+    position = Position(controlPoints_*getWeights(Basis::getCumulativeBasis(u)));
+    velocity = Velocity(controlPoints_*getWeights(Basis::getCumulativeBasisDerivative(u))/timeInterval_);
+    acceleration = Acceleration(controlPoints_*getWeights(Basis::getCumulativeBasisSecondDerivative(u))/(timeInterval_*timeInterval_));
+  }
+
+  /*! \brief Gets the Jacobian of the position with respect to the four control points.
+   *  \param u  normalized time in [0,1]
+   */
+  void getPositionJacobian(Scalar u, Jacobian& jacobian) const {
+    const Vector4 weights = getWeights(Basis::getCumulativeBasis(u));
+    for (int k = 0; k < 4; ++k) {
+      jacobian.template block<3,3>(0, 3*k) = weights(k)*Matrix3::Identity();
+    }
+  }
+
+ private:
+  //! Weights lambda_k - lambda_{k+1} of the control points, with lambda_4 = 0
+  inline static Vector4 getWeights(const Vector4& lambda) {
+    return Vector4(lambda(0) - lambda(1), lambda(1) - lambda(2), lambda(2) - lambda(3), lambda(3));
+  }
+
+  Eigen::Matrix<Scalar, 3, 4> controlPoints_ = Eigen::Matrix<Scalar, 3, 4>::Zero();
+  Scalar timeInterval_ = Scalar(1);
+};
+
+
+/*! \class RotationBSpline
+ *  \brief Uniform cumulative cubic B-spline on SO(3), e.g. for continuous-time trajectories.
+ *
+ *  The control point k belongs to the time t_0 + (k-1)*dt, and the segment s covers the times
+ *  [t_0 + s*dt, t_0 + (s+1)*dt] and depends on the control points s..s+3. A spline with n control points
+ *  is therefore defined between t_0 and t_0 + (n-3)*dt. A query costs O(1). For many queries, the
+ *  segments are reused as long as consecutive times fall into the same segment:
+ *  \code{.cpp}
+ *  RotationBSplineD spline(startTime, timeInterval, controlPoints);
+ *  const RotationQuaternionD rotation = spline.getRotation(time);
+ *  spline.getRotations(times, rotations); // sorted times
+ *  \endcode
+ *
+ *  \tparam PrimType_ the primitive type of the data (double or float)
+ *  \ingroup rotations
+ */
+template<typename PrimType_>
+class RotationBSpline {
+ public:
+  typedef PrimType_ Scalar;
+  typedef RotationBSplineSegment<Scalar> Segment;
+  typedef typename Segment::Rotation Rotation;
+  typedef typename Segment::AngularVelocity AngularVelocity;
+  typedef typename Segment::AngularAcceleration AngularAcceleration;
+  typedef typename Segment::Jacobian Jacobian;
+  typedef std::vector<Rotation, Eigen::aligned_allocator<Rotation>> Rotations;
+
+  /*! \brief Constructor without control points.
+   *  \param startTime     time t_0 at which the spline starts
+   *  \param timeInterval  time dt between two control points
+   */
+  RotationBSpline(Scalar startTime = Scalar(0), Scalar timeInterval = Scalar(1))
+    : startTime_(startTime),
+      timeInterval_(timeInterval) {
+    KINDR_ASSERT_TRUE(std::runtime_error, timeInterval > Scalar(0), "The time interval must be positive!");
+  }
+
+  RotationBSpline(Scalar startTime, Scalar timeInterval, const Rotations& controlPoints)
+    : RotationBSpline(startTime, timeInterval) {
+    controlPoints_ = controlPoints;
+  }
+
+  //! Appends a control point, e.g. while the trajectory grows
+  void addControlPoint(const Rotation& controlPoint) {
+    controlPoints_.push_back(controlPoint);
+  }
+
+  const Rotations& getControlPoints() const {
+    return controlPoints_;
+  }
+
+  Rotations& getControlPoints() {
+    return controlPoints_;
+  }
+
+  Scalar getStartTime() const {
+    return startTime_;
+  }
+
+  Scalar getTimeInterval() const {
+    return timeInterval_;
+  }
+
+  Scalar getEndTime() const {
+    return startTime_ + Scalar(getNumberOfSegments())*timeInterval_;
+  }
+
+  std::size_t getNumberOfSegments() const {
+    return controlPoints_.size() < 4 ? 0 : controlPoints_.size() - 3;
+  }
+
+  /*! \brief Gets the index of the segment, i.e. of its first control point, and the normalized time u in [0,1].
+   */
+  std::size_t getSegmentIndex(Scalar time, Scalar& u) const {
+    return internal::getBSplineSegmentIndex(startTime_, timeInterval_, getNumberOfSegments(), time, u);
+  }
+
+  Segment getSegment(std::size_t index) const {
+    KINDR_ASSERT_TRUE(std::runtime_error, index < getNumberOfSegments(), "The segment " << index << " does not exist!");
+    return Segment(controlPoints_[index], controlPoints_[index + 1], controlPoints_[index + 2], controlPoints_[index + 3], timeInterval_);
+  }
+
+  Rotation getRotation(Scalar time) const {
+    Scalar u;
+    const std::size_t index = getSegmentIndex(time, u);
+    return getSegment(index).getRotation(u);
+  }
+
+  AngularVelocity getAngularVelocity(Scalar time) const {
+    Rotation rotation;
+    AngularVelocity angularVelocity;
+    AngularAcceleration angularAcceleration;
+    evaluate(time, rotation, angularVelocity, angularAcceleration);
+    return angularVelocity;
+  }
+
+  AngularAcceleration getAngularAcceleration(Scalar time) const {
+    Rotation rotation;
+    AngularVelocity angularVelocity;
+    AngularAcceleration angularAcceleration;
+    evaluate(time, rotation, angularVelocity, angularAcceleration);
+    return angularAcceleration;
+  }
+
+  //! Gets the rotation and its local derivatives at once
+  void evaluate(Scalar time, Rotation& rotation, AngularVelocity& angularVelocity, AngularAcceleration& angularAcceleration) const {
+    Scalar u;
+    const std::size_t index = getSegmentIndex(time, u);
+    getSegment(index).evaluate(u, rotation, angularVelocity, angularAcceleration);
+  }
+
+  //! Gets the rotations at many times, preferably sorted
+  void getRotations(const std::vector<Scalar>& times, Rotations& rotations) const {
+    rotations.resize(times.size());
+    CachedSegment cache;
+    for (std::size_t i = 0; i < times.size(); ++i) {
+      Scalar u;
+      rotations[i] = getCachedSegment(times[i], u, cache).getRotation(u);
+    }
+  }
+
+  //! Gets the rotations and their local derivatives at many times, preferably sorted
+  void evaluate(const std::vector<Scalar>& times, Rotations& rotations, std::vector<AngularVelocity>& angularVelocities, std::vector<AngularAcceleration>& angularAccelerations) const {
+    rotations.resize(times.size());
+    angularVelocities.resize(times.size());
+    angularAccelerations.resize(times.size());
+    CachedSegment cache;
+    for (std::size_t i = 0; i < times.size(); ++i) {
+      Scalar u;
+      getCachedSegment(times[i], u, cache).evaluate(u, rotations[i], angularVelocities[i], angularAccelerations[i]);
+    }
+  }
+
+  /*! \brief Gets the Jacobian of the rotation with respect to the control points firstControlPoint..firstControlPoint+3.
+   */
+  void getRotationJacobian(Scalar time, Jacobian& jacobian, std::size_t& firstControlPoint) const {
+    Scalar u;
+    firstControlPoint = getSegmentIndex(time, u);
+    getSegment(firstControlPoint).getRotationJacobian(u, jacobian);
+  }
+
+  /*! \brief Gets the Jacobian of the local angular velocity with respect to the control points firstControlPoint..firstControlPoint+3.
+   */
+  void getAngularVelocityJacobian(Scalar time, Jacobian& jacobian, std::size_t& firstControlPoint) const {
+    Scalar u;
+    firstControlPoint = getSegmentIndex(time, u);
+    getSegment(firstControlPoint).getAngularVelocityJacobian(u, jacobian);
+  }
+
+ private:
+  struct CachedSegment {
+    std::size_t index = static_cast<std::size_t>(-1);
+    Segment segment;
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+  };
+
+  const Segment& getCachedSegment(Scalar time, Scalar& u, CachedSegment& cache) const {
+    const std::size_t index = getSegmentIndex(time, u);
+    if (index != cache.index) {
+      cache.index = index;
+      cache.segment = getSegment(index);
+    }
+    return cache.segment;
+  }
+
+  Scalar startTime_;
+  Scalar timeInterval_;
+  Rotations controlPoints_;
+};
+
+//! \brief Cumulative cubic B-spline on SO(3) with primitive type double
+typedef RotationBSpline<double> RotationBSplineD;
+//! \brief Cumulative cubic B-spline on SO(3) with primitive type float
+typedef RotationBSpline<float> RotationBSplineF;
+
+
+/*! \class PositionBSpline
+ *  \brief Uniform cubic B-spline in R^3 with the same timing as RotationBSpline.
+ *
+ *  \tparam PrimType_ the primitive type of the data (double or float)
+ *  \ingroup vectors
+ */
+template<typename PrimType_>
+class PositionBSpline {
+ public:
+  typedef PrimType_ Scalar;
+  typedef PositionBSplineSegment<Scalar> Segment;
+  typedef typename Segment::Position Position;
+  typedef typename Segment::Velocity Velocity;
+  typedef typename Segment::Acceleration Acceleration;
+  typedef typename Segment::Jacobian Jacobian;
+  typedef std::vector<Position, Eigen::aligned_allocator<Position>> Positions;
+
+  /*! \brief Constructor without control points.
+   *  \param startTime     time t_0 at which the spline starts
+   *  \param timeInterval  time dt between two control points
+   */
+  PositionBSpline(Scalar startTime = Scalar(0), Scalar timeInterval = Scalar(1))
+    : startTime_(startTime),
+      timeInterval_(timeInterval) {
+    KINDR_ASSERT_TRUE(std::runtime_error, timeInterval > Scalar(0), "The time interval must be positive!");
+  }
+
+  PositionBSpline(Scalar startTime, Scalar timeInterval, const Positions& controlPoints)
+    : PositionBSpline(startTime, timeInterval) {
+    controlPoints_ = controlPoints;
+  }
+
+  //! Appends a control point, e.g. while the trajectory grows
+  void addControlPoint(const Position& controlPoint) {
+    controlPoints_.push_back(controlPoint);
+  }
+
+  const Positions& getControlPoints() const {
+    return controlPoints_;
+  }
+
+  Positions& getControlPoints() {
+    return controlPoints_;
+  }
+
+  Scalar getStartTime() const {
+    return startTime_;
+  }
+
+  Scalar getTimeInterval() const {
+    return timeInterval_;
+  }
+
+  Scalar getEndTime() const {
+    return startTime_ + Scalar(getNumberOfSegments())*timeInterval_;
+  }
+
+  std::size_t getNumberOfSegments() const {
+    return controlPoints_.size() < 4 ? 0 : controlPoints_.size() - 3;
+  }
+
+  /*! \brief Gets the index of the segment, i.e. of its first control point, and the normalized time u in [0,1].
+   */
+  std::size_t getSegmentIndex(Scalar time, Scalar& u) const {
+    return internal::getBSplineSegmentIndex(startTime_, timeInterval_, getNumberOfSegments(), time, u);
+  }
+
+  Segment getSegment(std::size_t index) const {
+    KINDR_ASSERT_TRUE(std::runtime_error, index < getNumberOfSegments(), "The segment " << index << " does not exist!");
+    return Segment(controlPoints_[index], controlPoints_[index + 1], controlPoints_[index + 2], controlPoints_[index + 3], timeInterval_);
+  }
+
+  Position getPosition(Scalar time) const {
+    Scalar u;
+    const std::size_t index = getSegmentIndex(time, u);
+    return getSegment(index).getPosition(u);
+  }
+
+  //! Gets the position and its derivatives at once
+  void evaluate(Scalar time, Position& position, Velocity& velocity, Acceleration& acceleration) const {
+    Scalar u;
+    const std::size_t index = getSegmentIndex(time, u);
+    getSegment(index).evaluate(u, position, velocity, acceleration);
+  }
+
+  //! Gets the positions at many times
+  void getPositions(const std::vector<Scalar>& times, Positions& positions) const {
+    positions.resize(times.size());
+    for (std::size_t i = 0; i < times.size(); ++i) {
+      positions[i] = getPosition(times[i]);
+    }
+  }
+
+  /*! \brief Gets the Jacobian of the position with respect to the control points firstControlPoint..firstControlPoint+3.
+   */
+  void getPositionJacobian(Scalar time, Jacobian& jacobian, std::size_t& firstControlPoint) const {
+    Scalar u;
+    firstControlPoint = getSegmentIndex(time, u);
+    getSegment(firstControlPoint).getPositionJacobian(u, jacobian);
+  }
+
+ private:
+  Scalar startTime_;
+  Scalar timeInterval_;
+  Positions controlPoints_;
+};
+
+//! \brief Cubic B-spline in R^3 with primitive type double
+typedef PositionBSpline<double> PositionBSplineD;
+//! \brief Cubic B-spline in R^3 with primitive type float
+typedef PositionBSpline<float> PositionBSplineF;
+
+
+/*! \class PoseBSpline
+ *  \brief Cumulative cubic B-spline of poses on SO(3)xR^3.
+ *
+ *  The rotation and the position are interpolated by a RotationBSpline and a PositionBSpline with the same
+ *  timing. The twist is the body twist, i.e. the linear velocity R^T*dp/dt and the local angular velocity, which
+ *  integratePose() and PoseResampler expect. The acceleration is d^2p/dt^2 in the frame of the positions.
+ *
+ *  \tparam PrimType_ the primitive type of the data (double or float)
+ *  \ingroup poses
+ */
+template<typename PrimType_>
+class PoseBSpline {
+ public:
+  typedef PrimType_ Scalar;
+  typedef HomTransformQuat<Scalar> Pose;
+  typedef TwistLinearVelocityLocalAngularVelocity<Scalar> Twist;
+  typedef RotationBSpline<Scalar> RotationSpline;
+  typedef PositionBSpline<Scalar> PositionSpline;
+  typedef typename RotationSpline::AngularAcceleration AngularAcceleration;
+  typedef typename PositionSpline::Acceleration Acceleration;
+  typedef typename RotationSpline::Jacobian Jacobian;
+  typedef std::vector<Pose, Eigen::aligned_allocator<Pose>> Poses;
+
+  /*! \brief Constructor without control points.
+   *  \param startTime     time t_0 at which the spline starts
+   *  \param timeInterval  time dt between two control points
+   */
+  PoseBSpline(Scalar startTime = Scalar(0), Scalar timeInterval = Scalar(1))
+    : rotationSpline_(startTime, timeInterval),
+      positionSpline_(startTime, timeInterval) {
+  }
+
+  PoseBSpline(Scalar startTime, Scalar timeInterval, const Poses& controlPoints)
+    : PoseBSpline(startTime, timeInterval) {
+    for (const Pose& controlPoint : controlPoints) {
+      addControlPoint(controlPoint);
+    }
+  }
+
+  //! Appends a control point, e.g. while the trajectory grows
+  void addControlPoint(const Pose& controlPoint) {
+    rotationSpline_.addControlPoint(controlPoint.getRotation());
+    positionSpline_.addControlPoint(controlPoint.getPosition());
+  }
+
+  const RotationSpline& getRotationSpline() const {
+    return rotationSpline_;
+  }
+
+  const PositionSpline& getPositionSpline() const {
+    return positionSpline_;
+  }
+
+  Scalar getStartTime() const {
+    return rotationSpline_.getStartTime();
+  }
+
+  Scalar getTimeInterval() const {
+    return rotationSpline_.getTimeInterval();
+  }
+
+  Scalar getEndTime() const {
+    return rotationSpline_.getEndTime();
+  }
+
+  std::size_t getNumberOfSegments() const {
+    return rotationSpline_.getNumberOfSegments();
+  }
+
+  Pose getPose(Scalar time) const {
+    return Pose(positionSpline_.getPosition(time), rotationSpline_.getRotation(time));
+  }
+
+  Twist getTwist(Scalar time) const {
+    Pose pose;
+    Twist twist;
+    Acceleration acceleration;
+    AngularAcceleration angularAcceleration;
+    evaluate(time, pose, twist, acceleration, angularAcceleration);
+    return twist;
+  }
+
+  //! Gets the pose, the body twist and the accelerations at once
+  void evaluate(Scalar time, Pose& pose, Twist& twist, Acceleration& acceleration, AngularAcceleration& angularAcceleration) const {
+    typename PositionSpline::Velocity velocity;
+    positionSpline_.evaluate(time, pose.getPosition(), velocity, acceleration);
+    rotationSpline_.evaluate(time, pose.getRotation(), twist.getRotationalVelocity(), angularAcceleration);
+    twist.getTranslationalVelocity().toImplementation() = pose.getRotation().inverseRotate(velocity.toImplementation());
+  }
+
+  //! Gets the poses at many times, preferably sorted
+  void getPoses(const std::vector<Scalar>& times, Poses& poses) const {
+    typename RotationSpline::Rotations rotations;
+    rotationSpline_.getRotations(times, rotations);
+    poses.resize(times.size());
+    for (std::size_t i = 0; i < times.size(); ++i) {
+      poses[i] = Pose(positionSpline_.getPosition(times[i]), rotations[i]);
+    }
+  }
+
+  /*! \brief Gets the Jacobians of the position and of the rotation with respect to the control points firstControlPoint..firstControlPoint+3.
+   */
+  void getJacobians(Scalar time, Jacobian& positionJacobian, Jacobian& rotationJacobian, std::size_t& firstControlPoint) const {
+    positionSpline_.getPositionJacobian(time, positionJacobian, firstControlPoint);
+    rotationSpline_.getRotationJacobian(time, rotationJacobian, firstControlPoint);
+  }
+
+ private:
+  RotationSpline rotationSpline_;
+  PositionSpline positionSpline_;
+};
+
+//! \brief Cumulative cubic B-spline of poses with primitive type double
+typedef PoseBSpline<double> PoseBSplineD;
+//! \brief Cumulative cubic B-spline of poses with primitive type float
+typedef PoseBSpline<float> PoseBSplineF;
+
+} // namespace kindr
@@ -0,0 +1,355 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <deque>
+
+#include <Eigen/Core>
+#include <Eigen/StdDeque>
+
+#include "kindr/common/common.hpp"
+#include "kindr/common/assert_macros.hpp"
+#include "kindr/rotations/Rotation.hpp"
+#include "kindr/rotations/RotationDiff.hpp"
+#include "kindr/poses/HomogeneousTransformation.hpp"
+#include "kindr/poses/Twist.hpp"
+#include "kindr/poses/PoseIntegration.hpp"
+
+namespace kindr {
+
+//! Interpolation of the poses between two samples
+enum class PoseInterpolationType {
+  LinearSlerp,  //!< linear interpolation of the position and spherical linear interpolation of the rotation
+  Geodesic,     //!< geodesic of SE(3), i.e. T(u) = T_0*exp(u*log(T_0^-1*T_1))
+  Hermite       //!< cubic Hermite interpolation with the twists of the samples as tangents
+};
+
+/*! \class PoseResampler
+ *  \brief Resamples a stream of poses and body twists at query times, e.g. from sensor to controller timestamps.
+ *
+ *  The samples are added in the order of their times. The data of the segment between two consecutive samples,
+ *  such as the logarithm of the relative rotation, are computed once when the second sample is added. The queries
+ *  keep a cursor on the segments, such that resampling n samples at m sorted query times costs O(n + m). The batch
+ *  resample() evaluates the queries in chunks with Eigen arrays and returns them in structure-of-arrays form like
+ *  the batched pose integration, i.e. the positions as Mx3, the quaternions (w, x, y, z) as Mx4 and the
+ *  twists [linear; angular] as Mx6 matrices.
+ *
+ *  The rotations are interpolated in the body frame of the first sample, R(u) = R_0*exp(r(u)), where r(u) = u*phi
+ *  with phi = log(R_0^-1*R_1) for the linear and the geodesic interpolation. The Hermite interpolation uses the body
+ *  twists of the samples as tangents: the position is the cubic Hermite spline with the linear velocities rotated
+ *  into the world frame, and r(u) is the cubic Hermite spline with the tangents dt*w_0 and dt*J_r^-1(phi)*w_1, where
+ *  J_r is the right Jacobian of the exponential map, such that the angular velocities match at the samples.
+ *  The twists themselves are interpolated linearly.
+ *
+ *  \tparam PrimType_ the primitive type of the data (double or float)
+ *  \ingroup trajectories
+ */
+template<typename PrimType_>
+class PoseResampler {
+ public:
+  typedef PrimType_ Scalar;
+  typedef HomTransformQuat<PrimType_> Pose;
+  typedef TwistLinearVelocityLocalAngularVelocity<PrimType_> Twist;
+  typedef Eigen::Matrix<PrimType_, 3, 1> Vector3;
+  typedef Eigen::Matrix<PrimType_, 4, 1> Vector4;
+  typedef Eigen::Matrix<PrimType_, 6, 1> Vector6;
+  typedef Eigen::Matrix<PrimType_, Eigen::Dynamic, 1> Times;
+  typedef Eigen::Matrix<PrimType_, Eigen::Dynamic, 3> Positions;
+  typedef Eigen::Matrix<PrimType_, Eigen::Dynamic, 4> Quaternions;
+  typedef Eigen::Matrix<PrimType_, Eigen::Dynamic, 6> Twists;
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  explicit PoseResampler(PoseInterpolationType type = PoseInterpolationType::LinearSlerp)
+    : type_(type),
+      hasSample_(false),
+      lastTime_(Scalar(0)),
+      lastTwist_(Vector6::Zero()),
+      cursor_(0) {
+    lastPose_.setIdentity();
+  }
+
+  inline PoseInterpolationType getInterpolationType() const {
+    return type_;
+  }
+
+  /*! \brief Adds a sample at a time after the previous sample.
+   *  \param time   time of the sample
+   *  \param pose   pose of the body in the world frame
+   *  \param twist  body twist, which is required by the Hermite interpolation
+   */
+  template<typename PoseDerived_>
+  void addSample(Scalar time, const PoseBase<PoseDerived_>& pose, const Twist& twist = Twist(Vector6::Zero())) {
+    const Pose samplePose(pose);
+    if (hasSample_) {
+      KINDR_ASSERT_TRUE(std::runtime_error, time > lastTime_, "The samples must be added in the order of their times!");
+      segments_.push_back(getSegment(lastTime_, lastPose_, lastTwist_, time, samplePose, twist));
+    }
+    hasSample_ = true;
+    lastTime_ = time;
+    lastPose_ = samplePose;
+    lastTwist_ = twist;
+  }
+
+  /*! \brief Removes the samples which are not needed anymore for queries at or after a time.
+   *  \param time  earliest time of the following queries
+   */
+  void removeSamplesBefore(Scalar time) {
+    while (segments_.size() > 1 && segments_[1].startTime <= time) {
+      segments_.pop_front();
+      cursor_ = cursor_ > 0 ? cursor_ - 1 : 0;
+    }
+  }
+
+  //! Removes all samples
+  void clear() {
+    segments_.clear();
+    hasSample_ = false;
+    cursor_ = 0;
+  }
+
+  //! Gets the number of segments, i.e. the number of samples minus one
+  inline std::size_t getNumberOfSegments() const {
+    return segments_.size();
+  }
+
+  //! Gets the earliest time which can be queried
+  inline Scalar getStartTime() const {
+    KINDR_ASSERT_TRUE(std::runtime_error, !segments_.empty(), "The resampler needs at least two samples!");
+    return segments_.front().startTime;
+  }
+
+  //! Gets the latest time which can be queried
+  inline Scalar getEndTime() const {
+    KINDR_ASSERT_TRUE(std::runtime_error, !segments_.empty(), "The resampler needs at least two samples!");
+    return segments_.back().startTime + segments_.back().duration;
+  }
+
+  //! Gets the interpolated pose at a time
+  Pose getPose(Scalar time) {
+    Scalar u;
+    const Segment& segment = segments_[locate(time, u)];
+    const Pose start(Position<Scalar, 3>(segment.position), RotationQuaternion<Scalar>(segment.rotation(0), segment.rotation(1), segment.rotation(2), segment.rotation(3)));
+    switch (type_) {
+      case PoseInterpolationType::Geodesic:
+        return integratePose(start, Twist(segment.twistTranslation, segment.rotationVector), u);
+      case PoseInterpolationType::Hermite: {
+        const Vector4 basis = getHermiteBasis(u);
+        const Vector3 position = segment.position + basis(1)*segment.tangent0 + basis(2)*segment.translation + basis(3)*segment.tangent1;
+        const Vector3 rotationVector = basis(1)*segment.rotationTangent0 + basis(2)*segment.rotationVector + basis(3)*segment.rotationTangent1;
+        return Pose(Position<Scalar, 3>(position), start.getRotation()*RotationQuaternion<Scalar>().exponentialMap(rotationVector));
+      }
+      default:
+        return Pose(Position<Scalar, 3>(segment.position + u*segment.translation),
+                    start.getRotation()*RotationQuaternion<Scalar>().exponentialMap(u*segment.rotationVector));
+    }
+  }
+
+  //! Gets the linearly interpolated twist at a time
+  Twist getTwist(Scalar time) {
+    Scalar u;
+    const Segment& segment = segments_[locate(time, u)];
+    return Twist(Vector6((Scalar(1) - u)*segment.twist0 + u*segment.twist1));
+  }
+
+  /*! \brief Resamples the poses at many query times.
+   *  \param queryTimes   query times within [getStartTime(), getEndTime()], preferably sorted
+   *  \param positions    resized to Mx3, positions at the query times
+   *  \param quaternions  resized to Mx4, quaternions (w, x, y, z) at the query times
+   */
+  void resample(const Times& queryTimes, Positions& positions, Quaternions& quaternions) {
+    resampleImpl<false>(queryTimes, positions, quaternions, nullptr);
+  }
+
+  /*! \brief Resamples the poses and twists at many query times.
+   *  \param twists  resized to Mx6, twists [linear; angular] at the query times
+   */
+  void resample(const Times& queryTimes, Positions& positions, Quaternions& quaternions, Twists& twists) {
+    resampleImpl<true>(queryTimes, positions, quaternions, &twists);
+  }
+
+ private:
+  //! Cached data of the segment between two samples
+  struct Segment {
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+    Scalar startTime;
+    Scalar duration;
+    Vector3 position;
+    Vector4 rotation;
+    //! p_1 - p_0
+    Vector3 translation;
+    //! log(R_0^-1*R_1)
+    Vector3 rotationVector;
+    //! translation part of log(T_0^-1*T_1) for the geodesic interpolation
+    Vector3 twistTranslation;
+    //! tangents of the Hermite interpolation
+    Vector3 tangent0;
+    Vector3 tangent1;
+    Vector3 rotationTangent0;
+    Vector3 rotationTangent1;
+    Vector6 twist0;
+    Vector6 twist1;
+  };
+  typedef std::deque<Segment, Eigen::aligned_allocator<Segment> > Segments;
+  typedef Eigen::Array<Scalar, Eigen::Dynamic, 1, 0, internal::PoseIntegrationChunkSize, 1> Chunk;
+
+  Segment getSegment(Scalar startTime, const Pose& start, const Twist& startTwist, Scalar endTime, const Pose& end, const Twist& endTwist) const {
+    Segment segment;
+    segment.startTime = startTime;
+    segment.duration = endTime - startTime;
+    segment.position = start.getPosition().toImplementation();
+    segment.rotation << start.getRotation().w(), start.getRotation().x(), start.getRotation().y(), start.getRotation().z();
+    segment.translation = end.getPosition().toImplementation() - start.getPosition().toImplementation();
+    segment.rotationVector = (start.getRotation().inverted()*end.getRotation()).logarithmicMap();
+    segment.twist0 = startTwist.getVector();
+    segment.twist1 = endTwist.getVector();
+    segment.twistTranslation.setZero();
+    segment.tangent0.setZero();
+    segment.tangent1.setZero();
+    segment.rotationTangent0.setZero();
+    segment.rotationTangent1.setZero();
+    if (type_ == PoseInterpolationType::Geodesic) {
+      segment.twistTranslation = getInverseJacobianOfExponentialMap<Scalar>(segment.rotationVector)*start.getRotation().inverseRotate(segment.translation);
+    } else if (type_ == PoseInterpolationType::Hermite) {
+      segment.tangent0 = segment.duration*start.getRotation().rotate(Vector3(segment.twist0.template head<3>()));
+      segment.tangent1 = segment.duration*end.getRotation().rotate(Vector3(segment.twist1.template head<3>()));
+      segment.rotationTangent0 = segment.duration*segment.twist0.template tail<3>();
+      // dr/dt = J_r^-1(r)*w with J_r^-1(r) = J_l^-1(-r)
+      segment.rotationTangent1 = segment.duration*getInverseJacobianOfExponentialMap<Scalar>(Vector3(-segment.rotationVector))*segment.twist1.template tail<3>();
+    }
+    return segment;
+  }
+
+  //! Cubic Hermite basis [h00 h10 h01 h11]
+  static Vector4 getHermiteBasis(Scalar u) {
+    const Scalar u2 = u*u;
+    const Scalar u3 = u2*u;
+    return Vector4(Scalar(2)*u3 - Scalar(3)*u2 + Scalar(1), u3 - Scalar(2)*u2 + u, Scalar(3)*u2 - Scalar(2)*u3, u3 - u2);
+  }
+
+  //! Moves the cursor to the segment containing the time and gets the normalized time u in [0,1]
+  std::size_t locate(Scalar time, Scalar& u) {
+    KINDR_ASSERT_TRUE(std::runtime_error, !segments_.empty(), "The resampler needs at least two samples!");
+    KINDR_ASSERT_TRUE(std::runtime_error, time >= getStartTime() && time <= getEndTime(), "The time " << time << " is outside of the samples!");
+    while (cursor_ > 0 && time < segments_[cursor_].startTime) {
+      --cursor_;
+    }
+    while (cursor_ + 1 < segments_.size() && time >= segments_[cursor_ + 1].startTime) {
+      ++cursor_;
+    }
+    const Segment& segment = segments_[cursor_];
+    u = std::min((time - segment.startTime)/segment.duration, Scalar(1));
+    return cursor_;
+  }
+
+  template<bool WithTwists_>
+  void resampleImpl(const Times& queryTimes, Positions& positions, Quaternions& quaternions, Twists* twists) {
+    const Eigen::DenseIndex size = queryTimes.size();
+    positions.resize(size, 3);
+    quaternions.resize(size, 4);
+    if (WithTwists_) {
+      twists->resize(size, 6);
+    }
+    for (Eigen::DenseIndex begin = 0; begin < size; begin += internal::PoseIntegrationChunkSize) {
+      const Eigen::DenseIndex n = std::min<Eigen::DenseIndex>(internal::PoseIntegrationChunkSize, size - begin);
+      // gather the segment data of the queries, which is the only sequential part
+      Chunk u(n), px(n), py(n), pz(n), qw(n), qx(n), qy(n), qz(n), dx(n), dy(n), dz(n), fx(n), fy(n), fz(n);
+      Chunk ax(n), ay(n), az(n), bx(n), by(n), bz(n), cx(n), cy(n), cz(n), ex(n), ey(n), ez(n);
+      for (Eigen::DenseIndex i = 0; i < n; ++i) {
+        const Segment& segment = segments_[locate(queryTimes(begin + i), u(i))];
+        px(i) = segment.position.x(); py(i) = segment.position.y(); pz(i) = segment.position.z();
+        qw(i) = segment.rotation(0); qx(i) = segment.rotation(1); qy(i) = segment.rotation(2); qz(i) = segment.rotation(3);
+        fx(i) = segment.rotationVector.x(); fy(i) = segment.rotationVector.y(); fz(i) = segment.rotationVector.z();
+        if (type_ == PoseInterpolationType::Geodesic) {
+          dx(i) = segment.twistTranslation.x(); dy(i) = segment.twistTranslation.y(); dz(i) = segment.twistTranslation.z();
+        } else {
+          dx(i) = segment.translation.x(); dy(i) = segment.translation.y(); dz(i) = segment.translation.z();
+        }
+        if (type_ == PoseInterpolationType::Hermite) {
+          ax(i) = segment.tangent0.x(); ay(i) = segment.tangent0.y(); az(i) = segment.tangent0.z();
+          bx(i) = segment.tangent1.x(); by(i) = segment.tangent1.y(); bz(i) = segment.tangent1.z();
+          cx(i) = segment.rotationTangent0.x(); cy(i) = segment.rotationTangent0.y(); cz(i) = segment.rotationTangent0.z();
+          ex(i) = segment.rotationTangent1.x(); ey(i) = segment.rotationTangent1.y(); ez(i) = segment.rotationTangent1.z();
+        }
+        if (WithTwists_) {
+          twists->row(begin + i) = ((Scalar(1) - u(i))*segment.twist0 + u(i)*segment.twist1).transpose();
+        }
+      }
+
+      // interpolation, vectorized over the chunk
+      Chunk ox(n), oy(n), oz(n), dw(n), dqx(n), dqy(n), dqz(n);
+      if (type_ == PoseInterpolationType::Geodesic) {
+        Chunk tx(n), ty(n), tz(n);
+        internal::getExponentialOfBodyTwists<Chunk>(u*dx, u*dy, u*dz, u*fx, u*fy, u*fz, Scalar(1), dw, dqx, dqy, dqz, tx, ty, tz);
+        internal::rotateByQuaternions<Chunk>(qw, qx, qy, qz, tx, ty, tz, ox, oy, oz);
+        ox += px;
+        oy += py;
+        oz += pz;
+      } else if (type_ == PoseInterpolationType::Hermite) {
+        const Chunk u2 = u*u;
+        const Chunk u3 = u2*u;
+        const Chunk h10 = u3 - Scalar(2)*u2 + u;
+        const Chunk h01 = Scalar(3)*u2 - Scalar(2)*u3;
+        const Chunk h11 = u3 - u2;
+        ox = px + h10*ax + h01*dx + h11*bx;
+        oy = py + h10*ay + h01*dy + h11*by;
+        oz = pz + h10*az + h01*dz + h11*bz;
+        internal::getExponentialOfRotationVectors<Chunk>(h10*cx + h01*fx + h11*ex, h10*cy + h01*fy + h11*ey, h10*cz + h01*fz + h11*ez, dw, dqx, dqy, dqz);
+      } else {
+        ox = px + u*dx;
+        oy = py + u*dy;
+        oz = pz + u*dz;
+        internal::getExponentialOfRotationVectors<Chunk>(u*fx, u*fy, u*fz, dw, dqx, dqy, dqz);
+      }
+      Chunk rw(n), rx(n), ry(n), rz(n);
+      internal::multiplyQuaternions<Chunk>(qw, qx, qy, qz, dw, dqx, dqy, dqz, rw, rx, ry, rz);
+      positions.col(0).segment(begin, n) = ox.matrix();
+      positions.col(1).segment(begin, n) = oy.matrix();
+      positions.col(2).segment(begin, n) = oz.matrix();
+      quaternions.col(0).segment(begin, n) = rw.matrix();
+      quaternions.col(1).segment(begin, n) = rx.matrix();
+      quaternions.col(2).segment(begin, n) = ry.matrix();
+      quaternions.col(3).segment(begin, n) = rz.matrix();
+    }
+  }
+
+  PoseInterpolationType type_;
+  bool hasSample_;
+  Scalar lastTime_;
+  Pose lastPose_;
+  Twist lastTwist_;
+  Segments segments_;
+  std::size_t cursor_;
+};
+
+typedef PoseResampler<double> PoseResamplerD;
+typedef PoseResampler<float> PoseResamplerF;
+
+} // namespace kindr
@@ -0,0 +1,536 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+/*
+ * This test checks that the fixed-size API of kindr never touches the heap.
+ *
+ * Two kinds of allocations are counted inside countHeapAllocations():
+ *  - calls to the global operator new/new[] (replaced below),
+ *  - Eigen allocations, which go through malloc and are caught with EIGEN_RUNTIME_NO_MALLOC.
+ *
+ * The defines below must come before any Eigen header is included.
+ */
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace kindr_test {
+
+static std::size_t numHeapAllocations = 0;
+static bool isCountingHeapAllocations = false;
+
+//! Called by eigen_assert. Allocations are counted, any other failed assertion aborts.
+inline void onEigenAssertion(const char* expression) {
+  if (std::strstr(expression, "heap allocation is forbidden") != nullptr) {
+    ++numHeapAllocations;
+    return;
+  }
+  std::abort();
+}
+
+} // namespace kindr_test
+
+#define EIGEN_RUNTIME_NO_MALLOC
+#define eigen_assert(x) do { if (!(x)) { kindr_test::onEigenAssertion(#x); } } while (false)
+
+void* operator new(std::size_t size) {
+  if (kindr_test::isCountingHeapAllocations) {
+    ++kindr_test::numHeapAllocations;
+  }
+  void* pointer = std::malloc(size == 0 ? 1 : size);
+  if (pointer == nullptr) {
+    throw std::bad_alloc();
+  }
+  return pointer;
+}
+
+void* operator new[](std::size_t size) {
+  return ::operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+  if (kindr_test::isCountingHeapAllocations) {
+    ++kindr_test::numHeapAllocations;
+  }
+  return std::malloc(size == 0 ? 1 : size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept {
+  return ::operator new(size, tag);
+}
+
+// The replaced operator new and delete are both backed by malloc and free, but GCC warns about free() on a pointer
+// from operator new once they are inlined into each other (-Wpragmas keeps compilers before GCC 11 silent).
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpragmas"
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void operator delete(void* pointer) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept {
+  std::free(pointer);
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+#include <Eigen/Core>
+
+#include <gtest/gtest.h>
+
+#include "kindr/Core"
+#include "kindr/math/LinearAlgebra.hpp"
+#include "kindr/poses/Covariance.hpp"
+#include "kindr/poses/PoseIntegration.hpp"
+#include "kindr/phys_quant/WrenchAggregation.hpp"
+#include "kindr/kinematics/InverseKinematics.hpp"
+
+namespace kindr_test {
+
+/*! \brief Counts the heap allocations of a function.
+ *  gtest assertions allocate on failure, hence they must not be called inside the function.
+ *  \returns number of heap allocations
+ */
+template<typename Function_>
+std::size_t countHeapAllocations(Function_ function) {
+  numHeapAllocations = 0;
+  isCountingHeapAllocations = true;
+  Eigen::internal::set_is_malloc_allowed(false);
+  function();
+  Eigen::internal::set_is_malloc_allowed(true);
+  isCountingHeapAllocations = false;
+  return numHeapAllocations;
+}
+
+} // namespace kindr_test
+
+using kindr_test::countHeapAllocations;
+
+
+template <typename PrimType_>
+struct HeapAllocationTest : public ::testing::Test {
+  typedef PrimType_ Scalar;
+  typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+  typedef Eigen::Matrix<Scalar, 3, 4> Matrix34;
+  typedef kindr::AngleAxis<Scalar> AngleAxis;
+  typedef kindr::RotationVector<Scalar> RotationVector;
+  typedef kindr::RotationQuaternion<Scalar> RotationQuaternion;
+  typedef kindr::RotationMatrix<Scalar> RotationMatrix;
+  typedef kindr::EulerAnglesZyx<Scalar> EulerAnglesZyx;
+  typedef kindr::EulerAnglesXyz<Scalar> EulerAnglesXyz;
+  typedef kindr::Position<Scalar, 3> Position;
+  typedef kindr::Velocity<Scalar, 3> Velocity;
+
+  /*! \brief Exercises the complete rotation interface of one parameterization.
+   *  \returns a value depending on all results (keeps the optimizer from removing the calls)
+   */
+  template<typename Rotation_>
+  static Scalar exerciseRotation() {
+    const Vector3 vector(Scalar(0.3), Scalar(-0.2), Scalar(0.5));
+    Matrix34 matrix;
+    matrix << Scalar(1), Scalar(2), Scalar(3), Scalar(4),
+              Scalar(5), Scalar(6), Scalar(7), Scalar(8),
+              Scalar(9), Scalar(10), Scalar(11), Scalar(12);
+
+    Rotation_ rotation(AngleAxis(Scalar(0.7), Scalar(0), Scalar(0.6), Scalar(0.8)));
+    const Rotation_ other(EulerAnglesZyx(Scalar(0.1), Scalar(-0.4), Scalar(0.9)));
+
+    // conversions
+    Scalar sum = AngleAxis(rotation).angle();
+    sum += RotationVector(rotation).x();
+    sum += RotationQuaternion(rotation).w();
+    sum += RotationMatrix(rotation).matrix()(0,1);
+    sum += EulerAnglesZyx(rotation).yaw();
+    sum += EulerAnglesXyz(rotation).roll();
+    rotation = RotationQuaternion(other);
+    rotation(RotationMatrix(other));
+
+    // inversion, concatenation and comparison
+    sum += RotationQuaternion(rotation.inverted()).x();
+    sum += RotationQuaternion(rotation*other).y();
+    sum += RotationQuaternion(rotation*RotationQuaternion(other)).z();
+    sum += RotationQuaternion(rotation.getUnique()).w();
+    sum += rotation.getDisparityAngle(other);
+    sum += Scalar(rotation.isNear(other, Scalar(1e-3)));
+    sum += Scalar(rotation == other);
+    rotation.invert();
+    rotation.setUnique();
+
+    // rotation of vectors and fixed-size matrices
+    sum += rotation.rotate(vector).x();
+    sum += rotation.inverseRotate(vector).y();
+    sum += rotation.rotate(Position(vector)).z();
+    sum += rotation.inverseRotate(Velocity(vector)).x();
+    sum += rotation.template rotate<4>(matrix)(1,3);
+    sum += rotation.template inverseRotate<4>(matrix)(2,2);
+
+    // maps and box operations
+    sum += rotation.logarithmicMap().x();
+    sum += RotationQuaternion(rotation.exponentialMap(vector)).x();
+    sum += rotation.boxMinus(other).y();
+    sum += RotationQuaternion(rotation.boxPlus(vector)).z();
+    rotation.setFromVectors(vector, Vector3(Scalar(0), Scalar(0), Scalar(1)));
+    sum += RotationQuaternion(rotation).w();
+
+    rotation.fix();
+    rotation.setIdentity();
+    sum += RotationQuaternion(rotation).w();
+    return sum;
+  }
+};
+
+typedef ::testing::Types<
+    float,
+    double
+> PrimTypes;
+
+TYPED_TEST_CASE(HeapAllocationTest, PrimTypes);
+
+
+TYPED_TEST(HeapAllocationTest, testCounterDetectsDynamicAllocations)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  Scalar sum = Scalar(0);
+  EXPECT_LT(0u, countHeapAllocations([&]() {
+    Eigen::Matrix<Scalar, 3, Eigen::Dynamic> matrix(3, 10);
+    matrix.setOnes();
+    sum += matrix.sum();
+  }));
+  EXPECT_LT(0u, countHeapAllocations([&]() {
+    Scalar* array = new Scalar[4];
+    array[0] = Scalar(1);
+    sum += array[0];
+    delete[] array;
+  }));
+  EXPECT_EQ(Scalar(31), sum);
+}
+
+TYPED_TEST(HeapAllocationTest, testRotations)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  Scalar sum = Scalar(0);
+  EXPECT_EQ(0u, countHeapAllocations([&]() { sum += TestFixture::template exerciseRotation<typename TestFixture::AngleAxis>(); }));
+  EXPECT_EQ(0u, countHeapAllocations([&]() { sum += TestFixture::template exerciseRotation<typename TestFixture::RotationVector>(); }));
+  EXPECT_EQ(0u, countHeapAllocations([&]() { sum += TestFixture::template exerciseRotation<typename TestFixture::RotationQuaternion>(); }));
+  EXPECT_EQ(0u, countHeapAllocations([&]() { sum += TestFixture::template exerciseRotation<typename TestFixture::RotationMatrix>(); }));
+  EXPECT_EQ(0u, countHeapAllocations([&]() { sum += TestFixture::template exerciseRotation<typename TestFixture::EulerAnglesZyx>(); }));
+  EXPECT_EQ(0u, countHeapAllocations([&]() { sum += TestFixture::template exerciseRotation<typename TestFixture::EulerAnglesXyz>(); }));
+  EXPECT_FALSE(std::isnan(sum));
+}
+
+TYPED_TEST(HeapAllocationTest, testQuaternions)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  Scalar sum = Scalar(0);
+  EXPECT_EQ(0u, countHeapAllocations([&]() {
+    const kindr::Quaternion<Scalar> quaternion(Scalar(1), Scalar(2), Scalar(3), Scalar(4));
+    const kindr::UnitQuaternion<Scalar> unitQuaternion(quaternion.normalized());
+    sum += (quaternion*quaternion).w();
+    sum += quaternion.inverted().x();
+    sum += quaternion.conjugated().y();
+    sum += quaternion.norm();
+    sum += (unitQuaternion*unitQuaternion).z();
+    sum += unitQuaternion.inverted().w();
+    sum += Scalar(quaternion == quaternion);
+
+    const typename TestFixture::RotationQuaternion rotationQuaternion(unitQuaternion);
+    sum += rotationQuaternion.getQuaternionMatrix()(1,2);
+    sum += rotationQuaternion.getConjugateQuaternionMatrix()(2,1);
+    sum += rotationQuaternion.getGlobalQuaternionDiffMatrix()(0,3);
+    sum += rotationQuaternion.getLocalQuaternionDiffMatrix()(2,0);
+    sum += rotationQuaternion.vector()(3);
+  }));
+  EXPECT_FALSE(std::isnan(sum));
+}
+
+TYPED_TEST(HeapAllocationTest, testRotationDiffs)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Vector3 Vector3;
+  Scalar sum = Scalar(0);
+  EXPECT_EQ(0u, countHeapAllocations([&]() {
+    const kindr::LocalAngularVelocity<Scalar> localAngularVelocity(Scalar(0.1), Scalar(0.2), Scalar(0.3));
+    const typename TestFixture::RotationQuaternion rotationQuaternion(typename TestFixture::AngleAxis(Scalar(0.4), Scalar(1), Scalar(0), Scalar(0)));
+    const typename TestFixture::RotationMatrix rotationMatrix(rotationQuaternion);
+    const typename TestFixture::EulerAnglesZyx eulerAnglesZyx(rotationQuaternion);
+    const typename TestFixture::EulerAnglesXyz eulerAnglesXyz(rotationQuaternion);
+
+    const kindr::GlobalAngularVelocity<Scalar> globalAngularVelocity(rotationQuaternion, localAngularVelocity);
+    const kindr::RotationQuaternionDiff<Scalar> rotationQuaternionDiff(rotationQuaternion, localAngularVelocity);
+    const kindr::RotationMatrixDiff<Scalar> rotationMatrixDiff(rotationMatrix, localAngularVelocity);
+    const kindr::EulerAnglesZyxDiff<Scalar> eulerAnglesZyxDiff(eulerAnglesZyx, localAngularVelocity);
+    const kindr::EulerAnglesXyzDiff<Scalar> eulerAnglesXyzDiff(eulerAnglesXyz, localAngularVelocity);
+
+    sum += globalAngularVelocity.x();
+    sum += kindr::LocalAngularVelocity<Scalar>(rotationQuaternion, rotationQuaternionDiff).y();
+    sum += kindr::LocalAngularVelocity<Scalar>(rotationMatrix, rotationMatrixDiff).z();
+    sum += kindr::LocalAngularVelocity<Scalar>(eulerAnglesZyx, eulerAnglesZyxDiff).x();
+    sum += kindr::LocalAngularVelocity<Scalar>(eulerAnglesXyz, eulerAnglesXyzDiff).y();
+    sum += (localAngularVelocity + localAngularVelocity).z();
+    sum += (localAngularVelocity*Scalar(2)).x();
+    sum += eulerAnglesZyx.getMappingFromLocalAngularVelocityToDiff()(0,1);
+    sum += eulerAnglesXyz.getMappingFromDiffToLocalAngularVelocity()(1,1);
+    sum += kindr::getJacobianOfExponentialMap(Vector3(localAngularVelocity.toImplementation()))(0,2);
+  }));
+  EXPECT_FALSE(std::isnan(sum));
+}
+
+TYPED_TEST(HeapAllocationTest, testVectors)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Position Position;
+  typedef typename TestFixture::Velocity Velocity;
+  Scalar sum = Scalar(0);
+  EXPECT_EQ(0u, countHeapAllocations([&]() {
+    const Position position(Scalar(1), Scalar(2), Scalar(3));
+    const kindr::Force<Scalar, 3> force(Scalar(4), Scalar(5), Scalar(6));
+    const Velocity velocity = Velocity::UnitX();
+    sum += (position + position).x();
+    sum += (position - position*Scalar(2)).y();
+    sum += (-position/Scalar(3)).z();
+    sum += position.cross(force).x();
+    sum += position.dot(force);
+    sum += position.norm() + position.squaredNorm();
+    sum += position.normalized().x();
+    sum += position.projectOn(Position(velocity)).y();
+    sum += position.elementwiseMultiplication(force).z();
+    sum += position.abs().max() + position.min() + position.sum() + position.mean();
+    sum += position.template getHead<2>()(1);
+    sum += position.template getTail<1>()(0);
+    sum += position.template getSegment<2>(1)(0);
+    sum += Scalar(position.isSimilarTo(position, Scalar(1e-6)));
+  }));
+  EXPECT_FALSE(std::isnan(sum));
+}
+
+TYPED_TEST(HeapAllocationTest, testPoses)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Position Position;
+  typedef kindr::HomTransformQuat<Scalar> HomTransformQuat;
+  typedef kindr::HomTransformMatrix<Scalar> HomTransformMatrix;
+  Scalar sum = Scalar(0);
+  EXPECT_EQ(0u, countHeapAllocations([&]() {
+    const Position position(Scalar(1), Scalar(2), Scalar(3));
+    const typename TestFixture::RotationQuaternion rotation(typename TestFixture::AngleAxis(Scalar(0.4), Scalar(0), Scalar(0), Scalar(1)));
+    HomTransformQuat poseQuat(position, rotation);
+    const HomTransformMatrix poseMatrix(poseQuat);
+    sum += (poseQuat*poseQuat).getPosition().x();
+    sum += (poseMatrix*poseMatrix).getPosition().y();
+    sum += poseQuat.transform(position).z();
+    sum += poseMatrix.inverseTransform(position).x();
+    sum += poseQuat.getTransformationMatrix()(0,3);
+    poseQuat.setIdentity();
+    sum += poseQuat.getPosition().x();
+  }));
+  // pose integration with preallocated dynamic-size matrices
+  typedef Eigen::Matrix<Scalar, Eigen::Dynamic, 3> MatrixX3;
+  typedef Eigen::Matrix<Scalar, Eigen::Dynamic, 4> MatrixX4;
+  MatrixX3 positions = MatrixX3::Zero(40, 3);
+  MatrixX4 quaternions = MatrixX4::Zero(40, 4);
+  quaternions.col(0).setOnes();
+  const MatrixX3 velocities = MatrixX3::Random(40, 3);
+  const HomTransformQuat pose(Position(Scalar(1), Scalar(2), Scalar(3)), typename TestFixture::RotationQuaternion());
+  const kindr::TwistLinearVelocityLocalAngularVelocity<Scalar> twist(Eigen::Matrix<Scalar, 6, 1>::Ones());
+  EXPECT_EQ(0u, countHeapAllocations([&]() {
+    sum += kindr::integratePoseRungeKutta4(pose, twist, twist, twist, Scalar(0.1)).getPosition().x();
+    kindr::integratePoses(positions, quaternions, velocities, velocities, Scalar(0.01));
+    sum += positions(0, 0);
+    sum += kindr::integratePoseStream(pose, velocities, velocities, Scalar(0.01), positions, quaternions).getPosition().y();
+  }));
+  EXPECT_FALSE(std::isnan(sum));
+}
+
+TYPED_TEST(HeapAllocationTest, testTwistsAndWrenches)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Vector3 Vector3;
+  typedef kindr::Wrench6<Scalar> Wrench;
+  Scalar sum = Scalar(0);
+  EXPECT_EQ(0u, countHeapAllocations([&]() {
+    const kindr::TwistLinearVelocityLocalAngularVelocity<Scalar> twistLocal(Vector3(Scalar(1), Scalar(2), Scalar(3)), Vector3(Scalar(0.1), Scalar(0.2), Scalar(0.3)));
+    const kindr::TwistLinearVelocityGlobalAngularVelocity<Scalar> twistGlobal(twistLocal.getVector());
+    const Wrench wrench(Vector3(Scalar(1), Scalar(2), Scalar(3)), Vector3(Scalar(4), Scalar(5), Scalar(6)));
+    sum += twistLocal.getVector()(4);
+    sum += twistGlobal.getRotationalVelocity().x();
+    sum += (wrench + wrench*Scalar(2) - wrench/Scalar(2)).getForce().x();
+    sum += (-wrench).getTorque().y();
+    sum += wrench.getVector()(5);
+  }));
+  // batched wrenches with preallocated dynamic-size matrices
+  typedef Eigen::Matrix<Scalar, Eigen::Dynamic, 3> MatrixX3;
+  const MatrixX3 positions = MatrixX3::Random(20, 3);
+  const MatrixX3 forces = MatrixX3::Random(20, 3);
+  const MatrixX3 torques = MatrixX3::Random(20, 3);
+  Eigen::Matrix<Scalar, Eigen::Dynamic, 4> quaternions = Eigen::Matrix<Scalar, Eigen::Dynamic, 4>::Random(20, 4);
+  quaternions.rowwise().normalize();
+  MatrixX3 resultForces(20, 3);
+  MatrixX3 resultTorques(20, 3);
+  const typename TestFixture::Position referencePoint(Scalar(1), Scalar(2), Scalar(3));
+  EXPECT_EQ(0u, countHeapAllocations([&]() {
+    sum += kindr::aggregateWrenches(positions, forces, torques, referencePoint).getTorque().x();
+    sum += kindr::aggregateWrenches(positions, quaternions, forces, torques, referencePoint, resultForces, resultTorques).getForce().y();
+    sum += kindr::shiftWrench(Wrench(), referencePoint, referencePoint).getTorque().z();
+  }));
+  EXPECT_FALSE(std::isnan(sum));
+}
+
+TYPED_TEST(HeapAllocationTest, testLinearAlgebra)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Vector3 Vector3;
+  Scalar sum = Scalar(0);
+  EXPECT_EQ(0u, countHeapAllocations([&]() {
+    const Eigen::Matrix<Scalar, 3, 3> skew = kindr::getSkewMatrixFromVector(Vector3(Scalar(1), Scalar(2), Scalar(3)));
+    sum += skew(0,1);
+    sum += kindr::getVectorFromSkewMatrix<Scalar>(skew).z();
+  }));
+  Eigen::Matrix<Scalar, 3, 6> jacobian;
+  jacobian << Scalar(1), Scalar(0), Scalar(2), Scalar(0), Scalar(1), Scalar(0),
+              Scalar(0), Scalar(1), Scalar(0), Scalar(3), Scalar(0), Scalar(1),
+              Scalar(1), Scalar(1), Scalar(0), Scalar(0), Scalar(2), Scalar(1);
+  Eigen::Matrix<Scalar, 6, 3> jacobianInverse;
+  Eigen::Matrix<Scalar, 3, 3> inverse3;
+  kindr::PseudoInverseWorkspace<Scalar, 3, 6> workspace;
+  bool isSuccessful[5];
+  EXPECT_EQ(0u, countHeapAllocations([&]() {
+    isSuccessful[0] = kindr::pseudoInverse(jacobian, jacobianInverse);
+    sum += jacobianInverse(0,0);
+    isSuccessful[1] = kindr::pseudoInverse(Eigen::Matrix<Scalar, 3, 3>(jacobian.template leftCols<3>()), inverse3);
+    sum += inverse3(0,0);
+    isSuccessful[2] = kindr::dampedPseudoInverse(jacobian, jacobianInverse, Scalar(0.1));
+    sum += jacobianInverse(0,0);
+    isSuccessful[3] = kindr::fullRankPseudoInverse(jacobian, jacobianInverse);
+    sum += jacobianInverse(0,0);
+    isSuccessful[4] = workspace.dampedPseudoInverse(jacobian, jacobianInverse, Scalar(0.1));
+    sum += jacobianInverse(0,0);
+  }));
+  for (bool success : isSuccessful) {
+    EXPECT_TRUE(success);
+  }
+  EXPECT_FALSE(std::isnan(sum));
+}
+
+TYPED_TEST(HeapAllocationTest, testPseudoInverseWithDynamicColumns)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  // 6xN Jacobian of a manipulator: the Gram matrix is bounded by 6x6, the result is allocated by the caller
+  typedef Eigen::Matrix<Scalar, 6, Eigen::Dynamic> Jacobian;
+  typedef Eigen::Matrix<Scalar, Eigen::Dynamic, 6> JacobianInverse;
+  const Eigen::DenseIndex numberOfJoints = 7;
+  const Jacobian jacobian = Jacobian::Random(6, numberOfJoints);
+  const Jacobian wideJacobian = Jacobian::Random(6, 12);
+  JacobianInverse jacobianInverse(numberOfJoints, 6);
+  JacobianInverse wideJacobianInverse(12, 6);
+  const Jacobian tallJacobian = Jacobian::Random(6, 3);
+  JacobianInverse tallJacobianInverse(3, 6);
+  kindr::PseudoInverseWorkspace<Scalar, 6, Eigen::Dynamic> workspace(6, numberOfJoints);
+  Scalar sum = Scalar(0);
+  bool isSuccessful[8];
+  EXPECT_EQ(0u, countHeapAllocations([&]() {
+    isSuccessful[0] = kindr::gramPseudoInverse(jacobian, jacobianInverse);
+    sum += jacobianInverse(0,0);
+    isSuccessful[1] = kindr::dampedPseudoInverse(jacobian, jacobianInverse, Scalar(0.1));
+    sum += jacobianInverse(0,0);
+    isSuccessful[2] = kindr::fullRankPseudoInverse(jacobian, jacobianInverse);
+    sum += jacobianInverse(0,0);
+    isSuccessful[3] = kindr::dampedPseudoInverse(wideJacobian, wideJacobianInverse, Scalar(0.1));
+    sum += wideJacobianInverse(0,0);
+    isSuccessful[4] = workspace.dampedPseudoInverse(jacobian, jacobianInverse, Scalar(0.1));
+    sum += jacobianInverse(0,0);
+    isSuccessful[5] = workspace.fullRankPseudoInverse(jacobian, jacobianInverse);
+    sum += jacobianInverse(0,0);
+    isSuccessful[6] = workspace.gramPseudoInverse(jacobian, jacobianInverse);
+    sum += jacobianInverse(0,0);
+    isSuccessful[7] = kindr::fullRankPseudoInverse(tallJacobian, tallJacobianInverse);
+    sum += tallJacobianInverse(0,0);
+  }));
+  for (bool success : isSuccessful) {
+    EXPECT_TRUE(success);
+  }
+  EXPECT_FALSE(std::isnan(sum));
+}
+
+TYPED_TEST(HeapAllocationTest, testCovariance)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef Eigen::Matrix<Scalar, 6, 6> Matrix6;
+  const kindr::HomTransformQuat<Scalar> pose(kindr::Position<Scalar, 3>(Scalar(1), Scalar(2), Scalar(3)), kindr::RotationQuaternion<Scalar>(kindr::EulerAnglesZyx<Scalar>(Scalar(0.1), Scalar(0.2), Scalar(0.3))));
+  Matrix6 covariance = Matrix6::Identity();
+  const Matrix6 jacobian = Matrix6::Identity();
+  Scalar sum = Scalar(0);
+  EXPECT_EQ(0u, countHeapAllocations([&]() {
+    kindr::rotateCovarianceInPlace(pose.getRotation(), covariance);
+    kindr::inverseTransformCovarianceInPlace(pose, covariance);
+    kindr::transformCovarianceInPlace(pose, covariance);
+    sum += kindr::rotateCovariance(pose.getRotation(), covariance.template topLeftCorner<3,3>())(0,1);
+    sum += kindr::inverseTransformCovariance(pose, covariance)(2,5);
+    sum += kindr::propagateCovariance(jacobian, covariance)(1,4);
+  }));
+  EXPECT_FALSE(std::isnan(sum));
+}
+
+TYPED_TEST(HeapAllocationTest, testInverseKinematics)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Vector3 Vector3;
+  typedef kindr::KinematicChain<Scalar> Chain;
+  typedef typename Chain::Pose Pose;
+  Chain chain;
+  for (int i = 0; i < 6; ++i) {
+    chain.addJoint(i == 2 ? kindr::JointType::Prismatic : kindr::JointType::Revolute,
+                   Pose(typename Pose::Position(Scalar(0), Scalar(0), Scalar(0.3)), typename Pose::Rotation()), Vector3::Unit(i % 3));
+  }
+  kindr::DampedLeastSquaresInverseKinematics<Scalar> solver(chain);
+  const kindr::HomTransformQuat<Scalar> target(kindr::Position<Scalar, 3>(Scalar(0.1), Scalar(0.2), Scalar(1.5)), kindr::RotationQuaternion<Scalar>(kindr::EulerAnglesZyx<Scalar>(Scalar(0.1), Scalar(0.2), Scalar(0.3))));
+  typename Chain::JointVector jointPositions = Chain::JointVector::Zero(6);
+  typename Chain::JointVector jointVelocities = Chain::JointVector::Ones(6);
+  Scalar sum = Scalar(0);
+  EXPECT_EQ(0u, countHeapAllocations([&]() {
+    chain.update(jointPositions, jointVelocities);
+    sum += chain.getJacobianTimeDerivative()(0,0);
+    solver.solve(target, jointPositions);
+    sum += jointPositions(0);
+  }));
+  EXPECT_FALSE(std::isnan(sum));
+}
@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+/*
+ * Tests that all types can be used with a forward-mode automatic differentiation scalar (Eigen::AutoDiffScalar).
+ * The derivatives are compared to central finite differences computed with double.
+ */
+
+#include <gtest/gtest.h>
+
+#include <Eigen/Core>
+#include <unsupported/Eigen/AutoDiff>
+
+#include "kindr/Core"
+#include "kindr/common/gtest_eigen.hpp"
+
+namespace kindr_test {
+
+typedef Eigen::AutoDiffScalar<Eigen::Vector3d> AutoDiff;
+
+/*! \brief Evaluates the function with AutoDiff and compares the value and the Jacobian to the double evaluation.
+ */
+template<typename Function_>
+void expectJacobianNearFiniteDifferences(const Function_& function, const Eigen::Vector3d& x, double tolerance) {
+  const int rows = function(x).size();
+
+  Eigen::Matrix<AutoDiff, 3, 1> xAutoDiff;
+  for (int i = 0; i < 3; i++) {
+    xAutoDiff(i) = AutoDiff(x(i), 3, i);
+  }
+  const auto yAutoDiff = function(xAutoDiff);
+  Eigen::VectorXd value(rows);
+  Eigen::MatrixXd jacobian(rows, 3);
+  for (int r = 0; r < rows; r++) {
+    value(r) = yAutoDiff(r).value();
+    jacobian.row(r) = yAutoDiff(r).derivatives().transpose();
+  }
+
+  const double step = 1e-6;
+  Eigen::MatrixXd jacobianFiniteDifferences(rows, 3);
+  for (int i = 0; i < 3; i++) {
+    Eigen::Vector3d xPlus = x;
+    Eigen::Vector3d xMinus = x;
+    xPlus(i) += step;
+    xMinus(i) -= step;
+    jacobianFiniteDifferences.col(i) = (function(xPlus) - function(xMinus))/(2.0*step);
+  }
+
+  const Eigen::VectorXd expectedValue = function(x);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expectedValue, value, 1e-12, 1e-12, "value");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(jacobianFiniteDifferences, jacobian, tolerance, tolerance, "Jacobian");
+}
+
+template<typename Scalar_>
+Eigen::Matrix<Scalar_, 3, 1> getConstantVector() {
+  return Eigen::Matrix<Scalar_, 3, 1>(Scalar_(0.3), Scalar_(-1.5), Scalar_(0.6));
+}
+
+template<typename Scalar_>
+Eigen::Matrix<Scalar_, 9, 1> toVector(const Eigen::Matrix<Scalar_, 3, 3>& matrix) {
+  return Eigen::Map<const Eigen::Matrix<Scalar_, 9, 1>>(matrix.data());
+}
+
+struct ExponentialMapRotate {
+  template<typename Scalar_>
+  Eigen::Matrix<Scalar_, 3, 1> operator()(const Eigen::Matrix<Scalar_, 3, 1>& x) const {
+    return kindr::RotationQuaternion<Scalar_>().exponentialMap(x).rotate(getConstantVector<Scalar_>());
+  }
+};
+
+struct RotationVectorToRotationMatrix {
+  template<typename Scalar_>
+  Eigen::Matrix<Scalar_, 9, 1> operator()(const Eigen::Matrix<Scalar_, 3, 1>& x) const {
+    return toVector(kindr::RotationMatrix<Scalar_>(kindr::RotationVector<Scalar_>(x)).toImplementation());
+  }
+};
+
+struct AngleAxisRotate {
+  template<typename Scalar_>
+  Eigen::Matrix<Scalar_, 3, 1> operator()(const Eigen::Matrix<Scalar_, 3, 1>& x) const {
+    return kindr::AngleAxis<Scalar_>(kindr::RotationVector<Scalar_>(x)).rotate(getConstantVector<Scalar_>());
+  }
+};
+
+struct LogarithmicMap {
+  template<typename Scalar_>
+  Eigen::Matrix<Scalar_, 3, 1> operator()(const Eigen::Matrix<Scalar_, 3, 1>& x) const {
+    const kindr::RotationMatrix<Scalar_> rotation = kindr::RotationMatrix<Scalar_>(kindr::RotationVector<Scalar_>(x));
+    return rotation.logarithmicMap();
+  }
+};
+
+struct BoxMinus {
+  template<typename Scalar_>
+  Eigen::Matrix<Scalar_, 3, 1> operator()(const Eigen::Matrix<Scalar_, 3, 1>& x) const {
+    const kindr::RotationQuaternion<Scalar_> reference(kindr::EulerAnglesZyx<Scalar_>(Scalar_(0.2), Scalar_(-0.1), Scalar_(0.4)));
+    return kindr::RotationQuaternion<Scalar_>(kindr::RotationVector<Scalar_>(x)).boxMinus(reference);
+  }
+};
+
+struct EulerAnglesZyxToRotationMatrix {
+  template<typename Scalar_>
+  Eigen::Matrix<Scalar_, 9, 1> operator()(const Eigen::Matrix<Scalar_, 3, 1>& x) const {
+    return toVector(kindr::RotationMatrix<Scalar_>(kindr::EulerAnglesZyx<Scalar_>(x)).toImplementation());
+  }
+};
+
+struct RotationVectorToEulerAnglesZyx {
+  template<typename Scalar_>
+  Eigen::Matrix<Scalar_, 3, 1> operator()(const Eigen::Matrix<Scalar_, 3, 1>& x) const {
+    return kindr::EulerAnglesZyx<Scalar_>(kindr::RotationQuaternion<Scalar_>(kindr::RotationVector<Scalar_>(x))).getUnique().toImplementation();
+  }
+};
+
+struct RotationVectorToEulerAnglesXyz {
+  template<typename Scalar_>
+  Eigen::Matrix<Scalar_, 3, 1> operator()(const Eigen::Matrix<Scalar_, 3, 1>& x) const {
+    return kindr::EulerAnglesXyz<Scalar_>(kindr::RotationMatrix<Scalar_>(kindr::RotationVector<Scalar_>(x))).getUnique().toImplementation();
+  }
+};
+
+struct EulerAnglesZyxMapping {
+  template<typename Scalar_>
+  Eigen::Matrix<Scalar_, 3, 1> operator()(const Eigen::Matrix<Scalar_, 3, 1>& x) const {
+    return kindr::EulerAnglesZyx<Scalar_>(x).getMappingFromLocalAngularVelocityToDiff()*getConstantVector<Scalar_>();
+  }
+};
+
+struct JacobianOfExponentialMap {
+  template<typename Scalar_>
+  Eigen::Matrix<Scalar_, 3, 1> operator()(const Eigen::Matrix<Scalar_, 3, 1>& x) const {
+    return kindr::getJacobianOfExponentialMap(x)*getConstantVector<Scalar_>();
+  }
+};
+
+struct RotationQuaternionDiff {
+  template<typename Scalar_>
+  Eigen::Matrix<Scalar_, 4, 1> operator()(const Eigen::Matrix<Scalar_, 3, 1>& x) const {
+    const kindr::RotationQuaternion<Scalar_> rotation = kindr::RotationQuaternion<Scalar_>(kindr::RotationVector<Scalar_>(x));
+    const kindr::LocalAngularVelocity<Scalar_> angularVelocity(getConstantVector<Scalar_>());
+    return kindr::RotationQuaternionDiff<Scalar_>(rotation, angularVelocity).toQuaternion().vector();
+  }
+};
+
+struct PoseTransform {
+  template<typename Scalar_>
+  Eigen::Matrix<Scalar_, 3, 1> operator()(const Eigen::Matrix<Scalar_, 3, 1>& x) const {
+    typedef kindr::HomTransformQuat<Scalar_> Pose;
+    const Pose poseA = Pose(typename Pose::Position(x), typename Pose::Rotation(kindr::RotationVector<Scalar_>(x)));
+    const Pose poseB(typename Pose::Position(getConstantVector<Scalar_>()), typename Pose::Rotation(kindr::RotationVector<Scalar_>(Scalar_(2)*x)));
+    return (poseA*poseB).inverted().transform(typename Pose::Position(getConstantVector<Scalar_>())).toImplementation();
+  }
+};
+
+struct TwistAndWrench {
+  template<typename Scalar_>
+  Eigen::Matrix<Scalar_, 6, 1> operator()(const Eigen::Matrix<Scalar_, 3, 1>& x) const {
+    const kindr::Force<Scalar_, 3> force(x);
+    const kindr::Torque<Scalar_, 3> torque(kindr::Position<Scalar_, 3>(getConstantVector<Scalar_>()).cross(force));
+    const kindr::Wrench6<Scalar_> wrench(force, torque);
+    return wrench.getVector();
+  }
+};
+
+} // namespace kindr_test
+
+using namespace kindr_test;
+
+class AutoDiffTest : public ::testing::Test {
+ public:
+  //! Generic point, identity and near identity (exercises the small angle branches)
+  const std::vector<Eigen::Vector3d, Eigen::aligned_allocator<Eigen::Vector3d>> points = {
+    Eigen::Vector3d(0.4, -0.7, 1.1),
+    Eigen::Vector3d(0.0, 0.0, 0.0),
+    Eigen::Vector3d(1e-5, -2e-5, 3e-5)
+  };
+
+  template<typename Function_>
+  void checkAllPoints(const Function_& function, double tolerance = 1e-6) {
+    for (const Eigen::Vector3d& point : points) {
+      SCOPED_TRACE(::testing::Message() << "point: " << point.transpose());
+      expectJacobianNearFiniteDifferences(function, point, tolerance);
+    }
+  }
+};
+
+TEST_F(AutoDiffTest, testNumTraits)
+{
+  EXPECT_EQ(kindr::internal::NumTraits<double>::dummy_precision(), kindr::internal::NumTraits<AutoDiff>::dummy_precision().value());
+}
+
+TEST_F(AutoDiffTest, testComparison)
+{
+  const kindr::RotationQuaternion<AutoDiff> rotationA(kindr::EulerAnglesZyx<AutoDiff>(AutoDiff(0.2), AutoDiff(-0.1), AutoDiff(0.4)));
+  const kindr::RotationMatrix<AutoDiff> rotationB(rotationA);
+  EXPECT_TRUE(rotationA.isNear(rotationB, AutoDiff(1e-9)));
+  EXPECT_NEAR(0.0, rotationA.getDisparityAngle(rotationB).value(), 1e-9);
+}
+
+TEST_F(AutoDiffTest, testExponentialMap)
+{
+  checkAllPoints(ExponentialMapRotate());
+}
+
+TEST_F(AutoDiffTest, testRotationVectorToRotationMatrix)
+{
+  checkAllPoints(RotationVectorToRotationMatrix());
+}
+
+TEST_F(AutoDiffTest, testAngleAxis)
+{
+  expectJacobianNearFiniteDifferences(AngleAxisRotate(), points[0], 1e-6);
+}
+
+TEST_F(AutoDiffTest, testLogarithmicMap)
+{
+  checkAllPoints(LogarithmicMap());
+}
+
+TEST_F(AutoDiffTest, testBoxMinus)
+{
+  checkAllPoints(BoxMinus());
+}
+
+TEST_F(AutoDiffTest, testEulerAngles)
+{
+  checkAllPoints(EulerAnglesZyxToRotationMatrix());
+  expectJacobianNearFiniteDifferences(RotationVectorToEulerAnglesZyx(), points[0], 1e-6);
+  expectJacobianNearFiniteDifferences(RotationVectorToEulerAnglesXyz(), points[0], 1e-6);
+  checkAllPoints(EulerAnglesZyxMapping());
+}
+
+TEST_F(AutoDiffTest, testRotationDiffs)
+{
+  checkAllPoints(JacobianOfExponentialMap());
+  checkAllPoints(RotationQuaternionDiff());
+}
+
+TEST_F(AutoDiffTest, testPoses)
+{
+  checkAllPoints(PoseTransform());
+}
+
+TEST_F(AutoDiffTest, testWrench)
+{
+  checkAllPoints(TwistAndWrench());
+}
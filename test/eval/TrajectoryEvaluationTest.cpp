@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "kindr/eval/TrajectoryEvaluation.hpp"
+#include "kindr/common/gtest_eigen.hpp"
+
+typedef ::testing::Types<
+    float,
+    double
+> PrimTypes;
+
+template <typename PrimType_>
+struct TrajectoryEvaluationTest : public ::testing::Test {
+  typedef PrimType_ Scalar;
+  typedef kindr::HomTransformQuat<Scalar> Pose;
+  typedef kindr::Position<Scalar, 3> Position;
+  typedef kindr::RotationQuaternion<Scalar> RotationQuaternion;
+
+  TrajectoryEvaluationTest() {
+    // helix as ground truth, sampled at 100 Hz
+    for (int i = 0; i < 500; ++i) {
+      const double time = 0.01*i;
+      groundTruthTimestamps.push_back(time);
+      groundTruths.push_back(Pose(Position(Scalar(std::cos(time)), Scalar(std::sin(time)), Scalar(0.1*time)),
+                                  RotationQuaternion(kindr::AngleAxis<Scalar>(Scalar(time), 0, 0, 1))));
+    }
+  }
+
+  std::vector<double> groundTruthTimestamps;
+  std::vector<Pose> groundTruths;
+};
+
+TYPED_TEST_CASE(TrajectoryEvaluationTest, PrimTypes);
+
+TYPED_TEST(TrajectoryEvaluationTest, testErrorStatistics)
+{
+  typedef typename TestFixture::Scalar Scalar;
+
+  kindr::eval::ErrorStatistics<Scalar> all, first, second;
+  const Scalar values[] = {Scalar(1), Scalar(2), Scalar(4), Scalar(-1), Scalar(3)};
+  for (int i = 0; i < 5; ++i) {
+    all.add(values[i]);
+    (i < 2 ? first : second).add(values[i]);
+  }
+  ASSERT_EQ(all.getCount(), 5u);
+  ASSERT_NEAR(all.getMean(), Scalar(1.8), 1e-6);
+  ASSERT_NEAR(all.getStandardDeviation(), std::sqrt(Scalar(2.96)), 1e-5);
+  ASSERT_NEAR(all.getRootMeanSquare(), std::sqrt(Scalar(31.0/5.0)), 1e-5);
+  ASSERT_EQ(all.getMin(), Scalar(-1));
+  ASSERT_EQ(all.getMax(), Scalar(4));
+
+  first.merge(second);
+  ASSERT_EQ(first.getCount(), 5u);
+  ASSERT_NEAR(first.getMean(), all.getMean(), 1e-6);
+  ASSERT_NEAR(first.getStandardDeviation(), all.getStandardDeviation(), 1e-5);
+  ASSERT_EQ(first.getMax(), all.getMax());
+}
+
+TYPED_TEST(TrajectoryEvaluationTest, testAssociation)
+{
+  const std::vector<double> timestamps = {0.0, 0.1, 0.2, 0.3};
+  ASSERT_EQ(kindr::eval::associate(timestamps, 0.14, 0.05), 1);
+  ASSERT_EQ(kindr::eval::associate(timestamps, 0.16, 0.05), 2);
+  ASSERT_EQ(kindr::eval::associate(timestamps, -0.01, 0.05), 0);
+  ASSERT_EQ(kindr::eval::associate(timestamps, 0.34, 0.05), 3);
+  ASSERT_EQ(kindr::eval::associate(timestamps, 0.5, 0.05), -1);
+  ASSERT_EQ(kindr::eval::associate(std::vector<double>(), 0.5, 0.05), -1);
+}
+
+TYPED_TEST(TrajectoryEvaluationTest, testAbsoluteTrajectoryError)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Pose Pose;
+  typedef typename TestFixture::Position Position;
+  typedef typename TestFixture::RotationQuaternion RotationQuaternion;
+
+  // estimate in another frame, sampled at 20 Hz with a time offset
+  const Pose offset(Position(Scalar(5), Scalar(-2), Scalar(1)), RotationQuaternion(kindr::EulerAnglesZyx<Scalar>(Scalar(0.5), Scalar(0.1), Scalar(-0.2))));
+  std::vector<double> timestamps;
+  std::vector<Pose> estimates;
+  for (std::size_t i = 0; i < this->groundTruths.size(); i += 5) {
+    timestamps.push_back(this->groundTruthTimestamps[i] + 0.001);
+    estimates.push_back(offset.inverted()*this->groundTruths[i]);
+  }
+
+  const kindr::eval::AbsoluteTrajectoryError<Scalar> aligned = kindr::eval::evaluateAbsoluteTrajectoryError<Scalar>(
+      timestamps, estimates, this->groundTruthTimestamps, this->groundTruths, 0.004);
+  ASSERT_EQ(aligned.getTranslationError().getCount(), estimates.size());
+  ASSERT_NEAR(aligned.getTranslationError().getRootMeanSquare(), Scalar(0), 1e-3);
+  ASSERT_NEAR(aligned.getRotationError().getMax(), Scalar(0), 1e-3);
+  ASSERT_TRUE(aligned.getAlignment().getRotation().isNear(offset.getRotation(), 1e-3));
+
+  const kindr::eval::AbsoluteTrajectoryError<Scalar> unaligned = kindr::eval::evaluateAbsoluteTrajectoryError<Scalar>(
+      timestamps, estimates, this->groundTruthTimestamps, this->groundTruths, 0.004, false);
+  ASSERT_GT(unaligned.getTranslationError().getMean(), Scalar(1));
+
+  // no association
+  const kindr::eval::AbsoluteTrajectoryError<Scalar> none = kindr::eval::evaluateAbsoluteTrajectoryError<Scalar>(
+      timestamps, estimates, this->groundTruthTimestamps, this->groundTruths, 0.0001);
+  ASSERT_EQ(none.getTranslationError().getCount(), 0u);
+}
+
+TYPED_TEST(TrajectoryEvaluationTest, testRelativePoseError)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Pose Pose;
+  typedef typename TestFixture::Position Position;
+  typedef typename TestFixture::RotationQuaternion RotationQuaternion;
+
+  // a constant offset does not change the relative motion
+  const Pose offset(Position(Scalar(5), Scalar(-2), Scalar(1)), RotationQuaternion(kindr::EulerAnglesZyx<Scalar>(Scalar(0.5), Scalar(0.1), Scalar(-0.2))));
+  std::vector<Pose> estimates;
+  for (std::size_t i = 0; i < this->groundTruths.size(); ++i) {
+    estimates.push_back(offset*this->groundTruths[i]);
+  }
+  const kindr::eval::RelativePoseError<Scalar> exact = kindr::eval::evaluateRelativePoseError<Scalar>(
+      this->groundTruthTimestamps, estimates, this->groundTruthTimestamps, this->groundTruths, 0.001, 10);
+  ASSERT_EQ(exact.getTranslationError().getCount(), this->groundTruths.size() - 10);
+  ASSERT_NEAR(exact.getTranslationError().getMax(), Scalar(0), 1e-3);
+  ASSERT_NEAR(exact.getRotationError().getMax(), Scalar(0), 1e-3);
+
+  // a drift of 1 cm per pose yields an error of 1 cm per segment of one pose
+  kindr::eval::RelativePoseError<Scalar> drift;
+  for (std::size_t i = 0; i < this->groundTruths.size(); ++i) {
+    Pose estimate = this->groundTruths[i];
+    estimate.getPosition() += Position(Scalar(0.01*i), Scalar(0), Scalar(0));
+    drift.add(estimate, this->groundTruths[i]);
+  }
+  ASSERT_NEAR(drift.getTranslationError().getMean(), Scalar(0.01), 1e-4);
+
+  // chunks overlapping by delta poses merge to the same result
+  kindr::eval::RelativePoseError<Scalar> first(10), second(10);
+  for (std::size_t i = 0; i < 250; ++i) {
+    first.add(estimates[i], this->groundTruths[i]);
+  }
+  for (std::size_t i = 240; i < estimates.size(); ++i) {
+    second.add(estimates[i], this->groundTruths[i]);
+  }
+  first.merge(second);
+  ASSERT_EQ(first.getTranslationError().getCount(), exact.getTranslationError().getCount());
+}
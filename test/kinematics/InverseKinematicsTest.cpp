@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/kinematics/InverseKinematics.hpp"
+#include "kindr/common/gtest_eigen.hpp"
+
+template <typename Scalar_>
+class InverseKinematicsTest : public ::testing::Test {
+ public:
+  typedef Scalar_ Scalar;
+  typedef kindr::KinematicChain<Scalar> Chain;
+  typedef kindr::DampedLeastSquaresInverseKinematics<Scalar> Solver;
+  typedef typename Chain::Pose Pose;
+  typedef typename Solver::Target Target;
+  typedef typename Chain::JointVector JointVector;
+  typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+
+  //! Arm with a spherical wrist and a prismatic joint
+  InverseKinematicsTest() {
+    const typename Pose::Rotation identity;
+    chain.addJoint(kindr::JointType::Revolute, Pose(typename Pose::Position(Scalar(0), Scalar(0), Scalar(0.5)), identity), Vector3::UnitZ());
+    chain.addJoint(kindr::JointType::Revolute, Pose(typename Pose::Position(Scalar(0), Scalar(0), Scalar(0.2)), identity), Vector3::UnitY());
+    chain.addJoint(kindr::JointType::Prismatic, Pose(typename Pose::Position(Scalar(0), Scalar(0), Scalar(0.6)), identity), Vector3::UnitZ());
+    chain.addJoint(kindr::JointType::Revolute, Pose(typename Pose::Position(Scalar(0), Scalar(0), Scalar(0.1)), identity), Vector3::UnitZ());
+    chain.addJoint(kindr::JointType::Revolute, Pose(typename Pose::Position(Scalar(0), Scalar(0), Scalar(0.1)), identity), Vector3::UnitY());
+    chain.addJoint(kindr::JointType::Revolute, Pose(typename Pose::Position(Scalar(0), Scalar(0), Scalar(0.1)), identity), Vector3::UnitZ());
+    chain.setTool(Pose(typename Pose::Position(Scalar(0.05), Scalar(0), Scalar(0.1)), identity));
+  }
+
+  //! Target reached by the joint positions
+  Target getTarget(const JointVector& jointPositions) {
+    chain.update(jointPositions);
+    return Target(chain.getToolPose());
+  }
+
+  static Scalar getTolerance() {
+    return std::is_same<Scalar, float>::value ? Scalar(1.0e-3) : Scalar(1.0e-8);
+  }
+
+  Chain chain;
+};
+
+typedef ::testing::Types<float, double> PrimTypes;
+
+TYPED_TEST_CASE(InverseKinematicsTest, PrimTypes);
+
+TYPED_TEST(InverseKinematicsTest, testSolve) {
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::JointVector JointVector;
+  std::srand(3);
+  typename TestFixture::Solver solver(this->chain);
+  solver.setTolerances(this->getTolerance(), this->getTolerance());
+  for (int i = 0; i < 20; ++i) {
+    const JointVector jointPositionsReference = JointVector::Random(6);
+    const typename TestFixture::Target target = this->getTarget(jointPositionsReference);
+    JointVector jointPositions = jointPositionsReference + Scalar(0.3)*JointVector::Random(6);
+    ASSERT_TRUE(solver.solve(target, jointPositions));
+    EXPECT_LE(solver.getError().norm(), Scalar(2)*this->getTolerance());
+
+    // the solution reaches the target
+    const typename TestFixture::Target solution = this->getTarget(jointPositions);
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(target.getPosition().toImplementation(), solution.getPosition().toImplementation(), 10.0*this->getTolerance(), 1.0e-3, "position");
+    EXPECT_LE(target.getRotation().getDisparityAngle(solution.getRotation()), Scalar(10)*this->getTolerance());
+
+    // the solution is a warm start without iterations
+    ASSERT_TRUE(solver.solve(target, jointPositions));
+    EXPECT_EQ(0, solver.getNumberOfIterations());
+  }
+}
+
+TYPED_TEST(InverseKinematicsTest, testUnreachableTarget) {
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::JointVector JointVector;
+  typename TestFixture::Solver solver(this->chain);
+  solver.setMaximumNumberOfIterations(20);
+  const typename TestFixture::Target target(typename TestFixture::Pose::Position(Scalar(10), Scalar(0), Scalar(0)), kindr::RotationQuaternion<Scalar>());
+  JointVector jointPositions = JointVector::Zero(6);
+  EXPECT_FALSE(solver.solve(target, jointPositions));
+  EXPECT_EQ(20, solver.getNumberOfIterations());
+  EXPECT_TRUE(jointPositions.allFinite());
+}
+
+TYPED_TEST(InverseKinematicsTest, testBatch) {
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::JointVector JointVector;
+  typedef typename TestFixture::Solver Solver;
+  std::srand(5);
+  Solver solver(this->chain);
+  solver.setTolerances(this->getTolerance(), this->getTolerance());
+  typename Solver::Targets targets;
+  typename Solver::JointMatrix jointPositions(6, 100);
+  for (int i = 0; i < 100; ++i) {
+    const JointVector jointPositionsReference = JointVector::Random(6);
+    targets.push_back(this->getTarget(jointPositionsReference));
+    jointPositions.col(i) = jointPositionsReference + Scalar(0.3)*JointVector::Random(6);
+  }
+  const typename Solver::JointMatrix initialGuesses = jointPositions;
+  typename Solver::Flags converged;
+  const Eigen::DenseIndex numberOfConverged = solver.solve(targets, jointPositions, converged);
+  ASSERT_EQ(100, converged.size());
+  EXPECT_EQ(converged.count(), numberOfConverged);
+  EXPECT_EQ(100, numberOfConverged);
+
+  // the batch gives the same solutions as the sequential solves
+  for (int i = 0; i < 100; ++i) {
+    JointVector solution = initialGuesses.col(i);
+    EXPECT_EQ(solver.solve(targets[i], solution), converged(i));
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(solution, JointVector(jointPositions.col(i)), 1.0e-6, 1.0e-6, "solution");
+  }
+}
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/kinematics/KinematicChain.hpp"
+#include "kindr/common/gtest_eigen.hpp"
+
+template <typename Scalar_>
+class KinematicChainTest : public ::testing::Test {
+ public:
+  typedef Scalar_ Scalar;
+  typedef kindr::KinematicChain<Scalar> Chain;
+  typedef typename Chain::Pose Pose;
+  typedef typename Chain::JointVector JointVector;
+  typedef typename Chain::Jacobian Jacobian;
+  typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+
+  KinematicChainTest() {
+    std::srand(7);
+    const kindr::JointType jointTypes[] = {kindr::JointType::Revolute, kindr::JointType::Revolute, kindr::JointType::Prismatic,
+                                           kindr::JointType::Revolute, kindr::JointType::Prismatic, kindr::JointType::Revolute};
+    for (int i = 0; i < 6; ++i) {
+      kindr::RotationQuaternion<Scalar> rotation;
+      rotation.setRandom();
+      types.push_back(jointTypes[i]);
+      parentToJoints.push_back(Pose(typename Pose::Position(Vector3::Random()), typename Pose::Rotation(rotation)));
+      axes.push_back(Vector3::Random().normalized());
+      chain.addJoint(types.back(), parentToJoints.back(), axes.back());
+    }
+    kindr::RotationQuaternion<Scalar> toolRotation;
+    toolRotation.setRandom();
+    linkToTool = Pose(typename Pose::Position(Vector3::Random()), typename Pose::Rotation(toolRotation));
+    chain.setTool(linkToTool);
+    jointPositions = JointVector::Random(6);
+    jointVelocities = JointVector::Random(6);
+  }
+
+  //! Step and tolerance of the central differences
+  static Scalar getStep() {
+    return std::is_same<Scalar, float>::value ? Scalar(1.0e-2) : Scalar(1.0e-6);
+  }
+  static double getTolerance() {
+    return std::is_same<Scalar, float>::value ? 5.0e-3 : 1.0e-6;
+  }
+
+  //! Jacobian by central differences of the tool pose
+  Jacobian getNumericalJacobian() {
+    const Scalar step = getStep();
+    Jacobian jacobian(6, 6);
+    for (int i = 0; i < 6; ++i) {
+      JointVector jointPositionsPlus = jointPositions;
+      JointVector jointPositionsMinus = jointPositions;
+      jointPositionsPlus(i) += step;
+      jointPositionsMinus(i) -= step;
+      chain.update(jointPositionsPlus);
+      const Pose posePlus = chain.getToolPose();
+      chain.update(jointPositionsMinus);
+      const Pose poseMinus = chain.getToolPose();
+      jacobian.col(i).template head<3>() = (posePlus.getPosition() - poseMinus.getPosition()).toImplementation()/(Scalar(2)*step);
+      jacobian.col(i).template tail<3>() = posePlus.getRotation().boxMinus(poseMinus.getRotation())/(Scalar(2)*step);
+    }
+    return jacobian;
+  }
+
+  Chain chain;
+  std::vector<kindr::JointType> types;
+  typename Chain::Poses parentToJoints;
+  std::vector<Vector3, Eigen::aligned_allocator<Vector3> > axes;
+  Pose linkToTool;
+  JointVector jointPositions;
+  JointVector jointVelocities;
+};
+
+typedef ::testing::Types<float, double> PrimTypes;
+
+TYPED_TEST_CASE(KinematicChainTest, PrimTypes);
+
+TYPED_TEST(KinematicChainTest, testForwardKinematics) {
+  typedef typename TestFixture::Pose Pose;
+  this->chain.update(this->jointPositions);
+  ASSERT_EQ(6, this->chain.getNumberOfJoints());
+  ASSERT_EQ(6u, this->chain.getLinkPoses().size());
+
+  // reference by the generic concatenation of the poses
+  Pose pose;
+  pose.setIdentity();
+  for (int i = 0; i < 6; ++i) {
+    Pose motion;
+    motion.setIdentity();
+    if (this->types[i] == kindr::JointType::Revolute) {
+      motion.getRotation() = typename Pose::Rotation(kindr::AngleAxis<typename TestFixture::Scalar>(this->jointPositions(i), this->axes[i]));
+    } else {
+      motion.getPosition() = typename Pose::Position(this->jointPositions(i)*this->axes[i]);
+    }
+    pose = pose*this->parentToJoints[i]*motion;
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(pose.getTransformationMatrix(), this->chain.getLinkPose(i).getTransformationMatrix(), 1.0e-5, 1.0e-4, "link pose");
+  }
+  pose = pose*this->linkToTool;
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(pose.getTransformationMatrix(), this->chain.getToolPose().getTransformationMatrix(), 1.0e-5, 1.0e-4, "tool pose");
+
+  // the positions alone give the same poses as with the velocities
+  this->chain.update(this->jointPositions, this->jointVelocities);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(pose.getTransformationMatrix(), this->chain.getToolPose().getTransformationMatrix(), 1.0e-5, 1.0e-4, "tool pose");
+}
+
+TYPED_TEST(KinematicChainTest, testJacobian) {
+  typedef typename TestFixture::Jacobian Jacobian;
+  const Jacobian numericalJacobian = this->getNumericalJacobian();
+  this->chain.update(this->jointPositions);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(numericalJacobian, this->chain.getJacobian(), this->getTolerance(), this->getTolerance(), "jacobian");
+
+  // prismatic joints do not rotate the tool
+  EXPECT_TRUE(this->chain.getJacobian().col(2).template tail<3>().isZero());
+  EXPECT_TRUE(this->chain.getJacobian().col(4).template tail<3>().isZero());
+}
+
+TYPED_TEST(KinematicChainTest, testToolTwist) {
+  typedef typename TestFixture::Scalar Scalar;
+  this->chain.update(this->jointPositions, this->jointVelocities);
+  const Eigen::Matrix<Scalar, 6, 1> twist = this->chain.getJacobian()*this->jointVelocities;
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(twist, this->chain.getToolTwist().getVector(), 1.0e-5, 1.0e-4, "twist");
+}
+
+TYPED_TEST(KinematicChainTest, testJacobianTimeDerivative) {
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Jacobian Jacobian;
+  typedef typename TestFixture::JointVector JointVector;
+  const Scalar step = this->getStep();
+  const JointVector jointPositionsPlus = this->jointPositions + step*this->jointVelocities;
+  const JointVector jointPositionsMinus = this->jointPositions - step*this->jointVelocities;
+  this->chain.update(jointPositionsPlus);
+  const Jacobian jacobianPlus = this->chain.getJacobian();
+  this->chain.update(jointPositionsMinus);
+  const Jacobian jacobianMinus = this->chain.getJacobian();
+  const Jacobian numericalDerivative = (jacobianPlus - jacobianMinus)/(Scalar(2)*step);
+
+  this->chain.update(this->jointPositions, this->jointVelocities);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(numericalDerivative, this->chain.getJacobianTimeDerivative(), this->getTolerance(), this->getTolerance(), "jacobian derivative");
+}
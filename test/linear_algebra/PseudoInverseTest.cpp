@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/math/LinearAlgebra.hpp"
+
+typedef ::testing::Types<
+    float,
+    double
+> PrimTypes;
+
+template <typename PrimType_>
+struct PseudoInverseTest : public ::testing::Test {
+  typedef PrimType_ Scalar;
+  typedef Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> MatrixX;
+
+  //! Reference computed with the dynamic-size singular value decomposition
+  static MatrixX getReference(const MatrixX& a) {
+    MatrixX result(a.cols(), a.rows());
+    EXPECT_TRUE(kindr::pseudoInverse(a, result));
+    return result;
+  }
+
+  //! Checks the Penrose conditions A*X*A = A and X*A*X = X
+  template<typename Matrix_, typename Inverse_>
+  static void checkPenroseConditions(const Matrix_& a, const Inverse_& x, Scalar tolerance) {
+    EXPECT_LT((MatrixX(a)*MatrixX(x)*MatrixX(a) - MatrixX(a)).norm(), tolerance);
+    EXPECT_LT((MatrixX(x)*MatrixX(a)*MatrixX(x) - MatrixX(x)).norm(), tolerance);
+  }
+};
+
+TYPED_TEST_CASE(PseudoInverseTest, PrimTypes);
+
+TYPED_TEST(PseudoInverseTest, testDynamic)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::MatrixX MatrixX;
+
+  const MatrixX a = MatrixX::Random(4, 7);
+  const MatrixX x = TestFixture::getReference(a);
+  TestFixture::checkPenroseConditions(a, x, Scalar(1e-3));
+
+  MatrixX empty;
+  MatrixX emptyInverse;
+  EXPECT_FALSE(kindr::pseudoInverse(empty, emptyInverse));
+}
+
+TYPED_TEST(PseudoInverseTest, testFixedSize)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::MatrixX MatrixX;
+
+  const Eigen::Matrix<Scalar, 3, 3> a3 = Eigen::Matrix<Scalar, 3, 3>::Random();
+  Eigen::Matrix<Scalar, 3, 3> x3;
+  ASSERT_TRUE(kindr::pseudoInverse(a3, x3));
+  EXPECT_TRUE(MatrixX(x3).isApprox(TestFixture::getReference(a3), Scalar(1e-3)));
+
+  const Eigen::Matrix<Scalar, 6, 6> a6 = Eigen::Matrix<Scalar, 6, 6>::Random();
+  Eigen::Matrix<Scalar, 6, 6> x6;
+  ASSERT_TRUE(kindr::pseudoInverse(a6, x6));
+  EXPECT_TRUE(MatrixX(x6).isApprox(TestFixture::getReference(a6), Scalar(1e-2)));
+
+  // rank deficient
+  Eigen::Matrix<Scalar, 3, 5> a35 = Eigen::Matrix<Scalar, 3, 5>::Random();
+  a35.row(2) = a35.row(0) + a35.row(1);
+  Eigen::Matrix<Scalar, 5, 3> x35;
+  ASSERT_TRUE(kindr::pseudoInverse(a35, x35, Scalar(1e-4)));
+  TestFixture::checkPenroseConditions(a35, x35, Scalar(1e-3));
+}
+
+TYPED_TEST(PseudoInverseTest, testFixedRows)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::MatrixX MatrixX;
+
+  // 3xN and 6xN Jacobians
+  const Eigen::Matrix<Scalar, 3, Eigen::Dynamic> a3 = Eigen::Matrix<Scalar, 3, Eigen::Dynamic>::Random(3, 12);
+  Eigen::Matrix<Scalar, Eigen::Dynamic, 3> x3(12, 3);
+  ASSERT_TRUE(kindr::pseudoInverse(a3, x3));
+  EXPECT_TRUE(MatrixX(x3).isApprox(TestFixture::getReference(a3), Scalar(1e-3)));
+
+  const Eigen::Matrix<Scalar, 6, Eigen::Dynamic> a6 = Eigen::Matrix<Scalar, 6, Eigen::Dynamic>::Random(6, 18);
+  Eigen::Matrix<Scalar, Eigen::Dynamic, 6> x6(18, 6);
+  ASSERT_TRUE(kindr::pseudoInverse(a6, x6));
+  EXPECT_TRUE(MatrixX(x6).isApprox(TestFixture::getReference(a6), Scalar(1e-3)));
+
+  // tall Nx3 and rank deficient
+  Eigen::Matrix<Scalar, Eigen::Dynamic, 3> tall = Eigen::Matrix<Scalar, Eigen::Dynamic, 3>::Random(10, 3);
+  tall.col(2) = tall.col(0);
+  Eigen::Matrix<Scalar, 3, Eigen::Dynamic> tallInverse(3, 10);
+  ASSERT_TRUE(kindr::pseudoInverse(tall, tallInverse, Scalar(1e-3)));
+  TestFixture::checkPenroseConditions(tall, tallInverse, Scalar(1e-3));
+}
+
+TYPED_TEST(PseudoInverseTest, testDampedAndFullRank)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::MatrixX MatrixX;
+
+  const Eigen::Matrix<Scalar, 6, Eigen::Dynamic> a = Eigen::Matrix<Scalar, 6, Eigen::Dynamic>::Random(6, 9);
+  const MatrixX reference = TestFixture::getReference(a);
+
+  Eigen::Matrix<Scalar, Eigen::Dynamic, 6> x(9, 6);
+  ASSERT_TRUE(kindr::fullRankPseudoInverse(a, x));
+  EXPECT_TRUE(MatrixX(x).isApprox(reference, Scalar(1e-3)));
+
+  // vanishing damping converges to the pseudo-inverse
+  ASSERT_TRUE(kindr::dampedPseudoInverse(a, x, Scalar(1e-4)));
+  EXPECT_TRUE(MatrixX(x).isApprox(reference, Scalar(1e-3)));
+
+  // damping limits the norm close to singularities
+  Eigen::Matrix<Scalar, 6, Eigen::Dynamic> singular = a;
+  singular.row(5) = singular.row(4);
+  EXPECT_FALSE(kindr::fullRankPseudoInverse(singular, x, Scalar(1e-4)));
+  singular.row(5) += Eigen::Matrix<Scalar, 1, Eigen::Dynamic>::Constant(9, Scalar(1e-4));
+  ASSERT_TRUE(kindr::dampedPseudoInverse(singular, x, Scalar(0.1)));
+  EXPECT_LT(x.norm(), Scalar(100));
+
+  // tall fixed-size matrix
+  const Eigen::Matrix<Scalar, 5, 3> tall = Eigen::Matrix<Scalar, 5, 3>::Random();
+  Eigen::Matrix<Scalar, 3, 5> tallInverse;
+  ASSERT_TRUE(kindr::fullRankPseudoInverse(tall, tallInverse));
+  EXPECT_TRUE(MatrixX(tallInverse).isApprox(TestFixture::getReference(tall), Scalar(1e-3)));
+}
+
+TYPED_TEST(PseudoInverseTest, testExpressions)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::MatrixX MatrixX;
+
+  // blocks and transposes are accepted like by pseudoInverse()
+  const Eigen::Matrix<Scalar, 6, Eigen::Dynamic> a = Eigen::Matrix<Scalar, 6, Eigen::Dynamic>::Random(6, 9);
+  const MatrixX leftColsReference = TestFixture::getReference(a.leftCols(4));
+  Eigen::Matrix<Scalar, Eigen::Dynamic, 6> leftColsInverse(4, 6);
+  ASSERT_TRUE(kindr::fullRankPseudoInverse(a.leftCols(4), leftColsInverse));
+  EXPECT_TRUE(MatrixX(leftColsInverse).isApprox(leftColsReference, Scalar(1e-3)));
+  ASSERT_TRUE(kindr::gramPseudoInverse(a.leftCols(4), leftColsInverse));
+  EXPECT_TRUE(MatrixX(leftColsInverse).isApprox(leftColsReference, Scalar(1e-3)));
+  ASSERT_TRUE(kindr::dampedPseudoInverse(a.leftCols(4), leftColsInverse, Scalar(1e-4)));
+  EXPECT_TRUE(MatrixX(leftColsInverse).isApprox(leftColsReference, Scalar(1e-3)));
+
+  const MatrixX transposeReference = TestFixture::getReference(a.transpose());
+  Eigen::Matrix<Scalar, 6, Eigen::Dynamic> transposeInverse(6, 9);
+  ASSERT_TRUE(kindr::fullRankPseudoInverse(a.transpose(), transposeInverse));
+  EXPECT_TRUE(MatrixX(transposeInverse).isApprox(transposeReference, Scalar(1e-3)));
+  ASSERT_TRUE(kindr::dampedPseudoInverse(a.transpose(), transposeInverse, Scalar(1e-4)));
+  EXPECT_TRUE(MatrixX(transposeInverse).isApprox(transposeReference, Scalar(1e-3)));
+
+  Eigen::Matrix<Scalar, 5, 3> blockInverse;
+  ASSERT_TRUE(kindr::gramPseudoInverse(a.template block<3, 5>(1, 2), blockInverse));
+  EXPECT_TRUE(MatrixX(blockInverse).isApprox(TestFixture::getReference(a.template block<3, 5>(1, 2)), Scalar(1e-3)));
+}
+
+TYPED_TEST(PseudoInverseTest, testIllConditioned)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::MatrixX MatrixX;
+
+  // 6x7 Jacobian with the condition number 1e3
+  const Eigen::JacobiSVD<MatrixX> random(MatrixX::Random(6, 7), Eigen::ComputeThinU | Eigen::ComputeThinV);
+  Eigen::Matrix<Scalar, 6, 1> singularValues;
+  singularValues << Scalar(1), Scalar(0.3), Scalar(0.1), Scalar(0.03), Scalar(0.01), Scalar(1e-3);
+  const Eigen::Matrix<Scalar, 6, Eigen::Dynamic> a = random.matrixU()*singularValues.asDiagonal()*random.matrixV().transpose();
+  Eigen::Matrix<Scalar, Eigen::Dynamic, 6> x(7, 6);
+  const Scalar tolerance = std::is_same<Scalar, float>::value ? Scalar(1e-4) : Scalar(1e-12);
+
+  // the singular value decomposition does not square the condition number
+  ASSERT_TRUE(kindr::pseudoInverse(a, x));
+  EXPECT_LT((a*x*a - a).norm(), tolerance);
+  EXPECT_LT((x*a*x - x).norm(), Scalar(1e3)*tolerance);
+  const MatrixX reference = x;
+
+  // the Gram matrix does, but it still keeps the smallest singular value
+  ASSERT_TRUE(kindr::gramPseudoInverse(a, x));
+  EXPECT_TRUE(MatrixX(x).isApprox(reference, std::is_same<Scalar, float>::value ? Scalar(0.1) : Scalar(1e-6)));
+}
+
+TYPED_TEST(PseudoInverseTest, testDynamicColumnsTall)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::MatrixX MatrixX;
+
+  // 6xN with N < 6 has full column rank, i.e. the Gram matrix is A^T*A
+  const Eigen::Matrix<Scalar, 6, Eigen::Dynamic> tall = Eigen::Matrix<Scalar, 6, Eigen::Dynamic>::Random(6, 3);
+  const MatrixX reference = TestFixture::getReference(tall);
+  Eigen::Matrix<Scalar, Eigen::Dynamic, 6> x(3, 6);
+  ASSERT_TRUE(kindr::fullRankPseudoInverse(tall, x));
+  EXPECT_TRUE(MatrixX(x).isApprox(reference, Scalar(1e-3)));
+  ASSERT_TRUE(kindr::gramPseudoInverse(tall, x));
+  EXPECT_TRUE(MatrixX(x).isApprox(reference, Scalar(1e-3)));
+  ASSERT_TRUE(kindr::dampedPseudoInverse(tall, x, Scalar(1e-4)));
+  EXPECT_TRUE(MatrixX(x).isApprox(reference, Scalar(1e-3)));
+
+  kindr::PseudoInverseWorkspace<Scalar, 6, Eigen::Dynamic> workspace(6, 3);
+  ASSERT_TRUE(workspace.fullRankPseudoInverse(tall, x));
+  EXPECT_TRUE(MatrixX(x).isApprox(reference, Scalar(1e-3)));
+  ASSERT_TRUE(workspace.gramPseudoInverse(tall, x));
+  EXPECT_TRUE(MatrixX(x).isApprox(reference, Scalar(1e-3)));
+}
+
+TYPED_TEST(PseudoInverseTest, testWorkspace)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::MatrixX MatrixX;
+
+  kindr::PseudoInverseWorkspace<Scalar> workspace(4, 7);
+  MatrixX x(7, 4);
+  for (int i = 0; i < 3; ++i) {
+    const MatrixX a = MatrixX::Random(4, 7);
+    const MatrixX reference = TestFixture::getReference(a);
+    ASSERT_TRUE(workspace.pseudoInverse(a, x));
+    EXPECT_TRUE(x.isApprox(reference, Scalar(1e-3)));
+    ASSERT_TRUE(workspace.fullRankPseudoInverse(a, x));
+    EXPECT_TRUE(x.isApprox(reference, Scalar(1e-3)));
+    ASSERT_TRUE(workspace.gramPseudoInverse(a, x));
+    EXPECT_TRUE(x.isApprox(reference, Scalar(1e-3)));
+    ASSERT_TRUE(workspace.dampedPseudoInverse(a, x, Scalar(0)));
+    EXPECT_TRUE(x.isApprox(reference, Scalar(1e-3)));
+  }
+
+  // tall dynamic-size matrix
+  kindr::PseudoInverseWorkspace<Scalar> tallWorkspace(8, 3);
+  const MatrixX tall = MatrixX::Random(8, 3);
+  MatrixX tallInverse(3, 8);
+  ASSERT_TRUE(tallWorkspace.fullRankPseudoInverse(tall, tallInverse));
+  EXPECT_TRUE(tallInverse.isApprox(TestFixture::getReference(tall), Scalar(1e-3)));
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+
+#include <gtest/gtest.h>
+#include <kindr/math/LinearAlgebra.hpp>
+#include <kindr/rotations/Rotation.hpp>
+#include <kindr/rotations/RotationDiff.hpp>
+#include "kindr/common/gtest_eigen.hpp"
+
+template <typename Scalar_>
+class SkewProductsTest : public ::testing::Test {
+ public:
+  typedef Scalar_ Scalar;
+  typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+  typedef Eigen::Matrix<Scalar, 3, 3> Matrix3;
+
+  const Vector3 vector = Vector3(Scalar(0.3), Scalar(-1.2), Scalar(0.7));
+  const Matrix3 skewMatrix = kindr::getSkewMatrixFromVector(vector);
+};
+
+typedef ::testing::Types<float, double> ScalarTypes;
+TYPED_TEST_CASE(SkewProductsTest, ScalarTypes);
+
+TYPED_TEST(SkewProductsTest, testSkewTimes) {
+  typedef typename TestFixture::Scalar Scalar;
+  const Eigen::Matrix<Scalar, 3, 5> matrix = Eigen::Matrix<Scalar, 3, 5>::Random();
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->skewMatrix*matrix, kindr::skewTimes(this->vector, matrix), 1e-5, 1e-4, "fixed size");
+  const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> dynamicMatrix = matrix;
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->skewMatrix*matrix, kindr::skewTimes(this->vector, dynamicMatrix), 1e-5, 1e-4, "dynamic size");
+  const typename TestFixture::Vector3 vector = matrix.col(1);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->vector.cross(vector), kindr::skewTimes(this->vector, vector), 1e-5, 1e-4, "cross product");
+}
+
+TYPED_TEST(SkewProductsTest, testTimesSkew) {
+  typedef typename TestFixture::Scalar Scalar;
+  const Eigen::Matrix<Scalar, 6, 3> matrix = Eigen::Matrix<Scalar, 6, 3>::Random();
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(matrix*this->skewMatrix, kindr::timesSkew(matrix, this->vector), 1e-5, 1e-4, "fixed size");
+  const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> dynamicMatrix = matrix;
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(matrix*this->skewMatrix, kindr::timesSkew(dynamicMatrix, this->vector), 1e-5, 1e-4, "dynamic size");
+}
+
+TYPED_TEST(SkewProductsTest, testSkewSquaredTimes) {
+  typedef typename TestFixture::Scalar Scalar;
+  const Eigen::Matrix<Scalar, 3, 4> matrix = Eigen::Matrix<Scalar, 3, 4>::Random();
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->skewMatrix*this->skewMatrix*matrix, kindr::skewSquaredTimes(this->vector, matrix), 1e-5, 1e-4, "matrix");
+  const typename TestFixture::Vector3 vector = matrix.col(0);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->vector.cross(this->vector.cross(vector)), kindr::skewSquaredTimes(this->vector, vector), 1e-5, 1e-4, "vector");
+}
+
+TYPED_TEST(SkewProductsTest, testSkewTimesTimesSkewTranspose) {
+  typedef typename TestFixture::Matrix3 Matrix3;
+  const Matrix3 matrix = Matrix3::Random();
+  const Matrix3 covariance = matrix*matrix.transpose();
+  const Matrix3 result = kindr::skewTimesTimesSkewTranspose(this->vector, covariance);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->skewMatrix*covariance*this->skewMatrix.transpose(), result, 1e-5, 1e-4, "congruence");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(result.transpose(), result, 1e-5, 1e-4, "symmetry");
+}
+
+TYPED_TEST(SkewProductsTest, testAdoption) {
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Matrix3 Matrix3;
+  using std::sin;
+  using std::cos;
+  const Scalar norm = this->vector.norm();
+  const Matrix3 jacobian = Matrix3::Identity() + (Scalar(1) - cos(norm))/(norm*norm)*this->skewMatrix + (norm - sin(norm))/(norm*norm*norm)*this->skewMatrix*this->skewMatrix;
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(jacobian, kindr::getJacobianOfExponentialMap(this->vector), 1e-5, 1e-4, "exponential map Jacobian");
+
+  const kindr::RotationMatrix<Scalar> rotation(kindr::RotationVector<Scalar>(Scalar(0.2), Scalar(0.5), Scalar(-0.4)));
+  const kindr::LocalAngularVelocity<Scalar> localAngularVelocity(this->vector);
+  const kindr::GlobalAngularVelocity<Scalar> globalAngularVelocity(this->vector);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(rotation.matrix()*this->skewMatrix, kindr::RotationMatrixDiff<Scalar>(rotation, localAngularVelocity).matrix(), 1e-5, 1e-4, "local");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->skewMatrix*rotation.matrix(), kindr::RotationMatrixDiff<Scalar>(rotation, globalAngularVelocity).matrix(), 1e-5, 1e-4, "global");
+}
@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/math/NumericalDifferentiation.hpp"
+#include "kindr/common/gtest_eigen.hpp"
+#include "kindr/Core"
+
+typedef ::testing::Types<
+    float,
+    double
+> PrimTypes;
+
+template <typename PrimType_>
+struct NumericalDifferentiationTest : public ::testing::Test {
+  typedef PrimType_ Scalar;
+  typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+  typedef Eigen::Matrix<Scalar, 3, 3> Matrix3;
+  typedef Eigen::Matrix<Scalar, 2, 3> Matrix23;
+  typedef kindr::RotationQuaternion<Scalar> RotationQuaternion;
+  typedef kindr::HomTransformQuat<Scalar> Pose;
+
+  //! Tolerance of the central differences
+  static Scalar getTolerance() {
+    return std::is_same<Scalar, float>::value ? Scalar(5e-3) : Scalar(1e-8);
+  }
+
+  //! f(x) = [x0*x1^2; sin(x2)*x0; exp(x1)]
+  static Vector3 getFunction(const Vector3& x) {
+    return Vector3(x(0)*x(1)*x(1), std::sin(x(2))*x(0), std::exp(x(1)));
+  }
+
+  static Matrix3 getAnalyticJacobian(const Vector3& x) {
+    Matrix3 jacobian;
+    jacobian << x(1)*x(1), Scalar(2)*x(0)*x(1), Scalar(0),
+                std::sin(x(2)), Scalar(0), std::cos(x(2))*x(0),
+                Scalar(0), std::exp(x(1)), Scalar(0);
+    return jacobian;
+  }
+
+  RotationQuaternion getRandomRotation() const {
+    RotationQuaternion rotation;
+    rotation.setRandom();
+    return rotation;
+  }
+
+  Vector3 x = Vector3(Scalar(0.7), Scalar(-0.4), Scalar(1.3));
+};
+
+TYPED_TEST_CASE(NumericalDifferentiationTest, PrimTypes);
+
+TYPED_TEST(NumericalDifferentiationTest, testEuclidean)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Vector3 Vector3;
+  typedef typename TestFixture::Matrix3 Matrix3;
+  const Matrix3 reference = TestFixture::getAnalyticJacobian(this->x);
+
+  kindr::NumericalJacobian<Vector3, Vector3> central;
+  const Matrix3 centralJacobian = central.compute(&TestFixture::getFunction, this->x);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(centralJacobian, reference, TestFixture::getTolerance(), TestFixture::getTolerance(), "central");
+
+  kindr::NumericalJacobian<Vector3, Vector3> richardson(kindr::FiniteDifferenceScheme::Richardson);
+  const Matrix3 richardsonJacobian = richardson.compute(&TestFixture::getFunction, this->x);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(richardsonJacobian, reference, TestFixture::getTolerance(), TestFixture::getTolerance(), "richardson");
+
+  // With the same step, the extrapolation is more accurate
+  central.setStep(Scalar(0.1));
+  richardson.setStep(Scalar(0.1));
+  const Scalar centralError = (central.compute(&TestFixture::getFunction, this->x) - reference).norm();
+  const Scalar richardsonError = (richardson.compute(&TestFixture::getFunction, this->x) - reference).norm();
+  EXPECT_LT(richardsonError, Scalar(0.1)*centralError);
+
+  const Matrix3 convenience = kindr::getNumericalJacobian<Vector3>(&TestFixture::getFunction, this->x);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(convenience, reference, TestFixture::getTolerance(), TestFixture::getTolerance(), "convenience");
+}
+
+TYPED_TEST(NumericalDifferentiationTest, testDynamic)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Vector3 Vector3;
+  typedef Eigen::Matrix<Scalar, Eigen::Dynamic, 1> VectorX;
+  const VectorX x = this->x;
+  auto function = [](const VectorX& x) { return VectorX(TestFixture::getFunction(Vector3(x)).template head<2>()); };
+
+  kindr::NumericalJacobian<VectorX, VectorX> numericalJacobian;
+  const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> jacobian = numericalJacobian.compute(function, x);
+  ASSERT_EQ(jacobian.rows(), 2);
+  ASSERT_EQ(jacobian.cols(), 3);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(jacobian, TestFixture::getAnalyticJacobian(this->x).template topRows<2>(), TestFixture::getTolerance(), TestFixture::getTolerance(), "dynamic");
+
+  // Scalar valued function
+  auto norm = [](const VectorX& x) { return x.norm(); };
+  const Eigen::Matrix<Scalar, 1, Eigen::Dynamic> gradient = kindr::getNumericalJacobian<Scalar>(norm, x);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(gradient, (x/x.norm()).transpose(), TestFixture::getTolerance(), TestFixture::getTolerance(), "gradient");
+}
+
+TYPED_TEST(NumericalDifferentiationTest, testRotate)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Vector3 Vector3;
+  typedef typename TestFixture::Matrix3 Matrix3;
+  typedef typename TestFixture::RotationQuaternion RotationQuaternion;
+  const Vector3 vector(Scalar(0.3), Scalar(-1.2), Scalar(0.5));
+
+  for (int i = 0; i < 10; ++i) {
+    const RotationQuaternion rotation = this->getRandomRotation();
+    // d(exp(v)*R*p)/dv = -[R*p]x
+    auto function = [&vector](const RotationQuaternion& r) { return Vector3(r.rotate(vector)); };
+    const Matrix3 jacobian = kindr::getNumericalJacobian<Vector3>(function, rotation, kindr::FiniteDifferenceScheme::Richardson);
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(jacobian, Matrix3(-kindr::getSkewMatrixFromVector(rotation.rotate(vector))), TestFixture::getTolerance(), TestFixture::getTolerance(), "rotate");
+  }
+}
+
+TYPED_TEST(NumericalDifferentiationTest, testExponentialMap)
+{
+  typedef typename TestFixture::Vector3 Vector3;
+  typedef typename TestFixture::Matrix3 Matrix3;
+  typedef typename TestFixture::RotationQuaternion RotationQuaternion;
+  auto function = [](const Vector3& v) { return RotationQuaternion().exponentialMap(v); };
+
+  kindr::NumericalJacobian<Vector3, RotationQuaternion> numericalJacobian(kindr::FiniteDifferenceScheme::Richardson);
+  for (int i = 0; i < 10; ++i) {
+    const Vector3 v = this->getRandomRotation().logarithmicMap();
+    const Matrix3 jacobian = numericalJacobian.compute(function, v);
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(jacobian, Matrix3(kindr::getJacobianOfExponentialMap(v)), TestFixture::getTolerance(), TestFixture::getTolerance(), "exponential map");
+  }
+}
+
+TYPED_TEST(NumericalDifferentiationTest, testPose)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Vector3 Vector3;
+  typedef typename TestFixture::Pose Pose;
+  typedef Eigen::Matrix<Scalar, 3, 6> Matrix36;
+  const Vector3 point(Scalar(-0.2), Scalar(0.9), Scalar(0.4));
+  const Pose pose(typename Pose::Position(Scalar(1), Scalar(-2), Scalar(0.5)), this->getRandomRotation());
+
+  // d(p + exp(w)*R*x)/d[p; w] = [I, -[R*x]x]
+  auto function = [&point](const Pose& p) { return typename Pose::Position(p.transform(typename Pose::Position(point))); };
+  const Matrix36 jacobian = kindr::getNumericalJacobian<typename Pose::Position>(function, pose, kindr::FiniteDifferenceScheme::Richardson);
+  Matrix36 reference;
+  reference << Eigen::Matrix<Scalar, 3, 3>::Identity(), -kindr::getSkewMatrixFromVector(pose.getRotation().rotate(point));
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(jacobian, reference, TestFixture::getTolerance(), TestFixture::getTolerance(), "pose");
+
+  // The box operations of the identity are the identity
+  const Eigen::Matrix<Scalar, 6, 6> identity = kindr::getNumericalJacobian<Pose>([](const Pose& p) { return p; }, pose);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(identity, (Eigen::Matrix<Scalar, 6, 6>::Identity()), TestFixture::getTolerance(), TestFixture::getTolerance(), "identity");
+}
+
+TYPED_TEST(NumericalDifferentiationTest, testDirectionalDerivative)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Vector3 Vector3;
+  typedef typename TestFixture::Matrix23 Matrix23;
+  const Vector3 velocity(Scalar(0.5), Scalar(1.5), Scalar(-0.8));
+
+  // Time derivative of a matrix valued function A(x(t)), i.e. dA/dt = J*dx/dt
+  auto function = [](const Vector3& x) {
+    Matrix23 a;
+    a.row(0) = TestFixture::getFunction(x).transpose();
+    a.row(1) = Scalar(2)*x.transpose();
+    return a;
+  };
+  kindr::NumericalJacobian<Vector3, Matrix23> numericalJacobian;
+  const Eigen::Matrix<Scalar, 6, 3> jacobian = numericalJacobian.compute(function, this->x);
+  const Eigen::Matrix<Scalar, 6, 1> derivative = numericalJacobian.computeDirectionalDerivative(function, this->x, velocity);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(derivative, (jacobian*velocity).eval(), TestFixture::getTolerance(), TestFixture::getTolerance(), "directional derivative");
+
+  // The coefficients are stacked column-major
+  const Matrix23 timeDerivative = Eigen::Map<const Matrix23>(derivative.data());
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(timeDerivative.row(0).transpose(), (TestFixture::getAnalyticJacobian(this->x)*velocity).eval(), TestFixture::getTolerance(), TestFixture::getTolerance(), "time derivative");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(timeDerivative.row(1).transpose(), (Scalar(2)*velocity).eval(), TestFixture::getTolerance(), TestFixture::getTolerance(), "time derivative");
+}
+
+TYPED_TEST(NumericalDifferentiationTest, testTotalTimeDerivative)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Vector3 Vector3;
+  typedef typename TestFixture::RotationQuaternion RotationQuaternion;
+  const Vector3 velocity(Scalar(0.5), Scalar(1.5), Scalar(-0.8));
+  const Vector3 acceleration(Scalar(-0.3), Scalar(0.2), Scalar(1.1));
+
+  // f(x, dx) = [x0*dx1; sin(x2)*dx0^2; x1], see the example of fulldiff2.m
+  auto function = [](const Vector3& x, const Vector3& dx) { return Vector3(x(0)*dx(1), std::sin(x(2))*dx(0)*dx(0), x(1)); };
+  const Vector3 reference(velocity(0)*velocity(1) + this->x(0)*acceleration(1),
+                          std::cos(this->x(2))*velocity(2)*velocity(0)*velocity(0) + Scalar(2)*std::sin(this->x(2))*velocity(0)*acceleration(0),
+                          velocity(1));
+  const kindr::NumericalJacobian<Vector3, Vector3> central;
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(central.computeTotalTimeDerivative(function, this->x, velocity, acceleration), reference,
+                                    TestFixture::getTolerance(), TestFixture::getTolerance(), "euclidean");
+  const kindr::NumericalJacobian<Vector3, Vector3> richardson(kindr::FiniteDifferenceScheme::Richardson);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(richardson.computeTotalTimeDerivative(function, this->x, velocity, acceleration), reference,
+                                    TestFixture::getTolerance(), TestFixture::getTolerance(), "richardson");
+
+  // d(R*p + w)/dt = w x R*p + dw/dt for the global angular velocity w
+  const Vector3 point(Scalar(-0.2), Scalar(0.9), Scalar(0.4));
+  const RotationQuaternion rotation = this->getRandomRotation();
+  auto rotate = [&point](const RotationQuaternion& r, const Vector3& w) { return Vector3(r.rotate(point) + w); };
+  const kindr::NumericalJacobian<RotationQuaternion, Vector3> rotationDerivative(kindr::FiniteDifferenceScheme::Richardson);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(rotationDerivative.computeTotalTimeDerivative(rotate, rotation, velocity, acceleration),
+                                    Vector3(velocity.cross(rotation.rotate(point)) + acceleration), TestFixture::getTolerance(), TestFixture::getTolerance(), "rotation");
+}
+
+TYPED_TEST(NumericalDifferentiationTest, testParallel)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef Eigen::Matrix<Scalar, Eigen::Dynamic, 1> VectorX;
+  const VectorX x = VectorX::Random(40);
+  auto function = [](const VectorX& x) { return VectorX(x.array().sin()*x.sum()); };
+
+  kindr::NumericalJacobian<VectorX, VectorX> sequential(kindr::FiniteDifferenceScheme::Richardson);
+  kindr::NumericalJacobian<VectorX, VectorX> parallel(kindr::FiniteDifferenceScheme::Richardson);
+  parallel.setParallel(true);
+  const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> reference = sequential.compute(function, x);
+  EXPECT_TRUE(parallel.compute(function, x) == reference);
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/phys_quant/WrenchAggregation.hpp"
+#include "kindr/rotations/Rotation.hpp"
+#include "kindr/common/gtest_eigen.hpp"
+
+template <typename PrimType_>
+struct WrenchAggregationTest : public ::testing::Test {
+  typedef PrimType_ Scalar;
+  typedef kindr::Wrench6<Scalar> Wrench;
+  typedef kindr::Position<Scalar, 3> Position;
+  typedef kindr::RotationQuaternion<Scalar> Rotation;
+  typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+  typedef Eigen::Matrix<Scalar, Eigen::Dynamic, 3> MatrixX3;
+  typedef Eigen::Matrix<Scalar, Eigen::Dynamic, 4> MatrixX4;
+
+  WrenchAggregationTest()
+    : positions(MatrixX3::Random(37, 3)),
+      quaternions(37, 4),
+      forces(MatrixX3::Random(37, 3)),
+      torques(MatrixX3::Random(37, 3)),
+      referencePoint(Scalar(0.2), Scalar(-0.5), Scalar(1.0)) {
+    for (int i = 0; i < 37; ++i) {
+      Rotation rotation;
+      rotation.setRandom();
+      quaternions.row(i) << rotation.w(), rotation.x(), rotation.y(), rotation.z();
+    }
+  }
+
+  //! Contact wrench in the common frame about the contact position
+  Wrench getContactWrench(int i) const {
+    const Rotation rotation(quaternions(i, 0), quaternions(i, 1), quaternions(i, 2), quaternions(i, 3));
+    return Wrench(rotation.rotate(Vector3(forces.row(i).transpose())), rotation.rotate(Vector3(torques.row(i).transpose())));
+  }
+
+  MatrixX3 positions;
+  MatrixX4 quaternions;
+  MatrixX3 forces;
+  MatrixX3 torques;
+  Position referencePoint;
+};
+
+typedef ::testing::Types<
+    float,
+    double
+> PrimTypes;
+
+TYPED_TEST_CASE(WrenchAggregationTest, PrimTypes);
+
+TYPED_TEST(WrenchAggregationTest, testShiftWrench)
+{
+  typedef typename TestFixture::Wrench Wrench;
+  typedef typename TestFixture::Position Position;
+  typedef typename TestFixture::Scalar Scalar;
+  const Wrench wrench(typename Wrench::Force(Scalar(0), Scalar(0), Scalar(2)), typename Wrench::Torque(Scalar(0.1), Scalar(0), Scalar(0)));
+  const Position from(Scalar(1), Scalar(0), Scalar(0));
+  const Position to(Scalar(0), Scalar(0), Scalar(0));
+  // (1, 0, 0) x (0, 0, 2) = (0, -2, 0)
+  const Wrench shifted = kindr::shiftWrench(wrench, from, to);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(wrench.getForce().toImplementation(), shifted.getForce().toImplementation(), 1.0e-6, 1.0e-6, "force");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(typename TestFixture::Vector3(Scalar(0.1), Scalar(-2), Scalar(0)), shifted.getTorque().toImplementation(), 1.0e-6, 1.0e-6, "torque");
+
+  // shifting back gives the original wrench
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(wrench.getVector(), kindr::shiftWrench(shifted, to, from).getVector(), 1.0e-6, 1.0e-6, "wrench");
+}
+
+TYPED_TEST(WrenchAggregationTest, testAggregateWrenches)
+{
+  typedef typename TestFixture::Wrench Wrench;
+  typedef typename TestFixture::Position Position;
+  typedef typename TestFixture::MatrixX3 MatrixX3;
+  MatrixX3 resultForces(37, 3);
+  MatrixX3 resultTorques(37, 3);
+  const Wrench total = kindr::aggregateWrenches(this->positions, this->quaternions, this->forces, this->torques, this->referencePoint, resultForces, resultTorques);
+
+  Wrench reference;
+  for (int i = 0; i < 37; ++i) {
+    const Wrench contact = kindr::shiftWrench(this->getContactWrench(i), Position(typename TestFixture::Vector3(this->positions.row(i).transpose())), this->referencePoint);
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(contact.getForce().toImplementation(), resultForces.row(i).transpose(), 1.0e-5, 1.0e-5, "force");
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(contact.getTorque().toImplementation(), resultTorques.row(i).transpose(), 1.0e-5, 1.0e-5, "torque");
+    reference += contact;
+  }
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(reference.getVector(), total.getVector(), 1.0e-4, 1.0e-4, "total");
+
+  // the wrenches in the common frame give the same total without the rotations
+  MatrixX3 forcesInCommonFrame(37, 3);
+  MatrixX3 torquesInCommonFrame(37, 3);
+  for (int i = 0; i < 37; ++i) {
+    const Wrench contact = this->getContactWrench(i);
+    forcesInCommonFrame.row(i) = contact.getForce().toImplementation().transpose();
+    torquesInCommonFrame.row(i) = contact.getTorque().toImplementation().transpose();
+  }
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(total.getVector(), kindr::aggregateWrenches(this->positions, forcesInCommonFrame, torquesInCommonFrame, this->referencePoint).getVector(),
+                                    1.0e-4, 1.0e-4, "total");
+}
+
+TYPED_TEST(WrenchAggregationTest, testNoContacts)
+{
+  typedef typename TestFixture::MatrixX3 MatrixX3;
+  const MatrixX3 empty(0, 3);
+  EXPECT_TRUE(kindr::aggregateWrenches(empty, empty, empty, this->referencePoint).getVector().isZero());
+}
@@ -33,6 +33,7 @@
 #include <gtest/gtest.h>
 
 #include "kindr/phys_quant/Wrench.hpp"
+#include "kindr/phys_quant/Wrench2D.hpp"
 #include "kindr/common/gtest_eigen.hpp"
 
 template <typename PrimType_>
@@ -253,3 +254,18 @@ TYPED_TEST(WrenchTest, math)
   KINDR_ASSERT_DOUBLE_MX_EQ(torque1DivideByScalar.toImplementation(), wrenchDivideAssign.getTorque().toImplementation(), Scalar(0.5), "divide and assign");
 
 }
+
+TYPED_TEST(WrenchTest, planar)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef kindr::Wrench2D<Scalar> Wrench2D;
+  typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+
+  const Wrench2D wrenchA(Vector3(Scalar(1), Scalar(2), Scalar(3)));
+  const Wrench2D wrenchB(Vector3(Scalar(-0.5), Scalar(0), Scalar(1)));
+  ASSERT_TRUE((wrenchA + wrenchB).getVector().isApprox(Vector3(Scalar(0.5), Scalar(2), Scalar(4))));
+  ASSERT_TRUE((wrenchA*Scalar(2)).getVector().isApprox(Vector3(Scalar(2), Scalar(4), Scalar(6))));
+  const kindr::Wrench6<Scalar> wrench3D = wrenchA.getWrench3D();
+  ASSERT_EQ(wrench3D.getTorque()(2), Scalar(3));
+  ASSERT_TRUE(Wrench2D(wrench3D) == wrenchA);
+}
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/poses/Alignment.hpp"
+#include "kindr/common/gtest_eigen.hpp"
+
+typedef ::testing::Types<
+    float,
+    double
+> PrimTypes;
+
+template <typename PrimType_>
+struct AlignmentTest : public ::testing::Test {
+  typedef PrimType_ Scalar;
+  typedef kindr::AlignmentAccumulator<Scalar> Accumulator;
+  typedef kindr::RotationQuaternion<Scalar> RotationQuaternion;
+  typedef kindr::HomTransformQuat<Scalar> Pose;
+  typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+  typedef Eigen::Matrix<Scalar, 3, Eigen::Dynamic> Matrix3X;
+
+  AlignmentTest()
+    : rotation(kindr::EulerAnglesZyx<Scalar>(Scalar(0.4), Scalar(-1.1), Scalar(2.3))),
+      translation(Scalar(10.0), Scalar(-3.0), Scalar(0.5)),
+      sources(Matrix3X::Random(3, 200)*Scalar(2)) {
+    targets = rotation.toImplementation().toRotationMatrix()*sources;
+    targets.colwise() += translation;
+  }
+
+  const RotationQuaternion rotation;
+  const Vector3 translation;
+  const Matrix3X sources;
+  Matrix3X targets;
+};
+
+TYPED_TEST_CASE(AlignmentTest, PrimTypes);
+
+TYPED_TEST(AlignmentTest, testRotationAndTransformation)
+{
+  typedef typename TestFixture::Accumulator Accumulator;
+
+  Accumulator accumulator;
+  accumulator.add(this->sources, this->targets);
+  ASSERT_EQ(accumulator.getWeight(), 200);
+  ASSERT_TRUE(accumulator.getRotation().isNear(this->rotation, 1e-4));
+  ASSERT_TRUE(accumulator.getRotationHorn().isNear(this->rotation, 1e-4));
+
+  const typename TestFixture::Pose pose = accumulator.getTransformation();
+  ASSERT_TRUE(pose.getRotation().isNear(this->rotation, 1e-4));
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(pose.getPosition().toImplementation(), this->translation, 1e-3, 1e-4, "translation");
+
+  ASSERT_TRUE(kindr::getRotationFromCorrespondences(this->sources, this->targets).isNear(this->rotation, 1e-4));
+  ASSERT_TRUE(kindr::getTransformationFromCorrespondences(this->sources, this->targets).getRotation().isNear(this->rotation, 1e-4));
+}
+
+TYPED_TEST(AlignmentTest, testSimilarity)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Accumulator Accumulator;
+  typedef typename TestFixture::Matrix3X Matrix3X;
+
+  const Scalar scale = Scalar(2.5);
+  Matrix3X targets = scale*this->rotation.toImplementation().toRotationMatrix()*this->sources;
+  targets.colwise() += this->translation;
+
+  Scalar estimatedScale;
+  const typename TestFixture::Pose pose = Accumulator().add(this->sources, targets).getSimilarityTransformation(estimatedScale);
+  ASSERT_NEAR(estimatedScale, scale, 1e-4);
+  ASSERT_TRUE(pose.getRotation().isNear(this->rotation, 1e-4));
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(pose.getPosition().toImplementation(), this->translation, 1e-3, 1e-4, "translation");
+}
+
+TYPED_TEST(AlignmentTest, testWeightsAndMerge)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Accumulator Accumulator;
+  typedef Eigen::Matrix<Scalar, 1, Eigen::Dynamic> RowVectorX;
+
+  // merging two halves equals one batch
+  Accumulator first, second, all;
+  first.add(this->sources.leftCols(120), this->targets.leftCols(120));
+  second.add(this->sources.rightCols(80), this->targets.rightCols(80));
+  first += second;
+  all.add(this->sources, this->targets);
+  ASSERT_NEAR(first.getWeight(), all.getWeight(), 1e-6);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(first.getSourceCentroid(), all.getSourceCentroid(), 1e-5, 1e-4, "centroid");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(first.getCrossCovariance(), all.getCrossCovariance(), 1e-3, 1e-4, "covariance");
+  ASSERT_NEAR(first.getSourceVariance(), all.getSourceVariance(), 1e-2);
+
+  // single correspondences equal one batch
+  Accumulator single;
+  for (int i = 0; i < this->sources.cols(); ++i) {
+    single.add(this->sources.col(i), this->targets.col(i));
+  }
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(single.getCrossCovariance(), all.getCrossCovariance(), 1e-3, 1e-4, "single");
+
+  // outliers with zero weight are ignored
+  typename TestFixture::Matrix3X targets = this->targets;
+  targets.col(3).setConstant(Scalar(100));
+  RowVectorX weights = RowVectorX::Ones(this->sources.cols());
+  weights(3) = Scalar(0);
+  weights(4) = Scalar(2);
+  Accumulator weighted;
+  weighted.add(this->sources, targets, weights);
+  ASSERT_NEAR(weighted.getWeight(), Scalar(200), 1e-4);
+  ASSERT_TRUE(weighted.getRotation().isNear(this->rotation, 1e-4));
+  ASSERT_TRUE(weighted.getRotationHorn().isNear(this->rotation, 1e-4));
+}
+
+TYPED_TEST(AlignmentTest, testReflection)
+{
+  typedef typename TestFixture::Accumulator Accumulator;
+  typedef typename TestFixture::Matrix3X Matrix3X;
+
+  // planar points do not determine the handedness, the result has to be a proper rotation
+  Matrix3X sources = this->sources;
+  sources.row(2).setZero();
+  const Matrix3X targets = this->rotation.toImplementation().toRotationMatrix()*sources;
+  const typename TestFixture::RotationQuaternion rotation = Accumulator().add(sources, targets).getRotation();
+  ASSERT_NEAR(rotation.toImplementation().norm(), 1, 1e-5);
+  ASSERT_TRUE(rotation.isNear(this->rotation, 1e-3));
+}
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/poses/Pose.hpp"
+#include "kindr/common/gtest_eigen.hpp"
+
+typedef ::testing::Types<
+    kindr::ConstantHomTransformQuatD,
+    kindr::ConstantHomTransformQuatF,
+    kindr::ConstantHomTransformMatrixD,
+    kindr::ConstantHomTransformMatrixF
+> Types;
+
+template <typename Scalar_>
+kindr::ConstantRotationQuaternion<Scalar_> toConstantRotation(const kindr::ConstantRotationQuaternion<Scalar_>& rotation, kindr::ConstantRotationQuaternion<Scalar_>*) {
+  return rotation;
+}
+
+template <typename Scalar_>
+kindr::ConstantRotationMatrix<Scalar_> toConstantRotation(const kindr::ConstantRotationQuaternion<Scalar_>& rotation, kindr::ConstantRotationMatrix<Scalar_>*) {
+  return rotation.getRotationMatrix();
+}
+
+template <typename PoseImplementation>
+struct ConstantHomogeneousTransformationTest : public ::testing::Test {
+  typedef PoseImplementation ConstantPose;
+  typedef typename ConstantPose::Scalar Scalar;
+  typedef typename ConstantPose::Position ConstantPosition;
+  typedef typename ConstantPose::Rotation ConstantRotation;
+  typedef decltype(std::declval<ConstantPose>().toTransformation()) Pose;
+  typedef typename Pose::Position Position;
+  typedef typename Pose::Rotation Rotation;
+
+  const Pose poseA = Pose(Position(Scalar(1.0), Scalar(2.0), Scalar(3.0)), Rotation(kindr::EulerAnglesZyx<Scalar>(Scalar(0.5), Scalar(1.2), Scalar(-1.7))));
+  const Pose poseB = Pose(Position(Scalar(-0.4), Scalar(0.1), Scalar(0.7)), Rotation(kindr::EulerAnglesZyx<Scalar>(Scalar(-0.3), Scalar(0.2), Scalar(0.9))));
+  const Position position = Position(Scalar(0.3), Scalar(-1.5), Scalar(0.6));
+
+  ConstantPosition toConstant(const Position& position) const {
+    return ConstantPosition(position.x(), position.y(), position.z());
+  }
+  ConstantPose toConstant(const Pose& pose) const {
+    const kindr::RotationQuaternion<Scalar> quaternion(pose.getRotation());
+    const kindr::ConstantRotationQuaternion<Scalar> rotation(quaternion.w(), quaternion.x(), quaternion.y(), quaternion.z());
+    return ConstantPose(toConstant(pose.getPosition()), toConstantRotation(rotation, static_cast<ConstantRotation*>(nullptr)));
+  }
+};
+
+TYPED_TEST_CASE(ConstantHomogeneousTransformationTest, Types);
+
+// Chain of mounting transforms, evaluated at compile time.
+constexpr kindr::ConstantHomTransformQuatD T_BI(kindr::ConstantPositionD(0.1, 0.0, 0.2), kindr::ConstantRotationQuaternionD(0.0, 0.0, 0.0, 1.0));
+constexpr kindr::ConstantHomTransformQuatD T_IC(kindr::ConstantPositionD(0.0, 0.5, 0.0), kindr::ConstantRotationQuaternionD());
+constexpr kindr::ConstantHomTransformQuatD T_BC = T_BI*T_IC;
+static_assert(T_BC.getPosition().x() == 0.1 && T_BC.getPosition().y() == -0.5 && T_BC.getPosition().z() == 0.2, "concatenation is not evaluated at compile time");
+constexpr kindr::ConstantPositionD cameraOrigin = T_BC.inverseTransform(T_BC.getPosition());
+static_assert(cameraOrigin.x() == 0.0 && cameraOrigin.y() == 0.0 && cameraOrigin.z() == 0.0, "inverse transform is not evaluated at compile time");
+
+TYPED_TEST(ConstantHomogeneousTransformationTest, testDefaultIsIdentity)
+{
+  typedef typename TestFixture::ConstantPose ConstantPose;
+  typedef typename TestFixture::Position Position;
+
+  const Position transformed = ConstantPose().toTransformation().transform(this->position);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->position.toImplementation(), transformed.toImplementation(), 1e-6, 1e-6, "identity");
+}
+
+TYPED_TEST(ConstantHomogeneousTransformationTest, testConcatenation)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Pose Pose;
+
+  const Pose expected = this->poseA*this->poseB;
+  const Pose pose = (this->toConstant(this->poseA)*this->toConstant(this->poseB)).toTransformation();
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected.getTransformationMatrix(), pose.getTransformationMatrix(), Scalar(1e-5), Scalar(1e-4), "concatenation");
+}
+
+TYPED_TEST(ConstantHomogeneousTransformationTest, testInversion)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Pose Pose;
+
+  const Pose identity = (this->toConstant(this->poseA)*this->toConstant(this->poseA).inverted()).toTransformation();
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(Pose().getTransformationMatrix(), identity.getTransformationMatrix(), Scalar(1e-5), Scalar(1e-4), "inversion");
+}
+
+TYPED_TEST(ConstantHomogeneousTransformationTest, testTransform)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Position Position;
+
+  const Position expected = this->poseA.transform(this->position);
+  const Position transformed = this->toConstant(this->poseA).transform(this->toConstant(this->position)).toPosition();
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected.toImplementation(), transformed.toImplementation(), Scalar(1e-5), Scalar(1e-4), "transform");
+
+  const Position expectedInverse = this->poseA.inverseTransform(this->position);
+  const Position inverseTransformed = this->toConstant(this->poseA).inverseTransform(this->toConstant(this->position)).toPosition();
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expectedInverse.toImplementation(), inverseTransformed.toImplementation(), Scalar(1e-5), Scalar(1e-4), "inverse transform");
+}
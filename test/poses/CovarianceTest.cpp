@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+
+#include <gtest/gtest.h>
+
+#include "kindr/poses/Covariance.hpp"
+#include "kindr/poses/HomogeneousTransformation.hpp"
+#include "kindr/rotations/RotationDiff.hpp"
+#include "kindr/common/gtest_eigen.hpp"
+
+template <typename Scalar_>
+class CovarianceTest : public ::testing::Test {
+ public:
+  typedef Scalar_ Scalar;
+  typedef Eigen::Matrix<Scalar, 3, 3> Matrix3;
+  typedef Eigen::Matrix<Scalar, 6, 6> Matrix6;
+  typedef kindr::RotationQuaternion<Scalar> Rotation;
+  typedef kindr::HomTransformQuat<Scalar> Pose;
+
+  CovarianceTest() {
+    const Matrix6 matrix = Matrix6::Random();
+    covariance6 = matrix*matrix.transpose() + Matrix6::Identity();
+    covariance3 = covariance6.template topLeftCorner<3,3>();
+  }
+
+  //! Covariance with garbage in the lower triangle, which must not be read
+  template<typename Matrix_>
+  static Matrix_ getUpperTriangle(const Matrix_& matrix) {
+    Matrix_ upper = matrix;
+    upper.template triangularView<Eigen::StrictlyLower>().setConstant(Scalar(1000));
+    return upper;
+  }
+
+  const Rotation rotation = Rotation(kindr::EulerAnglesZyx<Scalar>(Scalar(0.4), Scalar(-0.7), Scalar(1.3)));
+  const Pose pose = Pose(typename Pose::Position(Scalar(1.0), Scalar(-2.0), Scalar(0.5)), rotation);
+  Matrix3 covariance3;
+  Matrix6 covariance6;
+};
+
+typedef ::testing::Types<float, double> ScalarTypes;
+TYPED_TEST_CASE(CovarianceTest, ScalarTypes);
+
+TYPED_TEST(CovarianceTest, testRotateCovariance) {
+  typedef typename TestFixture::Matrix3 Matrix3;
+  typedef typename TestFixture::Matrix6 Matrix6;
+  const Matrix3 rotationMatrix = kindr::RotationMatrix<typename TestFixture::Scalar>(this->rotation).matrix();
+  const Matrix3 expected = rotationMatrix*this->covariance3*rotationMatrix.transpose();
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected, kindr::rotateCovariance(this->rotation, TestFixture::getUpperTriangle(this->covariance3)), 1e-4, 1e-4, "quaternion");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected, kindr::rotateCovariance(kindr::RotationMatrix<typename TestFixture::Scalar>(this->rotation), this->covariance3), 1e-4, 1e-4, "rotation matrix");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->covariance3, kindr::inverseRotateCovariance(this->rotation, expected), 1e-4, 1e-4, "inverse");
+
+  Matrix3 covariance = TestFixture::getUpperTriangle(this->covariance3);
+  kindr::rotateCovarianceInPlace(this->rotation, covariance);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected, covariance, 1e-4, 1e-4, "in place");
+
+  Matrix6 blockRotation = Matrix6::Zero();
+  blockRotation.template topLeftCorner<3,3>() = rotationMatrix;
+  blockRotation.template bottomRightCorner<3,3>() = rotationMatrix;
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(blockRotation*this->covariance6*blockRotation.transpose(), kindr::rotateCovariance(this->rotation, TestFixture::getUpperTriangle(this->covariance6)), 1e-4, 1e-4, "6x6");
+  const Eigen::Matrix<typename TestFixture::Scalar, Eigen::Dynamic, Eigen::Dynamic> dynamicCovariance = this->covariance6;
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(blockRotation*this->covariance6*blockRotation.transpose(), kindr::rotateCovariance(this->rotation, dynamicCovariance), 1e-4, 1e-4, "dynamic");
+}
+
+TYPED_TEST(CovarianceTest, testPropagateCovariance) {
+  typedef typename TestFixture::Scalar Scalar;
+  const Eigen::Matrix<Scalar, 3, 1> vector(Scalar(0.2), Scalar(-0.5), Scalar(0.9));
+  const typename TestFixture::Matrix3 jacobian = kindr::getJacobianOfExponentialMap(vector);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(jacobian*this->covariance3*jacobian.transpose(), kindr::propagateCovariance(jacobian, TestFixture::getUpperTriangle(this->covariance3)), 1e-4, 1e-4, "exponential map");
+  const Eigen::Matrix<Scalar, 2, 6> projection = Eigen::Matrix<Scalar, 2, 6>::Random();
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(projection*this->covariance6*projection.transpose(), kindr::propagateCovariance(projection, TestFixture::getUpperTriangle(this->covariance6)), 1e-4, 1e-4, "rectangular");
+}
+
+TYPED_TEST(CovarianceTest, testTransformCovariance) {
+  typedef typename TestFixture::Matrix3 Matrix3;
+  typedef typename TestFixture::Matrix6 Matrix6;
+  const Matrix3 rotationMatrix = kindr::RotationMatrix<typename TestFixture::Scalar>(this->rotation).matrix();
+  Matrix6 adjoint = Matrix6::Zero();
+  adjoint.template topLeftCorner<3,3>() = rotationMatrix;
+  adjoint.template topRightCorner<3,3>() = kindr::getSkewMatrixFromVector(this->pose.getPosition().toImplementation())*rotationMatrix;
+  adjoint.template bottomRightCorner<3,3>() = rotationMatrix;
+  const Matrix6 expected = adjoint*this->covariance6*adjoint.transpose();
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected, kindr::transformCovariance(this->pose, TestFixture::getUpperTriangle(this->covariance6)), 1e-4, 1e-4, "transform");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->covariance6, kindr::inverseTransformCovariance(this->pose, TestFixture::getUpperTriangle(expected)), 1e-3, 1e-4, "inverse transform");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected, kindr::inverseTransformCovariance(this->pose.inverted(), this->covariance6), 1e-3, 1e-4, "inverse of inverted pose");
+
+  Matrix6 covariance = TestFixture::getUpperTriangle(expected);
+  kindr::inverseTransformCovarianceInPlace(this->pose, covariance);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->covariance6, covariance, 1e-3, 1e-4, "inverse transform in place");
+}
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/poses/Pose.hpp"
+#include "kindr/common/gtest_eigen.hpp"
+
+namespace {
+struct World {};
+struct Base {};
+struct Imu {};
+struct Camera {};
+}
+
+typedef ::testing::Types<
+    kindr::HomTransformQuatD,
+    kindr::HomTransformQuatF,
+    kindr::HomTransformMatrixD,
+    kindr::HomTransformMatrixF
+> Types;
+
+template <typename PoseImplementation>
+struct FrameTransformationTest : public ::testing::Test {
+  typedef PoseImplementation Pose;
+  typedef typename Pose::Scalar Scalar;
+  typedef typename Pose::Position Position;
+  typedef typename Pose::Rotation Rotation;
+  template<typename ToFrame_, typename FromFrame_>
+  using FramePose = kindr::FrameTransformation<ToFrame_, FromFrame_, Pose>;
+
+  const Pose poseWB = Pose(Position(Scalar(1.0), Scalar(2.0), Scalar(3.0)), Rotation(kindr::EulerAnglesZyx<Scalar>(Scalar(0.5), Scalar(1.2), Scalar(-1.7))));
+  const Pose poseBI = Pose(Position(Scalar(-0.4), Scalar(0.1), Scalar(0.7)), Rotation(kindr::EulerAnglesZyx<Scalar>(Scalar(-0.3), Scalar(0.2), Scalar(0.9))));
+  const Pose poseIC = Pose(Position(Scalar(0.05), Scalar(-0.2), Scalar(0.1)), Rotation(kindr::EulerAnglesZyx<Scalar>(Scalar(1.1), Scalar(-0.6), Scalar(0.4))));
+  const Position position = Position(Scalar(0.3), Scalar(-1.5), Scalar(0.6));
+};
+
+TYPED_TEST_CASE(FrameTransformationTest, Types);
+
+TYPED_TEST(FrameTransformationTest, testSizeIsUnchanged)
+{
+  typedef typename TestFixture::Pose Pose;
+  ASSERT_EQ(sizeof(Pose), (sizeof(typename TestFixture::template FramePose<World, Base>)));
+}
+
+TYPED_TEST(FrameTransformationTest, testChainEvaluation)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Pose Pose;
+
+  const typename TestFixture::template FramePose<World, Base> T_WB(this->poseWB);
+  const typename TestFixture::template FramePose<Base, Imu> T_BI(this->poseBI);
+  const typename TestFixture::template FramePose<Imu, Camera> T_IC(this->poseIC);
+
+  const Pose expected = this->poseWB*this->poseBI*this->poseIC;
+  const typename TestFixture::template FramePose<World, Camera> T_WC = T_WB*T_BI*T_IC;
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected.getTransformationMatrix(), T_WC.getTransformation().getTransformationMatrix(), Scalar(1e-5), Scalar(1e-4), "left associative chain");
+
+  typename TestFixture::template FramePose<World, Camera> T_WC2;
+  T_WC2 = T_WB*(T_BI*T_IC);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected.getTransformationMatrix(), T_WC2.getTransformation().getTransformationMatrix(), Scalar(1e-5), Scalar(1e-4), "right associative chain");
+}
+
+TYPED_TEST(FrameTransformationTest, testChainTransform)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Position Position;
+
+  const typename TestFixture::template FramePose<World, Base> T_WB(this->poseWB);
+  const typename TestFixture::template FramePose<Base, Imu> T_BI(this->poseBI);
+  const typename TestFixture::template FramePose<Imu, Camera> T_IC(this->poseIC);
+
+  const Position expected = (this->poseWB*this->poseBI*this->poseIC).transform(this->position);
+  const Position transformed = (T_WB*T_BI*T_IC).transform(this->position);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected.toImplementation(), transformed.toImplementation(), Scalar(1e-5), Scalar(1e-4), "chain transform");
+}
+
+TYPED_TEST(FrameTransformationTest, testInversion)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Pose Pose;
+
+  const typename TestFixture::template FramePose<World, Base> T_WB(this->poseWB);
+  const typename TestFixture::template FramePose<Base, World> T_BW = T_WB.inverted();
+  const typename TestFixture::template FramePose<World, World> T_WW = T_WB*T_BW;
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(Pose().getTransformationMatrix(), T_WW.getTransformation().getTransformationMatrix(), Scalar(1e-5), Scalar(1e-4), "inversion");
+}
+
+TEST(FrameTransformationRotationTest, testMixedRotationChain)
+{
+  const kindr::RotationQuaternionD rotationWB(kindr::EulerAnglesZyxD(0.5, 1.2, -1.7));
+  const kindr::RotationMatrixD rotationBC(kindr::EulerAnglesZyxD(-0.3, 0.2, 0.9));
+  const kindr::FrameRotationQuaternionD<World, Base> R_WB(rotationWB);
+  const kindr::FrameRotationMatrixD<Base, Camera> R_BC(rotationBC);
+
+  const kindr::FrameRotationQuaternionD<World, Camera> R_WC = R_WB*R_BC;
+  ASSERT_TRUE(R_WC.getTransformation().isNear(rotationWB*kindr::RotationQuaternionD(rotationBC), 1e-10));
+
+  const Eigen::Vector3d vector(0.3, -1.5, 0.6);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(R_WC.getTransformation().rotate(vector), (R_WB*R_BC).transform(vector), 1e-10, 1e-10, "chain rotate");
+}
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/poses/Pose.hpp"
+#include "kindr/poses/PoseDiff.hpp"
+#include "kindr/phys_quant/PhysicalQuantities.hpp"
+#include "kindr/common/gtest_eigen.hpp"
+
+typedef ::testing::Types<
+    float,
+    double
+> PrimTypes;
+
+template <typename PrimType_>
+struct HomogeneousTransformation2DTest : public ::testing::Test {
+  typedef PrimType_ Scalar;
+  typedef kindr::HomogeneousTransformation2D<Scalar> Pose;
+  typedef typename Pose::Position Position;
+  typedef typename Pose::Vector3 Vector3;
+  typedef Eigen::Matrix<Scalar, 2, 1> Vector2;
+
+  const Pose poseA = Pose(Scalar(1.0), Scalar(-2.0), Scalar(0.6));
+  const Pose poseB = Pose(Scalar(-0.5), Scalar(0.3), Scalar(2.8));
+  const Position position = Position(Vector2(Scalar(0.4), Scalar(1.2)));
+};
+
+TYPED_TEST_CASE(HomogeneousTransformation2DTest, PrimTypes);
+
+TYPED_TEST(HomogeneousTransformation2DTest, testTransform)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Pose Pose;
+  typedef typename TestFixture::Position Position;
+
+  const Eigen::Matrix<Scalar, 3, 1> homogeneous(this->position(0), this->position(1), Scalar(1));
+  const Eigen::Matrix<Scalar, 3, 1> expected = this->poseA.getTransformationMatrix()*homogeneous;
+  const Position transformed = this->poseA.transform(this->position);
+  ASSERT_NEAR(transformed(0), expected(0), 1e-5);
+  ASSERT_NEAR(transformed(1), expected(1), 1e-5);
+  const Position back = this->poseA.inverseTransform(transformed);
+  ASSERT_NEAR(back(0), this->position(0), 1e-5);
+  ASSERT_NEAR(back(1), this->position(1), 1e-5);
+
+  // batch
+  Eigen::Matrix<Scalar, 2, Eigen::Dynamic> points = Eigen::Matrix<Scalar, 2, Eigen::Dynamic>::Random(2, 9);
+  const Eigen::Matrix<Scalar, 2, Eigen::Dynamic> transformedPoints = this->poseA.transform(points);
+  ASSERT_NEAR(transformedPoints(0, 3), this->poseA.transform(Position(Eigen::Matrix<Scalar, 2, 1>(points.col(3))))(0), 1e-5);
+  ASSERT_TRUE(this->poseA.inverseTransform(transformedPoints).isApprox(points, Scalar(1e-4)));
+
+  // concatenation and inverse
+  const Pose poseAB = this->poseA*this->poseB;
+  ASSERT_TRUE(poseAB.getTransformationMatrix().isApprox(this->poseA.getTransformationMatrix()*this->poseB.getTransformationMatrix(), Scalar(1e-5)));
+  ASSERT_TRUE((this->poseA*this->poseA.inverted()).isNear(Pose(), 1e-5));
+}
+
+TYPED_TEST(HomogeneousTransformation2DTest, testConversions3D)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Pose Pose;
+  typedef kindr::HomTransformQuat<Scalar> Pose3D;
+
+  const Pose3D pose3D = this->poseA.template getTransformation3D<>();
+  const kindr::Position<Scalar, 3> position3D(this->position(0), this->position(1), Scalar(0));
+  const kindr::Position<Scalar, 3> transformed3D = pose3D.transform(position3D);
+  const typename TestFixture::Position transformed = this->poseA.transform(this->position);
+  ASSERT_NEAR(transformed3D(0), transformed(0), 1e-5);
+  ASSERT_NEAR(transformed3D(1), transformed(1), 1e-5);
+  ASSERT_NEAR(transformed3D(2), Scalar(0), 1e-5);
+  ASSERT_TRUE(Pose(pose3D).isNear(this->poseA, 1e-5));
+  ASSERT_TRUE(Pose(this->poseA.template getTransformation3D<kindr::RotationMatrix<Scalar>>()).isNear(this->poseA, 1e-5));
+}
+
+TYPED_TEST(HomogeneousTransformation2DTest, testMaps)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Pose Pose;
+  typedef typename TestFixture::Vector3 Vector3;
+
+  Pose pose;
+  const Vector3 vector(Scalar(0.5), Scalar(-0.2), Scalar(1.3));
+  const Vector3 log = pose.exponentialMap(vector).logarithmicMap();
+  ASSERT_TRUE(log.isApprox(vector, Scalar(1e-5)));
+  const Vector3 small(Scalar(0.5), Scalar(-0.2), Scalar(1e-9));
+  ASSERT_TRUE(pose.exponentialMap(small).logarithmicMap().isApprox(small, Scalar(1e-5)));
+
+  // exponential map of a pure rotation about the origin
+  ASSERT_TRUE(pose.exponentialMap(Vector3(Scalar(0), Scalar(0), Scalar(0.4))).isNear(Pose(Scalar(0), Scalar(0), Scalar(0.4)), 1e-6));
+
+  // box operations
+  ASSERT_TRUE(this->poseA.boxPlus(this->poseB.boxMinus(this->poseA)).isNear(this->poseB, 1e-4));
+  ASSERT_TRUE(this->poseA.boxPlus(Vector3::Zero()).isNear(this->poseA, 1e-6));
+
+  // interpolation
+  ASSERT_TRUE(this->poseA.interpolate(this->poseB, Scalar(0)).isNear(this->poseA, 1e-5));
+  ASSERT_TRUE(this->poseA.interpolate(this->poseB, Scalar(1)).isNear(this->poseB, 1e-4));
+  const Pose half = this->poseA.interpolate(this->poseB, Scalar(0.5));
+  ASSERT_TRUE(half.interpolate(this->poseB, Scalar(1)).isNear(this->poseB, 1e-4));
+  ASSERT_TRUE((half.boxMinus(this->poseA) - this->poseB.boxMinus(half)).norm() < Scalar(1e-4));
+}
+
+TYPED_TEST(HomogeneousTransformation2DTest, testTwistIntegration)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Pose Pose;
+  typedef kindr::Twist2D<Scalar> Twist2D;
+
+  // driving on a circle with radius 2 for a quarter turn
+  const Twist2D twist(Eigen::Matrix<Scalar, 2, 1>(Scalar(1), Scalar(0)), Scalar(0.5));
+  const Scalar duration = Scalar(M_PI);
+  const Pose pose = Pose().boxPlus(twist.getVector()*duration);
+  ASSERT_TRUE(pose.isNear(Pose(Scalar(2), Scalar(2), Scalar(0.5*M_PI)), 1e-4));
+
+  // 3D twist
+  const kindr::TwistLinearVelocityLocalAngularVelocity<Scalar> twist3D = twist.getTwist3D();
+  ASSERT_NEAR(twist3D.getRotationalVelocity()(2), Scalar(0.5), 1e-6);
+  ASSERT_TRUE(Twist2D(twist3D).getVector().isApprox(twist.getVector()));
+}
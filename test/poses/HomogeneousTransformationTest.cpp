@@ -171,6 +171,30 @@ TYPED_TEST(HomogeneousTransformationTest, testConcatenation)
 }
 
 
+TYPED_TEST(HomogeneousTransformationTest, testInversion)
+{
+  typedef typename TestFixture::Pose Pose;
+  typedef typename TestFixture::Position Position;
+  typedef typename TestFixture::Rotation Rotation;
+  typedef typename TestFixture::Scalar Scalar;
+
+  Pose poseBToA(Position(1.0,2.0,3.0), Rotation(kindr::EulerAnglesZyx<Scalar>(0.5,1.2,-1.7)));
+  Position positionInB(-0.8, 5.0, 1.6);
+
+  Position positionInverted = poseBToA.inverted().transform(positionInB);
+  Position positionInverseTransform = poseBToA.inverseTransform(positionInB);
+  EXPECT_NEAR(positionInverseTransform.x(), positionInverted.x(), 1.0e-3);
+  EXPECT_NEAR(positionInverseTransform.y(), positionInverted.y(), 1.0e-3);
+  EXPECT_NEAR(positionInverseTransform.z(), positionInverted.z(), 1.0e-3);
+
+  Pose poseIdentity = poseBToA;
+  poseIdentity.invert();
+  poseIdentity = poseIdentity*poseBToA;
+  EXPECT_NEAR(0.0, poseIdentity.getPosition().norm(), 1.0e-3);
+  ASSERT_TRUE(poseIdentity.getRotation().isNear(Rotation(), 1.0e-3));
+}
+
+
 TYPED_TEST(HomogeneousTransformationTest, testGenericRotateVectorCompilable)
 {
   typedef typename TestFixture::Pose Pose;
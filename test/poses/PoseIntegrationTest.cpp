@@ -0,0 +1,275 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "kindr/poses/PoseIntegration.hpp"
+#include "kindr/common/gtest_eigen.hpp"
+
+template <typename PrimType_>
+class PoseIntegrationTest : public ::testing::Test {
+ public:
+  typedef PrimType_ Scalar;
+  typedef kindr::HomTransformQuat<Scalar> Pose;
+  typedef kindr::TwistLinearVelocityLocalAngularVelocity<Scalar> Twist;
+  typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+  typedef Eigen::Matrix<Scalar, 6, 1> Vector6;
+  typedef Eigen::Matrix<Scalar, Eigen::Dynamic, 3> MatrixX3;
+  typedef Eigen::Matrix<Scalar, Eigen::Dynamic, 4> MatrixX4;
+
+  PoseIntegrationTest() {
+    kindr::RotationQuaternion<Scalar> rotation;
+    rotation.setRandom();
+    pose = Pose(typename Pose::Position(Scalar(1), Scalar(-2), Scalar(0.5)), rotation);
+    twist = Twist(Vector3(Scalar(0.3), Scalar(-1.2), Scalar(0.8)), Vector3(Scalar(1.5), Scalar(-0.4), Scalar(2.0)));
+  }
+
+  //! Stores poses as rows of the SoA matrices
+  static void setRow(const Pose& pose, Eigen::DenseIndex row, MatrixX3& positions, MatrixX4& quaternions) {
+    positions.row(row) = pose.getPosition().toImplementation().transpose();
+    quaternions.row(row) << pose.getRotation().w(), pose.getRotation().x(), pose.getRotation().y(), pose.getRotation().z();
+  }
+
+  static void expectNear(const Pose& expected, const Pose& actual, double tolerance, const std::string& message) {
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected.getPosition().toImplementation(), actual.getPosition().toImplementation(), tolerance, tolerance, message);
+    EXPECT_LE(expected.getRotation().getDisparityAngle(actual.getRotation()), tolerance) << message;
+  }
+
+  static double getTolerance() {
+    return std::is_same<Scalar, float>::value ? 1.0e-4 : 1.0e-10;
+  }
+
+  Pose pose;
+  Twist twist;
+};
+
+typedef ::testing::Types<float, double> PrimTypes;
+
+TYPED_TEST_CASE(PoseIntegrationTest, PrimTypes);
+
+TYPED_TEST(PoseIntegrationTest, testExactIntegration) {
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Pose Pose;
+  // the exponential map is exact for constant twists, i.e. the time steps can be split
+  const Scalar timeStep = Scalar(0.7);
+  const Pose pose = kindr::integratePose(this->pose, this->twist, timeStep);
+  Pose poseSplit = this->pose;
+  for (int i = 0; i < 7; ++i) {
+    poseSplit = kindr::integratePose(poseSplit, this->twist, timeStep/Scalar(7));
+  }
+  this->expectNear(pose, poseSplit, 10.0*this->getTolerance(), "split");
+
+  // the body twist is the derivative of the pose
+  const Scalar smallTimeStep = Scalar(1.0e-3);
+  const Pose posePlus = kindr::integratePose(this->pose, this->twist, smallTimeStep);
+  const typename TestFixture::Vector3 linearVelocity = this->pose.getRotation().inverseRotate(posePlus.getPosition() - this->pose.getPosition()).toImplementation()/smallTimeStep;
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->twist.getTranslationalVelocity().toImplementation(), linearVelocity, 1.0e-2, 1.0e-2, "velocity");
+
+  // without rotation, the position moves along the rotated velocity
+  const typename TestFixture::Twist translation(this->twist.getTranslationalVelocity().toImplementation(), TestFixture::Vector3::Zero());
+  const Pose translated = kindr::integratePose(this->pose, translation, timeStep);
+  const typename TestFixture::Vector3 expectedPosition = this->pose.getPosition().toImplementation() + timeStep*this->pose.getRotation().rotate(translation.getTranslationalVelocity().toImplementation());
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expectedPosition, translated.getPosition().toImplementation(), this->getTolerance(), this->getTolerance(), "position");
+}
+
+TYPED_TEST(PoseIntegrationTest, testGlobalTwist) {
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Pose Pose;
+  const Scalar timeStep = Scalar(0.1);
+  const kindr::TwistLinearVelocityGlobalAngularVelocity<Scalar> twist(this->twist.getVector());
+  const Pose pose = kindr::integratePose(this->pose, twist, timeStep);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL((this->pose.getPosition().toImplementation() + timeStep*twist.getTranslationalVelocity().toImplementation()),
+                                    pose.getPosition().toImplementation(), this->getTolerance(), this->getTolerance(), "position");
+
+  // the global angular velocity is the local one rotated into the world frame
+  const typename TestFixture::Twist localTwist(TestFixture::Vector3::Zero(), this->pose.getRotation().inverseRotate(twist.getRotationalVelocity().toImplementation()));
+  this->expectNear(kindr::integratePose(this->pose, localTwist, timeStep), Pose(this->pose.getPosition(), pose.getRotation()), 10.0*this->getTolerance(), "rotation");
+}
+
+TYPED_TEST(PoseIntegrationTest, testBatch) {
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Pose Pose;
+  typedef typename TestFixture::Twist Twist;
+  typedef typename TestFixture::MatrixX3 MatrixX3;
+  typedef typename TestFixture::MatrixX4 MatrixX4;
+  std::srand(11);
+  const Eigen::DenseIndex size = 37;
+  const Scalar timeStep = Scalar(0.05);
+  MatrixX3 positions(size, 3);
+  MatrixX4 quaternions(size, 4);
+  MatrixX3 linearVelocities = MatrixX3::Random(size, 3);
+  MatrixX3 angularVelocities = Scalar(5)*MatrixX3::Random(size, 3);
+  // zero and tiny angular velocities use the Taylor expansions
+  angularVelocities.row(3).setZero();
+  angularVelocities.row(4) *= Scalar(1.0e-5);
+  std::vector<Pose, Eigen::aligned_allocator<Pose> > poses;
+  for (Eigen::DenseIndex i = 0; i < size; ++i) {
+    kindr::RotationQuaternion<Scalar> rotation;
+    rotation.setRandom();
+    poses.push_back(Pose(typename Pose::Position(TestFixture::Vector3::Random()), rotation));
+    this->setRow(poses.back(), i, positions, quaternions);
+  }
+  kindr::integratePoses(positions, quaternions, linearVelocities, angularVelocities, timeStep);
+  for (Eigen::DenseIndex i = 0; i < size; ++i) {
+    const Twist twist(typename TestFixture::Vector3(linearVelocities.row(i).transpose()), typename TestFixture::Vector3(angularVelocities.row(i).transpose()));
+    const Pose expected = kindr::integratePose(poses[i], twist, timeStep);
+    const Pose actual(typename Pose::Position(typename TestFixture::Vector3(positions.row(i).transpose())),
+                      kindr::RotationQuaternion<Scalar>(quaternions(i, 0), quaternions(i, 1), quaternions(i, 2), quaternions(i, 3)));
+    this->expectNear(expected, actual, 10.0*this->getTolerance(), "batch");
+  }
+}
+
+TYPED_TEST(PoseIntegrationTest, testBatchRollout) {
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::MatrixX3 MatrixX3;
+  typedef typename TestFixture::MatrixX4 MatrixX4;
+  std::srand(13);
+  const Eigen::DenseIndex size = 40;
+  MatrixX3 positions = MatrixX3::Zero(size, 3);
+  MatrixX4 quaternions = MatrixX4::Zero(size, 4);
+  quaternions.col(0).setOnes();
+  const MatrixX3 linearVelocities = MatrixX3::Random(size, 3);
+  const MatrixX3 angularVelocities = Scalar(5)*MatrixX3::Random(size, 3);
+  // the quaternions are fed back tick after tick and must stay normalized
+  for (int k = 0; k < 10000; ++k) {
+    kindr::integratePoses(positions, quaternions, linearVelocities, angularVelocities, Scalar(0.01));
+  }
+  EXPECT_LT((quaternions.rowwise().norm().array() - Scalar(1)).abs().maxCoeff(), Scalar(10)*std::numeric_limits<Scalar>::epsilon());
+}
+
+TYPED_TEST(PoseIntegrationTest, testStream) {
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Pose Pose;
+  typedef typename TestFixture::Twist Twist;
+  typedef typename TestFixture::MatrixX3 MatrixX3;
+  typedef typename TestFixture::MatrixX4 MatrixX4;
+  std::srand(13);
+  const Eigen::DenseIndex size = 50;
+  const Scalar timeStep = Scalar(0.01);
+  const MatrixX3 linearVelocities = MatrixX3::Random(size, 3);
+  const MatrixX3 angularVelocities = Scalar(3)*MatrixX3::Random(size, 3);
+  MatrixX3 positions(size, 3);
+  MatrixX4 quaternions(size, 4);
+  const Pose last = kindr::integratePoseStream(this->pose, linearVelocities, angularVelocities, timeStep, positions, quaternions);
+
+  Pose pose = this->pose;
+  for (Eigen::DenseIndex k = 0; k < size; ++k) {
+    pose = kindr::integratePose(pose, Twist(typename TestFixture::Vector3(linearVelocities.row(k).transpose()), typename TestFixture::Vector3(angularVelocities.row(k).transpose())), timeStep);
+    const Pose actual(typename Pose::Position(typename TestFixture::Vector3(positions.row(k).transpose())),
+                      kindr::RotationQuaternion<Scalar>(quaternions(k, 0), quaternions(k, 1), quaternions(k, 2), quaternions(k, 3)));
+    this->expectNear(pose, actual, 100.0*this->getTolerance(), "stream");
+  }
+  this->expectNear(pose, last, 100.0*this->getTolerance(), "last");
+}
+
+namespace {
+
+//! Time-varying body twist
+kindr::TwistLinearVelocityLocalAngularVelocityD getTwist(double time) {
+  return kindr::TwistLinearVelocityLocalAngularVelocityD(Eigen::Vector3d(1.0 + time, std::sin(3.0*time), 0.5),
+                                                        Eigen::Vector3d(std::cos(2.0*time), 0.8*time, 1.0 - time*time));
+}
+
+enum class IntegrationScheme {
+  Trapezoidal,
+  Midpoint,
+  RungeKutta4
+};
+
+//! Error of the integration over the unit interval
+double getIntegrationError(IntegrationScheme scheme, const kindr::HomTransformQuatD& pose, const kindr::HomTransformQuatD& reference, int numberOfSteps) {
+  const double timeStep = 1.0/numberOfSteps;
+  kindr::HomTransformQuatD integrated = pose;
+  for (int k = 0; k < numberOfSteps; ++k) {
+    const double time = k*timeStep;
+    switch (scheme) {
+      case IntegrationScheme::Trapezoidal:
+        integrated = kindr::integratePoseTrapezoidal(integrated, getTwist(time), getTwist(time + timeStep), timeStep);
+        break;
+      case IntegrationScheme::Midpoint:
+        integrated = kindr::integratePoseMidpoint(integrated, getTwist(time + 0.5*timeStep), timeStep);
+        break;
+      case IntegrationScheme::RungeKutta4:
+        integrated = kindr::integratePoseRungeKutta4(integrated, getTwist(time), getTwist(time + 0.5*timeStep), getTwist(time + timeStep), timeStep);
+        break;
+    }
+  }
+  return (integrated.getPosition() - reference.getPosition()).norm() + integrated.getRotation().getDisparityAngle(reference.getRotation());
+}
+
+} // namespace
+
+TEST(PoseIntegrationOrderTest, testOrder) {
+  const kindr::HomTransformQuatD pose(kindr::Position3D(0.1, 0.2, 0.3), kindr::RotationQuaternionD(kindr::EulerAnglesZyxD(0.3, -0.2, 0.1)));
+  // reference with many small fourth-order steps
+  kindr::HomTransformQuatD reference = pose;
+  const int numberOfReferenceSteps = 4000;
+  for (int k = 0; k < numberOfReferenceSteps; ++k) {
+    const double timeStep = 1.0/numberOfReferenceSteps;
+    const double time = k*timeStep;
+    reference = kindr::integratePoseRungeKutta4(reference, getTwist(time), getTwist(time + 0.5*timeStep), getTwist(time + timeStep), timeStep);
+  }
+  // halving the time step reduces the errors by 4 and 16
+  const double trapezoidalError = getIntegrationError(IntegrationScheme::Trapezoidal, pose, reference, 20);
+  const double trapezoidalErrorHalf = getIntegrationError(IntegrationScheme::Trapezoidal, pose, reference, 40);
+  EXPECT_NEAR(4.0, trapezoidalError/trapezoidalErrorHalf, 0.5);
+  const double midpointError = getIntegrationError(IntegrationScheme::Midpoint, pose, reference, 20);
+  const double midpointErrorHalf = getIntegrationError(IntegrationScheme::Midpoint, pose, reference, 40);
+  EXPECT_NEAR(4.0, midpointError/midpointErrorHalf, 0.5);
+  const double rungeKuttaError = getIntegrationError(IntegrationScheme::RungeKutta4, pose, reference, 20);
+  const double rungeKuttaErrorHalf = getIntegrationError(IntegrationScheme::RungeKutta4, pose, reference, 40);
+  EXPECT_NEAR(16.0, rungeKuttaError/rungeKuttaErrorHalf, 2.0);
+  EXPECT_LT(rungeKuttaError, trapezoidalError);
+  EXPECT_LT(rungeKuttaError, midpointError);
+}
+
+TEST(PoseIntegrationPrecisionTest, testFloatAtSmallAngles) {
+  // The closed forms of the exponential map cancel in float just above the small-angle branch.
+  const Eigen::Vector3d axis = Eigen::Vector3d(0.3, -0.8, 0.5).normalized();
+  const Eigen::Vector3d linearVelocity(0.9, 0.7, -1.1);
+  const double angles[] = {0.0, 1.0e-3, 5.0e-3, 9.9e-3, 1.01e-2, 1.03e-2, 1.06e-2, 1.1e-2, 1.5e-2, 1.8e-2, 2.0e-2, 5.0e-2, 0.5};
+  const Eigen::DenseIndex size = sizeof(angles)/sizeof(angles[0]);
+  Eigen::Matrix<float, Eigen::Dynamic, 3> linearVelocities(size, 3);
+  Eigen::Matrix<float, Eigen::Dynamic, 3> angularVelocities(size, 3);
+  for (Eigen::DenseIndex i = 0; i < size; ++i) {
+    linearVelocities.row(i) = linearVelocity.transpose().cast<float>();
+    angularVelocities.row(i) = (angles[i]*axis).transpose().cast<float>();
+  }
+  Eigen::Matrix<float, Eigen::Dynamic, 3> positions = Eigen::Matrix<float, Eigen::Dynamic, 3>::Zero(size, 3);
+  Eigen::Matrix<float, Eigen::Dynamic, 4> quaternions(size, 4);
+  quaternions.col(0).setOnes();
+  quaternions.rightCols(3).setZero();
+  Eigen::Matrix<double, Eigen::Dynamic, 3> positionsD = positions.cast<double>();
+  Eigen::Matrix<double, Eigen::Dynamic, 4> quaternionsD = quaternions.cast<double>();
+  kindr::integratePoses(positions, quaternions, linearVelocities, angularVelocities, 1.0f);
+  kindr::integratePoses(positionsD, quaternionsD, linearVelocities.cast<double>(), angularVelocities.cast<double>(), 1.0);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(positionsD, positions.cast<double>(), 3.0e-7, 3.0e-7, "positions");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(quaternionsD, quaternions.cast<double>(), 3.0e-7, 3.0e-7, "quaternions");
+}
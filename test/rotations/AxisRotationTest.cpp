@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/rotations/Rotation.hpp"
+#include "kindr/phys_quant/PhysicalQuantities.hpp"
+#include "kindr/common/gtest_eigen.hpp"
+
+typedef ::testing::Types<
+    float,
+    double
+> PrimTypes;
+
+template <typename PrimType_>
+struct AxisRotationTest : public ::testing::Test {
+  typedef PrimType_ Scalar;
+  typedef kindr::RotationQuaternion<Scalar> RotationQuaternion;
+  typedef kindr::RotationMatrix<Scalar> RotationMatrix;
+  typedef kindr::EulerAnglesZyx<Scalar> EulerAnglesZyx;
+  typedef Eigen::Matrix<Scalar, 3, 1> Vector;
+  typedef Eigen::Matrix<Scalar, 3, Eigen::Dynamic> Matrix3X;
+
+  const RotationQuaternion rotation = RotationQuaternion(EulerAnglesZyx(Scalar(0.3), Scalar(-0.7), Scalar(1.2)));
+  const Vector vector = Vector(Scalar(0.3), Scalar(-1.5), Scalar(0.6));
+  const Scalar angle = Scalar(0.8);
+};
+
+TYPED_TEST_CASE(AxisRotationTest, PrimTypes);
+
+TYPED_TEST(AxisRotationTest, testConstructors)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::RotationMatrix RotationMatrix;
+
+  const kindr::AxisRotationZ<Scalar> identity;
+  ASSERT_EQ(identity.axis(), 2);
+  ASSERT_EQ(identity.angle(), Scalar(0));
+  ASSERT_EQ(identity.getCosAngle(), Scalar(1));
+
+  const kindr::AxisRotationX<Scalar> rotationX(this->angle);
+  ASSERT_NEAR(rotationX.getSinAngle(), std::sin(this->angle), 1e-6);
+  ASSERT_NEAR(rotationX.getCosAngle(), std::cos(this->angle), 1e-6);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(RotationMatrix(rotationX).matrix(), RotationMatrix(kindr::AngleAxis<Scalar>(this->angle, 1, 0, 0)).matrix(), 1e-5, 1e-4, "x");
+
+  const kindr::AxisRotationDyn<Scalar> rotationY(1, this->angle);
+  ASSERT_EQ(rotationY.axis(), 1);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(RotationMatrix(rotationY).matrix(), RotationMatrix(kindr::AngleAxis<Scalar>(this->angle, 0, 1, 0)).matrix(), 1e-5, 1e-4, "y");
+
+  // projection of another rotation onto the axis
+  const kindr::AxisRotationZ<Scalar> projected(kindr::AngleAxis<Scalar>(this->angle, 0, 0, 1));
+  ASSERT_NEAR(projected.angle(), this->angle, 1e-5);
+  const kindr::AxisRotationDyn<Scalar> projectedDyn = kindr::AxisRotationDyn<Scalar>(kindr::RotationVector<Scalar>(Scalar(0.01), this->angle, Scalar(-0.02)));
+  ASSERT_EQ(projectedDyn.axis(), 1);
+}
+
+TYPED_TEST(AxisRotationTest, testConversions)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::RotationQuaternion RotationQuaternion;
+
+  for (int axis = 0; axis < 3; ++axis) {
+    const kindr::AxisRotationDyn<Scalar> rotation(axis, this->angle);
+    const RotationQuaternion reference(kindr::AngleAxis<Scalar>(this->angle, rotation.getAxis()));
+    ASSERT_TRUE(RotationQuaternion(rotation).isNear(reference, 1e-5));
+    ASSERT_TRUE(kindr::RotationVector<Scalar>(rotation).isNear(reference, 1e-5));
+    ASSERT_TRUE(kindr::EulerAnglesZyx<Scalar>(rotation).isNear(reference, 1e-5));
+    ASSERT_TRUE(kindr::EulerAnglesXyz<Scalar>(rotation).isNear(reference, 1e-5));
+    ASSERT_TRUE(kindr::EulerAnglesZyz<Scalar>(rotation).isNear(reference, 1e-5));
+    ASSERT_TRUE(kindr::AngleAxis<Scalar>(rotation).isNear(reference, 1e-5));
+  }
+}
+
+TYPED_TEST(AxisRotationTest, testConversionBetweenAxes)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  const kindr::AxisRotationY<Scalar> rotationY(this->angle);
+  const kindr::AxisRotationDyn<Scalar> rotationDyn(rotationY);
+  ASSERT_EQ(rotationDyn.axis(), 1);
+  ASSERT_EQ(rotationDyn.angle(), this->angle);
+  ASSERT_EQ(kindr::AxisRotationY<Scalar>(rotationDyn).angle(), this->angle);
+  // the projection onto an orthogonal axis would discard the whole rotation
+  ASSERT_THROW(kindr::AxisRotationZ<Scalar>{rotationY}, std::runtime_error);
+  ASSERT_THROW(kindr::AxisRotationX<Scalar>{rotationDyn}, std::runtime_error);
+}
+
+TYPED_TEST(AxisRotationTest, testQuaternionFromCachedSineAndCosine)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::RotationQuaternion RotationQuaternion;
+  const Scalar pi = Scalar(M_PI);
+  for (Scalar angle : {Scalar(0), Scalar(1e-4), this->angle, Scalar(0.5)*pi, pi - Scalar(1e-3), pi, pi + Scalar(1e-3), Scalar(4), -Scalar(2)}) {
+    for (int axis = 0; axis < 3; ++axis) {
+      const kindr::AxisRotationDyn<Scalar> rotation(axis, angle);
+      const Eigen::Quaternion<Scalar> q = rotation.getQuaternion();
+      ASSERT_GE(q.w(), Scalar(0));
+      ASSERT_NEAR(q.norm(), Scalar(1), 1e-6);
+      ASSERT_TRUE(RotationQuaternion(q).isNear(RotationQuaternion(kindr::AngleAxis<Scalar>(angle, rotation.getAxis())), 1e-5));
+    }
+  }
+}
+
+TYPED_TEST(AxisRotationTest, testConcatenation)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::RotationQuaternion RotationQuaternion;
+  typedef typename TestFixture::RotationMatrix RotationMatrix;
+
+  for (int axis = 0; axis < 3; ++axis) {
+    const kindr::AxisRotationDyn<Scalar> rotationA(axis, this->angle);
+    const RotationQuaternion quaternionA(rotationA);
+
+    // rotation matrix with the axis rotation on both sides
+    const RotationMatrix matrixRight = RotationMatrix(this->rotation)*rotationA;
+    const RotationMatrix matrixLeft = rotationA*RotationMatrix(this->rotation);
+    ASSERT_TRUE(matrixRight.isNear(this->rotation*quaternionA, 1e-5));
+    ASSERT_TRUE(matrixLeft.isNear(quaternionA*this->rotation, 1e-5));
+
+    // quaternion with the axis rotation on both sides
+    const RotationQuaternion quaternionRight = this->rotation*rotationA;
+    const RotationQuaternion quaternionLeft = rotationA*this->rotation;
+    ASSERT_TRUE(quaternionRight.isNear(this->rotation*quaternionA, 1e-5));
+    ASSERT_TRUE(quaternionLeft.isNear(quaternionA*this->rotation, 1e-5));
+
+    // other rotation types keep their type
+    const kindr::EulerAnglesZyx<Scalar> euler = kindr::EulerAnglesZyx<Scalar>(this->rotation)*rotationA;
+    ASSERT_TRUE(euler.isNear(this->rotation*quaternionA, 1e-5));
+  }
+
+  // rotations about the same fixed axis add their angles
+  const kindr::AxisRotationY<Scalar> rotationY = kindr::AxisRotationY<Scalar>(this->angle)*kindr::AxisRotationY<Scalar>(Scalar(-0.3));
+  ASSERT_NEAR(rotationY.angle(), this->angle - Scalar(0.3), 1e-6);
+  ASSERT_NEAR(rotationY.getSinAngle(), std::sin(this->angle - Scalar(0.3)), 1e-6);
+
+  // rotations about different axes yield a quaternion
+  const RotationQuaternion rotationXZ = kindr::AxisRotationX<Scalar>(this->angle)*kindr::AxisRotationZ<Scalar>(this->angle);
+  ASSERT_TRUE(rotationXZ.isNear(RotationQuaternion(kindr::AxisRotationX<Scalar>(this->angle))*RotationQuaternion(kindr::AxisRotationZ<Scalar>(this->angle)), 1e-5));
+}
+
+TYPED_TEST(AxisRotationTest, testRotateVector)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::RotationMatrix RotationMatrix;
+  typedef typename TestFixture::Matrix3X Matrix3X;
+
+  for (int axis = 0; axis < 3; ++axis) {
+    const kindr::AxisRotationDyn<Scalar> rotation(axis, this->angle);
+    const RotationMatrix matrix(rotation);
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(rotation.rotate(this->vector), matrix.rotate(this->vector), 1e-5, 1e-4, "rotate");
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(rotation.inverseRotate(this->vector), matrix.inverseRotate(this->vector), 1e-5, 1e-4, "inverseRotate");
+
+    const Matrix3X points = Matrix3X::Random(3, 5);
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(rotation.rotate(points), Matrix3X(matrix.matrix()*points), 1e-5, 1e-4, "rotate batch");
+
+    const kindr::Position<Scalar, 3> position(this->vector);
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(rotation.rotate(position).toImplementation(), matrix.rotate(this->vector), 1e-5, 1e-4, "rotate position");
+  }
+}
+
+TYPED_TEST(AxisRotationTest, testInverseAndUnique)
+{
+  typedef typename TestFixture::Scalar Scalar;
+
+  const kindr::AxisRotationZ<Scalar> rotation(Scalar(4.0));
+  ASSERT_TRUE((rotation*rotation.inverted()).isNear(kindr::AxisRotationZ<Scalar>(), 1e-6));
+  ASSERT_NEAR(rotation.getUnique().angle(), Scalar(4.0 - 2.0*M_PI), 1e-5);
+  ASSERT_TRUE(rotation == rotation.getUnique());
+  ASSERT_TRUE(rotation.isNear(kindr::RotationQuaternion<Scalar>(rotation), 1e-5));
+}
+
+TYPED_TEST(AxisRotationTest, testMaps)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Vector Vector;
+
+  const kindr::AxisRotationY<Scalar> rotation(this->angle);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(rotation.logarithmicMap(), Vector(Scalar(0), this->angle, Scalar(0)), 1e-5, 1e-4, "log");
+  kindr::AxisRotationY<Scalar> mapped;
+  ASSERT_NEAR(mapped.exponentialMap(Vector(Scalar(0.1), Scalar(0.2), Scalar(0.3))).angle(), Scalar(0.2), 1e-6);
+
+  const kindr::AxisRotationY<Scalar> perturbed = rotation.boxPlus(Vector(Scalar(0), Scalar(0.1), Scalar(0)));
+  ASSERT_NEAR(perturbed.angle(), this->angle + Scalar(0.1), 1e-6);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(perturbed.boxMinus(rotation), Vector(Scalar(0), Scalar(0.1), Scalar(0)), 1e-5, 1e-4, "boxMinus");
+}
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/rotations/CachedRotation.hpp"
+#include "kindr/phys_quant/PhysicalQuantities.hpp"
+#include "kindr/common/gtest_eigen.hpp"
+
+typedef ::testing::Types<
+    float,
+    double
+> PrimTypes;
+
+template <typename PrimType_>
+struct CachedRotationTest : public ::testing::Test {
+  typedef PrimType_ Scalar;
+  typedef kindr::CachedRotation<Scalar> CachedRotation;
+  typedef kindr::RotationQuaternion<Scalar> RotationQuaternion;
+  typedef kindr::RotationMatrix<Scalar> RotationMatrix;
+  typedef kindr::EulerAnglesZyx<Scalar> EulerAnglesZyx;
+  typedef Eigen::Matrix<Scalar, 3, 1> Vector;
+
+  const EulerAnglesZyx eulerA = EulerAnglesZyx(Scalar(0.3), Scalar(-0.7), Scalar(1.2));
+  const EulerAnglesZyx eulerB = EulerAnglesZyx(Scalar(-1.1), Scalar(0.4), Scalar(0.2));
+  const RotationQuaternion rotationA = RotationQuaternion(eulerA);
+  const RotationQuaternion rotationB = RotationQuaternion(eulerB);
+  const Vector vector = Vector(Scalar(0.3), Scalar(-1.5), Scalar(0.6));
+};
+
+TYPED_TEST_CASE(CachedRotationTest, PrimTypes);
+
+TYPED_TEST(CachedRotationTest, testLazyCaching)
+{
+  typedef typename TestFixture::CachedRotation CachedRotation;
+  typedef typename TestFixture::RotationMatrix RotationMatrix;
+
+  const CachedRotation fromQuaternion(this->rotationA);
+  ASSERT_TRUE(fromQuaternion.isValid(CachedRotation::QUATERNION));
+  ASSERT_FALSE(fromQuaternion.isValid(CachedRotation::MATRIX));
+  ASSERT_FALSE(fromQuaternion.isValid(CachedRotation::EULER_ANGLES_ZYX));
+  ASSERT_TRUE(fromQuaternion.getRotationMatrix().isNear(RotationMatrix(this->rotationA), 1e-5));
+  ASSERT_TRUE(fromQuaternion.isValid(CachedRotation::MATRIX));
+  ASSERT_TRUE(fromQuaternion.getEulerAnglesZyx().isNear(this->eulerA, 1e-5));
+  ASSERT_TRUE(fromQuaternion.isValid(CachedRotation::EULER_ANGLES_ZYX));
+
+  const CachedRotation fromEulerAngles(this->eulerA);
+  ASSERT_FALSE(fromEulerAngles.isValid(CachedRotation::QUATERNION));
+  ASSERT_TRUE(fromEulerAngles.getRotationQuaternion().isNear(this->rotationA, 1e-5));
+
+  const CachedRotation fromAngleAxis(kindr::AngleAxis<typename TestFixture::Scalar>(this->rotationB));
+  ASSERT_TRUE(fromAngleAxis.isValid(CachedRotation::QUATERNION));
+  CachedRotation rotation(RotationMatrix(this->rotationB));
+  ASSERT_TRUE(rotation.isValid(CachedRotation::MATRIX));
+  ASSERT_FALSE(rotation.isValid(CachedRotation::QUATERNION));
+  rotation.getEulerAnglesZyx();
+  rotation.setRotationQuaternion(this->rotationA);
+  ASSERT_FALSE(rotation.isValid(CachedRotation::MATRIX));
+  ASSERT_FALSE(rotation.isValid(CachedRotation::EULER_ANGLES_ZYX));
+  ASSERT_TRUE(rotation.getEulerAnglesZyx().isNear(this->eulerA, 1e-5));
+}
+
+TYPED_TEST(CachedRotationTest, testConversion)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::CachedRotation CachedRotation;
+  const CachedRotation rotation(this->eulerA);
+  ASSERT_TRUE(kindr::RotationQuaternion<Scalar>(rotation).isNear(this->rotationA, 1e-5));
+  ASSERT_TRUE(kindr::RotationMatrix<Scalar>(rotation).isNear(kindr::RotationMatrix<Scalar>(this->rotationA), 1e-5));
+  ASSERT_TRUE(kindr::EulerAnglesZyx<Scalar>(rotation).isNear(this->eulerA, 1e-5));
+  ASSERT_TRUE(kindr::AngleAxis<Scalar>(rotation).isNear(kindr::AngleAxis<Scalar>(this->rotationA), 1e-5));
+  ASSERT_TRUE(kindr::CachedRotation<double>(rotation).getRotationQuaternion().isNear(kindr::RotationQuaternion<double>(this->rotationA), 1e-5));
+
+  CachedRotation assigned;
+  assigned = kindr::RotationVector<Scalar>(this->rotationB);
+  ASSERT_TRUE(assigned.isNear(this->rotationB, 1e-5));
+}
+
+TYPED_TEST(CachedRotationTest, testConcatenation)
+{
+  typedef typename TestFixture::CachedRotation CachedRotation;
+  typedef typename TestFixture::RotationMatrix RotationMatrix;
+  const typename TestFixture::RotationQuaternion expected = this->rotationA*this->rotationB;
+
+  const CachedRotation quaternionProduct = CachedRotation(this->rotationA)*CachedRotation(this->rotationB);
+  ASSERT_TRUE(quaternionProduct.isValid(CachedRotation::QUATERNION));
+  ASSERT_TRUE(quaternionProduct.getRotationQuaternion().isNear(expected, 1e-5));
+
+  const CachedRotation matrixProduct = CachedRotation(RotationMatrix(this->rotationA))*CachedRotation(RotationMatrix(this->rotationB));
+  ASSERT_TRUE(matrixProduct.isValid(CachedRotation::MATRIX));
+  ASSERT_FALSE(matrixProduct.isValid(CachedRotation::QUATERNION));
+  ASSERT_TRUE(matrixProduct.getRotationQuaternion().isNear(expected, 1e-5));
+
+  const CachedRotation mixedProduct = CachedRotation(this->eulerA)*this->rotationB;
+  ASSERT_TRUE(mixedProduct.isNear(expected, 1e-5));
+}
+
+TYPED_TEST(CachedRotationTest, testRotationAndInversion)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::CachedRotation CachedRotation;
+  typedef typename TestFixture::Vector Vector;
+  const Vector expected = this->rotationA.rotate(this->vector);
+
+  const CachedRotation rotation(this->rotationA);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected, rotation.rotate(this->vector), 1e-5, 1e-4, "quaternion");
+  ASSERT_FALSE(rotation.isValid(CachedRotation::MATRIX));
+
+  Eigen::Matrix<Scalar, 3, Eigen::Dynamic> vectors(3, 2);
+  vectors << this->vector, -this->vector;
+  const Eigen::Matrix<Scalar, 3, Eigen::Dynamic> rotated = rotation.rotate(vectors);
+  ASSERT_TRUE(rotation.isValid(CachedRotation::MATRIX));
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected, rotated.col(0), 1e-5, 1e-4, "matrix");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected, rotation.rotate(this->vector), 1e-5, 1e-4, "cached matrix");
+
+  const kindr::Position<Scalar, 3> position(this->vector);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected, rotation.rotate(position).toImplementation(), 1e-5, 1e-4, "position");
+
+  const CachedRotation inverse = rotation.inverted();
+  ASSERT_TRUE(inverse.isValid(CachedRotation::QUATERNION));
+  ASSERT_TRUE(inverse.isValid(CachedRotation::MATRIX));
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->vector, inverse.rotate(expected), 1e-5, 1e-4, "inverse");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->vector, rotation.inverseRotate(expected), 1e-5, 1e-4, "inverse rotate");
+  ASSERT_TRUE(CachedRotation(this->eulerA).inverted().isNear(this->rotationA.inverted(), 1e-5));
+}
+
+TYPED_TEST(CachedRotationTest, testComparisonAndMaps)
+{
+  typedef typename TestFixture::CachedRotation CachedRotation;
+  const CachedRotation rotation(this->rotationA);
+  ASSERT_TRUE(rotation == CachedRotation(this->rotationA));
+  ASSERT_TRUE(rotation.isNear(CachedRotation(this->eulerA), 1e-5));
+  ASSERT_FALSE(rotation.isNear(CachedRotation(this->eulerB), 1e-5));
+
+  const typename TestFixture::Vector vector = rotation.logarithmicMap();
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->rotationA.logarithmicMap(), vector, 1e-5, 1e-4, "log");
+  ASSERT_TRUE(rotation.boxPlus(this->vector).isNear(this->rotationA.boxPlus(this->vector), 1e-5));
+
+  CachedRotation identity(this->rotationB);
+  identity.setIdentity();
+  ASSERT_TRUE(identity.isNear(typename TestFixture::RotationQuaternion(), 1e-6));
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/rotations/ConstantRotation.hpp"
+#include "kindr/rotations/Rotation.hpp"
+#include "kindr/common/gtest_eigen.hpp"
+
+typedef ::testing::Types<
+    float,
+    double
+> PrimTypes;
+
+template <typename PrimType_>
+struct ConstantRotationTest : public ::testing::Test {
+  typedef PrimType_ Scalar;
+  typedef kindr::ConstantPosition<Scalar> ConstantPosition;
+  typedef kindr::ConstantRotationQuaternion<Scalar> ConstantRotationQuaternion;
+  typedef kindr::ConstantRotationMatrix<Scalar> ConstantRotationMatrix;
+  typedef kindr::RotationQuaternion<Scalar> RotationQuaternion;
+  typedef kindr::RotationMatrix<Scalar> RotationMatrix;
+  typedef kindr::Position<Scalar, 3> Position;
+
+  const RotationQuaternion rotationA = RotationQuaternion(kindr::EulerAnglesZyx<Scalar>(Scalar(0.3), Scalar(-0.7), Scalar(1.2)));
+  const RotationQuaternion rotationB = RotationQuaternion(kindr::EulerAnglesZyx<Scalar>(Scalar(-1.1), Scalar(0.4), Scalar(0.2)));
+  const Position position = Position(Scalar(0.3), Scalar(-1.5), Scalar(0.6));
+
+  ConstantRotationQuaternion toConstant(const RotationQuaternion& rotation) const {
+    return ConstantRotationQuaternion(rotation.w(), rotation.x(), rotation.y(), rotation.z());
+  }
+  ConstantRotationMatrix toConstant(const RotationMatrix& rotation) const {
+    const typename RotationMatrix::Implementation& m = rotation.toImplementation();
+    return ConstantRotationMatrix(m(0,0), m(0,1), m(0,2), m(1,0), m(1,1), m(1,2), m(2,0), m(2,1), m(2,2));
+  }
+  ConstantPosition toConstant(const Position& position) const {
+    return ConstantPosition(position.x(), position.y(), position.z());
+  }
+};
+
+TYPED_TEST_CASE(ConstantRotationTest, PrimTypes);
+
+// Quarter turn about z, evaluated at compile time.
+constexpr kindr::ConstantRotationQuaternionD quarterTurnZ(0.70710678118654752, 0.0, 0.0, 0.70710678118654752);
+constexpr kindr::ConstantRotationMatrixD quarterTurnZMatrix(0.0, -1.0, 0.0,
+                                                            1.0,  0.0, 0.0,
+                                                            0.0,  0.0, 1.0);
+constexpr kindr::ConstantPositionD unitX(1.0, 0.0, 0.0);
+constexpr kindr::ConstantPositionD rotatedUnitX = quarterTurnZMatrix.rotate(unitX);
+static_assert(rotatedUnitX.x() == 0.0 && rotatedUnitX.y() == 1.0 && rotatedUnitX.z() == 0.0, "rotate is not evaluated at compile time");
+constexpr kindr::ConstantRotationMatrixD halfTurnZMatrix = quarterTurnZMatrix*quarterTurnZMatrix;
+static_assert(halfTurnZMatrix(0,0) == -1.0 && halfTurnZMatrix(1,1) == -1.0 && halfTurnZMatrix(2,2) == 1.0, "concatenation is not evaluated at compile time");
+constexpr kindr::ConstantRotationQuaternionD halfTurnZ = quarterTurnZ*quarterTurnZ;
+static_assert(halfTurnZ.w() < 1e-15 && halfTurnZ.z() > 1.0 - 1e-15, "concatenation is not evaluated at compile time");
+static_assert(quarterTurnZ.inverted().z() == -quarterTurnZ.z(), "inversion is not evaluated at compile time");
+
+TYPED_TEST(ConstantRotationTest, testDefaultIsIdentity)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::RotationQuaternion RotationQuaternion;
+  typedef typename TestFixture::RotationMatrix RotationMatrix;
+
+  ASSERT_TRUE(typename TestFixture::ConstantRotationQuaternion().toRotation().isNear(RotationQuaternion(), Scalar(1e-6)));
+  ASSERT_TRUE(typename TestFixture::ConstantRotationMatrix().toRotation().isNear(RotationMatrix(), Scalar(1e-6)));
+  const typename TestFixture::Position position = typename TestFixture::ConstantPosition().toPosition();
+  ASSERT_EQ(Scalar(0), position.norm());
+}
+
+TYPED_TEST(ConstantRotationTest, testQuaternionToRotationMatrix)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::RotationMatrix RotationMatrix;
+
+  const RotationMatrix expected(this->rotationA);
+  const RotationMatrix matrix = this->toConstant(this->rotationA).getRotationMatrix().toRotation();
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected.toImplementation(), matrix.toImplementation(), Scalar(1e-5), Scalar(1e-4), "quaternion to matrix");
+}
+
+TYPED_TEST(ConstantRotationTest, testConcatenation)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::RotationQuaternion RotationQuaternion;
+  typedef typename TestFixture::RotationMatrix RotationMatrix;
+
+  const RotationQuaternion expected = this->rotationA*this->rotationB;
+  const RotationQuaternion quaternion = (this->toConstant(this->rotationA)*this->toConstant(this->rotationB)).toRotation();
+  ASSERT_TRUE(quaternion.isNear(expected, Scalar(1e-4)));
+  const RotationMatrix matrix = (this->toConstant(RotationMatrix(this->rotationA))*this->toConstant(RotationMatrix(this->rotationB))).toRotation();
+  ASSERT_TRUE(RotationQuaternion(matrix).isNear(expected, Scalar(1e-4)));
+}
+
+TYPED_TEST(ConstantRotationTest, testInversion)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::RotationQuaternion RotationQuaternion;
+  typedef typename TestFixture::RotationMatrix RotationMatrix;
+
+  const RotationQuaternion expected = this->rotationA.inverted();
+  ASSERT_TRUE(this->toConstant(this->rotationA).inverted().toRotation().isNear(expected, Scalar(1e-4)));
+  ASSERT_TRUE(RotationQuaternion(this->toConstant(RotationMatrix(this->rotationA)).inverted().toRotation()).isNear(expected, Scalar(1e-4)));
+}
+
+TYPED_TEST(ConstantRotationTest, testRotate)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Position Position;
+  typedef typename TestFixture::RotationMatrix RotationMatrix;
+
+  const Position expected = this->rotationA.rotate(this->position);
+  const Position rotatedByQuaternion = this->toConstant(this->rotationA).rotate(this->toConstant(this->position)).toPosition();
+  const Position rotatedByMatrix = this->toConstant(RotationMatrix(this->rotationA)).rotate(this->toConstant(this->position)).toPosition();
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected.toImplementation(), rotatedByQuaternion.toImplementation(), Scalar(1e-5), Scalar(1e-4), "rotate");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected.toImplementation(), rotatedByMatrix.toImplementation(), Scalar(1e-5), Scalar(1e-4), "rotate");
+
+  const Position expectedInverse = this->rotationA.inverseRotate(this->position);
+  const Position inverseRotated = this->toConstant(this->rotationA).inverseRotate(this->toConstant(this->position)).toPosition();
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expectedInverse.toImplementation(), inverseRotated.toImplementation(), Scalar(1e-5), Scalar(1e-4), "inverse rotate");
+}
@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/rotations/EulerAngles.hpp"
+#include "kindr/common/gtest_eigen.hpp"
+
+typedef ::testing::Types<
+    kindr::EulerAngles<double, 0, 1, 2>,
+    kindr::EulerAnglesXzyD,
+    kindr::EulerAnglesYxzD,
+    kindr::EulerAnglesYzxD,
+    kindr::EulerAnglesZxyD,
+    kindr::EulerAngles<double, 2, 1, 0>,
+    kindr::EulerAnglesXyxD,
+    kindr::EulerAnglesXzxD,
+    kindr::EulerAnglesYxyD,
+    kindr::EulerAnglesYzyD,
+    kindr::EulerAnglesZxzD,
+    kindr::EulerAnglesZyzD,
+    kindr::EulerAnglesZxzF,
+    kindr::EulerAnglesYzxF
+> EulerAnglesTypes;
+
+template <typename EulerAngles_>
+struct EulerAnglesTest : public ::testing::Test {
+  typedef EulerAngles_ EulerAngles;
+  typedef typename EulerAngles::Scalar Scalar;
+  typedef typename EulerAngles::Sequence Sequence;
+  typedef Eigen::Matrix<Scalar, 3, 3> Matrix3;
+  typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+
+  const EulerAngles angles = EulerAngles(Scalar(0.3), Scalar(0.7), Scalar(-1.2));
+
+  static Matrix3 getEigenMatrix(const EulerAngles& angles) {
+    return (Eigen::AngleAxis<Scalar>(angles.a(), Vector3::Unit(Sequence::i))*
+            Eigen::AngleAxis<Scalar>(angles.b(), Vector3::Unit(Sequence::j))*
+            Eigen::AngleAxis<Scalar>(angles.c(), Vector3::Unit(Sequence::isProper ? Sequence::i : Sequence::k))).toRotationMatrix();
+  }
+
+  static Scalar tolerance() {
+    return std::is_same<Scalar, float>::value ? Scalar(1e-4) : Scalar(1e-8);
+  }
+};
+
+TYPED_TEST_CASE(EulerAnglesTest, EulerAnglesTypes);
+
+TYPED_TEST(EulerAnglesTest, testConversionToMatrixAndQuaternion)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  const typename TestFixture::Matrix3 expected = TestFixture::getEigenMatrix(this->angles);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected, this->angles.getRotationMatrix(), this->tolerance(), this->tolerance(), "matrix");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected, kindr::RotationMatrix<Scalar>(this->angles).matrix(), this->tolerance(), this->tolerance(), "rotation matrix");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected, kindr::RotationQuaternion<Scalar>(this->angles).toImplementation().toRotationMatrix(), this->tolerance(), this->tolerance(), "quaternion");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected, kindr::RotationMatrix<Scalar>(kindr::AngleAxis<Scalar>(this->angles)).matrix(), this->tolerance(), this->tolerance(), "angle axis");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected, kindr::RotationMatrix<Scalar>(kindr::RotationVector<Scalar>(this->angles)).matrix(), this->tolerance(), this->tolerance(), "rotation vector");
+}
+
+TYPED_TEST(EulerAnglesTest, testConversionFromRotations)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::EulerAngles EulerAngles;
+  const typename EulerAngles::Vector expected = this->angles.getUnique().toImplementation();
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected, EulerAngles(kindr::RotationMatrix<Scalar>(this->angles)).toImplementation(), this->tolerance(), this->tolerance(), "from matrix");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected, EulerAngles(kindr::RotationQuaternion<Scalar>(this->angles)).toImplementation(), this->tolerance(), this->tolerance(), "from quaternion");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected, EulerAngles(kindr::AngleAxis<Scalar>(this->angles)).toImplementation(), 10*this->tolerance(), 10*this->tolerance(), "from angle axis");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected, EulerAngles(kindr::EulerAnglesZyx<Scalar>(this->angles)).toImplementation(), this->tolerance(), this->tolerance(), "from zyx");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected, EulerAngles(kindr::EulerAnglesXyz<Scalar>(this->angles)).toImplementation(), this->tolerance(), this->tolerance(), "from xyz");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected, EulerAngles(kindr::EulerAnglesZxz<Scalar>(this->angles)).toImplementation(), this->tolerance(), this->tolerance(), "from zxz");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected, EulerAngles(kindr::EulerAngles<double, 1, 0, 2>(this->angles)).toImplementation(), this->tolerance(), this->tolerance(), "from yxz");
+}
+
+TYPED_TEST(EulerAnglesTest, testUnique)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::EulerAngles EulerAngles;
+  const Scalar pi = Scalar(M_PI);
+  const EulerAngles angles[] = {EulerAngles(Scalar(2.5), Scalar(2.0), Scalar(-3.0)),
+                                EulerAngles(Scalar(-2.5), Scalar(-0.4), Scalar(7.0)),
+                                EulerAngles(Scalar(0.1), Scalar(-2.2), Scalar(0.3))};
+  for (const EulerAngles& rotation : angles) {
+    const EulerAngles unique = rotation.getUnique();
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(TestFixture::getEigenMatrix(rotation), unique.getRotationMatrix(), this->tolerance(), this->tolerance(), "unique");
+    EXPECT_LE(-pi, unique.a());
+    EXPECT_GT(pi, unique.a());
+    EXPECT_LE(-pi, unique.c());
+    EXPECT_GT(pi, unique.c());
+    if (TestFixture::Sequence::isProper) {
+      EXPECT_LE(Scalar(0), unique.b());
+      EXPECT_GE(pi, unique.b());
+    } else {
+      EXPECT_LE(-pi/2, unique.b());
+      EXPECT_GE(pi/2, unique.b());
+    }
+    ASSERT_TRUE(rotation == unique);
+  }
+}
+
+TYPED_TEST(EulerAnglesTest, testInversionAndConcatenation)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::EulerAngles EulerAngles;
+  const EulerAngles other(Scalar(-0.6), Scalar(1.1), Scalar(0.2));
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->angles.getRotationMatrix().transpose(), this->angles.inverted().getRotationMatrix(), this->tolerance(), this->tolerance(), "inverse");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->angles.getRotationMatrix()*other.getRotationMatrix(), (this->angles*other).getRotationMatrix(), this->tolerance(), this->tolerance(), "concatenation");
+  const typename TestFixture::Vector3 vector(Scalar(0.3), Scalar(-1.5), Scalar(0.6));
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->angles.getRotationMatrix()*vector, this->angles.rotate(vector), this->tolerance(), this->tolerance(), "rotate");
+}
+
+TYPED_TEST(EulerAnglesTest, testRateMappings)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::EulerAngles EulerAngles;
+  typedef typename TestFixture::Matrix3 Matrix3;
+  typedef typename TestFixture::Vector3 Vector3;
+  const Vector3 diff(Scalar(0.4), Scalar(-0.3), Scalar(0.8));
+  const Scalar dt = std::is_same<Scalar, float>::value ? Scalar(1e-3) : Scalar(1e-6);
+
+  // Angular velocity from the finite difference of the rotation matrix: skew(omega_I) = dR/dt*R^T.
+  const Matrix3 R = this->angles.getRotationMatrix();
+  const Matrix3 Rplus = EulerAngles(this->angles.toImplementation() + dt*diff).getRotationMatrix();
+  const Matrix3 Rminus = EulerAngles(this->angles.toImplementation() - dt*diff).getRotationMatrix();
+  const Matrix3 skew = (Rplus - Rminus)/(2*dt)*R.transpose();
+  const Vector3 globalAngularVelocity(skew(2,1), skew(0,2), skew(1,0));
+  const Vector3 localAngularVelocity = R.transpose()*globalAngularVelocity;
+  const Scalar tol = std::is_same<Scalar, float>::value ? Scalar(1e-2) : Scalar(1e-6);
+
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(globalAngularVelocity, this->angles.getMappingFromDiffToGlobalAngularVelocity()*diff, tol, tol, "global");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(localAngularVelocity, this->angles.getMappingFromDiffToLocalAngularVelocity()*diff, tol, tol, "local");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(diff, this->angles.getMappingFromGlobalAngularVelocityToDiff()*globalAngularVelocity, tol, tol, "global inverse");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(diff, this->angles.getMappingFromLocalAngularVelocityToDiff()*localAngularVelocity, tol, tol, "local inverse");
+}
+
+TEST(EulerAnglesTest, testExistingSequences)
+{
+  const kindr::EulerAnglesZyxD zyx(0.3, -0.7, 1.2);
+  const kindr::EulerAngles<double, 2, 1, 0> genericZyx(zyx);
+  KINDR_ASSERT_DOUBLE_MX_EQ(zyx.toImplementation(), genericZyx.toImplementation(), 1e-12, "zyx");
+  KINDR_ASSERT_DOUBLE_MX_EQ(kindr::RotationMatrixD(zyx).matrix(), genericZyx.getRotationMatrix(), 1e-12, "zyx matrix");
+  KINDR_ASSERT_DOUBLE_MX_EQ(zyx.getMappingFromDiffToLocalAngularVelocity(), genericZyx.getMappingFromDiffToLocalAngularVelocity(), 1e-12, "zyx local mapping");
+  KINDR_ASSERT_DOUBLE_MX_EQ(zyx.getMappingFromLocalAngularVelocityToDiff(), genericZyx.getMappingFromLocalAngularVelocityToDiff(), 1e-12, "zyx local inverse mapping");
+  KINDR_ASSERT_DOUBLE_MX_EQ(zyx.toImplementation(), kindr::EulerAnglesZyxD(genericZyx).toImplementation(), 1e-12, "to zyx");
+
+  const kindr::EulerAnglesXyzD xyz(0.3, -0.7, 1.2);
+  const kindr::EulerAngles<double, 0, 1, 2> genericXyz(xyz);
+  KINDR_ASSERT_DOUBLE_MX_EQ(kindr::RotationMatrixD(xyz).matrix(), genericXyz.getRotationMatrix(), 1e-12, "xyz matrix");
+  KINDR_ASSERT_DOUBLE_MX_EQ(xyz.toImplementation(), kindr::EulerAnglesXyzD(genericXyz).toImplementation(), 1e-12, "to xyz");
+
+  const kindr::EulerAnglesZxzD zxz(xyz);
+  ASSERT_TRUE(kindr::EulerAnglesZyxD(zxz).isNear(kindr::EulerAnglesZyxD(xyz), 1e-10));
+  ASSERT_TRUE(kindr::EulerAnglesXyzD(zxz).isNear(xyz, 1e-10));
+}
+
+TEST(EulerAnglesTest, testGimbalLock)
+{
+  const kindr::EulerAnglesZxzD proper(0.3, 0.0, 0.2);
+  const kindr::EulerAnglesZxzD properExtracted = kindr::EulerAnglesZxzD(kindr::RotationMatrixD(proper));
+  ASSERT_TRUE(properExtracted.isNear(proper, 1e-10));
+  ASSERT_NEAR(0.5, properExtracted.a(), 1e-10);
+  ASSERT_NEAR(0.0, properExtracted.c(), 1e-10);
+  ASSERT_THROW(proper.getMappingFromLocalAngularVelocityToDiff(), std::runtime_error);
+
+  const kindr::EulerAnglesYzyD properHalfTurn(0.3, M_PI, 0.2);
+  ASSERT_TRUE(kindr::EulerAnglesYzyD(kindr::RotationMatrixD(properHalfTurn)).isNear(properHalfTurn, 1e-10));
+  const kindr::EulerAnglesYxzD taitBryan(0.3, M_PI/2, 0.2);
+  ASSERT_TRUE(kindr::EulerAnglesYxzD(kindr::RotationMatrixD(taitBryan)).isNear(taitBryan, 1e-10));
+  const kindr::EulerAnglesZxyD taitBryanNegative(-0.3, -M_PI/2, 0.9);
+  ASSERT_TRUE(kindr::EulerAnglesZxyD(kindr::RotationMatrixD(taitBryanNegative)).isNear(taitBryanNegative, 1e-10));
+}
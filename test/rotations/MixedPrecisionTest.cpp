@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "kindr/rotations/MixedPrecision.hpp"
+#include "kindr/rotations/RotationDiff.hpp"
+#include "kindr/common/gtest_eigen.hpp"
+
+typedef ::testing::Types<
+    kindr::PrecisionPolicyF,
+    kindr::PrecisionPolicyFD,
+    kindr::PrecisionPolicyD
+> PrecisionPolicies;
+
+template <typename Policy_>
+struct MixedPrecisionTest : public ::testing::Test {
+  typedef typename Policy_::StorageScalar StorageScalar;
+  typedef typename Policy_::ComputeScalar ComputeScalar;
+  typedef kindr::RotationQuaternion<StorageScalar> RotationQuaternion;
+  typedef kindr::RotationQuaternionAccumulator<Policy_> Accumulator;
+
+  const RotationQuaternion rotationA = RotationQuaternion(kindr::EulerAnglesZyx<StorageScalar>(StorageScalar(0.3), StorageScalar(-0.7), StorageScalar(1.2)));
+  const RotationQuaternion rotationB = RotationQuaternion(kindr::EulerAnglesZyx<StorageScalar>(StorageScalar(-1.1), StorageScalar(0.4), StorageScalar(0.2)));
+};
+
+TYPED_TEST_CASE(MixedPrecisionTest, PrecisionPolicies);
+
+TYPED_TEST(MixedPrecisionTest, testConcatenation)
+{
+  typedef typename TestFixture::RotationQuaternion RotationQuaternion;
+  typename TestFixture::Accumulator accumulator(this->rotationA);
+  accumulator.concatenate(this->rotationB);
+  const RotationQuaternion expected = this->rotationA*this->rotationB;
+  ASSERT_TRUE(accumulator.getRotation().isNear(expected, 1e-6));
+
+  std::vector<RotationQuaternion> rotations = {this->rotationA, this->rotationB, this->rotationA.inverted()};
+  ASSERT_TRUE(kindr::concatenate<TypeParam>(rotations.begin(), rotations.end()).isNear(expected*this->rotationA.inverted(), 1e-6));
+
+  accumulator.setIdentity();
+  ASSERT_TRUE(accumulator.getRotation().isNear(RotationQuaternion(), 1e-8));
+}
+
+TYPED_TEST(MixedPrecisionTest, testBoxPlus)
+{
+  typedef typename TestFixture::StorageScalar StorageScalar;
+  const Eigen::Matrix<StorageScalar, 3, 1> vector(StorageScalar(0.1), StorageScalar(-0.2), StorageScalar(0.05));
+  typename TestFixture::Accumulator accumulator(this->rotationA);
+  accumulator.boxPlus(vector);
+  ASSERT_TRUE(accumulator.getRotation().isNear(this->rotationA.boxPlus(vector), 1e-6));
+}
+
+TYPED_TEST(MixedPrecisionTest, testRotateBatch)
+{
+  typedef typename TestFixture::StorageScalar StorageScalar;
+  const Eigen::Matrix<StorageScalar, 3, Eigen::Dynamic> points = Eigen::Matrix<StorageScalar, 3, Eigen::Dynamic>::Random(3, 17);
+  const Eigen::Matrix<StorageScalar, 3, Eigen::Dynamic> rotated = kindr::rotateBatch<TypeParam>(this->rotationA, points);
+  ASSERT_EQ(points.cols(), rotated.cols());
+  for (int i = 0; i < points.cols(); ++i) {
+    const Eigen::Matrix<StorageScalar, 3, 1> expected = this->rotationA.rotate(Eigen::Matrix<StorageScalar, 3, 1>(points.col(i)));
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected, rotated.col(i), 1e-6, 1e-5, "column " << i);
+  }
+}
+
+TEST(MixedPrecisionTest, testFloatStorageDoesNotDrift)
+{
+  // Concatenate many small increments which sum up to a known rotation about z.
+  const int numberOfIncrements = 100000;
+  const double angle = 3.0;
+  const kindr::RotationQuaternionF increment(kindr::AngleAxisF(float(angle/numberOfIncrements), 0.0f, 0.0f, 1.0f));
+
+  kindr::RotationQuaternionF floatChain;
+  kindr::RotationQuaternionAccumulator<kindr::PrecisionPolicyFD> accumulator;
+  for (int i = 0; i < numberOfIncrements; ++i) {
+    floatChain = floatChain*increment;
+    accumulator.concatenate(increment);
+  }
+  const kindr::RotationQuaternionD expected(kindr::AngleAxisD(numberOfIncrements*double(float(angle/numberOfIncrements)), 0.0, 0.0, 1.0));
+  const double floatChainError = kindr::RotationQuaternionD(floatChain).getDisparityAngle(expected);
+  const double accumulatorError = kindr::RotationQuaternionD(accumulator.getRotation()).getDisparityAngle(expected);
+  EXPECT_LT(accumulatorError, 1e-6);
+  EXPECT_LT(accumulatorError, floatChainError);
+}
+
+TEST(MixedPrecisionTest, testFloatPathsStayInFloat)
+{
+  static_assert(std::is_same<kindr::RotationQuaternionAccumulator<kindr::PrecisionPolicyF>::ComputeRotation, kindr::RotationQuaternionF>::value,
+                "float policy has to compute in float");
+  const Eigen::Matrix3Xf points = Eigen::Matrix3Xf::Random(3, 8);
+  static_assert(std::is_same<decltype(kindr::rotateBatch<kindr::PrecisionPolicyF>(kindr::RotationQuaternionF(), points))::Scalar, float>::value,
+                "float batch kernel has to return float");
+  const kindr::EulerAnglesZyxF euler(0.3f, -0.2f, 0.1f);
+  const Eigen::Matrix3f mapping = euler.getMappingFromLocalAngularVelocityToDiff();
+  const Eigen::Matrix3d expected = kindr::EulerAnglesZyxD(euler).getMappingFromLocalAngularVelocityToDiff();
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected, mapping.cast<double>(), 1e-6, 1e-5, "mapping");
+}
+
+TEST(MixedPrecisionTest, testFloatJacobianOfExponentialMapAtSmallAngles)
+{
+  // The closed forms of the Jacobians cancel in float just above the small-angle branch.
+  const Eigen::Vector3d axis = Eigen::Vector3d(0.3, -0.8, 0.5).normalized();
+  for (double angle : {0.0, 1e-6, 1e-4, 2e-4, 1e-3, 1e-2, 2e-2, 0.1, 1.0, 3.0}) {
+    const Eigen::Vector3f vector = (angle*axis).cast<float>();
+    const Eigen::Vector3d vectorD = vector.cast<double>();
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(kindr::getJacobianOfExponentialMap(vectorD),
+                                      kindr::getJacobianOfExponentialMap(vector).cast<double>(), 1e-6, 1e-6, "Jacobian");
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(kindr::getInverseJacobianOfExponentialMap(vectorD),
+                                      kindr::getInverseJacobianOfExponentialMap(vector).cast<double>(), 1e-6, 1e-6, "inverse Jacobian");
+  }
+}
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/rotations/Rotation2D.hpp"
+#include "kindr/phys_quant/PhysicalQuantities.hpp"
+#include "kindr/common/gtest_eigen.hpp"
+
+typedef ::testing::Types<
+    float,
+    double
+> PrimTypes;
+
+template <typename PrimType_>
+struct Rotation2DTest : public ::testing::Test {
+  typedef PrimType_ Scalar;
+  typedef kindr::Rotation2D<Scalar> Rotation2D;
+  typedef Eigen::Matrix<Scalar, 2, 1> Vector2;
+  typedef Eigen::Matrix<Scalar, 2, 2> Matrix2;
+
+  const Scalar angleA = Scalar(0.7);
+  const Scalar angleB = Scalar(-2.9);
+  const Vector2 vector = Vector2(Scalar(0.3), Scalar(-1.5));
+};
+
+TYPED_TEST_CASE(Rotation2DTest, PrimTypes);
+
+TYPED_TEST(Rotation2DTest, testConstructors)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Rotation2D Rotation2D;
+
+  const Rotation2D identity;
+  ASSERT_EQ(identity.angle(), Scalar(0));
+
+  const Rotation2D rotation(this->angleA);
+  ASSERT_NEAR(rotation.angle(), this->angleA, 1e-6);
+  ASSERT_NEAR(Rotation2D(rotation.getRotationMatrix()).angle(), this->angleA, 1e-6);
+  ASSERT_NEAR(Rotation2D(std::cos(this->angleA), std::sin(this->angleA)).angle(), this->angleA, 1e-6);
+}
+
+TYPED_TEST(Rotation2DTest, testConversions3D)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Rotation2D Rotation2D;
+  typedef kindr::RotationQuaternion<Scalar> RotationQuaternion;
+
+  const Rotation2D rotation(this->angleA);
+  const RotationQuaternion rotation3D(rotation.getRotation3D());
+  ASSERT_TRUE(rotation3D.isNear(RotationQuaternion(kindr::AngleAxis<Scalar>(this->angleA, 0, 0, 1)), 1e-5));
+  ASSERT_NEAR(Rotation2D(rotation3D).angle(), this->angleA, 1e-5);
+
+  // yaw of a 3D rotation
+  const kindr::EulerAnglesZyx<Scalar> euler(this->angleA, Scalar(0), Scalar(0));
+  ASSERT_NEAR(Rotation2D(euler).angle(), this->angleA, 1e-5);
+}
+
+TYPED_TEST(Rotation2DTest, testConcatenationAndInverse)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Rotation2D Rotation2D;
+
+  const Rotation2D rotationA(this->angleA);
+  const Rotation2D rotationB(this->angleB);
+  ASSERT_NEAR((rotationA*rotationB).angle(), kindr::wrapPosNegPI(this->angleA + this->angleB), 1e-5);
+  ASSERT_TRUE((rotationA*rotationA.inverted()).isNear(Rotation2D(), 1e-6));
+  Rotation2D rotation = rotationA;
+  rotation.invert();
+  ASSERT_NEAR(rotation.angle(), -this->angleA, 1e-6);
+  ASSERT_NEAR(rotation.setIdentity().angle(), Scalar(0), 1e-6);
+}
+
+TYPED_TEST(Rotation2DTest, testRotate)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Rotation2D Rotation2D;
+  typedef typename TestFixture::Vector2 Vector2;
+
+  const Rotation2D rotation(this->angleA);
+  const Vector2 expected = rotation.getRotationMatrix()*this->vector;
+  const Vector2 rotated = rotation.rotate(this->vector);
+  ASSERT_NEAR(rotated(0), expected(0), 1e-5);
+  ASSERT_NEAR(rotated(1), expected(1), 1e-5);
+  const Vector2 back = rotation.inverseRotate(rotated);
+  ASSERT_NEAR(back(0), this->vector(0), 1e-5);
+  ASSERT_NEAR(back(1), this->vector(1), 1e-5);
+
+  const Eigen::Matrix<Scalar, 2, Eigen::Dynamic> points = Eigen::Matrix<Scalar, 2, Eigen::Dynamic>::Random(2, 7);
+  ASSERT_TRUE(rotation.rotate(points).isApprox(rotation.getRotationMatrix()*points, Scalar(1e-5)));
+
+  const kindr::Position<Scalar, 2> position(this->vector);
+  ASSERT_NEAR(rotation.rotate(position)(0), expected(0), 1e-5);
+  ASSERT_NEAR(rotation.inverseRotate(rotation.rotate(position))(1), this->vector(1), 1e-5);
+}
+
+TYPED_TEST(Rotation2DTest, testMapsAndInterpolation)
+{
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Rotation2D Rotation2D;
+
+  const Rotation2D rotationA(this->angleA);
+  const Rotation2D rotationB(this->angleB);
+  Rotation2D rotation;
+  ASSERT_NEAR(rotation.exponentialMap(this->angleA).logarithmicMap(), this->angleA, 1e-6);
+  ASSERT_NEAR(rotationA.boxPlus(Scalar(0.2)).angle(), this->angleA + Scalar(0.2), 1e-6);
+  ASSERT_TRUE(rotationA.boxPlus(rotationB.boxMinus(rotationA)).isNear(rotationB, 1e-5));
+
+  // shortest arc across +-pi
+  ASSERT_TRUE(rotationA.interpolate(rotationB, Scalar(0)).isNear(rotationA, 1e-5));
+  ASSERT_TRUE(rotationA.interpolate(rotationB, Scalar(1)).isNear(rotationB, 1e-5));
+  const Rotation2D half = Rotation2D(Scalar(3.0)).interpolate(Rotation2D(Scalar(-3.0)), Scalar(0.5));
+  ASSERT_NEAR(std::abs(half.angle()), Scalar(M_PI), 1e-5);
+}
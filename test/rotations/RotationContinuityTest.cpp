@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+
+#include <gtest/gtest.h>
+
+#include "kindr/rotations/RotationContinuity.hpp"
+#include "kindr/common/gtest_eigen.hpp"
+
+template <typename Scalar_>
+class RotationContinuityTest : public ::testing::Test {
+ public:
+  typedef Scalar_ Scalar;
+  typedef kindr::RotationQuaternion<Scalar> Quaternion;
+  typedef kindr::EulerAnglesZyx<Scalar> EulerAngles;
+  typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+
+  //! Rotation around a fixed axis by more than a full turn, with randomly flipped signs
+  RotationContinuityTest() {
+    for (int k = 0; k < 40; ++k) {
+      Quaternion quaternion(kindr::AngleAxis<Scalar>(Scalar(0.2)*Scalar(k), Scalar(0.36), Scalar(0.48), Scalar(0.8)));
+      if (k % 3 == 1 || k % 7 == 0) {
+        quaternion.toImplementation().coeffs() *= Scalar(-1);
+      }
+      quaternions.push_back(quaternion);
+    }
+  }
+
+  static void expectContinuous(const std::vector<Quaternion>& quaternions) {
+    for (std::size_t k = 1; k < quaternions.size(); ++k) {
+      EXPECT_GE(quaternions[k].toImplementation().coeffs().dot(quaternions[k - 1].toImplementation().coeffs()), Scalar(0));
+    }
+  }
+
+  std::vector<Quaternion> quaternions;
+};
+
+typedef ::testing::Types<float, double> ScalarTypes;
+TYPED_TEST_CASE(RotationContinuityTest, ScalarTypes);
+
+TYPED_TEST(RotationContinuityTest, testQuaternionFilter) {
+  typedef typename TestFixture::Quaternion Quaternion;
+  kindr::RotationQuaternionContinuityFilter<typename TestFixture::Scalar> filter;
+  std::vector<Quaternion> filtered;
+  for (const Quaternion& quaternion : this->quaternions) {
+    filtered.push_back(filter.filter(quaternion));
+    EXPECT_TRUE(filtered.back().isNear(quaternion, 1e-5));
+  }
+  TestFixture::expectContinuous(filtered);
+  EXPECT_TRUE(filtered.front().toImplementation().coeffs() == this->quaternions.front().toImplementation().coeffs());
+
+  // the filter continues from the given quaternion
+  Quaternion negated = this->quaternions.front();
+  negated.toImplementation().coeffs() *= -1;
+  kindr::RotationQuaternionContinuityFilter<typename TestFixture::Scalar> continuedFilter(negated);
+  EXPECT_TRUE(continuedFilter.filter(this->quaternions.front()).toImplementation().coeffs() == negated.toImplementation().coeffs());
+  continuedFilter.reset();
+  EXPECT_FALSE(continuedFilter.hasPrevious());
+}
+
+TYPED_TEST(RotationContinuityTest, testQuaternionBatch) {
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Quaternion Quaternion;
+  std::vector<Quaternion> filtered = this->quaternions;
+  kindr::makeRotationQuaternionsContinuous(filtered);
+  TestFixture::expectContinuous(filtered);
+
+  Eigen::Matrix<Scalar, 4, Eigen::Dynamic> coefficients(4, this->quaternions.size());
+  for (std::size_t k = 0; k < this->quaternions.size(); ++k) {
+    coefficients.col(k) = this->quaternions[k].toImplementation().coeffs();
+  }
+  kindr::makeRotationQuaternionsContinuous(coefficients);
+  for (std::size_t k = 0; k < this->quaternions.size(); ++k) {
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(filtered[k].toImplementation().coeffs(), coefficients.col(k), 1e-6, 1e-6, "batch");
+  }
+
+  // continue from a quaternion of the opposite hemisphere, which flips the whole batch
+  const Eigen::Matrix<Scalar, 4, 1> previous = -coefficients.col(0);
+  kindr::makeRotationQuaternionsContinuous(coefficients, previous);
+  for (std::size_t k = 0; k < this->quaternions.size(); ++k) {
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(-filtered[k].toImplementation().coeffs(), coefficients.col(k), 1e-6, 1e-6, "continued batch");
+  }
+
+  Eigen::Matrix<Scalar, 4, Eigen::Dynamic> empty(4, 0);
+  kindr::makeRotationQuaternionsContinuous(empty);
+}
+
+TYPED_TEST(RotationContinuityTest, testEulerAnglesZyx) {
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::EulerAngles EulerAngles;
+  std::vector<EulerAngles> eulerAngles;
+  for (const typename TestFixture::Quaternion& quaternion : this->quaternions) {
+    eulerAngles.push_back(EulerAngles(quaternion).getUnique());
+  }
+  std::vector<EulerAngles> unwrapped = eulerAngles;
+  kindr::makeEulerAnglesZyxContinuous(unwrapped);
+  for (std::size_t k = 0; k < eulerAngles.size(); ++k) {
+    EXPECT_TRUE(unwrapped[k].isNear(eulerAngles[k], 1e-4));
+    if (k > 0) {
+      EXPECT_LT((unwrapped[k].toImplementation() - unwrapped[k - 1].toImplementation()).norm(), Scalar(0.5));
+    }
+  }
+  // the yaw of the turn around the mostly vertical axis keeps growing
+  EXPECT_GT(unwrapped.back().yaw(), Scalar(M_PI));
+
+  // pitch passing through pi/2 continues on the other branch
+  kindr::EulerAnglesZyxContinuityFilter<Scalar> filter(EulerAngles(Scalar(0.3), Scalar(1.5), Scalar(-0.2)));
+  const EulerAngles beyond = filter.filter(EulerAngles(EulerAngles(Scalar(0.3), Scalar(1.62), Scalar(-0.2)).getUnique()));
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(typename TestFixture::Vector3(Scalar(0.3), Scalar(1.62), Scalar(-0.2)), beyond.toImplementation(), 1e-5, 1e-4, "pitch");
+}
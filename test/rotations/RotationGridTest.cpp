@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+
+#include <gtest/gtest.h>
+
+#include "kindr/rotations/RotationGrid.hpp"
+#include "kindr/common/gtest_eigen.hpp"
+
+template <typename Scalar_>
+class RotationGridTest : public ::testing::Test {
+ public:
+  typedef Scalar_ Scalar;
+  typedef kindr::HopfRotationGrid<Scalar> Grid;
+};
+
+typedef ::testing::Types<float, double> ScalarTypes;
+TYPED_TEST_CASE(RotationGridTest, ScalarTypes);
+
+TEST(RotationGridTest, testHealpix) {
+  for (std::int64_t nside : {1, 2, 3, 4, 8}) {
+    const std::int64_t npix = 12*nside*nside;
+    for (std::int64_t pixel = 0; pixel < npix; ++pixel) {
+      double z, phi;
+      kindr::internal::getHealpixPixelCenter(nside, pixel, z, phi);
+      ASSERT_LE(std::abs(z), 1.0);
+      ASSERT_GE(phi, 0.0);
+      ASSERT_LT(phi, 2.0*M_PI);
+      ASSERT_EQ(pixel, kindr::internal::getHealpixPixel(nside, z, phi)) << "nside " << nside;
+    }
+  }
+  // the pixels have equal areas, i.e. uniformly distributed points hit them equally often
+  const std::int64_t nside = 2;
+  std::vector<int> counts(12*nside*nside, 0);
+  std::srand(0);
+  const int numSamples = 480000;
+  for (int i = 0; i < numSamples; ++i) {
+    const double z = 2.0*double(std::rand())/RAND_MAX - 1.0;
+    const double phi = 2.0*M_PI*double(std::rand())/(double(RAND_MAX) + 1.0);
+    ++counts[kindr::internal::getHealpixPixel(nside, z, phi)];
+  }
+  for (int count : counts) {
+    EXPECT_NEAR(numSamples/48, count, 500);
+  }
+}
+
+TYPED_TEST(RotationGridTest, testGridPoints) {
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Grid Grid;
+  for (std::int64_t resolution : {1, 2}) {
+    const Grid grid(resolution);
+    EXPECT_EQ(72*resolution*resolution*resolution, grid.size());
+    Eigen::Matrix<Scalar, Eigen::Dynamic, 4> quaternions(grid.size(), 4);
+    grid.getQuaternions(quaternions);
+    const typename Grid::Rotations rotations = grid.getRotations();
+    ASSERT_EQ(std::size_t(grid.size()), rotations.size());
+    for (std::int64_t i = 0; i < grid.size(); ++i) {
+      const typename Grid::Rotation rotation = grid.getRotation(i);
+      const Eigen::Matrix<Scalar, 4, 1> coefficients(rotation.w(), rotation.x(), rotation.y(), rotation.z());
+      KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(coefficients, quaternions.row(i).transpose(), 1e-5, 1e-5, "structure of arrays");
+      EXPECT_NEAR(Scalar(1), quaternions.row(i).norm(), 1e-5);
+      EXPECT_EQ(i, grid.getIndex(rotation));
+      EXPECT_TRUE(rotations[i].isNear(rotation, 1e-5));
+    }
+  }
+  EXPECT_ANY_THROW(Grid(0));
+}
+
+TEST(RotationGridTest, testUniformity) {
+  // the grid points are distinct rotations with similar distances to their nearest neighbors
+  const kindr::HopfRotationGridD grid(2);
+  const kindr::HopfRotationGridD::Rotations rotations = grid.getRotations();
+  double minDistance = 10.0;
+  double maxDistance = 0.0;
+  for (std::size_t i = 0; i < rotations.size(); ++i) {
+    double nearest = 10.0;
+    for (std::size_t j = 0; j < rotations.size(); ++j) {
+      if (i != j) {
+        nearest = std::min(nearest, rotations[i].getDisparityAngle(rotations[j]));
+      }
+    }
+    minDistance = std::min(minDistance, nearest);
+    maxDistance = std::max(maxDistance, nearest);
+  }
+  EXPECT_GT(minDistance, 0.1);
+  EXPECT_LT(maxDistance/minDistance, 2.0);
+}
+
+TYPED_TEST(RotationGridTest, testLookup) {
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Grid Grid;
+  std::srand(1);
+  Scalar maxDistance[2];
+  for (std::int64_t resolution : {2, 4}) {
+    const Grid grid(resolution);
+    Scalar maxCellDistance = Scalar(0);
+    for (int i = 0; i < 2000; ++i) {
+      typename Grid::Rotation rotation;
+      rotation.setRandom();
+      const std::int64_t index = grid.getIndex(rotation);
+      ASSERT_GE(index, 0);
+      ASSERT_LT(index, grid.size());
+      maxCellDistance = std::max(maxCellDistance, rotation.getDisparityAngle(grid.getRotation(index)));
+      // the sign of the quaternion does not matter
+      typename Grid::Rotation negated = rotation;
+      negated.toImplementation().coeffs() *= Scalar(-1);
+      EXPECT_EQ(index, grid.getIndex(negated));
+      EXPECT_EQ(index, grid.getIndex(kindr::RotationMatrix<Scalar>(rotation)));
+    }
+    maxDistance[resolution/4] = maxCellDistance;
+  }
+  // the cells shrink with the resolution
+  EXPECT_LT(maxDistance[0], Scalar(0.8));
+  EXPECT_LT(maxDistance[1], Scalar(0.6)*maxDistance[0]);
+}
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+
+#include <gtest/gtest.h>
+
+#include "kindr/search/VantagePointTree.hpp"
+
+template <typename Scalar_>
+class VantagePointTreeTest : public ::testing::Test {
+ public:
+  typedef Scalar_ Scalar;
+  typedef kindr::VantagePointTree<kindr::RotationDisparityMetric<Scalar>> RotationTree;
+  typedef kindr::VantagePointTree<kindr::PoseDisparityMetric<Scalar>> PoseTree;
+  typedef kindr::RotationQuaternion<Scalar> Rotation;
+  typedef kindr::HomTransformQuat<Scalar> Pose;
+
+  VantagePointTreeTest() {
+    std::srand(42);
+    for (int i = 0; i < 2000; ++i) {
+      Rotation rotation;
+      rotation.setRandom();
+      // clustered rotations with duplicates and flipped signs
+      if (i % 10 == 0 && i > 0) {
+        rotation = rotations.back();
+        rotation.toImplementation().coeffs() *= Scalar(-1);
+      }
+      rotations.push_back(rotation);
+      poses.push_back(Pose(typename Pose::Position(Eigen::Matrix<Scalar, 3, 1>::Random()), rotation));
+    }
+    for (int i = 0; i < 50; ++i) {
+      Rotation rotation;
+      rotation.setRandom();
+      queries.push_back(rotation);
+      poseQueries.push_back(Pose(typename Pose::Position(Eigen::Matrix<Scalar, 3, 1>::Random()), rotation));
+    }
+  }
+
+  //! Brute-force reference
+  template<typename Tree_>
+  static typename Tree_::Neighbors getReference(const typename Tree_::Elements& elements, const typename Tree_::Element& query, const typename Tree_::Metric& metric) {
+    typename Tree_::Neighbors neighbors;
+    for (std::size_t i = 0; i < elements.size(); ++i) {
+      neighbors.push_back(typename Tree_::Neighbor{i, metric(query, elements[i])});
+    }
+    std::stable_sort(neighbors.begin(), neighbors.end());
+    return neighbors;
+  }
+
+  typename RotationTree::Elements rotations;
+  typename RotationTree::Elements queries;
+  typename PoseTree::Elements poses;
+  typename PoseTree::Elements poseQueries;
+};
+
+typedef ::testing::Types<float, double> ScalarTypes;
+TYPED_TEST_CASE(VantagePointTreeTest, ScalarTypes);
+
+TYPED_TEST(VantagePointTreeTest, testMetric) {
+  typedef typename TestFixture::Rotation Rotation;
+  const kindr::RotationDisparityMetric<typename TestFixture::Scalar> metric;
+  for (std::size_t i = 1; i < 20; ++i) {
+    EXPECT_NEAR(this->rotations[i].getDisparityAngle(this->rotations[i - 1]), metric(this->rotations[i], this->rotations[i - 1]), 1e-4);
+  }
+  Rotation negated = this->rotations[3];
+  negated.toImplementation().coeffs() *= -1;
+  EXPECT_EQ(metric(this->rotations[3], this->rotations[3]), metric(this->rotations[3], negated));
+  EXPECT_EQ(0, metric(this->rotations[3], negated));
+}
+
+TYPED_TEST(VantagePointTreeTest, testRotationQueries) {
+  typedef typename TestFixture::RotationTree Tree;
+  const Tree tree(this->rotations);
+  ASSERT_EQ(this->rotations.size(), tree.size());
+  for (std::size_t i = 0; i < this->rotations.size(); i += 97) {
+    EXPECT_TRUE(tree.getElement(i).toImplementation().coeffs() == this->rotations[i].toImplementation().coeffs());
+  }
+  for (const typename Tree::Element& query : this->queries) {
+    const typename Tree::Neighbors reference = TestFixture::template getReference<Tree>(this->rotations, query, typename Tree::Metric());
+    const typename Tree::Neighbors neighbors = tree.getNearestNeighbors(query, 5);
+    ASSERT_EQ(5u, neighbors.size());
+    for (std::size_t i = 0; i < neighbors.size(); ++i) {
+      EXPECT_EQ(reference[i].distance, neighbors[i].distance);
+    }
+    EXPECT_EQ(reference[0].distance, tree.getNearestNeighbor(query).distance);
+
+    const typename TestFixture::Scalar radius = reference[20].distance;
+    const typename Tree::Neighbors withinRadius = tree.getNeighborsWithinRadius(query, radius);
+    std::size_t numWithinRadius = 21;
+    while (numWithinRadius < reference.size() && reference[numWithinRadius].distance <= radius) {
+      ++numWithinRadius;
+    }
+    ASSERT_EQ(numWithinRadius, withinRadius.size());
+    for (std::size_t i = 0; i < withinRadius.size(); ++i) {
+      EXPECT_EQ(reference[i].distance, withinRadius[i].distance);
+      EXPECT_EQ(withinRadius[i].distance, typename Tree::Metric()(query, this->rotations[withinRadius[i].index]));
+    }
+  }
+  // more neighbors than elements
+  EXPECT_EQ(this->rotations.size(), tree.getNearestNeighbors(this->queries[0], 5000).size());
+}
+
+TYPED_TEST(VantagePointTreeTest, testPoseQueries) {
+  typedef typename TestFixture::PoseTree Tree;
+  const typename Tree::Metric metric(typename TestFixture::Scalar(2), typename TestFixture::Scalar(0.5));
+  const Tree tree(this->poses, metric, 4);
+  const std::vector<typename Tree::Neighbors> neighbors = tree.getNearestNeighbors(this->poseQueries, 3);
+  const std::vector<typename Tree::Neighbors> withinRadius = tree.getNeighborsWithinRadius(this->poseQueries, typename TestFixture::Scalar(0.4));
+  ASSERT_EQ(this->poseQueries.size(), neighbors.size());
+  for (std::size_t q = 0; q < this->poseQueries.size(); ++q) {
+    const typename Tree::Neighbors reference = TestFixture::template getReference<Tree>(this->poses, this->poseQueries[q], metric);
+    ASSERT_EQ(3u, neighbors[q].size());
+    for (std::size_t i = 0; i < 3; ++i) {
+      EXPECT_EQ(reference[i].distance, neighbors[q][i].distance);
+    }
+    std::size_t numWithinRadius = 0;
+    while (numWithinRadius < reference.size() && reference[numWithinRadius].distance <= typename TestFixture::Scalar(0.4)) {
+      ++numWithinRadius;
+    }
+    EXPECT_EQ(numWithinRadius, withinRadius[q].size());
+  }
+}
+
+TYPED_TEST(VantagePointTreeTest, testLargeTree) {
+  typedef typename TestFixture::RotationTree Tree;
+  // larger than the subtrees which are built in separate tasks if OpenMP is enabled
+  typename Tree::Elements rotations;
+  for (int i = 0; i < 10000; ++i) {
+    typename TestFixture::Rotation rotation;
+    rotation.setRandom();
+    rotations.push_back(rotation);
+  }
+  const Tree tree(rotations);
+  ASSERT_EQ(rotations.size(), tree.size());
+  for (std::size_t i = 0; i < rotations.size(); ++i) {
+    ASSERT_TRUE(tree.getElement(i).toImplementation().coeffs() == rotations[i].toImplementation().coeffs());
+  }
+  const std::vector<typename Tree::Neighbors> neighbors = tree.getNearestNeighbors(this->queries, 3);
+  ASSERT_EQ(this->queries.size(), neighbors.size());
+  for (std::size_t q = 0; q < this->queries.size(); ++q) {
+    const typename Tree::Neighbors reference = TestFixture::template getReference<Tree>(rotations, this->queries[q], typename Tree::Metric());
+    ASSERT_EQ(3u, neighbors[q].size());
+    for (std::size_t i = 0; i < 3; ++i) {
+      EXPECT_EQ(reference[i].distance, neighbors[q][i].distance);
+    }
+  }
+}
+
+TEST(VantagePointTreeTest, testEmpty) {
+  const kindr::RotationVantagePointTreeD tree((kindr::RotationVantagePointTreeD::Elements()));
+  EXPECT_EQ(0u, tree.size());
+  EXPECT_TRUE(tree.getNearestNeighbors(kindr::RotationQuaternionD(), 3).empty());
+  EXPECT_TRUE(tree.getNeighborsWithinRadius(kindr::RotationQuaternionD(), 1.0).empty());
+  EXPECT_ANY_THROW(tree.getNearestNeighbor(kindr::RotationQuaternionD()));
+}
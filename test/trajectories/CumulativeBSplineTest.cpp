@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+
+#include <gtest/gtest.h>
+
+#include "kindr/trajectories/CumulativeBSpline.hpp"
+#include "kindr/poses/PoseIntegration.hpp"
+#include "kindr/common/gtest_eigen.hpp"
+
+template <typename Scalar_>
+class CumulativeBSplineData {
+ public:
+  typedef Scalar_ Scalar;
+  typedef kindr::RotationBSpline<Scalar> RotationSpline;
+  typedef kindr::PositionBSpline<Scalar> PositionSpline;
+  typedef typename RotationSpline::Rotation Rotation;
+  typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+
+  CumulativeBSplineData() : rotationSpline(startTime, timeInterval), positionSpline(startTime, timeInterval) {
+    for (int k = 0; k < 7; ++k) {
+      const Scalar s = Scalar(k);
+      rotationSpline.addControlPoint(Rotation().exponentialMap(Vector3(Scalar(0.3)*s, Scalar(-0.2)*s*s/Scalar(3), Scalar(0.5)*std::sin(s))));
+      positionSpline.addControlPoint(typename PositionSpline::Position(Scalar(0.5)*s, s*s/Scalar(4), -s));
+    }
+  }
+
+  const Scalar startTime = Scalar(1.5);
+  const Scalar timeInterval = Scalar(0.2);
+  RotationSpline rotationSpline;
+  PositionSpline positionSpline;
+};
+
+template <typename Scalar_>
+class CumulativeBSplineTest : public ::testing::Test, public CumulativeBSplineData<Scalar_> {
+};
+
+typedef ::testing::Types<float, double> ScalarTypes;
+TYPED_TEST_CASE(CumulativeBSplineTest, ScalarTypes);
+
+TYPED_TEST(CumulativeBSplineTest, testTiming) {
+  typedef typename TestFixture::Scalar Scalar;
+  EXPECT_EQ(4u, this->rotationSpline.getNumberOfSegments());
+  EXPECT_NEAR(Scalar(2.3), this->rotationSpline.getEndTime(), 1e-5);
+  Scalar u;
+  EXPECT_EQ(2u, this->rotationSpline.getSegmentIndex(Scalar(2.0), u));
+  EXPECT_NEAR(Scalar(0.5), u, 1e-4);
+  EXPECT_EQ(3u, this->rotationSpline.getSegmentIndex(this->rotationSpline.getEndTime(), u));
+  EXPECT_NEAR(Scalar(1), u, 1e-4);
+  EXPECT_ANY_THROW(this->rotationSpline.getRotation(Scalar(1.4)));
+  EXPECT_ANY_THROW(this->rotationSpline.getRotation(Scalar(2.4)));
+  EXPECT_ANY_THROW(kindr::RotationBSplineD().getRotation(0.0));
+}
+
+TYPED_TEST(CumulativeBSplineTest, testContinuity) {
+  for (std::size_t s = 0; s + 1 < this->rotationSpline.getNumberOfSegments(); ++s) {
+    EXPECT_TRUE(this->rotationSpline.getSegment(s).getRotation(1).isNear(this->rotationSpline.getSegment(s + 1).getRotation(0), 1e-5));
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->positionSpline.getSegment(s).getPosition(1).toImplementation(), this->positionSpline.getSegment(s + 1).getPosition(0).toImplementation(), 1e-5, 1e-4, "position");
+  }
+}
+
+TYPED_TEST(CumulativeBSplineTest, testConstantAngularVelocity) {
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Vector3 Vector3;
+  typedef typename TestFixture::Rotation Rotation;
+  const Vector3 angularVelocity(Scalar(0.4), Scalar(-1.0), Scalar(0.7));
+  kindr::RotationBSpline<Scalar> spline(Scalar(0), Scalar(0.1));
+  kindr::PositionBSpline<Scalar> positionSpline(Scalar(0), Scalar(0.1));
+  for (int k = 0; k < 5; ++k) {
+    spline.addControlPoint(Rotation().exponentialMap(Scalar(0.1)*Scalar(k - 1)*angularVelocity));
+    positionSpline.addControlPoint(typename kindr::PositionBSpline<Scalar>::Position(Scalar(0.1)*Scalar(k - 1)*angularVelocity));
+  }
+  Rotation rotation;
+  typename kindr::RotationBSpline<Scalar>::AngularVelocity localAngularVelocity;
+  typename kindr::RotationBSpline<Scalar>::AngularAcceleration angularAcceleration;
+  spline.evaluate(Scalar(0.13), rotation, localAngularVelocity, angularAcceleration);
+  EXPECT_TRUE(rotation.isNear(Rotation().exponentialMap(Scalar(0.13)*angularVelocity), 1e-5));
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(angularVelocity, localAngularVelocity.toImplementation(), 1e-4, 1e-4, "angular velocity");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(Vector3::Zero(), angularAcceleration.toImplementation(), 1e-3, 1e-4, "angular acceleration");
+
+  typename kindr::PositionBSpline<Scalar>::Position position;
+  typename kindr::PositionBSpline<Scalar>::Velocity velocity;
+  typename kindr::PositionBSpline<Scalar>::Acceleration acceleration;
+  positionSpline.evaluate(Scalar(0.13), position, velocity, acceleration);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(Scalar(0.13)*angularVelocity, position.toImplementation(), 1e-5, 1e-4, "position");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(angularVelocity, velocity.toImplementation(), 1e-4, 1e-4, "velocity");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(Vector3::Zero(), acceleration.toImplementation(), 1e-3, 1e-4, "acceleration");
+}
+
+TYPED_TEST(CumulativeBSplineTest, testBatchEvaluation) {
+  typedef typename TestFixture::Scalar Scalar;
+  std::vector<Scalar> times;
+  for (int i = 0; i <= 16; ++i) {
+    times.push_back(this->startTime + Scalar(i)*Scalar(0.05));
+  }
+  typename TestFixture::RotationSpline::Rotations rotations;
+  std::vector<typename TestFixture::RotationSpline::AngularVelocity> angularVelocities;
+  std::vector<typename TestFixture::RotationSpline::AngularAcceleration> angularAccelerations;
+  this->rotationSpline.evaluate(times, rotations, angularVelocities, angularAccelerations);
+  typename TestFixture::PositionSpline::Positions positions;
+  this->positionSpline.getPositions(times, positions);
+  ASSERT_EQ(times.size(), rotations.size());
+  ASSERT_EQ(times.size(), positions.size());
+  for (std::size_t i = 0; i < times.size(); ++i) {
+    EXPECT_TRUE(rotations[i].isNear(this->rotationSpline.getRotation(times[i]), 1e-5));
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->rotationSpline.getAngularVelocity(times[i]).toImplementation(), angularVelocities[i].toImplementation(), 1e-4, 1e-4, "angular velocity");
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->positionSpline.getPosition(times[i]).toImplementation(), positions[i].toImplementation(), 1e-5, 1e-4, "position");
+  }
+}
+
+TEST(CumulativeBSplineDoubleTest, testDerivatives) {
+  CumulativeBSplineData<double> fixture;
+  const kindr::RotationBSplineD& spline = fixture.rotationSpline;
+  const double h = 1.0e-5;
+  for (double time = 1.55; time < 2.25; time += 0.11) {
+    kindr::RotationQuaternionD rotation;
+    kindr::LocalAngularVelocityD angularVelocity;
+    kindr::AngularAcceleration3D angularAcceleration;
+    spline.evaluate(time, rotation, angularVelocity, angularAcceleration);
+    const Eigen::Vector3d numericalAngularVelocity = (spline.getRotation(time - h).inverted()*spline.getRotation(time + h)).logarithmicMap()/(2.0*h);
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(numericalAngularVelocity, angularVelocity.toImplementation(), 1e-5, 1e-5, "angular velocity");
+    const Eigen::Vector3d numericalAngularAcceleration = (spline.getAngularVelocity(time + h).toImplementation() - spline.getAngularVelocity(time - h).toImplementation())/(2.0*h);
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(numericalAngularAcceleration, angularAcceleration.toImplementation(), 1e-4, 1e-4, "angular acceleration");
+
+    kindr::Position3D position;
+    kindr::Velocity3D velocity;
+    kindr::Acceleration3D acceleration;
+    fixture.positionSpline.evaluate(time, position, velocity, acceleration);
+    const Eigen::Vector3d numericalVelocity = (fixture.positionSpline.getPosition(time + h) - fixture.positionSpline.getPosition(time - h)).toImplementation()/(2.0*h);
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(numericalVelocity, velocity.toImplementation(), 1e-5, 1e-5, "velocity");
+  }
+}
+
+TEST(CumulativeBSplineDoubleTest, testJacobians) {
+  CumulativeBSplineData<double> fixture;
+  const double h = 1.0e-6;
+  for (double time = 1.55; time < 2.25; time += 0.13) {
+    kindr::RotationBSplineD::Jacobian rotationJacobian;
+    kindr::RotationBSplineD::Jacobian angularVelocityJacobian;
+    kindr::PositionBSplineD::Jacobian positionJacobian;
+    std::size_t firstControlPoint;
+    fixture.rotationSpline.getRotationJacobian(time, rotationJacobian, firstControlPoint);
+    fixture.rotationSpline.getAngularVelocityJacobian(time, angularVelocityJacobian, firstControlPoint);
+    fixture.positionSpline.getPositionJacobian(time, positionJacobian, firstControlPoint);
+    const kindr::RotationQuaternionD rotation = fixture.rotationSpline.getRotation(time);
+    const Eigen::Vector3d angularVelocity = fixture.rotationSpline.getAngularVelocity(time).toImplementation();
+    const Eigen::Vector3d position = fixture.positionSpline.getPosition(time).toImplementation();
+    for (int k = 0; k < 4; ++k) {
+      for (int i = 0; i < 3; ++i) {
+        kindr::RotationBSplineD rotationSpline = fixture.rotationSpline;
+        kindr::RotationQuaternionD& controlPoint = rotationSpline.getControlPoints()[firstControlPoint + k];
+        controlPoint = controlPoint*kindr::RotationQuaternionD().exponentialMap(h*Eigen::Vector3d::Unit(i));
+        const Eigen::Vector3d numericalRotationJacobian = (rotation.inverted()*rotationSpline.getRotation(time)).logarithmicMap()/h;
+        KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(numericalRotationJacobian, rotationJacobian.col(3*k + i), 1e-4, 1e-4, "rotation");
+        const Eigen::Vector3d numericalAngularVelocityJacobian = (rotationSpline.getAngularVelocity(time).toImplementation() - angularVelocity)/h;
+        KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(numericalAngularVelocityJacobian, angularVelocityJacobian.col(3*k + i), 1e-3, 1e-4, "angular velocity");
+
+        kindr::PositionBSplineD positionSpline = fixture.positionSpline;
+        positionSpline.getControlPoints()[firstControlPoint + k].toImplementation()(i) += h;
+        const Eigen::Vector3d numericalPositionJacobian = (positionSpline.getPosition(time).toImplementation() - position)/h;
+        KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(numericalPositionJacobian, positionJacobian.col(3*k + i), 1e-4, 1e-4, "position");
+      }
+    }
+  }
+}
+
+TEST(CumulativeBSplineDoubleTest, testInverseJacobianOfExponentialMap) {
+  for (const Eigen::Vector3d& vector : {Eigen::Vector3d(0.3, -0.2, 0.1), Eigen::Vector3d(1.0e-6, 0.0, 2.0e-6), Eigen::Vector3d(0.0, 3.1, 0.0)}) {
+    KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(Eigen::Matrix3d::Identity(), kindr::getInverseJacobianOfExponentialMap(vector)*kindr::getJacobianOfExponentialMap(vector), 1e-8, 1e-8, "inverse");
+  }
+}
+
+TEST(CumulativeBSplineDoubleTest, testPoseSpline) {
+  CumulativeBSplineData<double> fixture;
+  kindr::PoseBSplineD spline(fixture.startTime, fixture.timeInterval);
+  for (std::size_t k = 0; k < fixture.rotationSpline.getControlPoints().size(); ++k) {
+    spline.addControlPoint(kindr::HomTransformQuatD(fixture.positionSpline.getControlPoints()[k], fixture.rotationSpline.getControlPoints()[k]));
+  }
+  const double time = 1.93;
+  const kindr::HomTransformQuatD pose = spline.getPose(time);
+  EXPECT_TRUE(pose.getRotation().isNear(fixture.rotationSpline.getRotation(time), 1e-10));
+  KINDR_ASSERT_DOUBLE_MX_EQ(fixture.positionSpline.getPosition(time).toImplementation(), pose.getPosition().toImplementation(), 1e-8, "position");
+  const kindr::PoseBSplineD::Twist twist = spline.getTwist(time);
+  KINDR_ASSERT_DOUBLE_MX_EQ(fixture.rotationSpline.getAngularVelocity(time).toImplementation(), twist.getRotationalVelocity().toImplementation(), 1e-8, "angular velocity");
+  // body linear velocity R^T*dp/dt
+  const double h = 1e-5;
+  const Eigen::Vector3d positionDerivative = (spline.getPose(time + h).getPosition() - spline.getPose(time - h).getPosition()).toImplementation()/(2.0*h);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(pose.getRotation().inverseRotate(positionDerivative), twist.getTranslationalVelocity().toImplementation(), 1e-6, 1e-6, "linear velocity");
+  // the twist is consistent with the pose integration
+  const kindr::HomTransformQuatD integrated = kindr::integratePose(pose, twist, h);
+  const kindr::HomTransformQuatD expected = spline.getPose(time + h);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(expected.getPosition().toImplementation(), integrated.getPosition().toImplementation(), 1e-8, 1e-8, "integrated position");
+  EXPECT_LT(expected.getRotation().getDisparityAngle(integrated.getRotation()), 1e-8);
+  kindr::PoseBSplineD::Poses poses;
+  spline.getPoses({1.6, 1.93, 2.2}, poses);
+  ASSERT_EQ(3u, poses.size());
+  EXPECT_TRUE(poses[1].getRotation().isNear(pose.getRotation(), 1e-10));
+}
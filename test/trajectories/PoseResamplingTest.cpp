@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "kindr/trajectories/PoseResampling.hpp"
+#include "kindr/common/gtest_eigen.hpp"
+
+template <typename PrimType_>
+class PoseResamplingTest : public ::testing::Test {
+ public:
+  typedef PrimType_ Scalar;
+  typedef kindr::PoseResampler<Scalar> Resampler;
+  typedef typename Resampler::Pose Pose;
+  typedef typename Resampler::Twist Twist;
+  typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+  typedef kindr::RotationQuaternion<Scalar> Rotation;
+
+  //! Smooth trajectory with a constant body angular velocity
+  static Pose getPose(Scalar time) {
+    using std::sin;
+    using std::cos;
+    const Rotation rotation = getInitialRotation()*Rotation().exponentialMap(time*getAngularVelocity());
+    return Pose(typename Pose::Position(sin(time), cos(Scalar(2)*time), Scalar(0.5)*time*time), rotation);
+  }
+
+  static Twist getTwist(Scalar time) {
+    using std::sin;
+    using std::cos;
+    const Vector3 velocity(cos(time), -Scalar(2)*sin(Scalar(2)*time), time);
+    return Twist(getPose(time).getRotation().inverseRotate(velocity), getAngularVelocity());
+  }
+
+  static Rotation getInitialRotation() {
+    return Rotation(kindr::EulerAnglesZyx<Scalar>(Scalar(0.3), Scalar(-0.2), Scalar(0.5)));
+  }
+
+  static Vector3 getAngularVelocity() {
+    return Vector3(Scalar(0.4), Scalar(-0.9), Scalar(1.3));
+  }
+
+  //! Samples at irregular times in [0, 2]
+  static void addSamples(Resampler& resampler) {
+    Scalar time = Scalar(0);
+    for (int k = 0; k < 40; ++k) {
+      resampler.addSample(time, getPose(time), getTwist(time));
+      time += Scalar(0.03) + Scalar(0.04)*Scalar(k % 3);
+    }
+  }
+
+  static Scalar getPositionError(const Pose& expected, const Pose& actual) {
+    return (expected.getPosition() - actual.getPosition()).norm();
+  }
+
+  static Scalar getRotationError(const Pose& expected, const Pose& actual) {
+    return expected.getRotation().getDisparityAngle(actual.getRotation());
+  }
+
+  static double getTolerance() {
+    return std::is_same<Scalar, float>::value ? 1.0e-4 : 1.0e-10;
+  }
+};
+
+typedef ::testing::Types<float, double> PrimTypes;
+
+TYPED_TEST_CASE(PoseResamplingTest, PrimTypes);
+
+TYPED_TEST(PoseResamplingTest, testSamples) {
+  typedef typename TestFixture::Scalar Scalar;
+  const kindr::PoseInterpolationType types[] = {kindr::PoseInterpolationType::LinearSlerp, kindr::PoseInterpolationType::Geodesic, kindr::PoseInterpolationType::Hermite};
+  for (kindr::PoseInterpolationType type : types) {
+    typename TestFixture::Resampler resampler(type);
+    this->addSamples(resampler);
+    ASSERT_EQ(39u, resampler.getNumberOfSegments());
+    EXPECT_EQ(Scalar(0), resampler.getStartTime());
+    // the interpolation passes through the samples
+    Scalar time = Scalar(0);
+    for (int k = 0; k < 40; ++k) {
+      EXPECT_LE(this->getPositionError(this->getPose(time), resampler.getPose(time)), 10.0*this->getTolerance());
+      EXPECT_LE(this->getRotationError(this->getPose(time), resampler.getPose(time)), 10.0*this->getTolerance());
+      KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(this->getTwist(time).getVector(), resampler.getTwist(time).getVector(), 1.0e-4, 1.0e-4, "twist");
+      time += Scalar(0.03) + Scalar(0.04)*Scalar(k % 3);
+    }
+    EXPECT_THROW(resampler.getPose(resampler.getEndTime() + Scalar(1)), std::runtime_error);
+  }
+}
+
+TYPED_TEST(PoseResamplingTest, testLinearSlerp) {
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Pose Pose;
+  typename TestFixture::Resampler resampler;
+  const Pose start = this->getPose(Scalar(0));
+  const Pose end = this->getPose(Scalar(1));
+  resampler.addSample(Scalar(1), start);
+  resampler.addSample(Scalar(3), end);
+  const Pose pose = resampler.getPose(Scalar(1.5));
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL((Scalar(0.75)*start.getPosition().toImplementation() + Scalar(0.25)*end.getPosition().toImplementation()),
+                                    pose.getPosition().toImplementation(), 1.0e-5, 1.0e-5, "position");
+  const typename TestFixture::Rotation slerp(start.getRotation().toImplementation().slerp(Scalar(0.25), end.getRotation().toImplementation()));
+  EXPECT_LE(slerp.getDisparityAngle(pose.getRotation()), Scalar(1.0e-5));
+}
+
+TYPED_TEST(PoseResamplingTest, testGeodesic) {
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Pose Pose;
+  // poses of a constant twist lie on a geodesic
+  const typename TestFixture::Twist twist(typename TestFixture::Vector3(Scalar(0.5), Scalar(-1), Scalar(2)), typename TestFixture::Vector3(Scalar(1), Scalar(0.5), Scalar(-0.7)));
+  const Pose start = this->getPose(Scalar(0.3));
+  typename TestFixture::Resampler resampler(kindr::PoseInterpolationType::Geodesic);
+  resampler.addSample(Scalar(0), start);
+  resampler.addSample(Scalar(1), kindr::integratePose(start, twist, Scalar(1)));
+  for (int i = 1; i < 10; ++i) {
+    const Scalar time = Scalar(0.1)*Scalar(i);
+    const Pose expected = kindr::integratePose(start, twist, time);
+    EXPECT_LE(this->getPositionError(expected, resampler.getPose(time)), 10.0*this->getTolerance());
+    EXPECT_LE(this->getRotationError(expected, resampler.getPose(time)), 10.0*this->getTolerance());
+  }
+}
+
+TYPED_TEST(PoseResamplingTest, testHermite) {
+  typedef typename TestFixture::Scalar Scalar;
+  typename TestFixture::Resampler linearResampler(kindr::PoseInterpolationType::LinearSlerp);
+  typename TestFixture::Resampler hermiteResampler(kindr::PoseInterpolationType::Hermite);
+  this->addSamples(linearResampler);
+  this->addSamples(hermiteResampler);
+  Scalar linearError = Scalar(0);
+  Scalar hermiteError = Scalar(0);
+  for (int i = 0; i < 100; ++i) {
+    const Scalar time = Scalar(0.0173)*Scalar(i);
+    linearError = std::max(linearError, this->getPositionError(this->getPose(time), linearResampler.getPose(time)));
+    hermiteError = std::max(hermiteError, this->getPositionError(this->getPose(time), hermiteResampler.getPose(time)));
+    // the rotation with a constant angular velocity is reproduced
+    EXPECT_LE(this->getRotationError(this->getPose(time), hermiteResampler.getPose(time)), 100.0*this->getTolerance());
+  }
+  EXPECT_LT(hermiteError, Scalar(1.0e-4));
+  EXPECT_LT(Scalar(20)*hermiteError, linearError);
+}
+
+TYPED_TEST(PoseResamplingTest, testBatch) {
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Resampler Resampler;
+  typedef typename TestFixture::Pose Pose;
+  const kindr::PoseInterpolationType types[] = {kindr::PoseInterpolationType::LinearSlerp, kindr::PoseInterpolationType::Geodesic, kindr::PoseInterpolationType::Hermite};
+  for (kindr::PoseInterpolationType type : types) {
+    Resampler resampler(type);
+    this->addSamples(resampler);
+    // sorted queries over several chunks followed by unsorted ones
+    typename Resampler::Times queryTimes(90);
+    for (int i = 0; i < 70; ++i) {
+      queryTimes(i) = Scalar(0.029)*Scalar(i);
+    }
+    for (int i = 70; i < 90; ++i) {
+      queryTimes(i) = Scalar(0.5)*(Scalar(1) + std::sin(Scalar(i)));
+    }
+    typename Resampler::Positions positions;
+    typename Resampler::Quaternions quaternions;
+    typename Resampler::Twists twists;
+    resampler.resample(queryTimes, positions, quaternions, twists);
+    ASSERT_EQ(90, positions.rows());
+    for (int i = 0; i < 90; ++i) {
+      const Pose expected = resampler.getPose(queryTimes(i));
+      const Pose actual(typename Pose::Position(typename TestFixture::Vector3(positions.row(i).transpose())),
+                        typename TestFixture::Rotation(quaternions(i, 0), quaternions(i, 1), quaternions(i, 2), quaternions(i, 3)));
+      EXPECT_LE(this->getPositionError(expected, actual), 10.0*this->getTolerance());
+      EXPECT_LE(this->getRotationError(expected, actual), 10.0*this->getTolerance());
+      KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(resampler.getTwist(queryTimes(i)).getVector(), twists.row(i).transpose(), 1.0e-6, 1.0e-6, "twist");
+    }
+  }
+}
+
+TYPED_TEST(PoseResamplingTest, testStreaming) {
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Resampler Resampler;
+  Resampler resampler(kindr::PoseInterpolationType::Hermite);
+  Resampler reference(kindr::PoseInterpolationType::Hermite);
+  this->addSamples(reference);
+  // samples and queries arrive interleaved, old samples are removed
+  Scalar sampleTime = Scalar(0);
+  Scalar queryTime = Scalar(0);
+  for (int k = 0; k < 40; ++k) {
+    resampler.addSample(sampleTime, this->getPose(sampleTime), this->getTwist(sampleTime));
+    sampleTime += Scalar(0.03) + Scalar(0.04)*Scalar(k % 3);
+    if (k == 0) {
+      continue;
+    }
+    while (queryTime <= resampler.getEndTime()) {
+      EXPECT_LE(this->getPositionError(reference.getPose(queryTime), resampler.getPose(queryTime)), 10.0*this->getTolerance());
+      queryTime += Scalar(0.01);
+    }
+    resampler.removeSamplesBefore(queryTime);
+    EXPECT_GE(2u, resampler.getNumberOfSegments());
+  }
+}
+
+TEST(PoseResamplingPrecisionTest, testFloatGeodesicAtSmallAngles) {
+  // The segment rotates by 0.02 rad, such that the interpolated angles cross the small-angle branch of the
+  // exponential map, where its closed forms cancel in float.
+  const Eigen::Vector3d rotationVector = 0.02*Eigen::Vector3d(0.3, -0.8, 0.5).normalized();
+  const Eigen::Vector4f coefficients = kindr::RotationQuaternionD().exponentialMap(rotationVector).vector().cast<float>();
+  const kindr::RotationQuaternionF rotation = kindr::RotationQuaternionF(coefficients(0), coefficients(1), coefficients(2), coefficients(3)).getUnique();
+  const kindr::RotationQuaternionD rotationD(double(rotation.w()), double(rotation.x()), double(rotation.y()), double(rotation.z()));
+  const Eigen::Vector3f position(0.9f, 0.7f, -1.1f);
+  kindr::PoseResampler<float> resampler(kindr::PoseInterpolationType::Geodesic);
+  kindr::PoseResampler<double> resamplerD(kindr::PoseInterpolationType::Geodesic);
+  resampler.addSample(0.0f, kindr::HomTransformQuatF());
+  resampler.addSample(1.0f, kindr::HomTransformQuatF(kindr::Position3F(position), rotation));
+  resamplerD.addSample(0.0, kindr::HomTransformQuatD());
+  resamplerD.addSample(1.0, kindr::HomTransformQuatD(kindr::Position3D(position.cast<double>()), rotationD));
+  kindr::PoseResampler<float>::Times queryTimes(41);
+  for (int i = 0; i < 41; ++i) {
+    queryTimes(i) = 0.025f*float(i);
+  }
+  kindr::PoseResampler<float>::Positions positions;
+  kindr::PoseResampler<float>::Quaternions quaternions;
+  kindr::PoseResampler<double>::Positions positionsD;
+  kindr::PoseResampler<double>::Quaternions quaternionsD;
+  resampler.resample(queryTimes, positions, quaternions);
+  resamplerD.resample(queryTimes.cast<double>(), positionsD, quaternionsD);
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(positionsD, positions.cast<double>(), 3.0e-7, 3.0e-7, "positions");
+  KINDR_ASSERT_DOUBLE_MX_EQ_ABS_REL(quaternionsD, quaternions.cast<double>(), 3.0e-7, 3.0e-7, "quaternions");
+}